@@ -91,6 +91,7 @@
 #include <eq/global.h>
 #include <eq/image.h>
 #include <eq/imageOp.h>
+#include <eq/imageWriter.h>
 #include <eq/init.h>
 #include <eq/layout.h>
 #include <eq/log.h>
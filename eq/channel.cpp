@@ -29,6 +29,7 @@
 #include "client.h"
 #include "compositor.h"
 #include "config.h"
+#include "detail/deltaCoder.h"
 #include "detail/fileFrameWriter.h"
 #include "error.h"
 #include "frame.h"
@@ -239,6 +240,8 @@ bool Channel::configExit()
     _impl->_deflectProxy = 0;
 #endif
     _impl->framebufferImage.flush();
+    _impl->sparseImage.flush();
+    _impl->packedVersion = co::ObjectVersion();
     return true;
 }
 
@@ -501,6 +504,9 @@ const View* Channel::getNativeView() const
 
 void Channel::changeLatency(const uint32_t latency)
 {
+    if (_impl->statistics->size() == latency + 1)
+        return;
+
 #ifndef NDEBUG
     for (detail::Channel::StatisticsRBCIter i = _impl->statistics->begin();
          i != _impl->statistics->end(); ++i)
@@ -1233,6 +1239,18 @@ bool Channel::_asyncFinishReadback(const std::vector<size_t>& imagePos,
         const std::vector<uint128_t>& nodes = frame->getInputNodes(eye);
         const co::NodeIDs& netNodes = frame->getInputNetNodes(eye);
 
+        // transmit multiple regions as one sparse image
+        bool hasAsync = false;
+        for (uint64_t j = imagePos[i]; j < nImages; ++j)
+            hasAsync = hasAsync || images[j]->hasAsyncReadback();
+        if (!hasAsync && nImages > imagePos[i] + 1 && !nodes.empty())
+        {
+            _asyncTransmit(frameData, frameNumber, imagePos[i],
+                           nImages - imagePos[i], nodes, netNodes,
+                           getTaskID());
+            continue;
+        }
+
         for (uint64_t j = imagePos[i]; j < nImages; ++j)
         {
             if (images[j]->hasAsyncReadback()) // finish async readback
@@ -1247,7 +1265,7 @@ bool Channel::_asyncFinishReadback(const std::vector<size_t>& imagePos,
                     << getTaskID() << nodes << netNodes;
             }
             else // transmit images asynchronously
-                _asyncTransmit(frameData, frameNumber, j, nodes, netNodes,
+                _asyncTransmit(frameData, frameNumber, j, 1, nodes, netNodes,
                                getTaskID());
         }
     }
@@ -1281,11 +1299,12 @@ void Channel::_finishReadback(const co::ObjectVersion& frameDataVersion,
     LBASSERT(!image->hasAsyncReadback());
 
     // schedule async image tranmission
-    _asyncTransmit(frameData, frameNumber, imageIndex, nodes, netNodes, taskID);
+    _asyncTransmit(frameData, frameNumber, imageIndex, 1, nodes, netNodes,
+                   taskID);
 }
 
 void Channel::_asyncTransmit(FrameDataPtr frame, const uint32_t frameNumber,
-                             const uint64_t image,
+                             const uint64_t image, const uint64_t nImages,
                              const std::vector<uint128_t>& nodes,
                              const co::NodeIDs& netNodes, const uint32_t taskID)
 {
@@ -1300,15 +1319,15 @@ void Channel::_asyncTransmit(FrameDataPtr frame, const uint32_t frameNumber,
                                         << " receiver " << *i << " on " << *j
                                         << std::endl;
         send(getLocalNode(), fabric::CMD_CHANNEL_FRAME_TRANSMIT_IMAGE)
-            << co::ObjectVersion(frame) << *i << *j << image << frameNumber
-            << taskID;
+            << co::ObjectVersion(frame) << *i << *j << image << nImages
+            << frameNumber << taskID;
     }
 }
 
 void Channel::_transmitImage(const co::ObjectVersion& frameDataVersion,
                              const uint128_t& nodeID,
                              const co::NodeID& netNodeID,
-                             const uint64_t imageIndex,
+                             const uint64_t imageIndex, const uint64_t nImages,
                              const uint32_t frameNumber, const uint32_t taskID)
 {
     LBLOG(LOG_TASKS | LOG_ASSEMBLY) << "Transmit" << std::endl;
@@ -1326,8 +1345,30 @@ void Channel::_transmitImage(const co::ObjectVersion& frameDataVersion,
     transmitEvent.statistic.task = taskID;
 
     const Images& images = frameData->getImages();
+    LBASSERT(images.size() >= imageIndex + nImages);
     Image* image = images[imageIndex];
-    LBASSERT(images.size() > imageIndex);
+
+    if (nImages > 1)
+    {
+        // pack once for all receivers
+        if (_impl->packedVersion != frameDataVersion ||
+            _impl->packedIndex != imageIndex)
+        {
+            const Images regions(images.begin() + imageIndex,
+                                 images.begin() + imageIndex + nImages);
+            _impl->packedVersion = co::ObjectVersion();
+            if (!_impl->sparseImage.packTiles(regions))
+            {
+                for (uint64_t i = imageIndex; i < imageIndex + nImages; ++i)
+                    _transmitImage(frameDataVersion, nodeID, netNodeID, i, 1,
+                                   frameNumber, taskID);
+                return;
+            }
+            _impl->packedVersion = frameDataVersion;
+            _impl->packedIndex = imageIndex;
+        }
+        image = &_impl->sparseImage;
+    }
 
     if (image->getStorageType() == Frame::TYPE_TEXTURE)
     {
@@ -1351,9 +1392,11 @@ void Channel::_transmitImage(const co::ObjectVersion& frameDataVersion,
 
     // use compression on links up to 2 GBit/s
     const bool useCompression = (description->bandwidth <= 262144);
+    const bool temporal = getIAttribute(IATTR_HINT_TEMPORAL_DELTA) == ON;
 
     std::vector<const PixelData*> pixelDatas;
     std::vector<float> qualities;
+    std::vector<std::shared_ptr<const detail::DeltaCoder>> deltas;
 
     Frame::Buffer commandBuffers = Frame::Buffer::none;
     uint64_t imageDataSize = 0;
@@ -1379,9 +1422,27 @@ void Channel::_transmitImage(const co::ObjectVersion& frameDataVersion,
                 // format, type, nChunks, compressor name
                 imageDataSize += sizeof(FrameData::ImageHeader);
 
+                // send only the tiles of lossless buffers changed since the
+                // last transmission to this node
+                Image* source = image;
+                std::shared_ptr<detail::DeltaCoder> delta;
+                if (temporal)
+                {
+                    imageDataSize += sizeof(detail::DeltaCoder::Header);
+                    if (image->getQuality(buffer) >= 1.f)
+                    {
+                        delta = getNode()->getDeltaEncoder(
+                            frameDataVersion.identifier, imageIndex, nodeID, j);
+                        if (delta->encode(*image, buffer))
+                            source = &delta->getTiles();
+                        imageDataSize += delta->getMask().size();
+                    }
+                }
+                deltas.push_back(delta);
+
                 const PixelData& data = useCompression
-                                            ? image->compressPixelData(buffer)
-                                            : image->getPixelData(buffer);
+                                            ? source->compressPixelData(buffer)
+                                            : source->getPixelData(buffer);
                 pixelDatas.push_back(&data);
                 qualities.push_back(image->getQuality(buffer));
 
@@ -1395,7 +1456,7 @@ void Channel::_transmitImage(const co::ObjectVersion& frameDataVersion,
                 }
                 else
                     imageDataSize +=
-                        sizeof(uint64_t) + image->getPixelDataSize(buffer);
+                        sizeof(uint64_t) + data.pvp.getArea() * data.pixelSize;
 
                 commandBuffers |= buffer;
                 rawSize += image->getPixelDataSize(buffer);
@@ -1426,7 +1487,8 @@ void Channel::_transmitImage(const co::ObjectVersion& frameDataVersion,
                                co::COMMANDTYPE_OBJECT, nodeID, CO_INSTANCE_ALL);
     command << frameDataVersion << image->getPixelViewport() << image->getZoom()
             << image->getContext() << commandBuffers << frameNumber
-            << image->getAlphaUsage();
+            << image->getAlphaUsage() << getNode()->getID() << imageIndex
+            << temporal << image->getTileMask() << image->getCoverage();
     command.sendHeader(imageDataSize);
 
 #ifndef NDEBUG
@@ -1435,6 +1497,19 @@ void Channel::_transmitImage(const co::ObjectVersion& frameDataVersion,
 
     for (uint32_t j = 0; j < pixelDatas.size(); ++j)
     {
+        if (temporal)
+        {
+            const detail::DeltaCoder* delta = deltas[j].get();
+            const detail::DeltaCoder::Header deltaHeader =
+                delta ? delta->getHeader() : detail::DeltaCoder::Header();
+            connection->send(&deltaHeader, sizeof(deltaHeader), true);
+            if (deltaHeader.maskSize > 0)
+                connection->send(delta->getMask().data(),
+                                 deltaHeader.maskSize, true);
+#ifndef NDEBUG
+            sentBytes += sizeof(deltaHeader) + deltaHeader.maskSize;
+#endif
+        }
 #ifndef NDEBUG
         sentBytes += sizeof(FrameData::ImageHeader);
 #endif
@@ -1606,7 +1681,7 @@ bool Channel::_cmdConfigInit(co::ICommand& cmd)
     LBLOG(LOG_INIT) << "TASK channel config init " << command << std::endl;
 
     const Config* config = getConfig();
-    changeLatency(config->getLatency());
+    changeLatency(config->getMaxLatency());
 
     bool result = false;
     const Window* window = getWindow();
@@ -1844,6 +1919,7 @@ bool Channel::_cmdFrameTransmitImage(co::ICommand& cmd)
     const uint128_t& nodeID = command.read<uint128_t>();
     const co::NodeID& netNodeID = command.read<co::NodeID>();
     const uint64_t imageIndex = command.read<uint64_t>();
+    const uint64_t nImages = command.read<uint64_t>();
     const uint32_t frameNumber = command.read<uint32_t>();
     const uint32_t taskID = command.read<uint32_t>();
 
@@ -1851,8 +1927,8 @@ bool Channel::_cmdFrameTransmitImage(co::ICommand& cmd)
                                     << frameData << " receiver " << nodeID
                                     << " on " << netNodeID << std::endl;
 
-    _transmitImage(frameData, nodeID, netNodeID, imageIndex, frameNumber,
-                   taskID);
+    _transmitImage(frameData, nodeID, netNodeID, imageIndex, nImages,
+                   frameNumber, taskID);
     _unrefFrame(frameNumber);
     return true;
 }
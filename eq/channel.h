@@ -640,11 +640,11 @@ private:
     /** Check for and send frame finish reply. */
     void _unrefFrame(const uint32_t frameNumber);
 
-    /** Transmit one image of a frame to one node. */
+    /** Transmit images of a frame to one node, packed if more than one. */
     void _transmitImage(const co::ObjectVersion& frameDataVersion,
                         const uint128_t& nodeID, const co::NodeID& netNodeID,
-                        const uint64_t imageIndex, const uint32_t frameNumber,
-                        const uint32_t taskID);
+                        const uint64_t imageIndex, const uint64_t nImages,
+                        const uint32_t frameNumber, const uint32_t taskID);
 
     void _frameReadback(const uint128_t& frameID,
                         const co::ObjectVersions& frames);
@@ -658,7 +658,7 @@ private:
                               const Frames& frames);
 
     void _asyncTransmit(FrameDataPtr frame, const uint32_t frameNumber,
-                        const uint64_t image,
+                        const uint64_t image, const uint64_t nImages,
                         const std::vector<uint128_t>& nodes,
                         const co::NodeIDs& netNodes, const uint32_t taskID);
 
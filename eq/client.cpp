@@ -22,6 +22,7 @@
 #include "config.h"
 #include "global.h"
 #include "init.h"
+#include "log.h"
 #include "node.h"
 #include "nodeFactory.h"
 #include "server.h"
@@ -35,6 +36,7 @@
 
 #include <eq/server/localServer.h>
 
+#include <co/buffer.h>
 #include <co/connection.h>
 #include <co/connectionDescription.h>
 #include <co/global.h>
@@ -91,6 +93,29 @@ public:
     QApplication* qtApp;
     bool running;
 
+    /** Recycled buffers of batched frame tasks, receiver thread only. */
+    std::vector<co::BufferPtr> taskBuffers;
+
+    /** Dispatched tasks of not fully dispatched batches, by batch data. */
+    std::unordered_map<const void*, size_t> dispatchedTasks;
+
+    /** @return a free buffer holding a copy of the given task command. */
+    co::BufferPtr getTaskBuffer(const uint8_t* data, const uint64_t size)
+    {
+        // a buffer is free when its last command has been handled
+        for (co::BufferPtr& buffer : taskBuffers)
+        {
+            if (buffer->getRefCount() == 1)
+            {
+                buffer->replace(data, size);
+                return buffer;
+            }
+        }
+        taskBuffers.push_back(new co::Buffer);
+        taskBuffers.back()->replace(data, size);
+        return taskBuffers.back();
+    }
+
     void initQt(int argc LB_UNUSED, char** argv LB_UNUSED)
     {
 #if EQ_GLX_USED || EQ_WGL_USED || EQ_AGL_USED
@@ -119,9 +144,11 @@ Client::Client()
     , _impl(new detail::Client)
 {
     registerCommand(fabric::CMD_CLIENT_EXIT,
-                    ClientFunc(this, &Client::_cmdExit), &_impl->queue);
+                    ClientFunc(this, &Client::_cmdExit),
+                    _impl->queue.getDispatchQueue());
     registerCommand(fabric::CMD_CLIENT_INTERRUPT,
-                    ClientFunc(this, &Client::_cmdInterrupt), &_impl->queue);
+                    ClientFunc(this, &Client::_cmdInterrupt),
+                    _impl->queue.getDispatchQueue());
 
     LBVERB << "New client at " << (void*)this << std::endl;
 }
@@ -366,7 +393,7 @@ bool Client::isRunning() const
 
 co::CommandQueue* Client::getMainThreadQueue()
 {
-    return &_impl->queue;
+    return _impl->queue.getDispatchQueue();
 }
 
 void Client::addActiveLayout(const std::string& activeLayout)
@@ -420,6 +447,57 @@ co::NodePtr Client::createNode(const uint32_t type)
     }
 }
 
+bool Client::dispatchCommand(co::ICommand& command)
+{
+    if (command.getType() != co::COMMANDTYPE_NODE ||
+        command.getCommand() != fabric::CMD_CLIENT_FRAME_TASKS)
+    {
+        return Super::dispatchCommand(command);
+    }
+
+    // Split the frame tasks of a node into the individual task commands. A
+    // task for an entity which is not attached yet fails to dispatch. The
+    // batch is then left to the receiver's pending command handling, which
+    // dispatches it again later, resuming at the first failed task.
+    co::ICommand batch(command); // read each dispatch from the start
+    const uint64_t nTasks = batch.read<uint64_t>();
+    const uint64_t* sizes = reinterpret_cast<const uint64_t*>(
+        batch.getRemainingBuffer(nTasks * sizeof(uint64_t)));
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(
+        batch.getRemainingBuffer(batch.getRemainingBufferSize()));
+
+    const void* key = data;
+    auto dispatched = _impl->dispatchedTasks.find(key);
+    uint64_t i = 0;
+    if (dispatched != _impl->dispatchedTasks.end())
+    {
+        for (; i < dispatched->second; ++i)
+            data += sizes[i];
+    }
+
+    co::LocalNodePtr localNode = batch.getLocalNode();
+    co::NodePtr remoteNode = batch.getRemoteNode();
+    for (; i < nTasks; ++i)
+    {
+        co::ICommand task(localNode, remoteNode,
+                          _impl->getTaskBuffer(data, sizes[i]));
+        if (!Super::dispatchCommand(task))
+        {
+            LBLOG(LOG_TASKS) << "TASK pending " << nTasks - i << " of "
+                             << nTasks << " batched tasks" << std::endl;
+            _impl->dispatchedTasks[key] = i;
+            return false;
+        }
+        data += sizes[i];
+    }
+
+    LBLOG(LOG_TASKS) << "TASK dispatched " << nTasks << " batched tasks"
+                     << std::endl;
+    if (dispatched != _impl->dispatchedTasks.end())
+        _impl->dispatchedTasks.erase(dispatched);
+    return true;
+}
+
 bool Client::_cmdExit(co::ICommand& command)
 {
     _impl->running = false;
@@ -99,6 +99,9 @@ public:
     /** @internal @return the command queue to the main node thread. */
     EQ_API co::CommandQueue* getMainThreadQueue() override;
 
+    /** @internal Splits batched frame tasks, see server::Node. */
+    EQ_API bool dispatchCommand(co::ICommand& command) override;
+
     /** Experimental: interrupt main thread queue @internal */
     void interruptMainThread();
 
@@ -21,17 +21,419 @@
 #include "messagePump.h"
 
 #include <co/iCommand.h>
+#include <co/node.h>
 #include <lunchbox/clock.h>
+#include <lunchbox/condition.h>
+#include <lunchbox/lockable.h>
+#include <lunchbox/scopedMutex.h>
+#include <lunchbox/spinLock.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace eq
 {
 namespace
 {
 static lunchbox::Clock _clock;
+const size_t _ringSize = 256; // commands per lane before overflowing
+
+/** A queued command with its enqueue time and order. */
+struct Entry
+{
+    Entry()
+        : time(0)
+        , sequence(0)
+    {
+    }
+
+    co::ICommand command;
+    int64_t time;
+    uint64_t sequence;
+};
+
+/**
+ * Multi-producer, single-consumer FIFO. Producers enqueue lock-free into a
+ * bounded ring of preallocated entries (D. Vyukov). When the ring is full,
+ * commands overflow into a locked list until the consumer has caught up, so
+ * that the queue stays unbounded and keeps the order of each producer.
+ */
+class Lane
+{
+public:
+    Lane()
+        : _slots(new Slot[_ringSize])
+        , _head(0)
+        , _tail(0)
+        , _overflowing(false)
+    {
+        for (size_t i = 0; i < _ringSize; ++i)
+            _slots[i].state.store(i, std::memory_order_relaxed);
+    }
+
+    /** Append a command. Lock-free unless the ring is full. */
+    void push(const co::ICommand& command, const uint64_t sequence)
+    {
+        if (!_overflowing.load(std::memory_order_acquire) &&
+            _pushRing(command, sequence))
+        {
+            return;
+        }
+
+        lunchbox::ScopedFastWrite mutex(_overflow);
+        _overflowing = true;
+        _overflow->push_back(Entry());
+        Entry& entry = _overflow->back();
+        entry.command = command;
+        entry.time = _clock.getTime64();
+        entry.sequence = sequence;
+    }
+
+    /**
+     * Move the pushed entries, oldest first, to the end of the given list.
+     * Consumer only.
+     * @return false if entries remain queued behind a push in flight.
+     */
+    bool drain(std::deque<Entry>& entries)
+    {
+        while (true)
+        {
+            Slot& slot = _slots[_tail % _ringSize];
+            if (slot.state.load(std::memory_order_acquire) != _tail + 1)
+                break;
+
+            entries.push_back(slot.entry);
+            slot.entry.command = co::ICommand(); // release the buffer
+            slot.state.store(_tail + _ringSize, std::memory_order_release);
+            ++_tail;
+        }
+
+        // Overflowed entries are newer than the ring entries of their
+        // producer: take them only once no push into the ring is in flight.
+        if (_head.load(std::memory_order_acquire) != _tail)
+            return false;
+        if (!_overflowing.load(std::memory_order_acquire))
+            return true;
+
+        lunchbox::ScopedFastWrite mutex(_overflow);
+        entries.insert(entries.end(), _overflow->begin(), _overflow->end());
+        _overflow->clear();
+        _overflowing = false;
+        return true;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> state; //!< ready to fill at pos, filled at pos+1
+        Entry entry;
+    };
+
+    std::unique_ptr<Slot[]> _slots;
+    std::atomic<size_t> _head; //!< next position to fill
+    size_t _tail;              //!< next position to consume
+    std::atomic<bool> _overflowing;
+    lunchbox::Lockable<std::deque<Entry>, lunchbox::SpinLock> _overflow;
+
+    bool _pushRing(const co::ICommand& command, const uint64_t sequence)
+    {
+        size_t pos = _head.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot& slot = _slots[pos % _ringSize];
+            const size_t state = slot.state.load(std::memory_order_acquire);
+            if (state == pos)
+            {
+                if (_head.compare_exchange_weak(pos, pos + 1,
+                                                std::memory_order_relaxed))
+                {
+                    slot.entry.command = command;
+                    slot.entry.time = _clock.getTime64();
+                    slot.entry.sequence = sequence;
+                    slot.state.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (state < pos)
+                return false; // full, slot not yet consumed
+            else
+                pos = _head.load(std::memory_order_relaxed);
+        }
+    }
+};
+
+/**
+ * The co::CommandQueue interface of an eq::CommandQueue. Forwards all
+ * virtual methods, the commands are stored in the eq::CommandQueue only.
+ */
+class Endpoint : public co::CommandQueue
+{
+public:
+    Endpoint(eq::CommandQueue& queue, const size_t maxSize, const bool priority)
+        : co::CommandQueue(maxSize)
+        , _queue(queue)
+        , _priority(priority)
+    {
+    }
+
+    void push(const co::ICommand& command) final
+    {
+        if (_priority)
+            _queue.pushPriority(command);
+        else
+            _queue.push(command);
+    }
+
+    void pushFront(const co::ICommand& command) final
+    {
+        _queue.pushFront(command);
+    }
+
+    co::ICommand pop(const uint32_t timeout) final
+    {
+        return _queue.pop(timeout);
+    }
+
+    co::ICommands popAll(const uint32_t timeout) final
+    {
+        return _queue.popAll(timeout);
+    }
+
+    co::ICommand tryPop() final { return _queue.tryPop(); }
+    void pump() final { _queue.pump(); }
+
+    eq::CommandQueue& getQueue() { return _queue; }
+
+private:
+    eq::CommandQueue& _queue;
+    const bool _priority;
+};
+}
+
+namespace detail
+{
+class CommandQueue
+{
+public:
+    CommandQueue(eq::CommandQueue& queue, const size_t maxSize_)
+        : dispatchQueue(queue, maxSize_, false)
+        , priorityQueue(queue, maxSize_, true)
+        , maxSize(maxSize_ ? maxSize_ : std::numeric_limits<size_t>::max())
+        , sequence(0)
+        , size(0)
+        , sleeping(0)
+        , blocked(0)
+        , commands(0)
+        , waitTime(0)
+        , maxWaitTime(0)
+        , depth(0)
+    {
+    }
+
+    void push(const co::ICommand& command, Lane& lane)
+    {
+        if (size >= maxSize)
+            _waitNotFull();
+
+        lane.push(command, sequence++);
+        _pushed();
+    }
+
+    void pushFront(const co::ICommand& command)
+    {
+        {
+            lunchbox::ScopedFastWrite mutex(front);
+            front->push_back(Entry());
+            front->back().command = command;
+            front->back().time = _clock.getTime64();
+        }
+        _pushed();
+    }
+
+    /** Dequeue the next command, if any. Consumer only. */
+    bool tryPop(co::ICommand& command)
+    {
+        if (size == 0)
+            return false;
+
+        int64_t time = 0;
+        if (!_popFront(command, time))
+        {
+            const bool drained = _drain();
+            std::deque<Entry>* entries = _select(drained);
+            if (!entries) // a producer has not finished its push, see wait()
+                return false;
+
+            const Entry& entry = entries->front();
+            if (entries == &normalEntries && entry.command.isValid())
+                _getPending(entry).pop_front();
+            command = entry.command;
+            time = entry.time;
+            entries->pop_front();
+        }
+
+        const int64_t wait = _clock.getTime64() - time;
+        waitTime += wait;
+        maxWaitTime = std::max(maxWaitTime, wait);
+        depth += size--;
+        ++commands;
+
+        if (blocked > 0)
+        {
+            notFull.lock();
+            notFull.signal();
+            notFull.unlock();
+        }
+        return true;
+    }
+
+    /**
+     * Wait until a push completes after size had the given value, also when
+     * the queue is not empty since tryPop() waits for a push in flight. Only
+     * the consumer decreases the size. @return false on timeout.
+     */
+    bool wait(const uint32_t timeout, const size_t observed)
+    {
+        bool result = true;
+        ++sleeping;
+        notEmpty.lock();
+        while (size == observed && result)
+        {
+            if (timeout == LB_TIMEOUT_INDEFINITE)
+                notEmpty.wait();
+            else
+                result = notEmpty.timedWait(timeout);
+        }
+        notEmpty.unlock();
+        --sleeping;
+        return size != observed;
+    }
+
+    void flush()
+    {
+        co::ICommand command;
+        while (tryPop(command))
+            command = co::ICommand();
+    }
+
+    Endpoint dispatchQueue;
+    Endpoint priorityQueue;
+    Lane high;
+    Lane normal;
+    lunchbox::Lockable<std::vector<Entry>, lunchbox::SpinLock> front;
+
+    const size_t maxSize;
+    std::atomic<uint64_t> sequence;
+    std::atomic<size_t> size;
+    std::atomic<int32_t> sleeping;
+    std::atomic<int32_t> blocked;
+    lunchbox::Condition notEmpty;
+    lunchbox::Condition notFull;
+
+    // drained entries, consumer thread only
+    std::deque<Entry> highEntries;
+    std::deque<Entry> normalEntries;
+
+    /** Sequences of the drained normal entries, by sender. */
+    std::unordered_map<const co::Node*, std::deque<uint64_t>> pending;
+
+    // statistics, consumer thread only
+    size_t commands;
+    int64_t waitTime;
+    int64_t maxWaitTime;
+    uint64_t depth;
+
+private:
+    void _pushed()
+    {
+        ++size;
+        if (sleeping > 0)
+        {
+            notEmpty.lock();
+            notEmpty.signal();
+            notEmpty.unlock();
+        }
+    }
+
+    bool _popFront(co::ICommand& command, int64_t& time)
+    {
+        lunchbox::ScopedFastWrite mutex(front);
+        if (front->empty())
+            return false;
+        command = front->back().command;
+        time = front->back().time;
+        front->pop_back();
+        return true;
+    }
+
+    std::deque<uint64_t>& _getPending(const Entry& entry)
+    {
+        return pending[entry.command.getRemoteNode().get()];
+    }
+
+    /**
+     * Move the pushed entries to the consumer. The priority lane is drained
+     * first, so that the normal commands a node sent before a priority
+     * command are drained with it.
+     * @return false if normal commands remain behind a push in flight.
+     */
+    bool _drain()
+    {
+        high.drain(highEntries);
+
+        const size_t first = normalEntries.size();
+        const bool drained = normal.drain(normalEntries);
+        for (size_t i = first; i < normalEntries.size(); ++i)
+        {
+            const Entry& entry = normalEntries[i];
+            if (entry.command.isValid())
+                _getPending(entry).push_back(entry.sequence);
+        }
+        return drained;
+    }
+
+    /**
+     * @return the entries of the next command. A priority command goes first,
+     *         unless an older command of the same sender is still queued,
+     *         which is unknown while normal commands are not drained.
+     */
+    std::deque<Entry>* _select(const bool drained)
+    {
+        if (drained && !highEntries.empty())
+        {
+            const Entry& first = highEntries.front();
+            if (!first.command.isValid())
+                return &highEntries;
+
+            const std::deque<uint64_t>& older = _getPending(first);
+            if (older.empty() || older.front() > first.sequence)
+                return &highEntries;
+        }
+
+        if (!normalEntries.empty())
+            return &normalEntries;
+        return drained && !highEntries.empty() ? &highEntries : nullptr;
+    }
+
+    void _waitNotFull()
+    {
+        ++blocked;
+        notFull.lock();
+        while (size >= maxSize)
+            notFull.wait();
+        notFull.unlock();
+        --blocked;
+    }
+};
 }
 
 CommandQueue::CommandQueue(const size_t maxSize)
-    : co::CommandQueue(maxSize)
+    : _impl(new detail::CommandQueue(*this, maxSize))
     , _messagePump(0)
     , _waitTime(0)
 {
@@ -42,56 +444,82 @@ CommandQueue::~CommandQueue()
     LBASSERT(!_messagePump);
     delete _messagePump;
     _messagePump = 0;
+    delete _impl;
 }
 
 void CommandQueue::push(const co::ICommand& command)
 {
-    co::CommandQueue::push(command);
+    _impl->push(command, _impl->normal);
     if (_messagePump)
         _messagePump->postWakeup();
 }
 
 void CommandQueue::pushFront(const co::ICommand& command)
 {
-    co::CommandQueue::pushFront(command);
+    _impl->pushFront(command);
+    if (_messagePump)
+        _messagePump->postWakeup();
+}
+
+void CommandQueue::pushPriority(const co::ICommand& command)
+{
+    _impl->push(command, _impl->high);
     if (_messagePump)
         _messagePump->postWakeup();
 }
 
+co::CommandQueue* CommandQueue::getDispatchQueue()
+{
+    return &_impl->dispatchQueue;
+}
+
+co::CommandQueue* CommandQueue::getPriorityQueue()
+{
+    return &_impl->priorityQueue;
+}
+
+CommandQueue* CommandQueue::get(co::CommandQueue* queue)
+{
+    Endpoint* endpoint = dynamic_cast<Endpoint*>(queue);
+    return endpoint ? &endpoint->getQueue() : 0;
+}
+
 co::ICommand CommandQueue::pop(const uint32_t timeout)
 {
     const int64_t start = _clock.getTime64();
     int64_t waitBegin = -1;
+    co::ICommand command;
     while (true)
     {
         if (_messagePump)
             _messagePump->dispatchAll(); // non-blocking
 
         // Poll for a command
-        if (!isEmpty())
+        const size_t size = _impl->size;
+        if (_impl->tryPop(command))
         {
             if (waitBegin > -1)
                 _waitTime += (_clock.getTime64() - waitBegin);
-            return co::CommandQueue::pop(0);
+            return command;
         }
 
+        if (waitBegin == -1)
+            waitBegin = _clock.getTime64();
+
         if (_messagePump)
-        {
-            if (waitBegin == -1)
-                waitBegin = _clock.getTime64();
             _messagePump->dispatchOne(timeout); // blocks - push sends wakeup
-        }
-        else
+        else if (!_impl->wait(timeout, size))
         {
-            waitBegin = _clock.getTime64();
-            // blocking
-            const co::ICommand& command = co::CommandQueue::pop(timeout);
             _waitTime += (_clock.getTime64() - waitBegin);
-            return command;
+            return co::ICommand();
         }
 
-        if (_clock.getTime64() - start > timeout)
+        if (timeout != LB_TIMEOUT_INDEFINITE &&
+            _clock.getTime64() - start > timeout)
+        {
+            _waitTime += (_clock.getTime64() - waitBegin);
             return co::ICommand();
+        }
     }
 }
 
@@ -99,36 +527,41 @@ co::ICommands CommandQueue::popAll(const uint32_t timeout)
 {
     const int64_t start = _clock.getTime64();
     int64_t waitBegin = -1;
+    co::ICommands commands;
+    co::ICommand command;
     while (true)
     {
         if (_messagePump)
             _messagePump->dispatchAll(); // non-blocking
 
-        // Poll for commands
-        if (!isEmpty())
+        // Poll for commands, batched dequeue of all queued commands
+        const size_t size = _impl->size;
+        while (_impl->tryPop(command))
+            commands.push_back(command);
+        if (!commands.empty())
         {
             if (waitBegin > -1)
                 _waitTime += (_clock.getTime64() - waitBegin);
-            return co::CommandQueue::popAll(0);
+            return commands;
         }
 
+        if (waitBegin == -1)
+            waitBegin = _clock.getTime64();
+
         if (_messagePump)
-        {
-            if (waitBegin == -1)
-                waitBegin = _clock.getTime64();
             _messagePump->dispatchOne(timeout); // blocks - push sends wakeup
-        }
-        else
+        else if (!_impl->wait(timeout, size))
         {
-            waitBegin = _clock.getTime64();
-            // blocking
-            const co::ICommands& commands = co::CommandQueue::popAll(timeout);
             _waitTime += (_clock.getTime64() - waitBegin);
             return commands;
         }
 
-        if (_clock.getTime64() - start > timeout)
-            return co::ICommands();
+        if (timeout != LB_TIMEOUT_INDEFINITE &&
+            _clock.getTime64() - start > timeout)
+        {
+            _waitTime += (_clock.getTime64() - waitBegin);
+            return commands;
+        }
     }
 }
 
@@ -137,7 +570,40 @@ co::ICommand CommandQueue::tryPop()
     if (_messagePump)
         _messagePump->dispatchAll(); // non-blocking
 
-    return co::CommandQueue::tryPop();
+    co::ICommand command;
+    _impl->tryPop(command);
+    return command;
+}
+
+bool CommandQueue::isEmpty() const
+{
+    return _impl->size == 0;
+}
+
+size_t CommandQueue::getSize() const
+{
+    return _impl->size;
+}
+
+void CommandQueue::flush()
+{
+    _impl->flush();
+}
+
+CommandQueue::Stats CommandQueue::resetStatistics()
+{
+    Stats stats;
+    stats.commands = _impl->commands;
+    stats.waitTime = _impl->waitTime;
+    stats.maxWaitTime = _impl->maxWaitTime;
+    stats.depth = stats.commands ? float(_impl->depth) / float(stats.commands)
+                                 : 0.f;
+
+    _impl->commands = 0;
+    _impl->waitTime = 0;
+    _impl->maxWaitTime = 0;
+    _impl->depth = 0;
+    return stats;
 }
 
 void CommandQueue::pump()
@@ -19,38 +19,72 @@
 #ifndef EQ_COMMANDQUEUE_H
 #define EQ_COMMANDQUEUE_H
 
-#include <co/commandQueue.h> // base class
+#include <co/commandQueue.h> // return type
 #include <eq/types.h>
 #include <eq/windowSystem.h> // enum
 
 namespace eq
 {
+namespace detail
+{
+class CommandQueue;
+}
+
 /**
  * @internal
- * Augments an co::CommandQueue to pump system-specific events where
- * required by the underlying window/operating system.
+ * A command queue which pumps system-specific events where required by the
+ * underlying window/operating system.
+ *
+ * Commands are kept in lock-free, multi-producer lanes. Commands pushed to the
+ * priority lane are dequeued before older commands, unless these have been sent
+ * by the same node. Commands are registered with the co::CommandQueue
+ * interfaces returned by getDispatchQueue() and getPriorityQueue(), which
+ * forward push and pop to this queue and do not store commands themselves.
  */
-class CommandQueue : public co::CommandQueue
+class CommandQueue
 {
 public:
     explicit CommandQueue(const size_t maxSize);
-    virtual ~CommandQueue();
+    ~CommandQueue();
 
     /** @sa co::CommandQueue::push(). */
-    virtual void push(const co::ICommand& command);
+    void push(const co::ICommand& command);
 
     /** @sa co::CommandQueue::pushFront(). */
-    virtual void pushFront(const co::ICommand& command);
+    void pushFront(const co::ICommand& command);
+
+    /** Push a command to the priority lane. @sa getPriorityQueue(). */
+    void pushPriority(const co::ICommand& command);
 
     /** @sa co::CommandQueue::pop(). */
-    virtual co::ICommand pop(const uint32_t timeout = LB_TIMEOUT_INDEFINITE);
+    co::ICommand pop(const uint32_t timeout = LB_TIMEOUT_INDEFINITE);
 
     /** @sa co::CommandQueue::popAll(). */
-    virtual co::ICommands popAll(
-        const uint32_t timeout = LB_TIMEOUT_INDEFINITE);
+    co::ICommands popAll(const uint32_t timeout = LB_TIMEOUT_INDEFINITE);
 
     /** @sa co::CommandQueue::tryPop(). */
-    virtual co::ICommand tryPop();
+    co::ICommand tryPop();
+
+    /** @sa co::CommandQueue::isEmpty(). */
+    bool isEmpty() const;
+
+    /** @sa co::CommandQueue::getSize(). */
+    size_t getSize() const;
+
+    /** Drop all pending commands. @sa co::CommandQueue::flush(). */
+    void flush();
+
+    /** @return the queue to register commands with, pushing to push(). */
+    co::CommandQueue* getDispatchQueue();
+
+    /**
+     * @return the queue to register commands with which overtake the other
+     *         commands of this queue, unless these are from the same node.
+     */
+    co::CommandQueue* getPriorityQueue();
+
+    /** @return the queue of the given dispatch or priority queue, or 0. */
+    static CommandQueue* get(co::CommandQueue* queue);
 
     /** @sa reset the time spent in pop() and return the previous value. */
     int64_t resetWaitTime()
@@ -60,11 +94,27 @@ public:
         return time;
     }
 
+    /** The statistics of the commands dequeued since the last reset. */
+    struct Stats
+    {
+        size_t commands;     //!< number of dequeued commands
+        int64_t waitTime;    //!< summed time the commands spent queued
+        int64_t maxWaitTime; //!< longest time a command spent queued
+        float depth;         //!< mean number of queued commands at dequeue
+    };
+
+    /** Reset the command statistics and return the previous values. */
+    Stats resetStatistics();
+
     void setMessagePump(MessagePump* p) { _messagePump = p; }
     MessagePump* getMessagePump() { return _messagePump; }
-    virtual void pump(); //!< @sa co::CommandQueue::pump()
+    void pump(); //!< @sa co::CommandQueue::pump()
 
 private:
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+
+    detail::CommandQueue* const _impl;
     MessagePump* _messagePump;
 
     /** The time spent waiting in pop(). */
@@ -62,6 +62,9 @@ static const char* depthDBKey = shaderDBKey + 2;
 // Image used for CPU-based assembly
 static lunchbox::PerThread<Image> _resultImage;
 
+// Image used to expand sparse images for GPU-based assembly
+static lunchbox::PerThread<Image> _denseImage;
+
 struct CPUAssemblyFormat
 {
     CPUAssemblyFormat(const bool blend_)
@@ -275,9 +278,55 @@ bool _collectOutputData(const ImageOps& ops, PixelViewport& destPVP,
     return destPVP.hasArea();
 }
 
+/**
+ * Call func(color, depth, pvp, rowLength) for each dense area of an image,
+ * i.e., once for the full image or for each covered area of each tile of a
+ * sparse image.
+ */
+template <class F>
+void _forEachArea(const Image* image, const F& func)
+{
+    const uint8_t* color = image->getPixelPointer(Frame::Buffer::color);
+    const bool hasDepth = image->hasPixelData(Frame::Buffer::depth);
+    const uint8_t* depth =
+        hasDepth ? image->getPixelPointer(Frame::Buffer::depth) : 0;
+
+    if (!image->isSparse())
+    {
+        const PixelViewport& pvp = image->getPixelViewport();
+        func(color, depth, pvp, pvp.w);
+        return;
+    }
+
+    const size_t tileArea = Image::TILE_SIZE * Image::TILE_SIZE;
+    const size_t colorPixel = image->getPixelSize(Frame::Buffer::color);
+    const size_t depthPixel =
+        hasDepth ? image->getPixelSize(Frame::Buffer::depth) : 0;
+    const size_t colorSize = tileArea * colorPixel;
+    const size_t depthSize = tileArea * depthPixel;
+    const PixelViewports& coverage = image->getCoverage();
+
+    image->forEachTile([&](const size_t tile, const PixelViewport& tilePVP) {
+        for (const PixelViewport& covered : coverage)
+        {
+            PixelViewport pvp = tilePVP;
+            pvp.intersect(covered);
+            if (!pvp.hasArea())
+                continue;
+
+            const size_t offset =
+                (pvp.y - tilePVP.y) * Image::TILE_SIZE + pvp.x - tilePVP.x;
+            func(color + tile * colorSize + offset * colorPixel,
+                 depth ? depth + tile * depthSize + offset * depthPixel : 0,
+                 pvp, Image::TILE_SIZE);
+        }
+    });
+}
+
 void _mergeDBImage(void* destColor, void* destDepth,
-                   const PixelViewport& destPVP, const Image* image,
-                   const Vector2i& offset)
+                   const PixelViewport& destPVP, const uint8_t* colorData,
+                   const uint8_t* depthData, const PixelViewport& pvp,
+                   const int32_t rowLength, const Vector2i& offset)
 {
     LBASSERT(destColor && destDepth);
 
@@ -286,15 +335,11 @@ void _mergeDBImage(void* destColor, void* destDepth,
     uint32_t* destC = reinterpret_cast<uint32_t*>(destColor);
     uint32_t* destD = reinterpret_cast<uint32_t*>(destDepth);
 
-    const PixelViewport& pvp = image->getPixelViewport();
-
     const int32_t destX = offset.x() + pvp.x - destPVP.x;
     const int32_t destY = offset.y() + pvp.y - destPVP.y;
 
-    const uint32_t* color = reinterpret_cast<const uint32_t*>(
-        image->getPixelPointer(Frame::Buffer::color));
-    const uint32_t* depth = reinterpret_cast<const uint32_t*>(
-        image->getPixelPointer(Frame::Buffer::depth));
+    const uint32_t* color = reinterpret_cast<const uint32_t*>(colorData);
+    const uint32_t* depth = reinterpret_cast<const uint32_t*>(depthData);
 
 #pragma omp parallel for
     for (int32_t y = 0; y < pvp.h; ++y)
@@ -302,8 +347,8 @@ void _mergeDBImage(void* destColor, void* destDepth,
         const uint32_t skip = (destY + y) * destPVP.w + destX;
         uint32_t* destColorIt = destC + skip;
         uint32_t* destDepthIt = destD + skip;
-        const uint32_t* colorIt = color + y * pvp.w;
-        const uint32_t* depthIt = depth + y * pvp.w;
+        const uint32_t* colorIt = color + y * rowLength;
+        const uint32_t* depthIt = depth + y * rowLength;
 
         for (int32_t x = 0; x < pvp.w; ++x)
         {
@@ -322,8 +367,9 @@ void _mergeDBImage(void* destColor, void* destDepth,
 }
 
 void _merge2DImage(void* destColor, void* destDepth,
-                   const eq::PixelViewport& destPVP, const Image* image,
-                   const Vector2i& offset)
+                   const eq::PixelViewport& destPVP, const uint8_t* color,
+                   const size_t pixelSize, const PixelViewport& pvp,
+                   const int32_t rowLength, const Vector2i& offset)
 {
     // This is mostly copy&paste code from _mergeDBImage :-/
     LBVERB << "CPU-2D assembly" << std::endl;
@@ -331,44 +377,33 @@ void _merge2DImage(void* destColor, void* destDepth,
     uint8_t* destC = reinterpret_cast<uint8_t*>(destColor);
     uint8_t* destD = reinterpret_cast<uint8_t*>(destDepth);
 
-    const PixelViewport& pvp = image->getPixelViewport();
     const int32_t destX = offset.x() + pvp.x - destPVP.x;
     const int32_t destY = offset.y() + pvp.y - destPVP.y;
-
-    LBASSERT(image->hasPixelData(Frame::Buffer::color));
-
-    const uint8_t* color = image->getPixelPointer(Frame::Buffer::color);
-    const size_t pixelSize = image->getPixelSize(Frame::Buffer::color);
-    const size_t rowLength = pvp.w * pixelSize;
+    const size_t rowSize = pvp.w * pixelSize;
 
 #pragma omp parallel for
     for (int32_t y = 0; y < pvp.h; ++y)
     {
         const size_t skip = ((destY + y) * destPVP.w + destX) * pixelSize;
-        memcpy(destC + skip, color + y * pvp.w * pixelSize, rowLength);
+        memcpy(destC + skip, color + y * rowLength * pixelSize, rowSize);
         // clear depth, for depth-assembly into existing FB
         if (destD)
-            lunchbox::setZero(destD + skip, rowLength);
+            lunchbox::setZero(destD + skip, rowSize);
     }
 }
 
 void _blendImage(void* dest, const eq::PixelViewport& destPVP,
-                 const Image* image, const Vector2i& offset)
+                 const uint8_t* colorData, const PixelViewport& pvp,
+                 const int32_t rowLength, const Vector2i& offset)
 {
     LBVERB << "CPU-Blend assembly" << std::endl;
 
     int32_t* destColor = reinterpret_cast<int32_t*>(dest);
 
-    const PixelViewport& pvp = image->getPixelViewport();
     const int32_t destX = offset.x() + pvp.x - destPVP.x;
     const int32_t destY = offset.y() + pvp.y - destPVP.y;
 
-    LBASSERT(image->getPixelSize(Frame::Buffer::color) == 4);
-    LBASSERT(image->hasPixelData(Frame::Buffer::color));
-    LBASSERT(image->hasAlpha());
-
-    const int32_t* color = reinterpret_cast<const int32_t*>(
-        image->getPixelPointer(Frame::Buffer::color));
+    const int32_t* color = reinterpret_cast<const int32_t*>(colorData);
 
     // Blending of two slices, none of which is on final image (i.e. result
     // could be blended on to something else) should be performed with:
@@ -386,7 +421,7 @@ void _blendImage(void* dest, const eq::PixelViewport& destPVP,
     for (int32_t y = 0; y < pvp.h; ++y)
     {
         const unsigned char* src =
-            reinterpret_cast<const uint8_t*>(color + pvp.w * y);
+            reinterpret_cast<const uint8_t*>(color + rowLength * y);
         unsigned char* dst =
             reinterpret_cast<uint8_t*>(destColorStart + destPVP.w * y);
 
@@ -408,17 +443,27 @@ void _mergeImages(const ImageOps& ops, const bool blend, void* colorBuffer,
 {
     for (const ImageOp& op : ops)
     {
-        if (!op.image->hasPixelData(Frame::Buffer::color))
+        const Image* image = op.image;
+        if (!image->hasPixelData(Frame::Buffer::color))
             continue;
 
-        if (op.image->hasPixelData(Frame::Buffer::depth))
-            _mergeDBImage(colorBuffer, depthBuffer, destPVP, op.image,
-                          op.offset);
-        else if (blend && op.image->hasAlpha())
-            _blendImage(colorBuffer, destPVP, op.image, op.offset);
-        else
-            _merge2DImage(colorBuffer, depthBuffer, destPVP, op.image,
-                          op.offset);
+        const bool blendImage = blend && image->hasAlpha();
+        const size_t pixelSize = image->getPixelSize(Frame::Buffer::color);
+        LBASSERT(!blendImage || pixelSize == 4);
+
+        _forEachArea(image, [&](const uint8_t* color, const uint8_t* depth,
+                                const PixelViewport& pvp,
+                                const int32_t rowLength) {
+            if (depth)
+                _mergeDBImage(colorBuffer, depthBuffer, destPVP, color, depth,
+                              pvp, rowLength, op.offset);
+            else if (blendImage)
+                _blendImage(colorBuffer, destPVP, color, pvp, rowLength,
+                            op.offset);
+            else
+                _merge2DImage(colorBuffer, depthBuffer, destPVP, color,
+                              pixelSize, pvp, rowLength, op.offset);
+        });
     }
 }
 
@@ -1119,6 +1164,22 @@ void Compositor::assembleFrame(const Frame* frame, Channel* channel)
 
 void Compositor::assembleImage(const ImageOp& op, Channel* channel)
 {
+    if (op.image->isSparse())
+    {
+        // draw each covered area, the tiles also hold pixels of no image
+        if (!_denseImage)
+            _denseImage = new Image;
+
+        ImageOp denseOp = op;
+        denseOp.image = _denseImage.get();
+        for (const PixelViewport& area : op.image->getCoverage())
+        {
+            op.image->unpackTiles(*_denseImage.get(), area);
+            assembleImage(denseOp, channel);
+        }
+        return;
+    }
+
     const bool coreProfile = channel->getWindow()->getIAttribute(
                                  WindowSettings::IATTR_HINT_CORE_PROFILE) == ON;
     if (coreProfile && op.image->getContext().pixel != Pixel::ALL)
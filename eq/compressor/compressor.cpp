@@ -123,13 +123,9 @@ void EqCompressorCompress(void* const ptr, const unsigned /*name*/,
                           const eq_uint64_t flags)
 {
     assert(ptr);
-    const bool useAlpha = !(flags & EQ_COMPRESSOR_IGNORE_ALPHA);
-    const eq_uint64_t nPixels =
-        (flags & EQ_COMPRESSOR_DATA_1D) ? inDims[1] : inDims[1] * inDims[3];
-
     eq::plugin::Compressor* compressor =
         reinterpret_cast<eq::plugin::Compressor*>(ptr);
-    compressor->compress(in, nPixels, useAlpha);
+    compressor->compress2D(in, inDims, flags);
 }
 
 unsigned EqCompressorGetNumResults(void* const ptr, const unsigned /*name*/)
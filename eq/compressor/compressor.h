@@ -75,6 +75,27 @@ public:
         LBDONTCALL;
     }
 
+    /**
+     * Compress data with its dimensions.
+     *
+     * The default implementation forwards the number of pixels to compress().
+     * Compressors exploiting the 2D layout of the data override this method.
+     *
+     * @param inData data to compress.
+     * @param inDims the dimensions of the input data (x, w, y, h).
+     * @param flags capability flags for the compression.
+     */
+    virtual void compress2D(const void* const inData,
+                            const eq_uint64_t* const inDims,
+                            const eq_uint64_t flags)
+    {
+        const bool useAlpha = !(flags & EQ_COMPRESSOR_IGNORE_ALPHA);
+        const eq_uint64_t nPixels = (flags & EQ_COMPRESSOR_DATA_1D)
+                                        ? inDims[1]
+                                        : inDims[1] * inDims[3];
+        compress(inData, nPixels, useAlpha);
+    }
+
     typedef lunchbox::Bufferb Result;
     typedef std::vector<Result*> Results;
 
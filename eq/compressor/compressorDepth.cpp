@@ -0,0 +1,287 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "compressorDepth.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace eq
+{
+namespace plugin
+{
+namespace
+{
+const uint32_t FAR_DEPTH = 0xffffffffu; // value of cleared pixels
+const uint8_t RUN = 0x80;               // token flag of background runs
+const size_t BLOCK_SIZE = 64;           // max pixels per bit-packed block
+const size_t BAND_ROWS = 64;            // min rows per parallel band
+const size_t MAX_BANDS = 16;
+
+/** Prepended to the compressed data of each band. */
+struct Header
+{
+    uint32_t width;
+    uint32_t nPixels;
+};
+
+static void _getInfo(EqCompressorInfo* const info)
+{
+    info->version = EQ_COMPRESSOR_VERSION;
+    info->name = EQ_COMPRESSOR_PREDICT_DEPTH_UNSIGNED_INT;
+    info->capabilities = EQ_COMPRESSOR_DATA_1D | EQ_COMPRESSOR_DATA_2D;
+    info->tokenType = EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+    info->quality = 1.f;
+    info->ratio = .2f;
+    info->speed = 1.f;
+}
+
+static bool _register()
+{
+    Compressor::registerEngine(
+        Compressor::Functions(EQ_COMPRESSOR_PREDICT_DEPTH_UNSIGNED_INT,
+                              _getInfo, CompressorDepth::getNewCompressor,
+                              CompressorDepth::getNewDecompressor,
+                              CompressorDepth::decompress,
+                              CompressorDepth::isCompatible));
+    return true;
+}
+
+static bool _initialized LB_UNUSED = _register();
+
+/**
+ * Planar prediction from the left, upper and upper-left neighbor. Neighbors
+ * outside of the band or on the background are not used, since their value
+ * is unrelated to the foreground depth.
+ */
+inline uint32_t _predict(const uint32_t* pixel, const size_t x,
+                         const size_t width, const bool firstRow)
+{
+    const uint32_t left = x > 0 ? pixel[-1] : FAR_DEPTH;
+    const uint32_t up = firstRow ? FAR_DEPTH : pixel[-int64_t(width)];
+    const uint32_t upLeft =
+        x > 0 && !firstRow ? pixel[-int64_t(width) - 1] : FAR_DEPTH;
+
+    if (left != FAR_DEPTH && up != FAR_DEPTH && upLeft != FAR_DEPTH)
+        return left + up - upLeft; // wraps consistently on both ends
+    if (left != FAR_DEPTH)
+        return left;
+    if (up != FAR_DEPTH)
+        return up;
+    return upLeft != FAR_DEPTH ? upLeft : 0;
+}
+
+inline uint8_t* _writeRun(uint8_t* out, size_t run)
+{
+    if (run < RUN)
+    {
+        *out++ = RUN | uint8_t(run);
+        return out;
+    }
+
+    *out++ = RUN; // long run, followed by the LEB128-encoded length
+    while (run >= 0x80)
+    {
+        *out++ = uint8_t(run) | 0x80;
+        run >>= 7;
+    }
+    *out++ = uint8_t(run);
+    return out;
+}
+
+inline const uint8_t* _readRun(const uint8_t* in, const uint8_t token,
+                               size_t& run)
+{
+    run = token & ~RUN;
+    if (run > 0)
+        return in;
+
+    for (size_t shift = 0;; shift += 7)
+    {
+        const uint8_t byte = *in++;
+        run |= size_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return in;
+    }
+}
+
+/** @return the worst-case size of a compressed band. */
+size_t _getMaxSize(const size_t nPixels)
+{
+    // a block of one pixel has two bytes token and four bytes data
+    return sizeof(Header) + nPixels * 6;
+}
+
+size_t _compressBand(const uint32_t* const in, const size_t width,
+                     const size_t nPixels, uint8_t* out)
+{
+    uint8_t* const start = out;
+    const Header header = {uint32_t(width), uint32_t(nPixels)};
+    ::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+
+    uint32_t residuals[BLOCK_SIZE];
+    size_t i = 0;
+    while (i < nPixels)
+    {
+        if (in[i] == FAR_DEPTH)
+        {
+            size_t run = 1;
+            while (i + run < nPixels && in[i + run] == FAR_DEPTH)
+                ++run;
+            out = _writeRun(out, run);
+            i += run;
+            continue;
+        }
+
+        size_t x = i % width;
+        size_t n = 0;
+        uint32_t used = 0;
+        for (; n < BLOCK_SIZE && i < nPixels && in[i] != FAR_DEPTH; ++n, ++i)
+        {
+            const uint32_t residual =
+                in[i] - _predict(in + i, x, width, i < width);
+            const uint32_t zigzag =
+                (residual << 1) ^ uint32_t(int32_t(residual) >> 31);
+            residuals[n] = zigzag;
+            used |= zigzag;
+            if (++x == width)
+                x = 0;
+        }
+
+        uint8_t nBits = 0;
+        while (nBits < 32 && (used >> nBits))
+            ++nBits;
+
+        *out++ = nBits;
+        *out++ = uint8_t(n);
+
+        uint64_t bits = 0;
+        size_t nFilled = 0;
+        for (size_t j = 0; j < n; ++j)
+        {
+            bits |= uint64_t(residuals[j]) << nFilled;
+            nFilled += nBits;
+            for (; nFilled >= 8; nFilled -= 8, bits >>= 8)
+                *out++ = uint8_t(bits);
+        }
+        if (nFilled > 0)
+            *out++ = uint8_t(bits);
+    }
+    return out - start;
+}
+
+void _decompressBand(const uint8_t* in, uint32_t* const out)
+{
+    Header header;
+    ::memcpy(&header, in, sizeof(header));
+    in += sizeof(header);
+
+    const size_t width = header.width;
+    const size_t nPixels = header.nPixels;
+    size_t i = 0;
+    while (i < nPixels)
+    {
+        const uint8_t token = *in++;
+        if (token & RUN)
+        {
+            size_t run = 0;
+            in = _readRun(in, token, run);
+            std::fill(out + i, out + i + run, FAR_DEPTH);
+            i += run;
+            continue;
+        }
+
+        const uint8_t nBits = token;
+        const size_t n = *in++;
+        const uint32_t mask = nBits == 32 ? FAR_DEPTH : (1u << nBits) - 1;
+        size_t x = i % width;
+        uint64_t bits = 0;
+        size_t nFilled = 0;
+        for (size_t j = 0; j < n; ++j, ++i)
+        {
+            for (; nFilled < nBits; nFilled += 8)
+                bits |= uint64_t(*in++) << nFilled;
+            const uint32_t zigzag = uint32_t(bits) & mask;
+            bits >>= nBits;
+            nFilled -= nBits;
+
+            const uint32_t residual = (zigzag >> 1) ^ (0u - (zigzag & 1u));
+            out[i] = _predict(out + i, x, width, i < width) + residual;
+            if (++x == width)
+                x = 0;
+        }
+    }
+}
+}
+
+void CompressorDepth::compress2D(const void* const inData,
+                                 const eq_uint64_t* const inDims,
+                                 const eq_uint64_t flags)
+{
+    const bool is1D = flags & EQ_COMPRESSOR_DATA_1D;
+    const size_t width = size_t(inDims[1]);
+    const size_t height = is1D ? 1 : size_t(inDims[3]);
+    const size_t nBands =
+        std::max(size_t(1), std::min(height / BAND_ROWS, MAX_BANDS));
+    const size_t bandRows = (height + nBands - 1) / nBands;
+
+    _nResults = unsigned(nBands);
+    while (_results.size() < nBands)
+        _results.push_back(new Result);
+
+    const uint32_t* const in = reinterpret_cast<const uint32_t*>(inData);
+
+#pragma omp parallel for
+    for (int64_t i = 0; i < int64_t(nBands); ++i)
+    {
+        const size_t startRow = size_t(i) * bandRows;
+        const size_t nRows = std::min(bandRows, height - startRow);
+        const size_t nPixels = nRows * width;
+
+        Result* result = _results[i];
+        result->reserve(_getMaxSize(nPixels));
+        result->setSize(
+            _compressBand(in + startRow * width, width, nPixels,
+                          result->getData()));
+    }
+}
+
+void CompressorDepth::decompress(const void* const* inData,
+                                 const eq_uint64_t* const inSizes LB_UNUSED,
+                                 const unsigned nInputs, void* const outData,
+                                 const eq_uint64_t nPixels LB_UNUSED,
+                                 const bool /*useAlpha*/)
+{
+    // bands are independent, find the output position of each
+    std::vector<size_t> offsets(nInputs, 0);
+    for (unsigned i = 1; i < nInputs; ++i)
+    {
+        Header header;
+        ::memcpy(&header, inData[i - 1], sizeof(header));
+        offsets[i] = offsets[i - 1] + header.nPixels;
+    }
+
+    uint32_t* const out = reinterpret_cast<uint32_t*>(outData);
+
+#pragma omp parallel for
+    for (int64_t i = 0; i < int64_t(nInputs); ++i)
+        _decompressBand(reinterpret_cast<const uint8_t*>(inData[i]),
+                        out + offsets[i]);
+}
+}
+}
@@ -0,0 +1,58 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_PLUGIN_COMPRESSORDEPTH
+#define EQ_PLUGIN_COMPRESSORDEPTH
+
+#include "compressor.h"
+#include "compressorTypes.h"
+
+namespace eq
+{
+namespace plugin
+{
+/**
+ * Lossless compressor for EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT.
+ *
+ * Each pixel is predicted from its left, upper and upper-left neighbor as if
+ * lying on a plane, which makes smooth depth gradients cheap. The residuals
+ * are bit-packed in small blocks using the width of their largest value, and
+ * cleared (max depth) pixels are run-length encoded. The image is split in
+ * independent row bands, which are compressed and decompressed in parallel.
+ */
+class CompressorDepth : public Compressor
+{
+public:
+    CompressorDepth() {}
+    virtual ~CompressorDepth() {}
+
+    static void* getNewCompressor(const unsigned) { return new CompressorDepth; }
+    static void* getNewDecompressor(const unsigned) { return 0; }
+
+    void compress2D(const void* const inData, const eq_uint64_t* const inDims,
+                    const eq_uint64_t flags) override;
+
+    static void decompress(const void* const* inData,
+                           const eq_uint64_t* const inSizes,
+                           const unsigned nInputs, void* const outData,
+                           const eq_uint64_t nPixels, const bool useAlpha);
+
+    static bool isCompatible(const GLEWContext*) { return true; }
+};
+}
+}
+#endif // EQ_PLUGIN_COMPRESSORDEPTH
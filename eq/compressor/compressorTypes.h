@@ -0,0 +1,49 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#ifndef EQ_PLUGIN_COMPRESSORTYPES
+#define EQ_PLUGIN_COMPRESSORTYPES
+
+#include <pression/plugins/compressor.h> // EQ_COMPRESSOR_PRIVATE
+
+/**
+ * @file compressorTypes.h
+ *
+ * Names of the compressors implemented by the Equalizer plugin.
+ *
+ * The names are taken from the private range starting at
+ * EQ_COMPRESSOR_PRIVATE, which Pression leaves to internal Equalizer use.
+ * Private names are not registered with Pression and are only unique within
+ * the Equalizer plugin, so all of them are allocated in this file. Nodes
+ * exchanging compressed images need to use the same Equalizer plugin.
+ */
+
+/** Lossless predictive compressor for 32 bit unsigned depth values. */
+#define EQ_COMPRESSOR_PREDICT_DEPTH_UNSIGNED_INT (EQ_COMPRESSOR_PRIVATE + 1)
+
+/** @name Lossy YCoCg 4:2:0 compressors, by decreasing quality. */
+//@{
+#define EQ_COMPRESSOR_YCOCG_420_RGBA (EQ_COMPRESSOR_PRIVATE + 2)
+#define EQ_COMPRESSOR_YCOCG_420_BGRA (EQ_COMPRESSOR_PRIVATE + 3)
+#define EQ_COMPRESSOR_YCOCG_420_Q1_RGBA (EQ_COMPRESSOR_PRIVATE + 4)
+#define EQ_COMPRESSOR_YCOCG_420_Q1_BGRA (EQ_COMPRESSOR_PRIVATE + 5)
+#define EQ_COMPRESSOR_YCOCG_420_Q2_RGBA (EQ_COMPRESSOR_PRIVATE + 6)
+#define EQ_COMPRESSOR_YCOCG_420_Q2_BGRA (EQ_COMPRESSOR_PRIVATE + 7)
+//@}
+
+#endif // EQ_PLUGIN_COMPRESSORTYPES
@@ -0,0 +1,345 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "compressorYCoCg.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace eq
+{
+namespace plugin
+{
+namespace
+{
+const size_t BAND_ROWS = 64; // min rows per parallel band, even
+const size_t MAX_BANDS = 16;
+
+/** Prepended to the compressed data of each band. */
+struct Header
+{
+    uint32_t width;
+    uint32_t height;
+    uint8_t shift;
+    uint8_t hasAlpha;
+    uint8_t padding[2];
+};
+
+#define REGISTER_YCOCG(token, suffix, quality_, ratio_)                       \
+    static void _getInfo##suffix##token(EqCompressorInfo* const info)         \
+    {                                                                         \
+        info->version = EQ_COMPRESSOR_VERSION;                                \
+        info->name = EQ_COMPRESSOR_YCOCG_420##suffix##_##token;               \
+        info->capabilities =                                                  \
+            EQ_COMPRESSOR_DATA_2D | EQ_COMPRESSOR_IGNORE_ALPHA;               \
+        info->tokenType = EQ_COMPRESSOR_DATATYPE_##token;                     \
+        info->quality = quality_##f;                                          \
+        info->ratio = ratio_##f;                                              \
+        info->speed = 1.f;                                                    \
+    }                                                                         \
+                                                                              \
+    static bool _register##suffix##token()                                    \
+    {                                                                         \
+        Compressor::registerEngine(Compressor::Functions(                     \
+            EQ_COMPRESSOR_YCOCG_420##suffix##_##token,                        \
+            _getInfo##suffix##token, CompressorYCoCg::getNewCompressor,       \
+            CompressorYCoCg::getNewDecompressor,                              \
+            CompressorYCoCg::decompress, CompressorYCoCg::isCompatible));     \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    static bool _initialized##suffix##token LB_UNUSED =                       \
+        _register##suffix##token();
+
+// ratios without alpha, alpha adds .25
+REGISTER_YCOCG(RGBA, , .8, .375)
+REGISTER_YCOCG(BGRA, , .8, .375)
+REGISTER_YCOCG(RGBA, _Q1, .6, .33)
+REGISTER_YCOCG(BGRA, _Q1, .6, .33)
+REGISTER_YCOCG(RGBA, _Q2, .4, .28)
+REGISTER_YCOCG(BGRA, _Q2, .4, .28)
+
+uint8_t _getShift(const unsigned name)
+{
+    switch (name)
+    {
+    case EQ_COMPRESSOR_YCOCG_420_Q1_RGBA:
+    case EQ_COMPRESSOR_YCOCG_420_Q1_BGRA:
+        return 1;
+    case EQ_COMPRESSOR_YCOCG_420_Q2_RGBA:
+    case EQ_COMPRESSOR_YCOCG_420_Q2_BGRA:
+        return 2;
+    default:
+        return 0;
+    }
+}
+
+inline uint8_t _clamp(const int value)
+{
+    return uint8_t(std::min(std::max(value, 0), 255));
+}
+
+/** Pack n bytes using their lower nBits bits. */
+uint8_t* _pack(const uint8_t* in, const size_t n, const unsigned nBits,
+               uint8_t* out)
+{
+    if (nBits == 8)
+    {
+        ::memcpy(out, in, n);
+        return out + n;
+    }
+
+    uint64_t bits = 0;
+    unsigned nFilled = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        bits |= uint64_t(in[i]) << nFilled;
+        nFilled += nBits;
+        for (; nFilled >= 8; nFilled -= 8, bits >>= 8)
+            *out++ = uint8_t(bits);
+    }
+    if (nFilled > 0)
+        *out++ = uint8_t(bits);
+    return out;
+}
+
+const uint8_t* _unpack(const uint8_t* in, const size_t n, const unsigned nBits,
+                       uint8_t* out)
+{
+    if (nBits == 8)
+    {
+        ::memcpy(out, in, n);
+        return in + n;
+    }
+
+    const uint64_t mask = (1u << nBits) - 1;
+    uint64_t bits = 0;
+    unsigned nFilled = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (; nFilled < nBits; nFilled += 8)
+            bits |= uint64_t(*in++) << nFilled;
+        out[i] = uint8_t(bits & mask);
+        bits >>= nBits;
+        nFilled -= nBits;
+    }
+    return in;
+}
+
+size_t _getPackedSize(const size_t n, const unsigned nBits)
+{
+    return (n * nBits + 7) / 8;
+}
+
+/** @return the size of a compressed band. */
+size_t _getSize(const size_t width, const size_t height, const uint8_t shift,
+                const bool hasAlpha)
+{
+    const size_t nPixels = width * height;
+    const size_t nChroma = ((width + 1) / 2) * ((height + 1) / 2);
+    const unsigned nBits = 8 - shift;
+    return sizeof(Header) + _getPackedSize(nPixels, nBits) +
+           2 * _getPackedSize(nChroma, nBits) + (hasAlpha ? nPixels : 0);
+}
+
+size_t _compressBand(const uint8_t* const in, const size_t width,
+                     const size_t height, const uint8_t shift,
+                     const bool hasAlpha, uint8_t* out)
+{
+    uint8_t* const start = out;
+    const Header header = {uint32_t(width), uint32_t(height), shift,
+                           uint8_t(hasAlpha), {0, 0}};
+    ::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+
+    const size_t chromaWidth = (width + 1) / 2;
+    const size_t chromaHeight = (height + 1) / 2;
+    std::vector<uint8_t> luma(width * height);
+    std::vector<uint8_t> co(chromaWidth * chromaHeight);
+    std::vector<uint8_t> cg(co.size());
+    std::vector<int16_t> coRow(width * 2);
+    std::vector<int16_t> cgRow(width * 2);
+    const uint8_t bias = (1u << shift) >> 1;
+
+    for (size_t y = 0; y < height; y += 2)
+    {
+        // forward YCoCg-R for up to two rows
+        const size_t nRows = std::min(size_t(2), height - y);
+        for (size_t row = 0; row < nRows; ++row)
+        {
+            const uint8_t* pixel = in + (y + row) * width * 4;
+            uint8_t* lumaRow = luma.data() + (y + row) * width;
+            int16_t* coIt = coRow.data() + row * width;
+            int16_t* cgIt = cgRow.data() + row * width;
+            for (size_t x = 0; x < width; ++x, pixel += 4)
+            {
+                const int r = pixel[0];
+                const int g = pixel[1];
+                const int b = pixel[2];
+                const int coValue = r - b;
+                const int t = b + (coValue >> 1);
+                const int cgValue = g - t;
+                const int yValue = t + (cgValue >> 1);
+
+                lumaRow[x] = uint8_t(std::min(yValue + bias, 255) >> shift);
+                coIt[x] = int16_t(coValue);
+                cgIt[x] = int16_t(cgValue);
+            }
+        }
+
+        // 4:2:0 subsampling, mapped from [-255, 255] to [0, 255]
+        uint8_t* coOut = co.data() + y / 2 * chromaWidth;
+        uint8_t* cgOut = cg.data() + y / 2 * chromaWidth;
+        for (size_t x = 0; x < chromaWidth; ++x)
+        {
+            const size_t nColumns = std::min(size_t(2), width - x * 2);
+            int coSum = 0;
+            int cgSum = 0;
+            for (size_t row = 0; row < nRows; ++row)
+                for (size_t column = 0; column < nColumns; ++column)
+                {
+                    coSum += coRow[row * width + x * 2 + column];
+                    cgSum += cgRow[row * width + x * 2 + column];
+                }
+            const int n = int(nRows * nColumns);
+            const int coValue = (coSum + 255 * n + n) / (2 * n);
+            const int cgValue = (cgSum + 255 * n + n) / (2 * n);
+            coOut[x] = uint8_t(std::min(coValue + bias, 255) >> shift);
+            cgOut[x] = uint8_t(std::min(cgValue + bias, 255) >> shift);
+        }
+    }
+
+    const unsigned nBits = 8 - shift;
+    out = _pack(luma.data(), luma.size(), nBits, out);
+    out = _pack(co.data(), co.size(), nBits, out);
+    out = _pack(cg.data(), cg.size(), nBits, out);
+    if (hasAlpha)
+    {
+        const uint8_t* alpha = in + 3;
+        for (size_t i = 0; i < width * height; ++i, alpha += 4)
+            *out++ = *alpha;
+    }
+    return out - start;
+}
+
+void _decompressBand(const uint8_t* in, uint8_t* out)
+{
+    Header header;
+    ::memcpy(&header, in, sizeof(header));
+    in += sizeof(header);
+
+    const size_t width = header.width;
+    const size_t height = header.height;
+    const size_t chromaWidth = (width + 1) / 2;
+    const size_t chromaHeight = (height + 1) / 2;
+    const uint8_t shift = header.shift;
+    const unsigned nBits = 8 - shift;
+    const int bias = (1 << shift) >> 1;
+
+    std::vector<uint8_t> luma(width * height);
+    std::vector<uint8_t> co(chromaWidth * chromaHeight);
+    std::vector<uint8_t> cg(co.size());
+    in = _unpack(in, luma.size(), nBits, luma.data());
+    in = _unpack(in, co.size(), nBits, co.data());
+    in = _unpack(in, cg.size(), nBits, cg.data());
+    const uint8_t* alpha = header.hasAlpha ? in : nullptr;
+
+    for (size_t y = 0; y < height; ++y)
+    {
+        const uint8_t* lumaRow = luma.data() + y * width;
+        const uint8_t* coRow = co.data() + y / 2 * chromaWidth;
+        const uint8_t* cgRow = cg.data() + y / 2 * chromaWidth;
+        uint8_t* pixel = out + y * width * 4;
+        for (size_t x = 0; x < width; ++x, pixel += 4)
+        {
+            const int yValue = (lumaRow[x] << shift) + bias;
+            const int coValue = (((coRow[x / 2] << shift) + bias) << 1) - 255;
+            const int cgValue = (((cgRow[x / 2] << shift) + bias) << 1) - 255;
+
+            const int t = yValue - (cgValue >> 1);
+            const int g = cgValue + t;
+            const int b = t - (coValue >> 1);
+            const int r = b + coValue;
+
+            pixel[0] = _clamp(r);
+            pixel[1] = _clamp(g);
+            pixel[2] = _clamp(b);
+            pixel[3] = alpha ? alpha[y * width + x] : 255;
+        }
+    }
+}
+}
+
+CompressorYCoCg::CompressorYCoCg(const unsigned name)
+    : _shift(_getShift(name))
+{
+}
+
+void CompressorYCoCg::compress2D(const void* const inData,
+                                 const eq_uint64_t* const inDims,
+                                 const eq_uint64_t flags)
+{
+    const bool hasAlpha = !(flags & EQ_COMPRESSOR_IGNORE_ALPHA);
+    const size_t width = size_t(inDims[1]);
+    const size_t height = size_t(inDims[3]);
+    const size_t nBands =
+        std::max(size_t(1), std::min(height / BAND_ROWS, MAX_BANDS));
+    const size_t bandRows = ((height + nBands - 1) / nBands + 1) & ~size_t(1);
+
+    _nResults = unsigned((height + bandRows - 1) / bandRows);
+    while (_results.size() < _nResults)
+        _results.push_back(new Result);
+
+    const uint8_t* const in = reinterpret_cast<const uint8_t*>(inData);
+
+#pragma omp parallel for
+    for (int64_t i = 0; i < int64_t(_nResults); ++i)
+    {
+        const size_t startRow = size_t(i) * bandRows;
+        const size_t nRows = std::min(bandRows, height - startRow);
+
+        Result* result = _results[i];
+        result->reserve(_getSize(width, nRows, _shift, hasAlpha));
+        result->setSize(_compressBand(in + startRow * width * 4, width, nRows,
+                                      _shift, hasAlpha, result->getData()));
+    }
+}
+
+void CompressorYCoCg::decompress(const void* const* inData,
+                                 const eq_uint64_t* const inSizes LB_UNUSED,
+                                 const unsigned nInputs, void* const outData,
+                                 const eq_uint64_t nPixels LB_UNUSED,
+                                 const bool /*useAlpha*/)
+{
+    // bands are independent, find the output position of each
+    std::vector<size_t> offsets(nInputs, 0);
+    for (unsigned i = 1; i < nInputs; ++i)
+    {
+        Header header;
+        ::memcpy(&header, inData[i - 1], sizeof(header));
+        offsets[i] = offsets[i - 1] + size_t(header.width) * header.height * 4;
+    }
+
+    uint8_t* const out = reinterpret_cast<uint8_t*>(outData);
+
+#pragma omp parallel for
+    for (int64_t i = 0; i < int64_t(nInputs); ++i)
+        _decompressBand(reinterpret_cast<const uint8_t*>(inData[i]),
+                        out + offsets[i]);
+}
+}
+}
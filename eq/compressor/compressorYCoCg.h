@@ -0,0 +1,65 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_PLUGIN_COMPRESSORYCOCG
+#define EQ_PLUGIN_COMPRESSORYCOCG
+
+#include "compressor.h"
+#include "compressorTypes.h"
+
+namespace eq
+{
+namespace plugin
+{
+/**
+ * Lossy compressor for 8 bit RGBA and BGRA images.
+ *
+ * The color is transformed to YCoCg-R, the chroma is subsampled 4:2:0 and
+ * the lower quality variants drop the least significant bits of luma and
+ * chroma before bit-packing the planes. Alpha is kept at full resolution and
+ * precision if used. The variants are registered with decreasing quality, so
+ * that Image::setQuality() selects the strongest compression still meeting
+ * the requested quality.
+ */
+class CompressorYCoCg : public Compressor
+{
+public:
+    explicit CompressorYCoCg(const unsigned name);
+    virtual ~CompressorYCoCg() {}
+
+    static void* getNewCompressor(const unsigned name)
+    {
+        return new CompressorYCoCg(name);
+    }
+    static void* getNewDecompressor(const unsigned) { return 0; }
+
+    void compress2D(const void* const inData, const eq_uint64_t* const inDims,
+                    const eq_uint64_t flags) override;
+
+    static void decompress(const void* const* inData,
+                           const eq_uint64_t* const inSizes,
+                           const unsigned nInputs, void* const outData,
+                           const eq_uint64_t nPixels, const bool useAlpha);
+
+    static bool isCompatible(const GLEWContext*) { return true; }
+
+private:
+    const uint8_t _shift; // number of dropped bits
+};
+}
+}
+#endif // EQ_PLUGIN_COMPRESSORYCOCG
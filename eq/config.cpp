@@ -44,12 +44,15 @@
 #include <eq/fabric/sizeEvent.h>
 #include <eq/fabric/task.h>
 
+#include <co/buffer.h>
+#include <co/bufferConnection.h>
 #include <co/connectionDescription.h>
 #include <co/global.h>
 #include <co/object.h>
 
 #include <lunchbox/clock.h>
 #include <lunchbox/monitor.h>
+#include <lunchbox/perThread.h>
 #include <lunchbox/scopedMutex.h>
 #include <lunchbox/spinLock.h>
 #include <pression/data/CompressorInfo.h>
@@ -101,6 +104,57 @@ private:
     const ChangeType _changeType;
     const co::CompressorInfo _compressor;
 };
+
+/** The events of one config buffered during an event batch. */
+struct EventBuffer
+{
+    Config* config;
+    co::BufferConnectionPtr connection;
+    std::vector<uint64_t> offsets; //!< The start of each event command
+};
+
+/** The per-thread state of Config::startEventBatch(). */
+struct EventBatch
+{
+    EventBatch()
+        : depth(0)
+    {
+    }
+
+    size_t depth;
+    std::vector<EventBuffer> buffers;
+};
+
+static lunchbox::PerThread<EventBatch> _eventBatch;
+
+void _sendEvents(EventBuffer& events)
+{
+    co::NodePtr appNode = events.config->getApplicationNode();
+    co::ConnectionPtr connection = appNode->getConnection();
+    lunchbox::Bufferb& buffer = events.connection->getBuffer();
+    if (events.offsets.size() < 2)
+    {
+        events.connection->sendBuffer(connection);
+        events.offsets.clear();
+        return;
+    }
+
+    // Send all events as one command, which the application node splits into
+    // the individual event commands. This saves the per-command overhead.
+    events.offsets.push_back(buffer.getSize());
+    std::vector<uint64_t> sizes(events.offsets.size() - 1);
+    for (size_t i = 0; i < sizes.size(); ++i)
+        sizes[i] = events.offsets[i + 1] - events.offsets[i];
+
+    co::ObjectOCommand(co::Connections(1, connection),
+                       fabric::CMD_CONFIG_EVENTS, co::COMMANDTYPE_OBJECT,
+                       events.config->getID(), CO_INSTANCE_ALL)
+        << sizes << co::Array<const uint8_t>(buffer.getData(), buffer.getSize());
+
+    buffer.setSize(0);
+    events.offsets.clear();
+}
+
 #ifdef EQUALIZER_USE_GLSTATS
 namespace
 {
@@ -124,6 +178,7 @@ public:
         , currentFrame(0)
         , unlockedFrame(0)
         , finishedFrame(0)
+        , waitTime(0)
         , running(false)
     {
         lunchbox::Log::setClock(&clock);
@@ -158,6 +213,8 @@ public:
     uint32_t unlockedFrame;
     /** The last completed frame. */
     lunchbox::Monitor<uint32_t> finishedFrame;
+    /** The time the last finishFrame() waited for the rendering. */
+    int64_t waitTime;
 
     /** The global clock. */
     lunchbox::Clock clock;
@@ -223,7 +280,9 @@ void Config::attach(const uint128_t& id, const uint32_t instanceID)
     registerCommand(fabric::CMD_CONFIG_FRAME_FINISH,
                     ConfigFunc(this, &Config::_cmdFrameFinish), 0);
     registerCommand(fabric::CMD_CONFIG_EVENT, ConfigFunc(0, 0),
-                    &_impl->eventQueue);
+                    _impl->eventQueue.getDispatchQueue());
+    registerCommand(fabric::CMD_CONFIG_EVENTS,
+                    ConfigFunc(this, &Config::_cmdEvents), 0);
     registerCommand(fabric::CMD_CONFIG_SYNC_CLOCK,
                     ConfigFunc(this, &Config::_cmdSyncClock), 0);
     registerCommand(fabric::CMD_CONFIG_SWAP_OBJECT,
@@ -418,7 +477,8 @@ uint32_t Config::startFrame(const uint128_t& frameID)
 
     // New frame
     ++_impl->currentFrame;
-    send(getServer(), fabric::CMD_CONFIG_START_FRAME) << frameID;
+    send(getServer(), fabric::CMD_CONFIG_START_FRAME) << frameID
+                                                      << _impl->waitTime;
 
     LBLOG(LOG_TASKS) << "---- Started Frame ---- " << _impl->currentFrame
                      << std::endl;
@@ -429,7 +489,7 @@ uint32_t Config::startFrame(const uint128_t& frameID)
 void Config::_frameStart()
 {
     _impl->frameTimes.push_back(_impl->clock.getTime64());
-    while (_impl->frameTimes.size() > getLatency())
+    while (_impl->frameTimes.size() > getMaxLatency())
     {
         const int64_t age =
             _impl->frameTimes.back() - _impl->frameTimes.front();
@@ -487,6 +547,7 @@ uint32_t Config::finishFrame()
         }
         LBLOG(LOG_TASKS) << "Global sync " << frameToFinish << " @ "
                          << _impl->currentFrame << std::endl;
+        _impl->waitTime = getTime() - waitStat.statistic.startTime;
     }
 
     handleEvents();
@@ -563,16 +624,18 @@ void Config::setLatency(const uint32_t latency)
         return;
 
     Super::setLatency(latency);
+    finishAllFrames();
+    commit(CO_COMMIT_NEXT);
     changeLatency(latency);
 }
 
 void Config::changeLatency(const uint32_t latency)
 {
-    finishAllFrames();
-    commit(CO_COMMIT_NEXT);
-
-    // update views
-    ChangeLatencyVisitor changeLatencyVisitor(latency);
+    // Buffers are sized for the max latency, which makes adaptive changes
+    // from the server safe without finishing the pending frames.
+    const int32_t maxLatency = getIAttribute(IATTR_MAX_LATENCY);
+    ChangeLatencyVisitor changeLatencyVisitor(
+        maxLatency > int32_t(latency) ? uint32_t(maxLatency) : latency);
     accept(changeLatencyVisitor);
 }
 
@@ -582,11 +645,53 @@ EventOCommand Config::sendEvent(const uint32_t type)
     LBASSERT(_impl->appNode);
     LBASSERT(type != EVENT_UNKNOWN);
 
+    if (_eventBatch && _eventBatch->depth > 0)
+    {
+        std::vector<EventBuffer>& buffers = _eventBatch->buffers;
+        std::vector<EventBuffer>::iterator i = buffers.begin();
+        while (i != buffers.end() && i->config != this)
+            ++i;
+        if (i == buffers.end())
+        {
+            EventBuffer events;
+            events.config = this;
+            events.connection = new co::BufferConnection;
+            i = buffers.insert(buffers.end(), events);
+        }
+
+        // the previous event has been written, since commands are temporaries
+        i->offsets.push_back(i->connection->getBuffer().getSize());
+        EventOCommand cmd(co::Connections(1, i->connection),
+                          fabric::CMD_CONFIG_EVENT, co::COMMANDTYPE_OBJECT,
+                          getID(), CO_INSTANCE_ALL);
+        cmd << type;
+        return cmd;
+    }
+
     EventOCommand cmd(send(_impl->appNode, fabric::CMD_CONFIG_EVENT));
     cmd << type;
     return cmd;
 }
 
+void Config::startEventBatch()
+{
+    if (!_eventBatch)
+        _eventBatch = new EventBatch;
+    ++_eventBatch->depth;
+}
+
+void Config::finishEventBatch()
+{
+    LBASSERT(_eventBatch && _eventBatch->depth > 0);
+    if (!_eventBatch || --_eventBatch->depth > 0)
+        return;
+
+    for (EventBuffer& events : _eventBatch->buffers)
+        if (!events.offsets.empty())
+            _sendEvents(events);
+    _eventBatch->buffers.clear(); // don't keep configs beyond the batch
+}
+
 EventOCommand Config::sendError(const uint32_t type, const Error& error)
 {
     return Super::sendError(getApplicationNode(), type, error);
@@ -902,6 +1007,8 @@ void Config::addStatistic(const Statistic& stat LB_UNUSED)
     }
     // no break;
 
+    case Statistic::PIPE_QUEUE:
+    case Statistic::CONFIG_LATENCY:
     case Statistic::WINDOW_FPS:
     case Statistic::NONE:
     case Statistic::ALL:
@@ -1035,8 +1142,7 @@ void Config::setupMessagePump(Pipe* pipe)
     _impl->eventQueue.setMessagePump(pump);
 
     ClientPtr client = getClient();
-    CommandQueue* queue =
-        LBSAFECAST(CommandQueue*, client->getMainThreadQueue());
+    CommandQueue* queue = CommandQueue::get(client->getMainThreadQueue());
     LBASSERT(queue);
     LBASSERT(!queue->getMessagePump());
 
@@ -1049,8 +1155,7 @@ void Config::_exitMessagePump()
     _impl->eventQueue.setMessagePump(0);
 
     ClientPtr client = getClient();
-    CommandQueue* queue =
-        LBSAFECAST(CommandQueue*, client->getMainThreadQueue());
+    CommandQueue* queue = CommandQueue::get(client->getMainThreadQueue());
     LBASSERT(queue);
     LBASSERT(queue->getMessagePump() == pump);
 
@@ -1061,8 +1166,7 @@ void Config::_exitMessagePump()
 MessagePump* Config::getMessagePump()
 {
     ClientPtr client = getClient();
-    CommandQueue* queue =
-        LBSAFECAST(CommandQueue*, client->getMainThreadQueue());
+    CommandQueue* queue = CommandQueue::get(client->getMainThreadQueue());
     if (queue)
         return queue->getMessagePump();
     return 0;
@@ -1088,7 +1192,7 @@ bool Config::registerObject(co::Object* object)
 {
     if (!getClient()->registerObject(object))
         return false;
-    object->setAutoObsolete(getLatency() + 1);
+    object->setAutoObsolete(getMaxLatency() + 1);
     return true;
 }
 
@@ -1100,7 +1204,7 @@ void Config::deregisterObject(co::Object* object)
     if (!object->isAttached()) // not registered
         return;
 
-    const uint32_t latency = getLatency();
+    const uint32_t latency = getMaxLatency();
     ClientPtr client = getClient();
     if (latency == 0 || !_impl->running || !object->isBuffered()) // OPT
     {
@@ -1309,7 +1413,7 @@ bool Config::_cmdSwapObject(co::ICommand& cmd)
 
     LatencyObject* latencyObject =
         new LatencyObject(object->getChangeType(), object->chooseCompressor(),
-                          _impl->currentFrame + getLatency() + 1);
+                          _impl->currentFrame + getMaxLatency() + 1);
     getLocalNode()->swapObject(object, latencyObject);
     {
         lunchbox::ScopedFastWrite mutex(_impl->latencyObjects);
@@ -1319,6 +1423,28 @@ bool Config::_cmdSwapObject(co::ICommand& cmd)
     getLocalNode()->serveRequest(requestID);
     return true;
 }
+
+bool Config::_cmdEvents(co::ICommand& cmd)
+{
+    co::ObjectICommand command(cmd);
+    const std::vector<uint64_t>& sizes = command.read<std::vector<uint64_t>>();
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(
+        command.getRemainingBuffer(command.getRemainingBufferSize()));
+
+    co::LocalNodePtr localNode = command.getLocalNode();
+    co::NodePtr remoteNode = command.getRemoteNode();
+    for (const uint64_t size : sizes)
+    {
+        co::BufferPtr buffer = new co::Buffer;
+        buffer->replace(data, size);
+        data += size;
+
+        co::ICommand event(localNode, remoteNode, buffer);
+        if (!localNode->dispatchCommand(event))
+            LBWARN << "Could not dispatch batched event " << event << std::endl;
+    }
+    return true;
+}
 }
 
 #include <eq/fabric/config.ipp>
@@ -351,6 +351,21 @@ public:
      */
     EQ_API EventOCommand sendEvent(const uint32_t type);
 
+    /**
+     * Start batching the events sent by the calling thread.
+     *
+     * Until the matching finishEventBatch(), sendEvent() buffers the events of
+     * the calling thread, which are then sent in one command per config to the
+     * application node. Batches may be nested. Used by the event handlers to
+     * deliver all events of one dispatch as one command.
+     *
+     * @version 2.1
+     */
+    EQ_API static void startEventBatch();
+
+    /** Send the events batched since startEventBatch(). @version 2.1 */
+    EQ_API static void finishEventBatch();
+
     /**
      * Send an error event to the application node.
      *
@@ -468,6 +483,7 @@ private:
     bool _cmdReleaseFrameLocal(co::ICommand& command);
     bool _cmdFrameFinish(co::ICommand& command);
     bool _cmdSwapObject(co::ICommand& command);
+    bool _cmdEvents(co::ICommand& command);
 };
 }
 
@@ -0,0 +1,52 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "messagePump.h"
+
+namespace eq
+{
+namespace cpu
+{
+MessagePump::MessagePump()
+    : _wakeup(false)
+{
+}
+
+MessagePump::~MessagePump()
+{
+}
+
+void MessagePump::postWakeup()
+{
+    _wakeup = true;
+}
+
+void MessagePump::dispatchAll()
+{
+    _wakeup = false;
+}
+
+void MessagePump::dispatchOne(const uint32_t timeout)
+{
+    if (timeout == LB_TIMEOUT_INDEFINITE)
+        _wakeup.waitEQ(true);
+    else
+        _wakeup.timedWaitEQ(true, timeout);
+    _wakeup = false;
+}
+}
+}
@@ -0,0 +1,55 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_CPU_MESSAGEPUMP_H
+#define EQ_CPU_MESSAGEPUMP_H
+
+#include <eq/messagePump.h> // base class
+#include <eq/types.h>
+
+#include <lunchbox/monitor.h> // member
+
+namespace eq
+{
+namespace cpu
+{
+/**
+ * A message pump for headless windows.
+ *
+ * Headless windows do not receive system events, this message pump only
+ * implements the wakeup mechanism used by the command queues.
+ * @version 2.1
+ */
+class MessagePump : public eq::MessagePump
+{
+public:
+    /** Construct a new CPU message pump. @version 2.1 */
+    MessagePump();
+
+    /** Destruct this message pump. @version 2.1 */
+    virtual ~MessagePump();
+
+    void postWakeup() final;
+    void dispatchAll() final;
+    void dispatchOne(const uint32_t timeout = LB_TIMEOUT_INDEFINITE) final;
+
+private:
+    lunchbox::Monitor<bool> _wakeup;
+};
+}
+}
+#endif // EQ_CPU_MESSAGEPUMP_H
@@ -0,0 +1,55 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "pipe.h"
+
+#include "../pipe.h"
+
+namespace eq
+{
+namespace cpu
+{
+namespace
+{
+// size of the virtual device, large enough for common tile and window sizes
+static const int32_t DEVICE_SIZE = 4096;
+}
+
+Pipe::Pipe(eq::Pipe* parent)
+    : SystemPipe(parent)
+{
+}
+
+Pipe::~Pipe()
+{
+}
+
+bool Pipe::configInit()
+{
+    eq::Pipe* pipe = getPipe();
+    if (!pipe->getPixelViewport().isValid())
+        pipe->setPixelViewport(PixelViewport(0, 0, DEVICE_SIZE, DEVICE_SIZE));
+
+    _maxOpenGLVersion = 0.f;
+    return true;
+}
+
+void Pipe::configExit()
+{
+}
+}
+}
@@ -0,0 +1,58 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_CPU_PIPE_H
+#define EQ_CPU_PIPE_H
+
+#include <eq/systemPipe.h> // base class
+
+namespace eq
+{
+namespace cpu
+{
+/**
+ * A system pipe without a GPU.
+ *
+ * The pipe represents a virtual device of the size given by its pixel
+ * viewport. It does not open any display connection and can therefore be used
+ * on nodes without a graphics driver.
+ * @version 2.1
+ */
+class Pipe : public SystemPipe
+{
+public:
+    /** Construct a new CPU system pipe. @version 2.1 */
+    EQ_API explicit Pipe(eq::Pipe* parent);
+
+    /** Destruct this CPU pipe. @version 2.1 */
+    EQ_API virtual ~Pipe();
+
+    /**
+     * Initialize this pipe.
+     *
+     * Sets the pixel viewport of the pipe to a default virtual device size if
+     * it is not valid.
+     * @version 2.1
+     */
+    EQ_API bool configInit() override;
+
+    /** Deinitialize this pipe. @version 2.1 */
+    EQ_API void configExit() override;
+};
+}
+}
+#endif // EQ_CPU_PIPE_H
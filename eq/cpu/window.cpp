@@ -0,0 +1,272 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "window.h"
+
+#include "../compositor.h"
+#include "../frameData.h"
+#include "../image.h"
+#include "../log.h"
+#include "../pixelData.h"
+
+#include <eq/fabric/drawableConfig.h>
+#include <eq/fabric/renderContext.h>
+#include <pression/plugins/compressor.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace eq
+{
+namespace cpu
+{
+namespace
+{
+static const uint32_t FAR_DEPTH = 0xffffffffu;
+
+/** @return the pixel viewport clipped to a width x height frame buffer. */
+PixelViewport _clip(PixelViewport pvp, const int32_t width,
+                    const int32_t height)
+{
+    pvp.intersect(PixelViewport(0, 0, width, height));
+    return pvp;
+}
+
+inline uint32_t _swizzle(const uint32_t bgra)
+{
+    // swap the first and third byte, i.e., B and R in memory order
+    return (bgra & 0xff00ff00u) | ((bgra & 0x00ff0000u) >> 16) |
+           ((bgra & 0x000000ffu) << 16);
+}
+}
+
+Window::Window(NotifierInterface& parent, const WindowSettings& settings)
+    : SystemWindow(parent, settings)
+    , _width(0)
+    , _height(0)
+{
+}
+
+Window::~Window()
+{
+}
+
+bool Window::configInit()
+{
+    const PixelViewport& pvp = getPixelViewport();
+    if (!pvp.hasArea())
+    {
+        sendError(ERROR_WINDOW_PVP_INVALID);
+        return false;
+    }
+
+    resize(pvp);
+    return true;
+}
+
+void Window::configExit()
+{
+    _width = 0;
+    _height = 0;
+    std::vector<uint32_t>().swap(_color);
+    std::vector<uint32_t>().swap(_depth);
+}
+
+void Window::queryDrawableConfig(DrawableConfig& drawableConfig)
+{
+    drawableConfig.stencilBits = 0;
+    drawableConfig.colorBits = 8;
+    drawableConfig.alphaBits = 8;
+    drawableConfig.accumBits = 0;
+    drawableConfig.glVersion = 0.f;
+    drawableConfig.stereo = false;
+    drawableConfig.doublebuffered = false;
+}
+
+void Window::resize(const PixelViewport& pvp)
+{
+    if (pvp.w == _width && pvp.h == _height)
+        return;
+
+    _width = std::max(pvp.w, 0);
+    _height = std::max(pvp.h, 0);
+    const size_t size = size_t(_width) * size_t(_height);
+    _color.assign(size, 0);
+    _depth.assign(size, FAR_DEPTH);
+}
+
+void Window::clear(const PixelViewport& area, const uint32_t color)
+{
+    const PixelViewport pvp = _clip(area, _width, _height);
+    if (!pvp.hasArea())
+        return;
+
+    for (int32_t y = pvp.y; y < pvp.getYEnd(); ++y)
+    {
+        const size_t start = size_t(y) * _width + pvp.x;
+        std::fill_n(_color.begin() + start, pvp.w, color);
+        std::fill_n(_depth.begin() + start, pvp.w, FAR_DEPTH);
+    }
+}
+
+void Window::readback(const Frames& frames, const PixelViewports& regions,
+                      const RenderContext& context)
+{
+    DrawableConfig config;
+    queryDrawableConfig(config);
+
+    for (Frame* frame : frames)
+        for (const PixelViewport& region : regions)
+            _readback(*frame, region, context, config);
+}
+
+void Window::_readback(Frame& frame, const PixelViewport& region,
+                       const RenderContext& context,
+                       const DrawableConfig& config)
+{
+    FrameDataPtr frameData = frame.getFrameData();
+    const Frame::Buffer buffers = frameData->getBuffers();
+    if (buffers == Frame::Buffer::none)
+        return;
+
+    if (frame.getZoom() != Zoom::NONE ||
+        frameData->getType() != Frame::TYPE_MEMORY)
+    {
+        LBWARN << "CPU readback supports only unzoomed memory frames"
+               << std::endl;
+        return;
+    }
+
+    // same coordinate handling as FrameData::startReadback
+    const PixelViewport& framePVP = frameData->getPixelViewport();
+    const PixelViewport absPVP = framePVP + frame.getOffset();
+    PixelViewport pvp = region + frame.getOffset();
+    pvp.intersect(absPVP);
+    pvp = _clip(pvp, _width, _height);
+    if (!pvp.hasArea())
+        return;
+
+    Image* image = frameData->newImage(Frame::TYPE_MEMORY, config);
+    image->setPixelViewport(PixelViewport(0, 0, pvp.w, pvp.h));
+    image->setContext(context);
+
+    if (buffers & Frame::Buffer::color)
+        _readback(*image, Frame::Buffer::color, pvp, _color);
+    if (buffers & Frame::Buffer::depth)
+        _readback(*image, Frame::Buffer::depth, pvp, _depth);
+
+    pvp -= frame.getOffset();
+    image->setOffset((pvp.x - framePVP.x) * context.pixel.w,
+                     (pvp.y - framePVP.y) * context.pixel.h);
+}
+
+void Window::_readback(Image& image, const Frame::Buffer buffer,
+                       const PixelViewport& pvp,
+                       const std::vector<uint32_t>& src)
+{
+    PixelData data;
+    data.internalFormat = image.getInternalFormat(buffer);
+    data.externalFormat = buffer == Frame::Buffer::color
+                              ? EQ_COMPRESSOR_DATATYPE_RGBA
+                              : EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
+    data.pixelSize = sizeof(uint32_t);
+    data.pvp = PixelViewport(0, 0, pvp.w, pvp.h);
+
+    const uint32_t* rows = src.data() + size_t(pvp.y) * _width + pvp.x;
+    if (pvp.w == _width) // contiguous rows, copy in one go
+    {
+        data.pixels = const_cast<uint32_t*>(rows);
+        image.setPixelData(buffer, data);
+        return;
+    }
+
+    image.setPixelData(buffer, data); // allocate
+    uint8_t* dst = image.getPixelPointer(buffer);
+    const size_t rowSize = pvp.w * sizeof(uint32_t);
+    for (int32_t y = 0; y < pvp.h; ++y)
+        ::memcpy(dst + y * rowSize, rows + size_t(y) * _width, rowSize);
+}
+
+bool Window::assemble(const Frames& frames, const PixelViewport& pvp,
+                      const bool blend, const uint32_t timeout)
+{
+    if (frames.empty())
+        return false;
+
+    const Image* image = Compositor::mergeFramesCPU(frames, blend, timeout);
+    if (!image)
+        return false;
+
+    const uint32_t format = image->getExternalFormat(Frame::Buffer::color);
+    if (format != EQ_COMPRESSOR_DATATYPE_RGBA &&
+        format != EQ_COMPRESSOR_DATATYPE_BGRA)
+    {
+        LBWARN << "Unsupported color format 0x" << std::hex << format
+               << std::dec << " for CPU assembly" << std::endl;
+        return false;
+    }
+
+    // image pvp is relative to the destination channel
+    const PixelViewport& imagePVP = image->getPixelViewport();
+    const PixelViewport destPVP =
+        _clip(imagePVP + Vector2i(pvp.x, pvp.y), _width, _height);
+    if (!destPVP.hasArea())
+        return false;
+
+    const bool swizzle = format == EQ_COMPRESSOR_DATATYPE_BGRA;
+    const bool depthTest = image->hasPixelData(Frame::Buffer::depth);
+    const uint32_t* color = reinterpret_cast<const uint32_t*>(
+        image->getPixelPointer(Frame::Buffer::color));
+    const uint32_t* depth =
+        depthTest ? reinterpret_cast<const uint32_t*>(
+                        image->getPixelPointer(Frame::Buffer::depth))
+                  : 0;
+
+    const int32_t srcX = destPVP.x - pvp.x - imagePVP.x;
+    const int32_t srcY = destPVP.y - pvp.y - imagePVP.y;
+
+    for (int32_t y = 0; y < destPVP.h; ++y)
+    {
+        const size_t src = size_t(srcY + y) * imagePVP.w + srcX;
+        const size_t dst = size_t(destPVP.y + y) * _width + destPVP.x;
+        const uint32_t* colorIt = color + src;
+        uint32_t* destColor = _color.data() + dst;
+
+        if (!depthTest)
+        {
+            if (swizzle)
+                std::transform(colorIt, colorIt + destPVP.w, destColor,
+                               _swizzle);
+            else
+                std::copy(colorIt, colorIt + destPVP.w, destColor);
+            continue;
+        }
+
+        const uint32_t* depthIt = depth + src;
+        uint32_t* destDepth = _depth.data() + dst;
+        for (int32_t x = 0; x < destPVP.w; ++x)
+        {
+            if (depthIt[x] >= destDepth[x])
+                continue;
+            destDepth[x] = depthIt[x];
+            destColor[x] = swizzle ? _swizzle(colorIt[x]) : colorIt[x];
+        }
+    }
+    return true;
+}
+}
+}
@@ -0,0 +1,152 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_CPU_WINDOW_H
+#define EQ_CPU_WINDOW_H
+
+#include <eq/frame.h>        // Frame::Buffer enum
+#include <eq/systemWindow.h> // base class
+
+#include <vector> // member
+
+namespace eq
+{
+/**
+ * @namespace eq::cpu
+ * @brief A headless window system for software rendering without a GPU.
+ */
+namespace cpu
+{
+/**
+ * A system window rendering into main memory.
+ *
+ * The window holds an RGBA color and a 32 bit depth buffer of the size of its
+ * pixel viewport. Pixels are stored row by row, starting with the bottom row,
+ * like an OpenGL frame buffer. Depth values increase with the distance, the
+ * far plane is 0xffffffff.
+ *
+ * The window provides readback and assembly of frames using the CPU
+ * compositor, so that all compounds producing memory frames without zoom and
+ * pixel decomposition can be used without OpenGL.
+ *
+ * Example usage: @include examples/eqCPU/channel.cpp
+ * @version 2.1
+ */
+class Window : public SystemWindow
+{
+public:
+    /** Construct a new CPU window. @version 2.1 */
+    EQ_API Window(NotifierInterface& parent, const WindowSettings& settings);
+
+    /** Destruct this CPU window. @version 2.1 */
+    EQ_API virtual ~Window();
+
+    /** @name Methods forwarded from eq::Window */
+    //@{
+    EQ_API bool configInit() override;
+    EQ_API void configExit() override;
+    void makeCurrent(bool /*cache*/) const override {}
+    void doneCurrent() const override {}
+    void bindFrameBuffer() const override {}
+    void bindDrawFrameBuffer() const override {}
+    void updateFrameBuffer() const override {}
+    void swapBuffers() override {}
+    void flush() override {}
+    void finish() override {}
+    void joinNVSwapBarrier(const uint32_t, const uint32_t) override {}
+    EQ_API void queryDrawableConfig(DrawableConfig& drawableConfig) override;
+    EQ_API void resize(const PixelViewport& pvp) override;
+    //@}
+
+    /** @name Frame buffer access */
+    //@{
+    /** @return the width of the frame buffer. @version 2.1 */
+    int32_t getWidth() const { return _width; }
+    /** @return the height of the frame buffer. @version 2.1 */
+    int32_t getHeight() const { return _height; }
+    /** @return the RGBA color buffer. @version 2.1 */
+    uint32_t* getColorBuffer() { return _color.data(); }
+    /** @return the RGBA color buffer. @version 2.1 */
+    const uint32_t* getColorBuffer() const { return _color.data(); }
+    /** @return the depth buffer. @version 2.1 */
+    uint32_t* getDepthBuffer() { return _depth.data(); }
+    /** @return the depth buffer. @version 2.1 */
+    const uint32_t* getDepthBuffer() const { return _depth.data(); }
+    /**
+     * Clear a part of the frame buffer.
+     *
+     * @param pvp the area to clear, relative to the window.
+     * @param color the RGBA clear color.
+     * @version 2.1
+     */
+    EQ_API void clear(const PixelViewport& pvp, uint32_t color);
+    //@}
+
+    /** @name Compositing */
+    //@{
+    /**
+     * Read back the given regions of the frame buffer into frames.
+     *
+     * The CPU equivalent of Frame::startReadback(). The readback is
+     * synchronous, the images are transmitted by the channel afterwards.
+     * Only unzoomed memory frames are supported, all other frames are skipped
+     * with a warning and produce no images.
+     *
+     * @param frames the output frames.
+     * @param regions the regions to read, relative to the channel.
+     * @param context the render context of the readback.
+     * @version 2.1
+     */
+    EQ_API void readback(const Frames& frames, const PixelViewports& regions,
+                         const RenderContext& context);
+
+    /**
+     * Assemble frames into the frame buffer.
+     *
+     * The frames are merged using Compositor::mergeFramesCPU() and the result
+     * is written to the frame buffer. Images with depth are depth-tested
+     * against the frame buffer, color-only images replace its content.
+     *
+     * @param frames the input frames.
+     * @param pvp the pixel viewport of the destination channel.
+     * @param blend blend color-only images with an alpha channel.
+     * @param timeout the time to wait for the input frames.
+     * @return true if an image was assembled, false otherwise.
+     * @version 2.1
+     */
+    EQ_API bool assemble(const Frames& frames, const PixelViewport& pvp,
+                         bool blend, uint32_t timeout);
+    //@}
+
+private:
+    int32_t _width;
+    int32_t _height;
+    std::vector<uint32_t> _color;
+    std::vector<uint32_t> _depth;
+
+    Window(const Window&) = delete;
+    Window& operator=(const Window&) = delete;
+
+    void _readback(Frame& frame, const PixelViewport& region,
+                   const RenderContext& context, const DrawableConfig& config);
+    void _readback(Image& image, Frame::Buffer buffer,
+                   const PixelViewport& pvp, const std::vector<uint32_t>& src);
+};
+}
+}
+
+#endif // EQ_CPU_WINDOW_H
@@ -0,0 +1,51 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include "../windowSystem.h"
+
+#include "messagePump.h"
+#include "pipe.h"
+#include "window.h"
+
+namespace eq
+{
+namespace cpu
+{
+class WindowSystem : public WindowSystemIF
+{
+public:
+    WindowSystem() {}
+private:
+    std::string getName() const final { return "CPU"; }
+    eq::SystemWindow* createWindow(eq::Window* window,
+                                   const WindowSettings& settings) final
+    {
+        return new Window(*window, settings);
+    }
+
+    eq::SystemPipe* createPipe(eq::Pipe* pipe) final { return new Pipe(pipe); }
+    eq::MessagePump* createMessagePump() final { return new MessagePump; }
+    bool setupFont(util::ObjectManager&, const void*, const std::string&,
+                   const uint32_t) const final
+    {
+        return false;
+    }
+};
+}
+}
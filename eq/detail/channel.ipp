@@ -186,6 +186,11 @@ public:
     /** Image of the current framebuffer if result listeners are present */
     eq::Image framebufferImage;
 
+    /** Regions of the last transmitted output image, packed into tiles. */
+    eq::Image sparseImage;
+    co::ObjectVersion packedVersion;
+    uint64_t packedIndex = 0;
+
 #ifdef EQUALIZER_USE_DEFLECT
     deflect::Proxy* _deflectProxy;
 #endif
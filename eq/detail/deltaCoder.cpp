@@ -0,0 +1,256 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "deltaCoder.h"
+
+#include <eq/pixelData.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace eq
+{
+namespace detail
+{
+namespace
+{
+// force a keyframe after this many deltas to bound the cost of lost state
+const uint32_t KEYFRAME_INTERVAL = 100;
+
+/** Call func(index, x, y, width, height) for each tile of the viewport. */
+template <class F>
+void _forEachTile(const PixelViewport& pvp, const F& func)
+{
+    const int32_t size = DeltaCoder::TILE_SIZE;
+    size_t index = 0;
+    for (int32_t y = 0; y < pvp.h; y += size)
+        for (int32_t x = 0; x < pvp.w; x += size, ++index)
+            func(index, x, y, std::min(size, pvp.w - x),
+                 std::min(size, pvp.h - y));
+}
+
+inline bool _isSet(const uint8_t* mask, const size_t index)
+{
+    return mask[index >> 3] & (1u << (index & 7));
+}
+
+size_t _getNumTiles(const PixelViewport& pvp)
+{
+    const int32_t size = DeltaCoder::TILE_SIZE;
+    return size_t((pvp.w + size - 1) / size) *
+           size_t((pvp.h + size - 1) / size);
+}
+}
+
+DeltaCoder::DeltaCoder()
+    : _header()
+    , _internalFormat(0)
+    , _externalFormat(0)
+    , _pixelSize(0)
+    , _sequence(0)
+    , _nDeltas(0)
+    , _keyframe(true)
+{
+}
+
+DeltaCoder::~DeltaCoder()
+{
+    _tiles.flush();
+}
+
+bool DeltaCoder::encode(const Image& image, const Frame::Buffer buffer)
+{
+    const PixelData& pixels = image.getPixelData(buffer);
+    const uint8_t* data = image.getPixelPointer(buffer);
+
+    _header.sequence = _sequence + 1;
+    _header.reference = _sequence;
+    _header.pvp = pixels.pvp;
+    _mask.clear();
+
+    const bool keyframe = _keyframe.exchange(false);
+    if (keyframe || !_hasReference(pixels) || _nDeltas >= KEYFRAME_INTERVAL)
+    {
+        _setReference(pixels, data, _header.sequence);
+        _header.mode = MODE_KEYFRAME;
+        _header.maskSize = 0;
+        _nDeltas = 0;
+        return false;
+    }
+
+    const size_t nTiles = _getNumTiles(pixels.pvp);
+    const size_t rowSize = size_t(pixels.pvp.w) * _pixelSize;
+    _mask.resize((((nTiles + 7) >> 3) + 7) & ~size_t(7), 0);
+
+    size_t nChanged = 0;
+    _forEachTile(pixels.pvp, [&](const size_t index, const int32_t x,
+                                 const int32_t y, const int32_t width,
+                                 const int32_t height) {
+        for (int32_t row = 0; row < height; ++row)
+        {
+            const size_t offset = (y + row) * rowSize + x * _pixelSize;
+            if (::memcmp(data + offset, _pixels.data() + offset,
+                         width * _pixelSize) != 0)
+            {
+                _mask[index >> 3] |= uint8_t(1u << (index & 7));
+                ++nChanged;
+                return;
+            }
+        }
+    });
+
+    if (nChanged * 2 > nTiles) // not worth it
+    {
+        _setReference(pixels, data, _header.sequence);
+        _header.mode = MODE_KEYFRAME;
+        _header.maskSize = 0;
+        _mask.clear();
+        _nDeltas = 0;
+        return false;
+    }
+
+    if (nChanged == 0) // send one tile to keep the data path uniform
+    {
+        _mask[0] = 1;
+        nChanged = 1;
+    }
+
+    const PixelViewport column(0, 0, TILE_SIZE, TILE_SIZE * int32_t(nChanged));
+    PixelData tiles;
+    tiles.internalFormat = _internalFormat;
+    tiles.externalFormat = _externalFormat;
+    tiles.pixelSize = _pixelSize;
+    tiles.pvp = column;
+    _tiles.setAlphaUsage(image.getAlphaUsage());
+    _tiles.setPixelViewport(column);
+    _tiles.setPixelData(buffer, tiles); // allocates and clears
+
+    uint8_t* out = _tiles.getPixelPointer(buffer);
+    const size_t tileRowSize = size_t(TILE_SIZE) * _pixelSize;
+    size_t tile = 0;
+    _forEachTile(pixels.pvp, [&](const size_t index, const int32_t x,
+                                 const int32_t y, const int32_t width,
+                                 const int32_t height) {
+        if (!_isSet(_mask.data(), index))
+            return;
+
+        for (int32_t row = 0; row < height; ++row)
+        {
+            const size_t offset = (y + row) * rowSize + x * _pixelSize;
+            const uint8_t* in = data + offset;
+            uint8_t* reference = _pixels.data() + offset;
+            uint8_t* delta = out + (tile * TILE_SIZE + row) * tileRowSize;
+
+            for (size_t i = 0; i < width * _pixelSize; ++i)
+                delta[i] = in[i] ^ reference[i];
+            ::memcpy(reference, in, width * _pixelSize);
+        }
+        ++tile;
+    });
+
+    _sequence = _header.sequence;
+    _header.mode = MODE_TILES;
+    _header.maskSize = uint32_t(_mask.size());
+    ++_nDeltas;
+    return true;
+}
+
+void DeltaCoder::setKeyframe(const Header& header, const Image& image,
+                             const Frame::Buffer buffer)
+{
+    _setReference(image.getPixelData(buffer), image.getPixelPointer(buffer),
+                  header.sequence);
+}
+
+bool DeltaCoder::decode(const Header& header, const uint8_t* mask,
+                        const PixelData& tiles, const Frame::Buffer buffer,
+                        PixelData& result)
+{
+    if (_pixels.empty() || header.reference != _sequence ||
+        header.pvp.w != _pvp.w || header.pvp.h != _pvp.h ||
+        tiles.pvp.w != TILE_SIZE)
+    {
+        return false;
+    }
+
+    const size_t nTiles = _getNumTiles(_pvp);
+    if (header.maskSize < (nTiles + 7) >> 3)
+        return false;
+
+    size_t nChanged = 0;
+    for (size_t i = 0; i < nTiles; ++i)
+        nChanged += _isSet(mask, i);
+    if (tiles.pvp.h != TILE_SIZE * int32_t(nChanged))
+        return false;
+
+    _tiles.setPixelViewport(tiles.pvp);
+    _tiles.setPixelData(buffer, tiles); // decompresses
+    if (_tiles.getPixelSize(buffer) != _pixelSize)
+        return false;
+
+    const uint8_t* in = _tiles.getPixelPointer(buffer);
+    const size_t rowSize = size_t(_pvp.w) * _pixelSize;
+    const size_t tileRowSize = size_t(TILE_SIZE) * _pixelSize;
+    size_t tile = 0;
+    _forEachTile(_pvp, [&](const size_t index, const int32_t x,
+                           const int32_t y, const int32_t width,
+                           const int32_t height) {
+        if (!_isSet(mask, index))
+            return;
+
+        for (int32_t row = 0; row < height; ++row)
+        {
+            uint8_t* reference =
+                _pixels.data() + (y + row) * rowSize + x * _pixelSize;
+            const uint8_t* delta =
+                in + (tile * TILE_SIZE + row) * tileRowSize;
+
+            for (size_t i = 0; i < width * _pixelSize; ++i)
+                reference[i] ^= delta[i];
+        }
+        ++tile;
+    });
+
+    _sequence = header.sequence;
+    result.internalFormat = _internalFormat;
+    result.externalFormat = _externalFormat;
+    result.pixelSize = _pixelSize;
+    result.pvp = header.pvp;
+    result.pixels = _pixels.data();
+    return true;
+}
+
+bool DeltaCoder::_hasReference(const PixelData& pixels) const
+{
+    return !_pixels.empty() && pixels.pvp.w == _pvp.w &&
+           pixels.pvp.h == _pvp.h && pixels.internalFormat == _internalFormat &&
+           pixels.externalFormat == _externalFormat &&
+           pixels.pixelSize == _pixelSize;
+}
+
+void DeltaCoder::_setReference(const PixelData& pixels, const uint8_t* data,
+                               const uint32_t sequence)
+{
+    _internalFormat = pixels.internalFormat;
+    _externalFormat = pixels.externalFormat;
+    _pixelSize = pixels.pixelSize;
+    _pvp = pixels.pvp;
+    _pixels.assign(data, data + size_t(_pvp.getArea()) * _pixelSize);
+    _sequence = sequence;
+}
+}
+}
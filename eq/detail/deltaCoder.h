@@ -0,0 +1,135 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_DELTACODER_H
+#define EQ_DETAIL_DELTACODER_H
+
+#include <eq/image.h> // member
+#include <eq/types.h>
+
+#include <atomic>
+#include <vector>
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * Tile-based temporal delta coding of an image buffer between two nodes.
+ *
+ * The encoder and the decoder both keep the last transmitted pixels as a
+ * reference. The encoder compares new pixels tile by tile against it, and
+ * sends a change mask together with the changed tiles XOR'ed with the
+ * reference. The tiles are stacked into a column image, which is compressed by
+ * the regular image plugins. Keyframes carry the full buffer; they are sent
+ * initially, periodically, when the format changes, when most tiles changed
+ * and when the decoder lost track of the sequence.
+ */
+class DeltaCoder
+{
+public:
+    enum Mode
+    {
+        MODE_NONE,     //!< not temporally coded
+        MODE_KEYFRAME, //!< full buffer, resets the reference
+        MODE_TILES     //!< changed tiles relative to the reference
+    };
+
+    /** Transmitted before the image header of each buffer. */
+    struct Header
+    {
+        uint32_t mode;      //!< Mode of the following data
+        uint32_t sequence;  //!< number of this transmission
+        uint32_t reference; //!< sequence the tiles are relative to
+        uint32_t maskSize;  //!< bytes of the following tile mask
+        PixelViewport pvp;  //!< of the full buffer
+    };
+
+    static const int32_t TILE_SIZE = 64;
+
+    EQ_API DeltaCoder();
+    EQ_API ~DeltaCoder();
+
+    /** @name Encoding */
+    //@{
+    /**
+     * Code the given pixels against the reference, which is updated.
+     *
+     * @return true if only the changed tiles need to be sent, false if the
+     *         full buffer needs to be sent as a keyframe.
+     */
+    EQ_API bool encode(const Image& image, Frame::Buffer buffer);
+
+    /** Force the next encoding to produce a keyframe. Thread safe. */
+    void requestKeyframe() { _keyframe = true; }
+
+    /** @return the header of the last coding operation. */
+    const Header& getHeader() const { return _header; }
+
+    /** @return the change mask of the last encoding, padded to 8 bytes. */
+    const std::vector<uint8_t>& getMask() const { return _mask; }
+
+    /** @return the column of changed tiles of the last encoding. */
+    Image& getTiles() { return _tiles; }
+    //@}
+
+    /** @name Decoding */
+    //@{
+    /** Use the pixels of a received keyframe as the reference. */
+    EQ_API void setKeyframe(const Header& header, const Image& image,
+                            Frame::Buffer buffer);
+
+    /**
+     * Apply received tiles to the reference.
+     *
+     * @param header the header of the transmission.
+     * @param mask the change mask.
+     * @param tiles the pixels of the tile column, compressed or not.
+     * @param buffer the image buffer.
+     * @param result set up to point to the decoded pixels on success.
+     * @return false if the tiles do not match the reference.
+     */
+    EQ_API bool decode(const Header& header, const uint8_t* mask,
+                       const PixelData& tiles, Frame::Buffer buffer,
+                       PixelData& result);
+    //@}
+
+private:
+    Header _header;
+    std::vector<uint8_t> _mask;
+    Image _tiles;
+
+    std::vector<uint8_t> _pixels; // reference
+    uint32_t _internalFormat;
+    uint32_t _externalFormat;
+    uint32_t _pixelSize;
+    fabric::PixelViewport _pvp;
+    uint32_t _sequence;
+    uint32_t _nDeltas;
+    std::atomic<bool> _keyframe;
+
+    bool _hasReference(const PixelData& pixels) const;
+    void _setReference(const PixelData& pixels, const uint8_t* data,
+                       uint32_t sequence);
+
+    DeltaCoder(const DeltaCoder&) = delete;
+    DeltaCoder& operator=(const DeltaCoder&) = delete;
+};
+}
+}
+
+#endif // EQ_DETAIL_DELTACODER_H
@@ -19,6 +19,8 @@
 
 #include <eq/channel.h>
 #include <eq/image.h>
+#include <eq/imageWriter.h>
+#include <eq/node.h>
 
 #include <lunchbox/log.h>
 
@@ -37,9 +39,11 @@ void FileFrameWriter::notifyNewImage(eq::Channel& channel,
     const std::string& prefix =
         channel.getSAttribute(eq::Channel::SATTR_DUMP_IMAGE);
     LBASSERT(!prefix.empty());
-    const std::string fileName = prefix + channel.getDumpImageFileName();
-    if (!image.writeImage(fileName, eq::Frame::Buffer::color))
-        LBWARN << "Could not write file " << fileName << std::endl;
+    const bool stream = prefix == "-" || prefix[0] == '|';
+    const std::string fileName =
+        stream ? prefix : prefix + channel.getDumpImageFileName();
+    channel.getNode()->getImageWriter().write(image, eq::Frame::Buffer::color,
+                                              fileName);
 }
 
 FileFrameWriter::~FileFrameWriter()
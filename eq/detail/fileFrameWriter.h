@@ -27,7 +27,11 @@ namespace detail
 {
 /**
  * Persist the color buffer of a channel to a file.
- * The name of the file is Channel::SATTR_DUMP_IMAGE.rgb
+ * The name of the file is Channel::SATTR_DUMP_IMAGE +
+ * Channel::getDumpImageFileName(). A SATTR_DUMP_IMAGE of "-" or "|command"
+ * streams all images to the standard output or the given command. The images
+ * are written asynchronously by the image writer of the node, which is shared
+ * by all channels, so that they share one ordered output stream.
  */
 class FileFrameWriter : public ResultImageListener
 {
@@ -0,0 +1,165 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "pluginCache.h"
+
+#include "../log.h"
+#include "../transferFinder.h"
+
+#include <lunchbox/lockable.h>
+#include <lunchbox/scopedMutex.h>
+#include <lunchbox/spinLock.h>
+#include <pression/pluginRegistry.h>
+
+#include <map>
+#include <tuple>
+
+namespace eq
+{
+namespace detail
+{
+namespace
+{
+class CompressorFinder : public pression::ConstPluginVisitor
+{
+public:
+    explicit CompressorFinder(const uint32_t token)
+        : token_(token)
+    {
+    }
+
+    virtual fabric::VisitorResult visit(const pression::Plugin&,
+                                        const EqCompressorInfo& info)
+    {
+        if (info.capabilities & EQ_COMPRESSOR_TRANSFER)
+            return fabric::TRAVERSE_CONTINUE;
+
+        if (info.tokenType == token_)
+            result.push_back(info.name);
+        return fabric::TRAVERSE_CONTINUE;
+    }
+
+    std::vector<uint32_t> result;
+
+private:
+    const uint32_t token_;
+};
+
+typedef std::tuple<uint32_t, uint32_t, uint64_t, float, bool,
+                   const GLEWContext*>
+    TransferKey;
+typedef std::map<TransferKey, PluginCache::InfosPtr> Transferers;
+typedef std::map<uint32_t, PluginCache::NamesPtr> Compressors;
+
+struct Cache
+{
+    Cache()
+        : nPlugins(0)
+    {
+    }
+
+    /** Clear the cache if plugins have been registered since the last use. */
+    void validate()
+    {
+        const size_t current =
+            pression::PluginRegistry::getInstance().getPlugins().size();
+        if (current == nPlugins)
+            return;
+
+        clear();
+        nPlugins = current;
+    }
+
+    void clear()
+    {
+        transferers.clear();
+        compressors.clear();
+        nPlugins = 0;
+    }
+
+    Transferers transferers;
+    Compressors compressors;
+    size_t nPlugins;
+};
+
+lunchbox::Lockable<Cache, lunchbox::SpinLock> _cache;
+}
+
+PluginCache::InfosPtr PluginCache::findTransferers(
+    const uint32_t internal, const uint32_t external, const uint64_t caps,
+    const float minQuality, const bool ignoreAlpha, const GLEWContext* gl)
+{
+    const TransferKey key(internal, external, caps, minQuality, ignoreAlpha,
+                          gl);
+    size_t nPlugins = 0;
+    {
+        lunchbox::ScopedFastWrite mutex(_cache);
+        _cache->validate();
+        nPlugins = _cache->nPlugins;
+        Transferers::const_iterator i = _cache->transferers.find(key);
+        if (i != _cache->transferers.end())
+            return i->second;
+    }
+
+    // traverse outside of the lock, concurrent misses yield the same result
+    TransferFinder finder(internal, external, caps, minQuality, ignoreAlpha,
+                          gl);
+    pression::PluginRegistry::getInstance().accept(finder);
+    InfosPtr infos = std::make_shared<const EqCompressorInfos>(finder.result);
+
+    lunchbox::ScopedFastWrite mutex(_cache);
+    _cache->validate();
+    if (_cache->nPlugins == nPlugins) // registry unchanged during traversal
+        _cache->transferers[key] = infos;
+    return infos;
+}
+
+PluginCache::NamesPtr PluginCache::findCompressors(const uint32_t tokenType)
+{
+    size_t nPlugins = 0;
+    {
+        lunchbox::ScopedFastWrite mutex(_cache);
+        _cache->validate();
+        nPlugins = _cache->nPlugins;
+        Compressors::const_iterator i = _cache->compressors.find(tokenType);
+        if (i != _cache->compressors.end())
+            return i->second;
+    }
+
+    CompressorFinder finder(tokenType);
+    pression::PluginRegistry::getInstance().accept(finder);
+    NamesPtr names = std::make_shared<const std::vector<uint32_t>>(
+        std::move(finder.result));
+
+    LBLOG(LOG_PLUGIN) << "Found " << names->size()
+                      << " compressors for token type 0x" << std::hex
+                      << tokenType << std::dec << std::endl;
+
+    lunchbox::ScopedFastWrite mutex(_cache);
+    _cache->validate();
+    if (_cache->nPlugins == nPlugins)
+        _cache->compressors[tokenType] = names;
+    return names;
+}
+
+void PluginCache::invalidate()
+{
+    lunchbox::ScopedFastWrite mutex(_cache);
+    _cache->clear();
+}
+}
+}
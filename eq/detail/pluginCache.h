@@ -0,0 +1,63 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_PLUGINCACHE_H
+#define EQ_DETAIL_PLUGINCACHE_H
+
+#include <eq/types.h>
+#include <pression/plugins/compressor.h> // EqCompressorInfos
+
+#include <memory>
+#include <vector>
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * A process-wide, thread-safe cache of plugin registry lookups.
+ *
+ * Images query the plugin registry for every buffer of every received or
+ * read-back image. The cache memoizes the results, so that only the first
+ * lookup for a given set of parameters traverses the registry. It is
+ * invalidated when the number of registered plugins changes, and explicitly
+ * during eq::init() and eq::exit().
+ */
+class PluginCache
+{
+public:
+    typedef std::shared_ptr<const EqCompressorInfos> InfosPtr;
+    typedef std::shared_ptr<const std::vector<uint32_t>> NamesPtr;
+
+    /**
+     * @return the transfer plugins for the given parameters.
+     * @sa TransferFinder
+     */
+    static InfosPtr findTransferers(uint32_t internal, uint32_t external,
+                                    uint64_t caps, float minQuality,
+                                    bool ignoreAlpha, const GLEWContext* gl);
+
+    /** @return the names of the CPU compressors for the given token type. */
+    static NamesPtr findCompressors(uint32_t tokenType);
+
+    /** Clear all cached lookups. */
+    static void invalidate();
+};
+}
+}
+
+#endif // EQ_DETAIL_PLUGINCACHE_H
@@ -449,7 +449,7 @@ bool Canvas<CFG, C, S, L>::_cmdNewSegment(co::ICommand& cmd)
     LBASSERT(segment);
 
     getLocalNode()->registerObject(segment);
-    segment->setAutoObsolete(_config->getLatency() + 1);
+    segment->setAutoObsolete(_config->getMaxLatency() + 1);
     LBASSERT(segment->isAttached());
 
     send(command.getRemoteNode(), CMD_CANVAS_NEW_SEGMENT_REPLY)
@@ -282,6 +282,8 @@ public:
         IATTR_HINT_STATISTICS,
         /** Use a send token for output frames (OFF, ON) */
         IATTR_HINT_SENDTOKEN,
+        /** Use temporal delta coding for output frames (OFF, ON) */
+        IATTR_HINT_TEMPORAL_DELTA,
         IATTR_LAST,
         IATTR_ALL = IATTR_LAST + 5
     };
@@ -52,6 +52,7 @@ enum ClientCommand
 {
     CMD_CLIENT_EXIT = CMD_SERVER_CUSTOM,
     CMD_CLIENT_INTERRUPT,
+    CMD_CLIENT_FRAME_TASKS,
     CMD_CLIENT_CUSTOM
 };
 
@@ -88,6 +89,7 @@ enum ConfigCommand
     CMD_CONFIG_SYNC_CLOCK,
     CMD_CONFIG_SWAP_OBJECT,
     CMD_CONFIG_CHECK_FRAME,
+    CMD_CONFIG_EVENTS,
     CMD_CONFIG_CUSTOM
 };
 
@@ -107,6 +109,7 @@ enum NodeCommand
     CMD_NODE_FRAME_TASKS_FINISH,
     CMD_NODE_FRAMEDATA_TRANSMIT,
     CMD_NODE_FRAMEDATA_READY,
+    CMD_NODE_FRAMEDATA_RESYNC,
     CMD_NODE_CUSTOM
 };
 
@@ -152,6 +155,7 @@ enum WindowCommand
     CMD_WINDOW_CREATE_QGL_WIDGET,
     CMD_WINDOW_DESTROY_QGL_WIDGET,
     CMD_WINDOW_RESIZE,
+    CMD_WINDOW_TREE_BARRIER,
     CMD_WINDOW_CUSTOM
 };
 
@@ -135,7 +135,9 @@ public:
     /** Integer attributes. */
     enum IAttribute
     {
-        IATTR_ROBUSTNESS, //!< Tolerate resource failures
+        IATTR_ROBUSTNESS,  //!< Tolerate resource failures
+        IATTR_MAX_LATENCY, //!< Upper bound of the adaptive latency, or OFF
+        IATTR_LAUNCH_CONCURRENCY, //!< Nodes connected or launched at once
         IATTR_LAST,
         IATTR_ALL = IATTR_LAST + 5
     };
@@ -186,6 +188,14 @@ public:
 
     /** @return the latency of this config. @version 1.0 */
     uint32_t getLatency() const { return _data.latency; }
+
+    /**
+     * @return the upper bound of the latency, which is the latency or the
+     *         larger IATTR_MAX_LATENCY in adaptive latency mode.
+     * @version 2.1
+     */
+    EQFABRIC_INL uint32_t getMaxLatency() const;
+
     /** @internal Restore the last backup. */
     EQFABRIC_INL virtual void restore();
     //@}
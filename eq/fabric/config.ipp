@@ -40,7 +40,8 @@ std::string _fAttributeStrings[] = {
     MAKE_ATTR_STRING(FATTR_EYE_BASE), MAKE_ATTR_STRING(FATTR_VERSION),
 };
 std::string _iAttributeStrings[] = {
-    MAKE_ATTR_STRING(IATTR_ROBUSTNESS),
+    MAKE_ATTR_STRING(IATTR_ROBUSTNESS), MAKE_ATTR_STRING(IATTR_MAX_LATENCY),
+    MAKE_ATTR_STRING(IATTR_LAUNCH_CONCURRENCY),
 };
 }
 
@@ -544,6 +545,15 @@ void Config<S, C, O, L, CV, N, V>::setLatency(const uint32_t latency)
     setDirty(DIRTY_LATENCY);
 }
 
+template <class S, class C, class O, class L, class CV, class N, class V>
+uint32_t Config<S, C, O, L, CV, N, V>::getMaxLatency() const
+{
+    const int32_t maxLatency = getIAttribute(IATTR_MAX_LATENCY);
+    if (maxLatency > int32_t(_data.latency))
+        return uint32_t(maxLatency);
+    return _data.latency;
+}
+
 template <class S, class C, class O, class L, class CV, class N, class V>
 void Config<S, C, O, L, CV, N, V>::setAppNodeID(const co::NodeID& nodeID)
 {
@@ -837,7 +847,7 @@ bool Config<S, C, O, L, CV, N, V>::_cmdNewLayout(co::ICommand& cmd)
     LBASSERT(layout);
 
     getLocalNode()->registerObject(layout);
-    layout->setAutoObsolete(_data.latency + 1);
+    layout->setAutoObsolete(getMaxLatency() + 1);
     LBASSERT(layout->isAttached());
 
     send(command.getRemoteNode(), CMD_CONFIG_NEW_ENTITY_REPLY)
@@ -855,7 +865,7 @@ bool Config<S, C, O, L, CV, N, V>::_cmdNewCanvas(co::ICommand& cmd)
     LBASSERT(canvas);
 
     getLocalNode()->registerObject(canvas);
-    canvas->setAutoObsolete(_data.latency + 1);
+    canvas->setAutoObsolete(getMaxLatency() + 1);
     LBASSERT(canvas->isAttached());
 
     send(command.getRemoteNode(), CMD_CONFIG_NEW_ENTITY_REPLY)
@@ -873,7 +883,7 @@ bool Config<S, C, O, L, CV, N, V>::_cmdNewObserver(co::ICommand& cmd)
     LBASSERT(observer);
 
     getLocalNode()->registerObject(observer);
-    observer->setAutoObsolete(_data.latency + 1);
+    observer->setAutoObsolete(getMaxLatency() + 1);
     LBASSERT(observer->isAttached());
 
     send(command.getRemoteNode(), CMD_CONFIG_NEW_ENTITY_REPLY)
@@ -912,8 +922,15 @@ std::ostream& operator<<(std::ostream& os,
     os << "attributes" << std::endl
        << "{" << std::endl
        << lunchbox::indent << "robustness "
-       << IAttribute(config.getIAttribute(C::IATTR_ROBUSTNESS)) << std::endl
-       << "eye_base   " << config.getFAttribute(C::FATTR_EYE_BASE) << std::endl
+       << IAttribute(config.getIAttribute(C::IATTR_ROBUSTNESS)) << std::endl;
+    const int32_t maxLatency = config.getIAttribute(C::IATTR_MAX_LATENCY);
+    if (maxLatency > 0)
+        os << "max_latency " << maxLatency << std::endl;
+    const int32_t concurrency =
+        config.getIAttribute(C::IATTR_LAUNCH_CONCURRENCY);
+    if (concurrency > 0)
+        os << "launch_concurrency " << concurrency << std::endl;
+    os << "eye_base   " << config.getFAttribute(C::FATTR_EYE_BASE) << std::endl
        << lunchbox::exdent << "}" << std::endl;
 
     const typename C::Nodes& nodes = config.getNodes();
@@ -42,6 +42,7 @@ public:
         , boundary2i(1, 1)
         , resistance2i(0, 0)
         , tilesize(64, 64)
+        , costMapSize(0, 0)
         , mode(fabric::Equalizer::MODE_2D)
         , frozen(false)
     {
@@ -73,6 +74,7 @@ public:
         , boundary2i(rhs.boundary2i)
         , resistance2i(rhs.resistance2i)
         , tilesize(rhs.tilesize)
+        , costMapSize(rhs.costMapSize)
         , mode(rhs.mode)
         , frozen(rhs.frozen)
     {
@@ -86,6 +88,7 @@ public:
     Vector2i boundary2i;
     Vector2i resistance2i;
     Vector2i tilesize;
+    Vector2i costMapSize;
     fabric::Equalizer::Mode mode;
     bool frozen;
 };
@@ -220,19 +223,31 @@ const Vector2i& Equalizer::getTileSize() const
     return _data->tilesize;
 }
 
+void Equalizer::setCostMapSize(const Vector2i& size)
+{
+    LBASSERT(size.x() >= 0 && size.y() >= 0);
+    _data->costMapSize = size;
+}
+
+const Vector2i& Equalizer::getCostMapSize() const
+{
+    return _data->costMapSize;
+}
+
 void Equalizer::serialize(co::DataOStream& os) const
 {
     os << _data->damping << _data->boundaryf << _data->resistancef
        << _data->assembleOnlyLimit << _data->frameRate << _data->boundary2i
-       << _data->resistance2i << _data->tilesize << _data->mode
-       << _data->frozen;
+       << _data->resistance2i << _data->tilesize << _data->costMapSize
+       << _data->mode << _data->frozen;
 }
 
 void Equalizer::deserialize(co::DataIStream& is)
 {
     is >> _data->damping >> _data->boundaryf >> _data->resistancef >>
         _data->assembleOnlyLimit >> _data->frameRate >> _data->boundary2i >>
-        _data->resistance2i >> _data->tilesize >> _data->mode >> _data->frozen;
+        _data->resistance2i >> _data->tilesize >> _data->costMapSize >>
+        _data->mode >> _data->frozen;
 }
 
 void Equalizer::backup()
@@ -121,6 +121,17 @@ public:
 
     /** @return the tile size for the TileEqualizer. */
     EQFABRIC_API const Vector2i& getTileSize() const;
+
+    /**
+     * Set the resolution of the cost map for predictive load balancing.
+     *
+     * A non-empty cost map enables the cost-map based split computation of the
+     * TreeEqualizer. For DB decompositions only the x resolution is used.
+     */
+    EQFABRIC_API void setCostMapSize(const Vector2i& size);
+
+    /** @return the resolution of the cost map. */
+    EQFABRIC_API const Vector2i& getCostMapSize() const;
     //@}
 
     EQFABRIC_API void serialize(co::DataOStream& os) const; //!< @internal
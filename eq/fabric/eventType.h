@@ -81,8 +81,8 @@ enum EventType // Also update string table in event.cpp
     EVENT_WINDOW_ERROR,  //!< Window error event. @sa CONFIG_ERROR
     EVENT_CHANNEL_ERROR, //!< Channel error event. @sa CONFIG_ERROR
 
-    EVENT_VIEW_SCREENSHOT, //!< Viewport, frameNumber, Image with requested
-                           //! buffers
+    EVENT_VIEW_SCREENSHOT, //!< Viewport, frameNumber, pixel data of the
+                           //! requested buffers
 
     // todo
     EVENT_NODE_TIMEOUT,       //!< Node has timed out
@@ -28,12 +28,12 @@ namespace fabric
 {
 void FrameData::serialize(co::DataOStream& os) const
 {
-    os << _pvp << _context << _zoom << _frameType << _buffers;
+    os << _pvp << _context << _zoom << _frameType << _buffers << _quality;
 }
 
 void FrameData::deserialize(co::DataIStream& is)
 {
-    is >> _pvp >> _context >> _zoom >> _frameType >> _buffers;
+    is >> _pvp >> _context >> _zoom >> _frameType >> _buffers >> _quality;
 }
 }
 }
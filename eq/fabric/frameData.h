@@ -36,6 +36,7 @@ public:
     FrameData()
         : _frameType(Frame::TYPE_MEMORY)
         , _buffers(Frame::Buffer::none)
+        , _quality(1.f)
     {
     }
 
@@ -72,6 +73,16 @@ public:
     void setType(const fabric::Frame::Type type) { _frameType = type; }
     /** @return the frame storage type. */
     Frame::Type getType() const { return _frameType; }
+    /**
+     * Set the compression quality scale.
+     *
+     * Preset for Equalizer output frames. The color quality of the images is
+     * scaled by this value, e.g., to transmit lower quality images when the
+     * frame rate drops.
+     */
+    void setQuality(const float quality) { _quality = quality; }
+    /** @return the compression quality scale. */
+    float getQuality() const { return _quality; }
     EQFABRIC_API void serialize(co::DataOStream& os) const;
     EQFABRIC_API void deserialize(co::DataIStream& is);
 
@@ -81,6 +92,7 @@ protected:
     Zoom _zoom;
     Frame::Type _frameType;
     Frame::Buffer _buffers;
+    float _quality;
 };
 }
 }
@@ -314,7 +314,7 @@ bool Layout<C, L, V>::_cmdNewView(co::ICommand& cmd)
     LBASSERT(view);
 
     getLocalNode()->registerObject(view);
-    view->setAutoObsolete(_config->getLatency() + 1);
+    view->setAutoObsolete(_config->getMaxLatency() + 1);
     LBASSERT(view->isAttached());
 
     send(command.getRemoteNode(), CMD_LAYOUT_NEW_VIEW_REPLY)
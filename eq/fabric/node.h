@@ -81,6 +81,7 @@ public:
         IATTR_THREAD_MODEL,
         IATTR_LAUNCH_TIMEOUT, //!< Timeout when auto-launching the node
         IATTR_HINT_AFFINITY,
+        IATTR_HINT_BATCH_TASKS, //!< Send the frame tasks as one command
         IATTR_LAST,
         IATTR_ALL = IATTR_LAST + 5
     };
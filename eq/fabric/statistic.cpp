@@ -66,6 +66,8 @@ static StatisticData _statisticData[] = {
     {Statistic::CONFIG_FINISH_FRAME, "finish frame", Vector3f(.5f, .5f, .5f)},
     {Statistic::CONFIG_WAIT_FINISH_FRAME, "wait finish",
      Vector3f(1.0f, 0.f, 0.f)},
+    {Statistic::CONFIG_LATENCY, "latency", Vector3f(1.f, 1.f, 1.f)},
+    {Statistic::PIPE_QUEUE, "pipe queue", Vector3f(1.f, 1.f, 1.f)},
     {Statistic::ALL, "ALL EVENTS", Vector3f(0.0f, 0.f, 0.f)}};
 }
 
@@ -67,7 +67,14 @@ struct Statistic : public Event
         CONFIG_FINISH_FRAME,   //!< Sampling of Config::finishFrame
         /** Sampling of synchronization time during Config::finishFrame */
         CONFIG_WAIT_FINISH_FRAME,
-        ALL // must be last
+        /**
+         * Latency change of the adaptive latency mode. The idle and total
+         * time are the mean application wait and frame time, the ratio is the
+         * pipe idle ratio.
+         */
+        CONFIG_LATENCY,
+        PIPE_QUEUE, //!< Pipe thread command queue wait and depth
+        ALL         // must be last
     };
 
     Type type;            //!< The type of statistic
@@ -75,15 +82,18 @@ struct Statistic : public Event
     uint32_t task;        //!< @internal
     uint32_t plugins[2];  //!< color,depth plugins (readback, compression)
 
-    int64_t startTime; //!< Absolute start time of the operation
-    int64_t endTime;   //!< Absolute end time of the operation
-    int64_t idleTime;  //!< Absolute idle time of PIPE_IDLE
-    int64_t totalTime; //!< Total time of a pipe frame (PIPE_IDLE)
+    int64_t startTime;    //!< Absolute start time of the operation
+    int64_t endTime;      //!< Absolute end time of the operation
+    int64_t idleTime;     //!< Absolute idle time of PIPE_IDLE
+    int64_t totalTime;    //!< Total time of a pipe frame (PIPE_IDLE)
+    int64_t queueWait;    //!< Mean time a command was queued (PIPE_QUEUE)
+    int64_t maxQueueWait; //!< Max time a command was queued (PIPE_QUEUE)
 
     float ratio;      //!< compression ratio (transfer, compression)
     float currentFPS; //!< FPS of last frame (WINDOW_FPS)
     float averageFPS; //!< Weighted sum averaging of FPS (WINDOW_FPS)
-    float pad;        //!< @internal
+    uint32_t latency; //!< The new latency (CONFIG_LATENCY)
+    float queueDepth; //!< Mean queued commands at dequeue (PIPE_QUEUE)
 
     char resourceName[32]; //!< A non-unique name of the originator
 
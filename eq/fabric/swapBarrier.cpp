@@ -17,10 +17,88 @@
 
 #include "swapBarrier.h"
 
+#include <co/barrier.h>
+
+#include <algorithm>
+#include <map>
+
 namespace eq
 {
 namespace fabric
 {
+namespace
+{
+void _addBarrier(SwapBarrier::Tree& tree, const std::vector<size_t>& members)
+{
+    if (members.size() < 2)
+        return;
+
+    const size_t barrier = tree.members.size();
+    tree.masters.push_back(members.front());
+    tree.members.push_back(members);
+    for (const size_t member : members)
+        tree.paths[member].push_back(barrier);
+}
+}
+
+SwapBarrier::Tree SwapBarrier::buildTree(const std::vector<uint32_t>& groups,
+                                         const uint32_t fanIn)
+{
+    LBASSERT(fanIn > 1);
+    Tree tree;
+    tree.paths.resize(groups.size());
+
+    // participants in order of their group's first appearance
+    std::vector<std::vector<size_t>> members;
+    std::map<uint32_t, size_t> index;
+    for (size_t i = 0; i < groups.size(); ++i)
+    {
+        const auto j = index.insert(std::make_pair(groups[i], members.size()));
+        if (j.second)
+            members.push_back(std::vector<size_t>());
+        members[j.first->second].push_back(i);
+    }
+
+    std::vector<size_t> leaders;
+    for (const std::vector<size_t>& group : members)
+    {
+        _addBarrier(tree, group);
+        leaders.push_back(group.front());
+    }
+
+    const size_t width = std::max(fanIn, 2u);
+    while (leaders.size() > 1)
+    {
+        std::vector<size_t> next;
+        for (size_t i = 0; i < leaders.size(); i += width)
+        {
+            const size_t end = std::min(i + width, leaders.size());
+            const std::vector<size_t> group(leaders.begin() + i,
+                                            leaders.begin() + end);
+            _addBarrier(tree, group);
+            next.push_back(group.front());
+        }
+        leaders.swap(next);
+    }
+    return tree;
+}
+
+bool SwapBarrier::enter(const co::Barriers& path, const bool release,
+                        const uint32_t timeout)
+{
+    for (co::Barrier* barrier : path)
+        if (!barrier->enter(timeout))
+            return false;
+
+    size_t i = path.size();
+    if (!release && i > 0)
+        --i; // the root releases all participants at once
+    while (i > 0)
+        if (!path[--i]->enter(timeout))
+            return false;
+    return true;
+}
+
 std::ostream& operator<<(std::ostream& os, const SwapBarrier& swapBarrier)
 {
     if (swapBarrier.isNvSwapBarrier())
@@ -33,6 +111,12 @@ std::ostream& operator<<(std::ostream& os, const SwapBarrier& swapBarrier)
                   << std::endl
                   << "}" << lunchbox::enableFlush << std::endl;
 
+    if (swapBarrier.isTree())
+        return os << lunchbox::disableFlush << "swapbarrier { name \""
+                  << swapBarrier.getName() << "\" fan_in "
+                  << swapBarrier.getFanIn() << " }" << lunchbox::enableFlush
+                  << std::endl;
+
     return os << lunchbox::disableFlush << "swapbarrier { name \""
               << swapBarrier.getName() << "\" }" << lunchbox::enableFlush
               << std::endl;
@@ -18,9 +18,11 @@
 #ifndef EQFABRIC_SWAPBARRIER_H
 #define EQFABRIC_SWAPBARRIER_H
 
+#include <co/types.h>
 #include <eq/fabric/api.h>
 #include <iostream>
 #include <lunchbox/referenced.h> // base class
+#include <vector>
 
 namespace eq
 {
@@ -33,6 +35,11 @@ namespace fabric
  * Swap barriers with the same name are linked together, that is, all
  * compounds holding a swap barrier with the same name synchronize their
  * window's swap command.
+ *
+ * By default, all windows enter one barrier served by the first node. With a
+ * fan-in, the windows of each node first synchronize on a node-local barrier,
+ * and the nodes synchronize on a tree of barriers with the given fan-in. This
+ * limits the number of requests each barrier master handles per frame.
  */
 class SwapBarrier : public lunchbox::Referenced
 {
@@ -43,9 +50,29 @@ public:
     SwapBarrier()
         : _nvSwapGroup(0)
         , _nvSwapBarrier(0)
+        , _fanIn(0)
     {
     }
 
+    /** @internal The barriers of a tree swap barrier. */
+    struct Tree
+    {
+        /** The participant serving each barrier. */
+        std::vector<size_t> masters;
+
+        /** The participants entering each barrier, the leader first. */
+        std::vector<std::vector<size_t>> members;
+
+        /** The barriers entered by each participant, bottom up. */
+        std::vector<std::vector<size_t>> paths;
+
+        /** @return true if the given barrier is the root of the tree. */
+        bool isRoot(const size_t barrier) const
+        {
+            return barrier + 1 == members.size();
+        }
+    };
+
     /** @name Data Access. */
     //@{
     void setName(const std::string& name) { _name = name; }
@@ -55,13 +82,51 @@ public:
     uint32_t getNVSwapBarrier() const { return _nvSwapBarrier; }
     void setNVSwapBarrier(uint32_t nvBarrier) { _nvSwapBarrier = nvBarrier; }
     bool isNvSwapBarrier() const { return (_nvSwapBarrier || _nvSwapGroup); }
+
+    /** Set the fan-in of the barrier tree, 0 or 1 for a central barrier. */
+    void setFanIn(const uint32_t fanIn) { _fanIn = fanIn; }
+    uint32_t getFanIn() const { return _fanIn; }
+    bool isTree() const { return _fanIn > 1 && !isNvSwapBarrier(); }
     //@}
 
+    /**
+     * @internal
+     * Compute the barrier tree for a set of participants.
+     *
+     * Participants of the same group, i.e., on the same node, share a first
+     * barrier led by the first participant of the group. The group leaders
+     * are combined recursively into barriers of at most fanIn participants.
+     * Barriers of only one participant are omitted.
+     *
+     * @param groups the group of each participant.
+     * @param fanIn the maximum number of groups per barrier.
+     * @return the barrier tree.
+     */
+    EQFABRIC_API static Tree buildTree(const std::vector<uint32_t>& groups,
+                                       uint32_t fanIn);
+
+    /**
+     * @internal
+     * Enter the path of a participant in a barrier tree.
+     *
+     * The barriers are entered bottom up to gather all participants. The
+     * barriers below the root are entered again top down to release the
+     * participants waiting for their leader.
+     *
+     * @param path the barriers of the participant, bottom up.
+     * @param release true if the topmost barrier is not the root.
+     * @param timeout the timeout for each barrier.
+     * @return false on timeout, true otherwise.
+     */
+    EQFABRIC_API static bool enter(const co::Barriers& path, bool release,
+                                   uint32_t timeout);
+
 private:
     std::string _name;
 
     uint32_t _nvSwapGroup;
     uint32_t _nvSwapBarrier;
+    uint32_t _fanIn;
 };
 
 EQFABRIC_API std::ostream& operator<<(std::ostream&, const SwapBarrier&);
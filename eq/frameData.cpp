@@ -21,6 +21,7 @@
 #include "frameData.h"
 
 #include "channelStatistics.h"
+#include "detail/deltaCoder.h"
 #include "exception.h"
 #include "image.h"
 #include "log.h"
@@ -42,6 +43,8 @@
 #include <boost/foreach.hpp>
 
 #include <algorithm>
+#include <map>
+#include <memory>
 
 namespace eq
 {
@@ -85,6 +88,13 @@ public:
 
     uint32_t colorCompressor;
     uint32_t depthCompressor;
+
+    /** Uncompressed pixel bytes received and copied for the pending version. */
+    uint64_t receivedBytes = 0;
+    uint64_t copiedBytes = 0;
+
+    /** Temporal delta decoders, indexed by image index and attachment. */
+    std::map<uint64_t, std::unique_ptr<DeltaCoder>> deltaDecoders;
 };
 }
 
@@ -184,6 +194,7 @@ void FrameData::flush()
     }
 
     _impl->imageCache.clear();
+    _impl->deltaDecoders.clear();
 }
 
 void FrameData::deleteGLObjects(util::ObjectManager& om)
@@ -235,7 +246,8 @@ Image* FrameData::_allocImage(const eq::Frame::Type type,
     image->setStorageType(type);
     if (setQuality_)
     {
-        image->setQuality(Frame::Buffer::color, _impl->colorQuality);
+        image->setQuality(Frame::Buffer::color,
+                          _impl->colorQuality * getQuality());
         image->setQuality(Frame::Buffer::depth, _impl->depthQuality);
     }
 
@@ -369,7 +381,11 @@ void FrameData::setReady(const co::ObjectVersion& frameData,
     _setReady(frameData.version.low());
 
     LBLOG(LOG_ASSEMBLY) << this << " applied v" << frameData.version.low()
+                        << ", copied " << _impl->copiedBytes << " of "
+                        << _impl->receivedBytes << " uncompressed bytes"
                         << std::endl;
+    _impl->receivedBytes = 0;
+    _impl->copiedBytes = 0;
 }
 
 void FrameData::_setReady(const uint64_t version)
@@ -413,8 +429,13 @@ bool FrameData::addImage(const co::ObjectVersion& frameDataVersion,
                          const PixelViewport& pvp, const Zoom& zoom,
                          const RenderContext& context,
                          const Frame::Buffer buffers_, const bool useAlpha,
-                         uint8_t* data)
+                         const uint64_t imageIndex, const bool temporal,
+                         const std::vector<uint8_t>& tileMask,
+                         const PixelViewports& coverage,
+                         co::ConstBufferPtr owner, uint8_t* data,
+                         bool& resync)
 {
+    resync = false;
     LBASSERT(_impl->readyVersion < frameDataVersion.version.low());
     if (_impl->readyVersion >= frameDataVersion.version.low())
         return false;
@@ -432,6 +453,16 @@ bool FrameData::addImage(const co::ObjectVersion& frameDataVersion,
 
         if (buffers_ & buffer)
         {
+            const detail::DeltaCoder::Header* delta = 0;
+            const uint8_t* mask = 0;
+            if (temporal)
+            {
+                delta = reinterpret_cast<detail::DeltaCoder::Header*>(data);
+                data += sizeof(detail::DeltaCoder::Header);
+                mask = data;
+                data += delta->maskSize;
+            }
+
             PixelData pixelData;
             const ImageHeader* header = reinterpret_cast<ImageHeader*>(data);
             data += sizeof(ImageHeader);
@@ -473,10 +504,59 @@ bool FrameData::addImage(const co::ObjectVersion& frameDataVersion,
             image->setZoom(zoom);
             image->setContext(context);
             image->setQuality(buffer, header->quality);
-            image->setPixelData(buffer, pixelData);
+
+            if (!delta || delta->mode != detail::DeltaCoder::MODE_TILES)
+            {
+                image->setPixelData(buffer, pixelData, owner);
+                if (pixelData.pixels)
+                {
+                    const uint64_t size =
+                        pixelData.pvp.getArea() * pixelData.pixelSize;
+                    _impl->receivedBytes += size;
+                    if (image->getPixelPointer(buffer) != pixelData.pixels)
+                        _impl->copiedBytes += size;
+                }
+                if (!delta || delta->mode == detail::DeltaCoder::MODE_NONE)
+                    continue;
+            }
+
+            std::unique_ptr<detail::DeltaCoder>& decoder =
+                _impl->deltaDecoders[(imageIndex << 1) | i];
+            if (!decoder)
+                decoder.reset(new detail::DeltaCoder);
+
+            if (delta->mode == detail::DeltaCoder::MODE_KEYFRAME)
+            {
+                decoder->setKeyframe(*delta, *image, buffer);
+                continue;
+            }
+
+            PixelData result;
+            if (!decoder->decode(*delta, mask, pixelData, buffer, result))
+            {
+                LBLOG(LOG_ASSEMBLY) << "Lost temporal delta reference, request "
+                                    << "keyframe" << std::endl;
+                resync = true;
+                continue;
+            }
+            image->setPixelData(buffer, result);
         }
     }
 
+    image->setTileMask(tileMask.data(), tileMask.size());
+    image->setCoverage(coverage);
+
+    // The tiles are relative to a reference this node does not have, so the
+    // image can't be shown. It is missing from this frame until the keyframe
+    // requested by the caller arrives with the next transmission.
+    if (resync)
+    {
+        _impl->imageCacheLock.lock();
+        _impl->imageCache.push_back(image);
+        _impl->imageCacheLock.unlock();
+        return false;
+    }
+
     _impl->pendingImages.push_back(image);
     return true;
 }
@@ -197,11 +197,19 @@ public:
     void removeListener(Listener& listener);
     //@}
 
-    /** @internal */
+    /**
+     * @internal
+     * @return false if the image was not added. resync is set when the
+     *         temporal delta reference was lost, dropping the image from this
+     *         frame.
+     */
     bool addImage(const co::ObjectVersion& frameDataVersion,
                   const PixelViewport& pvp, const Zoom& zoom,
                   const RenderContext& context, const Frame::Buffer buffers,
-                  const bool useAlpha, uint8_t* data);
+                  const bool useAlpha, uint64_t imageIndex, bool temporal,
+                  const std::vector<uint8_t>& tileMask,
+                  const PixelViewports& coverage, co::ConstBufferPtr owner,
+                  uint8_t* data, bool& resync);
     void setReady(const co::ObjectVersion& frameData,
                   const fabric::FrameData& data); //!< @internal
 
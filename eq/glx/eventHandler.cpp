@@ -37,6 +37,8 @@
 #include <lunchbox/scopedMutex.h>
 #include <lunchbox/spinLock.h>
 
+#include <map>
+
 #include <X11/XKBlib.h>
 #include <X11/keysym.h>
 
@@ -308,8 +310,11 @@ void EventHandler::dispatch()
     if (!_eventHandlers)
         return;
 
+    // Send the events of all windows in one command to the application
+    Config::startEventBatch();
     for (EventHandler* handler : *_eventHandlers)
         handler->_dispatch();
+    Config::finishEventBatch();
 }
 
 void EventHandler::_dispatch()
@@ -319,14 +324,78 @@ void EventHandler::_dispatch()
     if (!display)
         return;
 
+    // Read all queued events first, so that high-rate motion, resize and
+    // expose events can be coalesced before they are sent to the application
+    std::vector<XEvent> events;
     while (XPending(display))
     {
-        XEvent event;
-        XNextEvent(display, &event);
+        events.clear();
+        while (XPending(display))
+        {
+            events.resize(events.size() + 1);
+            XNextEvent(display, &events.back());
+        }
+
+        coalesce(events);
+        for (const XEvent& event : events)
+            for (EventHandler* handler : *_eventHandlers)
+                handler->_processEvent(event);
+    }
+}
+
+namespace
+{
+/** @return true if the later event makes the event obsolete. */
+bool _supersedes(const XEvent& later, const XEvent& event)
+{
+    if (later.type != event.type)
+        return false;
+
+    switch (event.type)
+    {
+    case MotionNotify:
+        return later.xmotion.state == event.xmotion.state;
+
+    case ConfigureNotify: // the window size is queried from the X server
+    case Expose:          // only the last expose event is reported
+        return true;
+
+    default:
+        return false;
+    }
+}
+}
 
-        for (EventHandler* handler : *_eventHandlers)
-            handler->_processEvent(event);
+size_t EventHandler::coalesce(std::vector<XEvent>& events)
+{
+    // Walk backwards, remembering the next later event of each window
+    std::map<XID, size_t> later;
+    std::vector<bool> superseded(events.size(), false);
+    for (size_t i = events.size(); i > 0; --i)
+    {
+        const size_t index = i - 1;
+        const XEvent& event = events[index];
+        const XID window = event.xany.window;
+
+        std::map<XID, size_t>::iterator next = later.find(window);
+        if (next != later.end() && _supersedes(events[next->second], event))
+            superseded[index] = true;
+        later[window] = index;
     }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        if (superseded[i])
+            continue;
+        if (kept != i)
+            events[kept] = events[i];
+        ++kept;
+    }
+
+    const size_t removed = events.size() - kept;
+    events.resize(kept);
+    return removed;
 }
 
 namespace
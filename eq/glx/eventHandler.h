@@ -25,6 +25,8 @@
 
 #include <lunchbox/thread.h> // thread-safety macro
 
+#include <vector>
+
 namespace eq
 {
 namespace glx
@@ -48,6 +50,21 @@ public:
      */
     static void dispatch();
 
+    /**
+     * Remove the events superseded by a later event of the same window.
+     *
+     * A motion, resize or expose event is dropped when the next event for the
+     * same window is of the same type, and for motion events has the same
+     * button and modifier state. The last event of each such run is kept, it
+     * carries the most recent state. Events of other windows do not break a
+     * run, and all other events are kept in their order.
+     *
+     * @param events the received events, modified in place.
+     * @return the number of removed events.
+     * @version 2.1
+     */
+    EQ_API static size_t coalesce(std::vector<XEvent>& events);
+
 private:
     WindowIF* const _window;
 
@@ -24,7 +24,8 @@
 #include "half.h"
 #include "log.h"
 #include "pixelData.h"
-#include "transferFinder.h"
+
+#include "detail/pluginCache.h"
 
 #include <eq/fabric/renderContext.h>
 #include <eq/gl.h>
@@ -52,6 +53,7 @@
 #include <osgDB/WriteFile>
 #endif
 
+#include <co/buffer.h>
 #include <co/dataIStream.h>
 #include <co/dataOStream.h>
 
@@ -75,7 +77,7 @@ public:
         , localBuffer(rhs.localBuffer)
         , hasAlpha(rhs.hasAlpha)
     {
-        if (rhs.localBuffer.isEmpty())
+        if (rhs.localBuffer.isEmpty() || rhs.sharedBuffer)
         {
             const size_t size = rhs.pvp.w * rhs.pvp.h * rhs.pixelSize;
             localBuffer.resize(size);
@@ -89,11 +91,22 @@ public:
         PixelData::reset();
         state = INVALID;
         localBuffer.clear();
+        sharedBuffer = 0;
         hasAlpha = true;
     }
 
+    /** Stop referencing a received command buffer. */
+    void releaseShared()
+    {
+        if (!sharedBuffer)
+            return;
+        sharedBuffer = 0;
+        pixels = localBuffer.getData();
+    }
+
     void useLocalBuffer()
     {
+        sharedBuffer = 0;
         LBASSERT(internalFormat != 0);
         LBASSERT(externalFormat != 0);
         LBASSERT(pixelSize > 0);
@@ -117,6 +130,9 @@ public:
      * allocates the memory. */
     lunchbox::Bufferb localBuffer;
 
+    /** The received command buffer holding the pixels, if referenced. */
+    co::ConstBufferPtr sharedBuffer;
+
     bool hasAlpha; //!< The uncompressed pixels contain alpha
 };
 
@@ -147,6 +163,38 @@ co::DataIStream& operator>>(co::DataIStream& is, Memory& mem)
     return is;
 }
 
+void _clearPixels(void* pixels, const ssize_t size,
+                  const uint32_t externalFormat)
+{
+    switch (externalFormat)
+    {
+    case EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT:
+        memset(pixels, 0xFF, size);
+        break;
+
+    case EQ_COMPRESSOR_DATATYPE_RGBA:
+    case EQ_COMPRESSOR_DATATYPE_BGRA:
+    {
+        uint8_t* data = reinterpret_cast<uint8_t*>(pixels);
+#ifdef Darwin
+        const unsigned char pixel[4] = {0, 0, 0, 255};
+        memset_pattern4(data, &pixel, size);
+#else
+        lunchbox::setZero(data, size);
+#pragma omp parallel for
+        for (ssize_t i = 3; i < size; i += 4)
+            data[i] = 255;
+#endif
+        break;
+    }
+    default:
+        LBWARN << "Unknown external format " << externalFormat
+               << ", initializing to 0" << std::endl;
+        lunchbox::setZero(pixels, size);
+        break;
+    }
+}
+
 enum ActivePlugin
 {
     PLUGIN_FULL,
@@ -248,6 +296,8 @@ public:
         , depth(rhs.depth)
         , ignoreAlpha(rhs.ignoreAlpha)
         , hasPremultipliedAlpha(rhs.hasPremultipliedAlpha)
+        , tileMask(rhs.tileMask)
+        , coverage(rhs.coverage)
     {
     }
 
@@ -271,6 +321,12 @@ public:
 
     bool hasPremultipliedAlpha;
 
+    /** The stored tiles of sparse pixel data, empty for dense data. */
+    std::vector<uint8_t> tileMask;
+
+    /** The areas of sparse pixel data holding pixels of the packed images. */
+    PixelViewports coverage;
+
     Attachment& getAttachment(const eq::Frame::Buffer buffer)
     {
         switch (buffer)
@@ -308,19 +364,59 @@ public:
         return getAttachment(buffer).memory;
     }
 
-    EqCompressorInfos findTransferers(const eq::Frame::Buffer buffer,
-                                      const GLEWContext* gl) const
+    PluginCache::InfosPtr findTransferers(const eq::Frame::Buffer buffer,
+                                          const GLEWContext* gl) const
     {
         const Attachment& attachment = getAttachment(buffer);
         const Memory& memory = attachment.memory;
-        TransferFinder finder(memory.internalFormat, memory.externalFormat, 0,
-                              attachment.quality, ignoreAlpha, gl);
-        pression::PluginRegistry::getInstance().accept(finder);
-        return finder.result;
+        return PluginCache::findTransferers(memory.internalFormat,
+                                            memory.externalFormat, 0,
+                                            attachment.quality, ignoreAlpha,
+                                            gl);
     }
 };
 }
 
+namespace
+{
+/** Set up the format of an image buffer for the given pixel data. */
+void _setFormat(detail::Image& image, const Frame::Buffer buffer,
+                const PixelData& pixels)
+{
+    Memory& memory = image.getMemory(buffer);
+    memory.releaseShared();
+    memory.externalFormat = pixels.externalFormat;
+    memory.internalFormat = pixels.internalFormat;
+    memory.pixelSize = pixels.pixelSize;
+    memory.pvp = pixels.pvp;
+    memory.state = Memory::INVALID;
+    memory.compressedData = pression::CompressorResult();
+    memory.hasAlpha = false;
+
+    const detail::PluginCache::InfosPtr infos =
+        image.findTransferers(buffer, 0 /*GLEW context*/);
+    const EqCompressorInfos& transferrers = *infos;
+    if (transferrers.empty())
+        LBWARN << "No upload engines found for given pixel data" << std::endl;
+    else
+    {
+        memory.hasAlpha =
+            transferrers.front().capabilities & EQ_COMPRESSOR_IGNORE_ALPHA;
+#ifndef NDEBUG
+        for (EqCompressorInfosCIter i = transferrers.begin();
+             i != transferrers.end(); ++i)
+        {
+            LBASSERTINFO(memory.hasAlpha ==
+                             bool(i->capabilities & EQ_COMPRESSOR_IGNORE_ALPHA),
+                         "Uploaders don't agree on alpha state of external "
+                             << "format: " << transferrers.front()
+                             << " != " << *i);
+        }
+#endif
+    }
+}
+}
+
 Image::Image()
     : _impl(new detail::Image)
 {
@@ -349,6 +445,8 @@ void Image::reset()
 {
     _impl->ignoreAlpha = false;
     _impl->hasPremultipliedAlpha = false;
+    _impl->tileMask.clear();
+    _impl->coverage.clear();
     setPixelViewport(PixelViewport());
     setContext(RenderContext());
 }
@@ -422,6 +520,7 @@ void Image::_setExternalFormat(const Frame::Buffer buffer,
                                const uint32_t pixelSize, const bool hasAlpha_)
 {
     Memory& memory = _impl->getMemory(buffer);
+    memory.releaseShared();
     if (memory.externalFormat == externalFormat)
         return;
 
@@ -451,51 +550,18 @@ uint32_t Image::getInternalFormat(const Frame::Buffer buffer) const
     return memory.internalFormat;
 }
 
-namespace
-{
-class CompressorFinder : public pression::ConstPluginVisitor
-{
-public:
-    explicit CompressorFinder(const uint32_t token)
-        : token_(token)
-    {
-    }
-
-    virtual fabric::VisitorResult visit(const pression::Plugin&,
-                                        const EqCompressorInfo& info)
-    {
-        if (info.capabilities & EQ_COMPRESSOR_TRANSFER)
-            return fabric::TRAVERSE_CONTINUE;
-
-        if (info.tokenType == token_)
-            result.push_back(info.name);
-        return fabric::TRAVERSE_CONTINUE;
-    }
-
-    std::vector<uint32_t> result;
-
-private:
-    const uint32_t token_;
-};
-}
-
 std::vector<uint32_t> Image::findCompressors(const Frame::Buffer buffer) const
 {
-    CompressorFinder finder(getExternalFormat(buffer));
-    pression::PluginRegistry::getInstance().accept(finder);
-
-    LBLOG(LOG_PLUGIN) << "Found " << finder.result.size()
-                      << " compressors for token type 0x" << std::hex
-                      << getExternalFormat(buffer) << std::dec << std::endl;
-    return finder.result;
+    return *detail::PluginCache::findCompressors(getExternalFormat(buffer));
 }
 
 std::vector<uint32_t> Image::findTransferers(const Frame::Buffer buffer,
                                              const GLEWContext* gl) const
 {
     std::vector<uint32_t> result;
-    const EqCompressorInfos& infos = _impl->findTransferers(buffer, gl);
-    for (EqCompressorInfosCIter i = infos.begin(); i != infos.end(); ++i)
+    const detail::PluginCache::InfosPtr infos =
+        _impl->findTransferers(buffer, gl);
+    for (EqCompressorInfosCIter i = infos->begin(); i != infos->end(); ++i)
         result.push_back(i->name);
     return result;
 }
@@ -886,6 +952,8 @@ bool Image::_readbackZoom(const Frame::Buffer buffer, util::ObjectManager& om)
 void Image::setPixelViewport(const PixelViewport& pvp)
 {
     _impl->pvp = pvp;
+    _impl->color.memory.releaseShared();
+    _impl->depth.memory.releaseShared();
     _impl->color.memory.state = Memory::INVALID;
     _impl->depth.memory.state = Memory::INVALID;
     _impl->color.memory.compressedData = pression::CompressorResult();
@@ -901,34 +969,7 @@ void Image::clearPixelData(const Frame::Buffer buffer)
         return;
 
     validatePixelData(buffer);
-
-    switch (memory.externalFormat)
-    {
-    case EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT:
-        memset(memory.pixels, 0xFF, size);
-        break;
-
-    case EQ_COMPRESSOR_DATATYPE_RGBA:
-    case EQ_COMPRESSOR_DATATYPE_BGRA:
-    {
-        uint8_t* data = reinterpret_cast<uint8_t*>(memory.pixels);
-#ifdef Darwin
-        const unsigned char pixel[4] = {0, 0, 0, 255};
-        memset_pattern4(data, &pixel, size);
-#else
-        lunchbox::setZero(data, size);
-#pragma omp parallel for
-        for (ssize_t i = 3; i < size; i += 4)
-            data[i] = 255;
-#endif
-        break;
-    }
-    default:
-        LBWARN << "Unknown external format " << memory.externalFormat
-               << ", initializing to 0" << std::endl;
-        lunchbox::setZero(memory.pixels, size);
-        break;
-    }
+    _clearPixels(memory.pixels, size, memory.externalFormat);
 }
 
 void Image::validatePixelData(const Frame::Buffer buffer)
@@ -942,34 +983,7 @@ void Image::validatePixelData(const Frame::Buffer buffer)
 void Image::setPixelData(const Frame::Buffer buffer, const PixelData& pixels)
 {
     Memory& memory = _impl->getMemory(buffer);
-    memory.externalFormat = pixels.externalFormat;
-    memory.internalFormat = pixels.internalFormat;
-    memory.pixelSize = pixels.pixelSize;
-    memory.pvp = pixels.pvp;
-    memory.state = Memory::INVALID;
-    memory.compressedData = pression::CompressorResult();
-    memory.hasAlpha = false;
-
-    const EqCompressorInfos& transferrers =
-        _impl->findTransferers(buffer, 0 /*GLEW context*/);
-    if (transferrers.empty())
-        LBWARN << "No upload engines found for given pixel data" << std::endl;
-    else
-    {
-        memory.hasAlpha =
-            transferrers.front().capabilities & EQ_COMPRESSOR_IGNORE_ALPHA;
-#ifndef NDEBUG
-        for (EqCompressorInfosCIter i = transferrers.begin();
-             i != transferrers.end(); ++i)
-        {
-            LBASSERTINFO(memory.hasAlpha ==
-                             bool(i->capabilities & EQ_COMPRESSOR_IGNORE_ALPHA),
-                         "Uploaders don't agree on alpha state of external "
-                             << "format: " << transferrers.front()
-                             << " != " << *i);
-        }
-#endif
-    }
+    _setFormat(*_impl, buffer, pixels);
 
     const uint32_t size = getPixelDataSize(buffer);
     LBASSERT(size > 0);
@@ -1023,6 +1037,26 @@ void Image::setPixelData(const Frame::Buffer buffer, const PixelData& pixels)
                                         outDims, pixels.compressorFlags);
 }
 
+void Image::setPixelData(const Frame::Buffer buffer, const PixelData& pixels,
+                         co::ConstBufferPtr owner)
+{
+    // uint32_t pixels are accessed in place by the CPU compositor
+    const bool aligned = (reinterpret_cast<uintptr_t>(pixels.pixels) & 3) == 0;
+    if (!owner || !pixels.pixels || !aligned ||
+        pixels.compressedData.compressor > EQ_COMPRESSOR_NONE)
+    {
+        setPixelData(buffer, pixels);
+        return;
+    }
+
+    _setFormat(*_impl, buffer, pixels);
+
+    Memory& memory = _impl->getMemory(buffer);
+    memory.pixels = pixels.pixels;
+    memory.sharedBuffer = owner;
+    memory.state = Memory::VALID;
+}
+
 /** Find and activate a compression engine */
 bool Image::allocCompressor(const Frame::Buffer buffer, const uint32_t name)
 {
@@ -1219,118 +1253,81 @@ __attribute__((packed))
 #endif
 ;
 
-void put32f(std::ostream& os, const char* ptr)
+uint8_t get32f(const uint8_t* ptr)
 {
     // cppcheck-suppress invalidPointerCast
     const float& value = *reinterpret_cast<const float*>(ptr);
-    const uint8_t byte = uint8_t(value * 255.f);
-    os.write((const char*)&byte, 1);
+    return uint8_t(value * 255.f);
 }
-void put16f(std::ostream& os, const char* ptr)
+uint8_t get16f(const uint8_t* ptr)
 {
     const uint16_t& value = *reinterpret_cast<const uint16_t*>(ptr);
     const float f = half_to_float(value);
-    put32f(os, (const char*)&f);
-}
+    return get32f(reinterpret_cast<const uint8_t*>(&f));
 }
 
-bool Image::writeImage(const std::string& filename,
-                       const Frame::Buffer buffer) const
+/** The channel layout of an external pixel format. */
+struct ChannelFormat
 {
-    const Memory& memory = _impl->getMemory(buffer);
-
-    const PixelViewport& pvp = memory.pvp;
-    const size_t nPixels = pvp.w * pvp.h;
-
-    if (nPixels == 0 || memory.state != Memory::VALID)
-        return false;
-
-    const unsigned char* data =
-        reinterpret_cast<const unsigned char*>(getPixelPointer(buffer));
-
-    unsigned char* convertedData = nullptr;
-
-    // glReadPixels with alpha has ARGB premultiplied format: post-divide alpha
-    if (_impl->hasPremultipliedAlpha &&
-        getExternalFormat(buffer) == EQ_COMPRESSOR_DATATYPE_BGRA)
+    ChannelFormat()
+        : bytesPerChannel(0)
+        , nChannels(0)
+        , maxValue(255)
+        , swapRB(false)
+        , color(true)
     {
-        convertedData = new unsigned char[nPixels * 4];
-
-        const uint32_t* bgraData = reinterpret_cast<const uint32_t*>(data);
-        uint32_t* bgraConverted = reinterpret_cast<uint32_t*>(convertedData);
-        for (size_t i = 0; i < nPixels; ++i, ++bgraConverted, ++bgraData)
-        {
-            *bgraConverted = *bgraData;
-            uint32_t& pixel = *bgraConverted;
-            const uint32_t alpha = pixel >> 24;
-            if (alpha != 0)
-            {
-                const uint32_t red = (pixel >> 16) & 0xff;
-                const uint32_t green = (pixel >> 8) & 0xff;
-                const uint32_t blue = pixel & 0xff;
-                *bgraConverted =
-                    ((alpha << 24) | (((255 * red) / alpha) << 16) |
-                     (((255 * green) / alpha) << 8) | ((255 * blue) / alpha));
-            }
-        }
     }
 
-    const bool retVal =
-        _writeImage(filename, buffer, convertedData ? convertedData : data);
-    delete[] convertedData;
-    return retVal;
-}
+    uint8_t bytesPerChannel;
+    uint16_t nChannels;
+    unsigned maxValue;
+    bool swapRB; //!< RGB(A) instead of BGR(A) channel order
+    bool color;  //!< false for depth data
+};
 
-bool Image::_writeImage(const std::string& filename, const Frame::Buffer buffer,
-                        const unsigned char* data_) const
+bool _getChannelFormat(const uint32_t externalFormat, ChannelFormat& format)
 {
-    const Memory& memory = _impl->getMemory(buffer);
-    const PixelViewport& pvp = memory.pvp;
-    const size_t nPixels = pvp.w * pvp.h;
-
-    RGBHeader header;
-    header.width = pvp.w;
-    header.height = pvp.h;
-
-    switch (getExternalFormat(buffer))
+    switch (externalFormat)
     {
     case EQ_COMPRESSOR_DATATYPE_RGB10_A2:
-        header.maxValue = 1023;
+        format.maxValue = 1023;
     case EQ_COMPRESSOR_DATATYPE_BGRA:
     case EQ_COMPRESSOR_DATATYPE_BGRA_UINT_8_8_8_8_REV:
     case EQ_COMPRESSOR_DATATYPE_RGBA:
     case EQ_COMPRESSOR_DATATYPE_RGBA_UINT_8_8_8_8_REV:
-        header.bytesPerChannel = 1;
-        header.depth = 4;
+        format.bytesPerChannel = 1;
+        format.nChannels = 4;
         break;
     case EQ_COMPRESSOR_DATATYPE_BGR:
     case EQ_COMPRESSOR_DATATYPE_RGB:
-        header.bytesPerChannel = 1;
-        header.depth = 3;
+        format.bytesPerChannel = 1;
+        format.nChannels = 3;
         break;
     case EQ_COMPRESSOR_DATATYPE_BGRA32F:
     case EQ_COMPRESSOR_DATATYPE_RGBA32F:
-        header.bytesPerChannel = 4;
-        header.depth = 4;
+        format.bytesPerChannel = 4;
+        format.nChannels = 4;
         break;
     case EQ_COMPRESSOR_DATATYPE_BGR32F:
     case EQ_COMPRESSOR_DATATYPE_RGB32F:
-        header.bytesPerChannel = 4;
-        header.depth = 3;
+        format.bytesPerChannel = 4;
+        format.nChannels = 3;
         break;
     case EQ_COMPRESSOR_DATATYPE_BGRA16F:
     case EQ_COMPRESSOR_DATATYPE_RGBA16F:
-        header.bytesPerChannel = 2;
-        header.depth = 4;
+        format.bytesPerChannel = 2;
+        format.nChannels = 4;
         break;
     case EQ_COMPRESSOR_DATATYPE_BGR16F:
     case EQ_COMPRESSOR_DATATYPE_RGB16F:
-        header.bytesPerChannel = 2;
-        header.depth = 3;
+        format.bytesPerChannel = 2;
+        format.nChannels = 3;
         break;
     case EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT:
-        header.bytesPerChannel = 4;
-        header.depth = 1;
+        // written as four 8 bit channels
+        format.bytesPerChannel = 1;
+        format.nChannels = 4;
+        format.color = false;
         break;
 
     default:
@@ -1338,17 +1335,8 @@ bool Image::_writeImage(const std::string& filename, const Frame::Buffer buffer,
         return false;
     }
 
-    if (header.depth == 1) // depth
-    {
-        LBASSERT((header.bytesPerChannel % 4) == 0);
-        header.depth = 4;
-        header.bytesPerChannel /= 4;
-    }
-    LBASSERT(header.bytesPerChannel > 0);
-
     // Swap red & blue where needed
-    bool swapRB = false;
-    switch (getExternalFormat(buffer))
+    switch (externalFormat)
     {
     case EQ_COMPRESSOR_DATATYPE_RGB10_A2:
     case EQ_COMPRESSOR_DATATYPE_RGBA:
@@ -1358,144 +1346,280 @@ bool Image::_writeImage(const std::string& filename, const Frame::Buffer buffer,
     case EQ_COMPRESSOR_DATATYPE_RGB32F:
     case EQ_COMPRESSOR_DATATYPE_RGBA16F:
     case EQ_COMPRESSOR_DATATYPE_RGB16F:
-        swapRB = true;
+        format.swapRB = true;
     }
+    return true;
+}
 
-    const uint8_t bpc = header.bytesPerChannel;
-    const uint16_t nChannels = header.depth;
-    const size_t depth = nChannels * bpc;
+/** The file formats written by Image::writeImage(). */
+enum FileFormat
+{
+    FILE_RGB, //!< SGI rgb, 8 or more bits per channel
+    FILE_PPM, //!< binary portable pixmap, 8 bit RGB
+    FILE_RAW, //!< the unmodified pixel data
+    FILE_OSG  //!< any format of the OpenSceneGraph plugins
+};
 
-    const boost::filesystem::path path(filename);
+FileFormat _getFileFormat(const std::string& filename)
+{
+    const std::string extension =
+        boost::filesystem::path(filename).extension().string();
+    if (extension == ".ppm")
+        return FILE_PPM;
+    if (extension == ".raw")
+        return FILE_RAW;
 #ifdef EQUALIZER_USE_OPENSCENEGRAPH
-    if (path.extension() != ".rgb")
-    {
-        osg::ref_ptr<osg::Image> osgImage = new osg::Image();
-        osgImage->setImage(pvp.w, pvp.h, depth, getExternalFormat(buffer),
-                           swapRB ? GL_RGBA : GL_BGRA, GL_UNSIGNED_BYTE,
-                           const_cast<unsigned char*>(data_),
-                           osg::Image::NO_DELETE);
-        return osgDB::writeImageFile(*osgImage, filename);
-    }
+    if (extension != ".rgb")
+        return FILE_OSG;
 #endif
+    return FILE_RGB;
+}
 
-    std::ofstream image(filename.c_str(), std::ios::out | std::ios::binary);
-    if (!image.is_open())
+/** Append one channel of the interleaved pixels to the planar rgb data. */
+void _appendChannel(lunchbox::Bufferb& out, const uint8_t* data,
+                    const size_t nPixels, const size_t pixelSize,
+                    const size_t offset, const uint8_t bpc, const bool to8bit)
+{
+    const size_t start = out.getSize();
+    out.resize(start + nPixels * (to8bit ? 1 : bpc));
+    uint8_t* dst = out.getData() + start;
+    const uint8_t* src = data + offset;
+
+    if (to8bit)
     {
-        LBERROR << "Can't open " << filename << " for writing" << std::endl;
-        return false;
+        LBASSERTINFO(bpc == 2 || bpc == 4, bpc);
+        for (size_t i = 0; i < nPixels; ++i, src += pixelSize)
+            dst[i] = bpc == 2 ? get16f(src) : get32f(src);
     }
+    else if (bpc == 1)
+        for (size_t i = 0; i < nPixels; ++i, src += pixelSize)
+            dst[i] = *src;
+    else
+        for (size_t i = 0; i < nPixels; ++i, src += pixelSize, dst += bpc)
+            memcpy(dst, src, bpc);
+}
 
-    const size_t nBytes = nPixels * depth;
-    if (header.bytesPerChannel > 2)
-        LBWARN << static_cast<int>(header.bytesPerChannel)
-               << " bytes per channel not supported by RGB spec" << std::endl;
+void _encodeRGB(lunchbox::Bufferb& out, const uint8_t* data,
+                const PixelViewport& pvp, const ChannelFormat& format,
+                const std::string& name, const bool to8bit)
+{
+    const uint8_t bpc = format.bytesPerChannel;
+    const uint16_t nChannels = format.nChannels;
+    const size_t pixelSize = nChannels * bpc;
+    const size_t nPixels = pvp.w * pvp.h;
 
-    strncpy(header.filename, filename.c_str(), 80);
-    header.convert();
-    image.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    RGBHeader header;
+    header.width = pvp.w;
+    header.height = pvp.h;
+    header.depth = nChannels;
+    header.bytesPerChannel = to8bit ? 1 : bpc;
+    header.maxValue = to8bit ? 255 : format.maxValue;
+    strncpy(header.filename, name.c_str(), 80);
     header.convert();
 
-    const char* data = reinterpret_cast<const char*>(data_);
+    out.reserve(out.getSize() + sizeof(header) +
+                nPixels * nChannels * header.bytesPerChannel);
+    out.append(reinterpret_cast<const uint8_t*>(&header), sizeof(header));
 
     // Each channel is saved separately
     if (nChannels == 3 || nChannels == 4)
     {
-        // channel one is R or B
-        if (swapRB)
-            for (size_t j = 0 * bpc; j < nBytes; j += depth)
-                image.write(&data[j], bpc);
-        else
-            for (size_t j = 2 * bpc; j < nBytes; j += depth)
-                image.write(&data[j], bpc);
-
-        // channel two is G
-        for (size_t j = 1 * bpc; j < nBytes; j += depth)
-            image.write(&data[j], bpc);
-
-        // channel three is B or G
-        if (swapRB)
-            for (size_t j = 2 * bpc; j < nBytes; j += depth)
-                image.write(&data[j], bpc);
-        else
-            for (size_t j = 0; j < nBytes; j += depth)
-                image.write(&data[j], bpc);
-
-        // channel four is Alpha
+        // channel one is R or B, two is G, three is B or R, four is Alpha
+        const size_t red = format.swapRB ? 0 : 2;
+        const size_t blue = format.swapRB ? 2 : 0;
+        _appendChannel(out, data, nPixels, pixelSize, red * bpc, bpc, to8bit);
+        _appendChannel(out, data, nPixels, pixelSize, 1 * bpc, bpc, to8bit);
+        _appendChannel(out, data, nPixels, pixelSize, blue * bpc, bpc, to8bit);
         if (nChannels == 4)
-            for (size_t j = 3 * bpc; j < nBytes; j += depth)
-                image.write(&data[j], bpc);
+            _appendChannel(out, data, nPixels, pixelSize, 3 * bpc, bpc,
+                           to8bit);
     }
     else
     {
         for (size_t i = 0; i < nChannels; i += bpc)
-            for (size_t j = i * bpc; j < nBytes; j += depth)
-                image.write(&data[j], bpc);
+            _appendChannel(out, data, nPixels, pixelSize, i * bpc, bpc,
+                           to8bit);
     }
-    image.close();
+}
 
-    if (header.bytesPerChannel == 1)
-        return true;
-    // else also write 8bpp version
+bool _encodePPM(lunchbox::Bufferb& out, const uint8_t* data,
+                const PixelViewport& pvp, const ChannelFormat& format)
+{
+    if (!format.color || format.maxValue != 255)
+    {
+        LBERROR << "PPM images need 8 bit color data" << std::endl;
+        return false;
+    }
 
-    const std::string smallFilename = path.parent_path().string() + "/s_" +
-#if BOOST_FILESYSTEM_VERSION == 3
-                                      path.filename().string();
-#else
-                                      path.filename();
-#endif
-    image.open(smallFilename.c_str(), std::ios::out | std::ios::binary);
-    if (!image.is_open())
+    std::ostringstream os;
+    os << "P6\n" << pvp.w << " " << pvp.h << "\n255\n";
+    const std::string header = os.str();
+
+    const uint8_t bpc = format.bytesPerChannel;
+    const size_t pixelSize = format.nChannels * bpc;
+    const size_t red = (format.swapRB ? 0 : 2) * bpc;
+    const size_t blue = (format.swapRB ? 2 : 0) * bpc;
+    const size_t start = out.getSize() + header.size();
+    out.append(reinterpret_cast<const uint8_t*>(header.data()), header.size());
+    out.resize(start + pvp.w * pvp.h * 3);
+
+    // PPM rows are top to bottom, the pixel data bottom to top
+    uint8_t* dst = out.getData() + start;
+    for (int32_t y = pvp.h - 1; y >= 0; --y)
+    {
+        const uint8_t* src = data + size_t(y) * pvp.w * pixelSize;
+        for (int32_t x = 0; x < pvp.w; ++x, src += pixelSize, dst += 3)
+        {
+            switch (bpc)
+            {
+            case 1:
+                dst[0] = src[red];
+                dst[1] = src[1];
+                dst[2] = src[blue];
+                break;
+            case 2:
+                dst[0] = get16f(src + red);
+                dst[1] = get16f(src + 2);
+                dst[2] = get16f(src + blue);
+                break;
+            default:
+                dst[0] = get32f(src + red);
+                dst[1] = get32f(src + 4);
+                dst[2] = get32f(src + blue);
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+bool _writeFile(const std::string& filename, const lunchbox::Bufferb& data)
+{
+    std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary);
+    if (!file.is_open())
     {
-        LBERROR << "Can't open " << smallFilename << " for writing"
-                << std::endl;
+        LBERROR << "Can't open " << filename << " for writing" << std::endl;
         return false;
     }
+    file.write(reinterpret_cast<const char*>(data.getData()), data.getSize());
+    return file.good();
+}
+}
 
-    header.bytesPerChannel = 1;
-    header.maxValue = 255;
-    header.convert();
-    image.write(reinterpret_cast<const char*>(&header), sizeof(header));
-    header.convert();
+const uint8_t* Image::_getImageData(const Frame::Buffer buffer,
+                                    lunchbox::Bufferb& converted) const
+{
+    const Memory& memory = _impl->getMemory(buffer);
+    const size_t nPixels = memory.pvp.w * memory.pvp.h;
+    if (nPixels == 0 || memory.state != Memory::VALID)
+        return nullptr;
 
-    LBASSERTINFO(bpc == 2 || bpc == 4, bpc);
-    const bool twoBPC = bpc == 2;
+    const uint8_t* data = getPixelPointer(buffer);
 
-    if (nChannels == 3 || nChannels == 4)
+    // glReadPixels with alpha has ARGB premultiplied format: post-divide alpha
+    if (!_impl->hasPremultipliedAlpha ||
+        getExternalFormat(buffer) != EQ_COMPRESSOR_DATATYPE_BGRA)
     {
-        // channel one is R or B
-        if (swapRB)
-            for (size_t j = 0 * bpc; j < nBytes; j += depth)
-                twoBPC ? put16f(image, &data[j]) : put32f(image, &data[j]);
-        else
-            for (size_t j = 2 * bpc; j < nBytes; j += depth)
-                twoBPC ? put16f(image, &data[j]) : put32f(image, &data[j]);
+        return data;
+    }
 
-        // channel two is G
-        for (size_t j = 1 * bpc; j < nBytes; j += depth)
-            twoBPC ? put16f(image, &data[j]) : put32f(image, &data[j]);
+    converted.resize(nPixels * 4);
+    const uint32_t* bgraData = reinterpret_cast<const uint32_t*>(data);
+    uint32_t* bgraConverted = reinterpret_cast<uint32_t*>(converted.getData());
+    for (size_t i = 0; i < nPixels; ++i, ++bgraConverted, ++bgraData)
+    {
+        *bgraConverted = *bgraData;
+        uint32_t& pixel = *bgraConverted;
+        const uint32_t alpha = pixel >> 24;
+        if (alpha != 0)
+        {
+            const uint32_t red = (pixel >> 16) & 0xff;
+            const uint32_t green = (pixel >> 8) & 0xff;
+            const uint32_t blue = pixel & 0xff;
+            *bgraConverted =
+                ((alpha << 24) | (((255 * red) / alpha) << 16) |
+                 (((255 * green) / alpha) << 8) | ((255 * blue) / alpha));
+        }
+    }
+    return converted.getData();
+}
 
-        // channel three is B or G
-        if (swapRB)
-            for (size_t j = 2 * bpc; j < nBytes; j += depth)
-                twoBPC ? put16f(image, &data[j]) : put32f(image, &data[j]);
-        else
-            for (size_t j = 0; j < nBytes; j += depth)
-                twoBPC ? put16f(image, &data[j]) : put32f(image, &data[j]);
+bool Image::encodeImage(lunchbox::Bufferb& out, const std::string& filename,
+                        const Frame::Buffer buffer) const
+{
+    lunchbox::Bufferb converted;
+    const uint8_t* data = _getImageData(buffer, converted);
+    ChannelFormat format;
+    if (!data || !_getChannelFormat(getExternalFormat(buffer), format))
+        return false;
 
-        // channel four is Alpha
-        if (nChannels == 4)
-            for (size_t j = 3 * bpc; j < nBytes; j += depth)
-                twoBPC ? put16f(image, &data[j]) : put32f(image, &data[j]);
+    const PixelViewport& pvp = _impl->getMemory(buffer).pvp;
+    switch (_getFileFormat(filename))
+    {
+    case FILE_PPM:
+        return _encodePPM(out, data, pvp, format);
+
+    case FILE_RAW:
+        out.append(data, size_t(pvp.w) * pvp.h * getPixelSize(buffer));
+        return true;
+
+    case FILE_RGB:
+        _encodeRGB(out, data, pvp, format, filename, false);
+        return true;
+
+    default:
+        LBERROR << "Can't encode " << filename << " in memory" << std::endl;
+        return false;
     }
-    else
+}
+
+bool Image::writeImage(const std::string& filename,
+                       const Frame::Buffer buffer) const
+{
+    lunchbox::Bufferb converted;
+    const uint8_t* data = _getImageData(buffer, converted);
+    ChannelFormat format;
+    if (!data || !_getChannelFormat(getExternalFormat(buffer), format))
+        return false;
+
+    const PixelViewport& pvp = _impl->getMemory(buffer).pvp;
+    const FileFormat fileFormat = _getFileFormat(filename);
+#ifdef EQUALIZER_USE_OPENSCENEGRAPH
+    if (fileFormat == FILE_OSG)
     {
-        for (size_t i = 0; i < nChannels; i += bpc)
-            for (size_t j = i * bpc; j < nBytes; j += depth)
-                twoBPC ? put16f(image, &data[j]) : put32f(image, &data[j]);
+        const size_t depth = format.nChannels * format.bytesPerChannel;
+        osg::ref_ptr<osg::Image> osgImage = new osg::Image();
+        osgImage->setImage(pvp.w, pvp.h, depth, getExternalFormat(buffer),
+                           format.swapRB ? GL_RGBA : GL_BGRA, GL_UNSIGNED_BYTE,
+                           const_cast<uint8_t*>(data), osg::Image::NO_DELETE);
+        return osgDB::writeImageFile(*osgImage, filename);
     }
-    image.close();
+#endif
 
-    return true;
+    // Encode the whole image in memory and write it with one call
+    lunchbox::Bufferb image;
+    if (!encodeImage(image, filename, buffer) || !_writeFile(filename, image))
+        return false;
+
+    const uint8_t bpc = format.bytesPerChannel;
+    if (fileFormat != FILE_RGB || bpc == 1)
+        return true;
+    // else also write 8bpp version
+
+    if (bpc > 2)
+        LBWARN << static_cast<int>(bpc)
+               << " bytes per channel not supported by RGB spec" << std::endl;
+
+    const boost::filesystem::path path(filename);
+    const std::string smallFilename = path.parent_path().string() + "/s_" +
+#if BOOST_FILESYSTEM_VERSION == 3
+                                      path.filename().string();
+#else
+                                      path.filename();
+#endif
+    image.setSize(0);
+    _encodeRGB(image, data, pvp, format, filename, true);
+    return _writeFile(smallFilename, image);
 }
 
 bool Image::readImage(const std::string& filename, const Frame::Buffer buffer)
@@ -1788,11 +1912,219 @@ void Image::setOffset(int32_t x, int32_t y)
     _impl->pvp.y = y;
 }
 
+bool Image::packTiles(const Images& images)
+{
+    if (images.empty())
+        return false;
+
+    const Image* first = images.front();
+    PixelViewport pvp;
+    for (const Image* image : images)
+    {
+        if (image->getStorageType() != Frame::TYPE_MEMORY ||
+            image->isSparse() || image->hasAsyncReadback())
+        {
+            return false;
+        }
+        for (const Frame::Buffer buffer :
+             {Frame::Buffer::color, Frame::Buffer::depth})
+        {
+            if (image->hasPixelData(buffer) != first->hasPixelData(buffer))
+                return false;
+            if (!image->hasPixelData(buffer))
+                continue;
+
+            const PixelData& data = image->getPixelData(buffer);
+            const PixelData& firstData = first->getPixelData(buffer);
+            if (data.internalFormat != firstData.internalFormat ||
+                data.externalFormat != firstData.externalFormat ||
+                data.pixelSize != firstData.pixelSize ||
+                data.pvp.w != image->getPixelViewport().w ||
+                data.pvp.h != image->getPixelViewport().h)
+            {
+                return false;
+            }
+        }
+        pvp.merge(image->getPixelViewport());
+    }
+    if (!pvp.hasArea())
+        return false;
+
+    reset();
+    setPixelViewport(pvp);
+    setContext(first->getContext());
+    setZoom(first->getZoom());
+    setAlphaUsage(first->getAlphaUsage());
+
+    // mark and number all tiles touched by an image
+    const size_t nX = (pvp.w + TILE_SIZE - 1) / TILE_SIZE;
+    const size_t nY = (pvp.h + TILE_SIZE - 1) / TILE_SIZE;
+    std::vector<uint8_t>& mask = _impl->tileMask;
+    mask.resize((((nX * nY + 7) >> 3) + 7) & ~size_t(7), 0);
+
+    for (const Image* image : images)
+    {
+        const PixelViewport& imagePVP = image->getPixelViewport();
+        if (!imagePVP.hasArea())
+            continue;
+
+        _impl->coverage.push_back(imagePVP);
+        const size_t startX = (imagePVP.x - pvp.x) / TILE_SIZE;
+        const size_t startY = (imagePVP.y - pvp.y) / TILE_SIZE;
+        const size_t endX = (imagePVP.getXEnd() - pvp.x - 1) / TILE_SIZE;
+        const size_t endY = (imagePVP.getYEnd() - pvp.y - 1) / TILE_SIZE;
+        for (size_t y = startY; y <= endY; ++y)
+            for (size_t x = startX; x <= endX; ++x)
+            {
+                const size_t index = y * nX + x;
+                mask[index >> 3] |= uint8_t(1u << (index & 7));
+            }
+    }
+
+    std::vector<PixelViewport> tiles;
+    forEachTile([&tiles](const size_t, const PixelViewport& tilePVP) {
+        tiles.push_back(tilePVP);
+    });
+
+    const PixelViewport column(0, 0, TILE_SIZE,
+                               TILE_SIZE * int32_t(tiles.size()));
+    for (const Frame::Buffer buffer :
+         {Frame::Buffer::color, Frame::Buffer::depth})
+    {
+        if (!first->hasPixelData(buffer))
+            continue;
+
+        const PixelData& firstData = first->getPixelData(buffer);
+        Attachment& attachment = _impl->getAttachment(buffer);
+        Memory& memory = attachment.memory;
+        memory.internalFormat = firstData.internalFormat;
+        memory.externalFormat = firstData.externalFormat;
+        memory.pixelSize = firstData.pixelSize;
+        memory.hasAlpha = first->_impl->getMemory(buffer).hasAlpha;
+        memory.pvp = column;
+        attachment.quality = first->getQuality(buffer);
+        validatePixelData(buffer);
+
+        // uncovered pixels are transparent and at the far plane, compositing
+        // skips them using the coverage
+        const size_t pixelSize = memory.pixelSize;
+        uint8_t* out = reinterpret_cast<uint8_t*>(memory.pixels);
+        if (memory.externalFormat == EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT)
+            ::memset(out, 0xFF, getPixelDataSize(buffer));
+        else
+            lunchbox::setZero(out, getPixelDataSize(buffer));
+
+#pragma omp parallel for
+        for (ssize_t i = 0; i < ssize_t(tiles.size()); ++i)
+        {
+            const PixelViewport& tile = tiles[i];
+            uint8_t* tileData = out + i * TILE_SIZE * TILE_SIZE * pixelSize;
+
+            for (const Image* image : images)
+            {
+                PixelViewport area = image->getPixelViewport();
+                area.intersect(tile);
+                if (!area.hasArea())
+                    continue;
+
+                const PixelViewport& imagePVP = image->getPixelViewport();
+                const uint8_t* in = image->getPixelPointer(buffer);
+                for (int32_t y = area.y; y < area.getYEnd(); ++y)
+                    ::memcpy(tileData + ((y - tile.y) * TILE_SIZE +
+                                         area.x - tile.x) *
+                                            pixelSize,
+                             in + ((y - imagePVP.y) * imagePVP.w + area.x -
+                                   imagePVP.x) *
+                                      pixelSize,
+                             area.w * pixelSize);
+            }
+        }
+    }
+    return true;
+}
+
+void Image::unpackTiles(Image& image) const
+{
+    unpackTiles(image, getPixelViewport());
+}
+
+void Image::unpackTiles(Image& image, const PixelViewport& area) const
+{
+    LBASSERT(isSparse());
+    image.reset();
+    image.setPixelViewport(area);
+    image.setContext(getContext());
+    image.setZoom(getZoom());
+    image.setAlphaUsage(getAlphaUsage());
+
+    for (const Frame::Buffer buffer :
+         {Frame::Buffer::color, Frame::Buffer::depth})
+    {
+        if (!hasPixelData(buffer))
+            continue;
+
+        PixelData data;
+        const PixelData& tiles = getPixelData(buffer);
+        data.internalFormat = tiles.internalFormat;
+        data.externalFormat = tiles.externalFormat;
+        data.pixelSize = tiles.pixelSize;
+        data.pvp = area;
+        image.setPixelData(buffer, data); // clears
+        image.setQuality(buffer, getQuality(buffer));
+
+        const size_t pixelSize = data.pixelSize;
+        const uint8_t* in = getPixelPointer(buffer);
+        uint8_t* out = image.getPixelPointer(buffer);
+        forEachTile([&](const size_t tile, const PixelViewport& tilePVP) {
+            PixelViewport copy = tilePVP;
+            copy.intersect(area);
+            if (!copy.hasArea())
+                return;
+
+            const uint8_t* tileData =
+                in + tile * TILE_SIZE * TILE_SIZE * pixelSize;
+            for (int32_t y = copy.y; y < copy.getYEnd(); ++y)
+                ::memcpy(out + ((y - area.y) * area.w + copy.x - area.x) *
+                                   pixelSize,
+                         tileData + ((y - tilePVP.y) * TILE_SIZE + copy.x -
+                                     tilePVP.x) *
+                                        pixelSize,
+                         copy.w * pixelSize);
+        });
+    }
+}
+
+bool Image::isSparse() const
+{
+    return !_impl->tileMask.empty();
+}
+
+const std::vector<uint8_t>& Image::getTileMask() const
+{
+    return _impl->tileMask;
+}
+
+void Image::setTileMask(const uint8_t* mask, const size_t size)
+{
+    _impl->tileMask.assign(mask, mask + size);
+}
+
+const PixelViewports& Image::getCoverage() const
+{
+    return _impl->coverage;
+}
+
+void Image::setCoverage(const PixelViewports& coverage)
+{
+    _impl->coverage = coverage;
+}
+
 co::DataOStream& operator<<(co::DataOStream& os, const Image& image)
 {
     os << image._impl->color << image._impl->context << image._impl->depth
        << image._impl->hasPremultipliedAlpha << image._impl->ignoreAlpha
-       << image._impl->pvp << image._impl->type << image._impl->zoom;
+       << image._impl->pvp << image._impl->type << image._impl->zoom
+       << image._impl->tileMask << image._impl->coverage;
     return os;
 }
 
@@ -1800,7 +2132,8 @@ co::DataIStream& operator>>(co::DataIStream& is, Image& image)
 {
     is >> image._impl->color >> image._impl->context >> image._impl->depth >>
         image._impl->hasPremultipliedAlpha >> image._impl->ignoreAlpha >>
-        image._impl->pvp >> image._impl->type >> image._impl->zoom;
+        image._impl->pvp >> image._impl->type >> image._impl->zoom >>
+        image._impl->tileMask >> image._impl->coverage;
     return is;
 }
 }
@@ -24,6 +24,8 @@
 #include <eq/frame.h> // for Frame::Buffer enum
 #include <eq/types.h>
 
+#include <algorithm> // std::min in forEachTile
+
 namespace eq
 {
 namespace detail
@@ -248,6 +250,16 @@ public:
      */
     EQ_API void setPixelData(const Frame::Buffer buffer, const PixelData& data);
 
+    /**
+     * @internal
+     * Set the pixel data of the given image buffer from a received command.
+     *
+     * Uncompressed, aligned pixels are referenced instead of copied, and the
+     * command buffer is held until the pixel data is invalidated.
+     */
+    void setPixelData(const Frame::Buffer buffer, const PixelData& data,
+                      co::ConstBufferPtr owner);
+
     /**
      * Set alpha data preservation during download and compression.
      * @version 1.0
@@ -341,11 +353,30 @@ public:
      * Since version 1.9 (if build with OpenSceneGraph) this function can
      * write images according to supported plugins, see
      * http://trac.openscenegraph.org/projects/osg/wiki/Support/UserGuides/Plugins
+     *
+     * Since version 2.1 files with a .ppm extension are written as binary 8 bit
+     * portable pixmaps, and files with a .raw extension contain the unmodified
+     * pixel data, bottom row first.
      * @version 1.0
      */
     EQ_API bool writeImage(const std::string& filename,
                            const Frame::Buffer buffer) const;
 
+    /**
+     * Encode the pixel data into memory.
+     *
+     * The file format is chosen from the extension of the given file name as
+     * in writeImage(), OpenSceneGraph formats are not supported.
+     *
+     * @param out the buffer to append the encoded image to.
+     * @param filename the name determining the file format.
+     * @param buffer the image buffer to encode.
+     * @return true on success, false on error.
+     * @version 2.1
+     */
+    EQ_API bool encodeImage(lunchbox::Bufferb& out, const std::string& filename,
+                            const Frame::Buffer buffer) const;
+
     /** Write all valid pixel data as separate images. @version 1.0 */
     EQ_API bool writeImages(const std::string& filenameTemplate) const;
 
@@ -357,6 +388,84 @@ public:
     void setOffset(int32_t x, int32_t y);
     //@}
 
+    /** @name Sparse Tiles */
+    //@{
+    /** The edge length of the tiles of a sparse image. @version 2.1 */
+    static const int32_t TILE_SIZE = 64;
+
+    /**
+     * Pack the pixel data of the given images into tiles of this image.
+     *
+     * The pixel viewport of this image becomes the union of the image
+     * viewports. It is divided into tiles of TILE_SIZE, and only the tiles
+     * intersecting at least one image are stored, stacked into a column of
+     * pixel data. Pixels of stored tiles not covered by any image are
+     * transparent and at the far plane, and the viewports of the images are
+     * recorded as the coverage. Images with many small regions are thus
+     * represented and transmitted as one image.
+     *
+     * @param images the non-overlapping memory images to pack.
+     * @return false if the images have different buffers or formats.
+     * @version 2.1
+     */
+    EQ_API bool packTiles(const Images& images);
+
+    /**
+     * Expand the tiles of a sparse image into the given image.
+     *
+     * Missing tiles are initialized as in clearPixelData().
+     * @version 2.1
+     */
+    EQ_API void unpackTiles(Image& image) const;
+
+    /**
+     * Expand the given area of a sparse image into the given image.
+     *
+     * Used with the areas of getCoverage() to obtain dense images holding only
+     * pixels of the packed images.
+     * @version 2.1
+     */
+    EQ_API void unpackTiles(Image& image, const PixelViewport& area) const;
+
+    /**
+     * @return true if the pixel data contains only the tiles of the tile
+     *         mask, false if it covers the full pixel viewport.
+     * @version 2.1
+     */
+    EQ_API bool isSparse() const;
+
+    /**
+     * @return the bitmap of stored tiles of a sparse image, row-major with one
+     *         bit per tile, padded to 8 bytes.
+     * @version 2.1
+     */
+    EQ_API const std::vector<uint8_t>& getTileMask() const;
+
+    /** @internal Set the tile mask of received sparse pixel data. */
+    EQ_API void setTileMask(const uint8_t* mask, size_t size);
+
+    /**
+     * @return the non-overlapping areas of a sparse image holding pixels of
+     *         the packed images. Only these are composited.
+     * @version 2.1
+     */
+    EQ_API const PixelViewports& getCoverage() const;
+
+    /** @internal Set the coverage of received sparse pixel data. */
+    EQ_API void setCoverage(const PixelViewports& coverage);
+
+    /**
+     * Call func(tile, pvp) for each stored tile of a sparse image.
+     *
+     * The pvp is the area of the tile within the image pixel viewport, and
+     * tile the index in the column of pixel data. The tile pixels start at
+     * tile * TILE_SIZE * TILE_SIZE, with a row length of TILE_SIZE pixels.
+     * @version 2.1
+     */
+    template <class F>
+    void forEachTile(const F& func) const;
+    //@}
+
     /** @name Internal */
     //@{
     /**
@@ -422,10 +531,31 @@ private:
 
     void _finishReadback(const Frame::Buffer buffer, const GLEWContext*);
     bool _readbackZoom(const Frame::Buffer buffer, util::ObjectManager& om);
-    bool _writeImage(const std::string& filename, const Frame::Buffer buffer,
-                     const unsigned char* data) const;
+    const uint8_t* _getImageData(const Frame::Buffer buffer,
+                                 lunchbox::Bufferb& converted) const;
 };
 
+template <class F>
+void Image::forEachTile(const F& func) const
+{
+    const PixelViewport& pvp = getPixelViewport();
+    const std::vector<uint8_t>& mask = getTileMask();
+    size_t index = 0;
+    size_t tile = 0;
+    for (int32_t y = 0; y < pvp.h; y += TILE_SIZE)
+    {
+        for (int32_t x = 0; x < pvp.w; x += TILE_SIZE, ++index)
+        {
+            if (!(mask[index >> 3] & (1u << (index & 7))))
+                continue;
+
+            func(tile++, PixelViewport(pvp.x + x, pvp.y + y,
+                                       std::min(TILE_SIZE, pvp.w - x),
+                                       std::min(TILE_SIZE, pvp.h - y)));
+        }
+    }
+}
+
 /** eq::Image serializer. @version 2.1 */
 EQ_API co::DataOStream& operator<<(co::DataOStream& os, const Image&);
 
@@ -0,0 +1,284 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "imageWriter.h"
+
+#include "image.h"
+
+#include <lunchbox/buffer.h>
+#include <lunchbox/lock.h>
+#include <lunchbox/log.h>
+#include <lunchbox/monitor.h>
+#include <lunchbox/mtQueue.h>
+#include <lunchbox/scopedMutex.h>
+#include <lunchbox/thread.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <thread>
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+namespace eq
+{
+namespace detail
+{
+namespace
+{
+const size_t maxThreads = 8;
+
+/** @return true for the names of the standard output and command pipes. */
+bool _isStream(const std::string& name)
+{
+    return name == "-" || (!name.empty() && name[0] == '|');
+}
+
+/** An output stream receiving the encoded images in order. */
+struct Stream
+{
+    Stream(FILE* file_, const bool pipe_)
+        : file(file_)
+        , pipe(pipe_)
+        , queued(0)
+        , written(0)
+    {
+    }
+
+    FILE* const file;
+    const bool pipe;
+    uint64_t queued;                     //!< The number of queued images
+    lunchbox::Monitor<uint64_t> written; //!< The number of written images
+};
+
+/** One queued image write. */
+struct Job
+{
+    Job(const Image& image_, const Frame::Buffer buffer_,
+        const std::string& filename_)
+        : image(image_)
+        , buffer(buffer_)
+        , filename(filename_)
+        , stream(nullptr)
+        , sequence(0)
+    {
+    }
+
+    const Image image; //!< A copy of the pixel data
+    const Frame::Buffer buffer;
+    const std::string filename;
+    Stream* stream;
+    uint64_t sequence; //!< The position in the stream
+};
+
+class Worker;
+}
+
+class ImageWriter
+{
+public:
+    ImageWriter(const size_t nThreads_, const size_t maxQueued)
+        : nThreads(nThreads_)
+        , queue(maxQueued)
+        , pending(0)
+        , streamFormat(".ppm")
+    {
+        if (nThreads == 0)
+        {
+            const size_t nCores = std::thread::hardware_concurrency();
+            nThreads = std::max(size_t(1), std::min(nCores, maxThreads));
+        }
+    }
+
+    ~ImageWriter();
+
+    void start();
+    void process(Job& job);
+    Stream* getStream(const std::string& name);
+
+    size_t nThreads;
+    lunchbox::MTQueue<Job*> queue;
+    lunchbox::Monitor<size_t> pending;
+    std::vector<Worker*> workers;
+    std::map<std::string, Stream*> streams;
+    std::string streamFormat;
+    lunchbox::Lock lock; //!< serializes write() from concurrent channels
+};
+
+namespace
+{
+class Worker : public lunchbox::Thread
+{
+public:
+    explicit Worker(ImageWriter& writer)
+        : _writer(writer)
+    {
+    }
+
+protected:
+    bool init() override
+    {
+        setName("ImgWrite");
+        return true;
+    }
+
+    void run() override
+    {
+        while (Job* job = _writer.queue.pop())
+        {
+            _writer.process(*job);
+            delete job;
+            --_writer.pending;
+        }
+    }
+
+private:
+    ImageWriter& _writer;
+};
+}
+
+ImageWriter::~ImageWriter()
+{
+    pending.waitEQ(0);
+    for (size_t i = 0; i < workers.size(); ++i)
+        queue.push(nullptr);
+    for (Worker* worker : workers)
+    {
+        worker->join();
+        delete worker;
+    }
+
+    for (const auto& i : streams)
+    {
+        Stream* stream = i.second;
+        if (stream->pipe)
+            pclose(stream->file);
+        else
+            fflush(stream->file);
+        delete stream;
+    }
+}
+
+void ImageWriter::start()
+{
+    if (!workers.empty())
+        return;
+
+    LBVERB << "Start " << nThreads << " image writer threads" << std::endl;
+    for (size_t i = 0; i < nThreads; ++i)
+    {
+        workers.push_back(new Worker(*this));
+        workers.back()->start();
+    }
+}
+
+Stream* ImageWriter::getStream(const std::string& name)
+{
+    std::map<std::string, Stream*>::iterator i = streams.find(name);
+    if (i != streams.end())
+        return i->second;
+
+    Stream* stream = nullptr;
+    if (name == "-")
+        stream = new Stream(stdout, false);
+    else
+    {
+        FILE* file = popen(name.substr(1).c_str(), "w");
+        if (file)
+            stream = new Stream(file, true);
+        else
+            LBWARN << "Can't start " << name.substr(1) << ": "
+                   << lunchbox::sysError() << std::endl;
+    }
+    streams[name] = stream;
+    return stream;
+}
+
+void ImageWriter::process(Job& job)
+{
+    if (!job.stream)
+    {
+        if (!job.image.writeImage(job.filename, job.buffer))
+            LBWARN << "Could not write file " << job.filename << std::endl;
+        return;
+    }
+
+    // Encode in parallel, but write the images in queue order
+    lunchbox::Bufferb data;
+    const bool encoded = job.image.encodeImage(data, streamFormat, job.buffer);
+
+    Stream& stream = *job.stream;
+    stream.written.waitEQ(job.sequence);
+    if (encoded &&
+        fwrite(data.getData(), 1, data.getSize(), stream.file) !=
+            data.getSize())
+    {
+        LBWARN << "Could not write image to " << job.filename << ": "
+               << lunchbox::sysError() << std::endl;
+    }
+    fflush(stream.file);
+    ++stream.written;
+}
+}
+
+ImageWriter::ImageWriter(const size_t nThreads, const size_t maxQueued)
+    : _impl(new detail::ImageWriter(nThreads, maxQueued))
+{
+}
+
+ImageWriter::~ImageWriter()
+{
+    delete _impl;
+}
+
+void ImageWriter::setStreamFormat(const std::string& extension)
+{
+    _impl->streamFormat = extension;
+}
+
+void ImageWriter::write(const Image& image, const Frame::Buffer buffer,
+                        const std::string& filename)
+{
+    detail::Job* job = new detail::Job(image, buffer, filename);
+
+    // Queue in stream order, so that the workers never wait for a stream
+    // position which is not queued yet
+    lunchbox::ScopedWrite mutex(_impl->lock);
+    if (detail::_isStream(filename))
+    {
+        job->stream = _impl->getStream(filename);
+        if (!job->stream)
+        {
+            delete job;
+            return;
+        }
+        job->sequence = job->stream->queued++;
+    }
+
+    _impl->start();
+    ++_impl->pending;
+    _impl->queue.push(job);
+}
+
+void ImageWriter::finish()
+{
+    _impl->pending.waitEQ(0);
+}
+}
@@ -0,0 +1,102 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_IMAGEWRITER_H
+#define EQ_IMAGEWRITER_H
+
+#include <eq/api.h>
+#include <eq/frame.h> // for Frame::Buffer enum
+#include <eq/types.h>
+
+namespace eq
+{
+namespace detail
+{
+class ImageWriter;
+}
+
+/**
+ * Writes images asynchronously using a pool of encoder threads.
+ *
+ * Images are copied when queued, so that the caller may reuse them right away.
+ * Image files are written using Image::writeImage(), possibly out of order.
+ * One writer may be shared by many threads, e.g., by all channels of a node.
+ *
+ * A file name of "-" streams the images to the standard output, and a file
+ * name starting with '|' streams them to the standard input of the given
+ * command, e.g., "|ffmpeg -f image2pipe -i - movie.mp4". Each stream is opened
+ * once per writer. Streamed images are written whole and in the order they
+ * were queued, in the stream format.
+ *
+ * @sa Channel::SATTR_DUMP_IMAGE
+ * @version 2.1
+ */
+class ImageWriter
+{
+public:
+    /**
+     * Construct a new image writer.
+     *
+     * The threads are started on the first write.
+     *
+     * @param nThreads the number of encoder threads, 0 for one per core.
+     * @param maxQueued the number of pending images at which write() blocks.
+     * @version 2.1
+     */
+    EQ_API explicit ImageWriter(size_t nThreads = 0, size_t maxQueued = 8);
+
+    /** Finish all writes and destruct the image writer. @version 2.1 */
+    EQ_API ~ImageWriter();
+
+    /**
+     * Set the format of streamed images.
+     *
+     * The format is given as a file extension supported by
+     * Image::encodeImage(), ".ppm" by default. The ".raw" format is the
+     * fastest, but needs the image size and pixel format on the receiving
+     * side.
+     *
+     * @param extension the file extension of the stream format.
+     * @version 2.1
+     */
+    EQ_API void setStreamFormat(const std::string& extension);
+
+    /**
+     * Queue a copy of an image buffer for writing.
+     *
+     * Blocks while the maximum number of images is pending. Thread safe.
+     *
+     * @param image the image to write.
+     * @param buffer the image buffer to write.
+     * @param filename the name of the file or stream.
+     * @version 2.1
+     */
+    EQ_API void write(const Image& image, Frame::Buffer buffer,
+                      const std::string& filename);
+
+    /** Wait until all queued images are written. @version 2.1 */
+    EQ_API void finish();
+
+private:
+    ImageWriter(const ImageWriter&) = delete;
+    ImageWriter& operator=(const ImageWriter&) = delete;
+
+    detail::ImageWriter* const _impl;
+};
+}
+
+#endif // EQ_IMAGEWRITER_H
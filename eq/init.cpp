@@ -26,6 +26,8 @@
 
 #include "client.h"
 #include "config.h"
+#include "cpu/windowSystem.h"
+#include "detail/pluginCache.h"
 #include "global.h"
 #include "nodeFactory.h"
 #include "os.h"
@@ -130,6 +132,8 @@ bool _init(const int argc, char** argv, NodeFactory* nodeFactory)
     if (QApplication::instance())
         WindowSystem::add(WindowSystemImpl(new qt::WindowSystem));
 #endif
+    // headless fallback, always available
+    WindowSystem::add(WindowSystemImpl(new cpu::WindowSystem));
 
     LBASSERT(nodeFactory);
     Global::_nodeFactory = nodeFactory;
@@ -143,6 +147,7 @@ bool _init(const int argc, char** argv, NodeFactory* nodeFactory)
         Global::setWorkDir(lunchbox::getWorkDir());
 
     _initPlugins();
+    detail::PluginCache::invalidate();
     return fabric::init(argc, argv);
 }
 
@@ -157,6 +162,7 @@ bool exit()
         return true;
 
     WindowSystem::clear();
+    detail::PluginCache::invalidate();
     Global::_nodeFactory = 0;
     return fabric::exit();
 }
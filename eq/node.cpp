@@ -21,10 +21,12 @@
 
 #include "client.h"
 #include "config.h"
+#include "detail/deltaCoder.h"
 #include "error.h"
 #include "exception.h"
 #include "frameData.h"
 #include "global.h"
+#include "imageWriter.h"
 #include "log.h"
 #include "nodeFactory.h"
 #include "nodeStatistics.h"
@@ -42,8 +44,14 @@
 #include <co/connection.h>
 #include <co/global.h>
 #include <co/objectICommand.h>
+#include <co/objectOCommand.h>
 #include <lunchbox/scopedMutex.h>
 
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <tuple>
+
 namespace eq
 {
 namespace
@@ -53,6 +61,10 @@ typedef std::unordered_map<uint128_t, FrameDataPtr> FrameDataHash;
 typedef FrameDataHash::const_iterator FrameDataHashCIter;
 typedef FrameDataHash::iterator FrameDataHashIter;
 
+// frame data, image index, receiving node, attachment
+typedef std::tuple<uint128_t, uint64_t, uint128_t, unsigned> DeltaKey;
+typedef std::map<DeltaKey, std::shared_ptr<detail::DeltaCoder>> DeltaCoders;
+
 enum State
 {
     STATE_STOPPED,
@@ -114,7 +126,13 @@ public:
     /** All frame datas used by the node during rendering. */
     lunchbox::Lockable<FrameDataHash> frameDatas;
 
+    /** Temporal delta encoders of transmitted output images. */
+    lunchbox::Lockable<DeltaCoders> deltaEncoders;
+
     TransmitThread transmitter;
+
+    /** Asynchronous image output, shared by all channels of the node. */
+    ImageWriter imageWriter;
 };
 }
 
@@ -165,6 +183,8 @@ void Node::attach(const uint128_t& id, const uint32_t instanceID)
                     NodeFunc(this, &Node::_cmdFrameDataTransmit), commandQ);
     registerCommand(fabric::CMD_NODE_FRAMEDATA_READY,
                     NodeFunc(this, &Node::_cmdFrameDataReady), commandQ);
+    registerCommand(fabric::CMD_NODE_FRAMEDATA_RESYNC,
+                    NodeFunc(this, &Node::_cmdFrameDataResync), commandQ);
 }
 
 void Node::setDirty(const uint64_t bits)
@@ -203,6 +223,11 @@ co::CommandQueue* Node::getTransmitterQueue()
     return &_impl->transmitter.getQueue();
 }
 
+ImageWriter& Node::getImageWriter()
+{
+    return _impl->imageWriter;
+}
+
 uint32_t Node::getCurrentFrame() const
 {
     return _impl->currentFrame.get();
@@ -264,6 +289,28 @@ void Node::releaseFrameData(FrameDataPtr data)
         return;
 
     _impl->frameDatas->erase(i);
+
+    lunchbox::ScopedWrite mutex2(_impl->deltaEncoders);
+    for (auto j = _impl->deltaEncoders->begin();
+         j != _impl->deltaEncoders->end();)
+    {
+        if (std::get<0>(j->first) == data->getID())
+            j = _impl->deltaEncoders->erase(j);
+        else
+            ++j;
+    }
+}
+
+std::shared_ptr<detail::DeltaCoder> Node::getDeltaEncoder(
+    const uint128_t& frameDataID, const uint64_t imageIndex,
+    const uint128_t& receiverID, const unsigned attachment)
+{
+    lunchbox::ScopedWrite mutex(_impl->deltaEncoders);
+    std::shared_ptr<detail::DeltaCoder>& coder = _impl->deltaEncoders.data[
+        DeltaKey(frameDataID, imageIndex, receiverID, attachment)];
+    if (!coder)
+        coder = std::make_shared<detail::DeltaCoder>();
+    return coder;
 }
 
 void Node::waitInitialized() const
@@ -374,10 +421,15 @@ void Node::releaseFrame(const uint32_t frameNumber)
         return;
     _impl->finishedFrame = frameNumber;
 
+    // the least idle pipe drives the adaptive latency on the server
+    float idle = 1.f;
+    for (const Pipe* pipe : getPipes())
+        idle = std::min(idle, pipe->getIdleRatio());
+
     Config* config = getConfig();
     ServerPtr server = config->getServer();
     co::NodePtr node = server.get();
-    send(node, fabric::CMD_NODE_FRAME_FINISH_REPLY) << frameNumber;
+    send(node, fabric::CMD_NODE_FRAME_FINISH_REPLY) << frameNumber << idle;
 }
 
 void Node::releaseFrameLocal(const uint32_t frameNumber)
@@ -633,6 +685,7 @@ bool Node::_cmdConfigExit(co::ICommand& cmd)
         Pipe* pipe = *i;
         pipe->waitExited();
     }
+    _impl->imageWriter.finish();
 
     _impl->state = configExit() ? STATE_STOPPED : STATE_FAILED;
     getTransmitterQueue()->push(co::ICommand()); // wake up to exit
@@ -735,6 +788,11 @@ bool Node::_cmdFrameDataTransmit(co::ICommand& cmd)
     const Frame::Buffer buffers = command.read<Frame::Buffer>();
     const uint32_t frameNumber = command.read<uint32_t>();
     const bool useAlpha = command.read<bool>();
+    const uint128_t& sourceID = command.read<uint128_t>();
+    const uint64_t imageIndex = command.read<uint64_t>();
+    const bool temporal = command.read<bool>();
+    const std::vector<uint8_t>& tileMask = command.read<std::vector<uint8_t>>();
+    const PixelViewports& coverage = command.read<PixelViewports>();
     const uint8_t* data = reinterpret_cast<const uint8_t*>(
         command.getRemainingBuffer(command.getRemainingBufferSize()));
 
@@ -752,8 +810,39 @@ bool Node::_cmdFrameDataTransmit(co::ICommand& cmd)
     // Note on the const_cast: since the PixelData structure stores non-const
     // pointers, we have to go non-const at some point, even though we do not
     // modify the data.
-    LBCHECK(frameData->addImage(frameDataVersion, pvp, zoom, context, buffers,
-                                useAlpha, const_cast<uint8_t*>(data)));
+    bool resync = false;
+    if (frameData->addImage(frameDataVersion, pvp, zoom, context, buffers,
+                            useAlpha, imageIndex, temporal, tileMask,
+                            coverage, command.getBuffer(),
+                            const_cast<uint8_t*>(data), resync))
+    {
+        return true;
+    }
+    LBASSERT(resync);
+    if (!resync)
+        return true;
+
+    // lost the temporal delta reference, request a keyframe from the source
+    co::NodePtr source = command.getRemoteNode();
+    co::ObjectOCommand(co::Connections(1, source->getConnection()),
+                       fabric::CMD_NODE_FRAMEDATA_RESYNC,
+                       co::COMMANDTYPE_OBJECT, sourceID, CO_INSTANCE_ALL)
+        << frameDataVersion.identifier << imageIndex << getID();
+    return true;
+}
+
+bool Node::_cmdFrameDataResync(co::ICommand& cmd)
+{
+    co::ObjectICommand command(cmd);
+    const uint128_t& frameDataID = command.read<uint128_t>();
+    const uint64_t imageIndex = command.read<uint64_t>();
+    const uint128_t& receiverID = command.read<uint128_t>();
+
+    LBLOG(LOG_ASSEMBLY) << "keyframe requested for image " << imageIndex
+                        << " of " << frameDataID << std::endl;
+    for (unsigned i = 0; i < 2; ++i)
+        getDeltaEncoder(frameDataID, imageIndex, receiverID, i)
+            ->requestKeyframe();
     return true;
 }
 
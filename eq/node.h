@@ -27,10 +27,13 @@
 
 #include <co/types.h>
 
+#include <memory>
+
 namespace eq
 {
 namespace detail
 {
+class DeltaCoder;
 class Node;
 }
 
@@ -67,6 +70,7 @@ public:
     EQ_API co::CommandQueue* getMainThreadQueue();    //!< @internal
     EQ_API co::CommandQueue* getCommandThreadQueue(); //!< @internal
     co::CommandQueue* getTransmitterQueue();          //!< @internal
+    ImageWriter& getImageWriter();                    //!< @internal
 
     /** @internal node thread only. */
     uint32_t getCurrentFrame() const;
@@ -92,6 +96,21 @@ public:
     /** @internal Release the frame data instance. */
     void releaseFrameData(FrameDataPtr data);
 
+    /**
+     * @internal
+     * Get the temporal delta encoder of a transmitted image buffer.
+     *
+     * @param frameDataID the identifier of the output frame data.
+     * @param imageIndex the index of the image in the frame data.
+     * @param receiverID the identifier of the receiving node.
+     * @param attachment 0 for color, 1 for depth.
+     * @return the encoder, created on first use. Stays valid while in use
+     *         after the frame data has been released.
+     */
+    std::shared_ptr<detail::DeltaCoder> getDeltaEncoder(
+        const uint128_t& frameDataID, uint64_t imageIndex,
+        const uint128_t& receiverID, unsigned attachment);
+
     /** @internal Wait for the node to be initialized. */
     EQ_API void waitInitialized() const;
 
@@ -287,6 +306,7 @@ private:
     bool _cmdFrameTasksFinish(co::ICommand& command);
     bool _cmdFrameDataTransmit(co::ICommand& command);
     bool _cmdFrameDataReady(co::ICommand& command);
+    bool _cmdFrameDataResync(co::ICommand& command);
     bool _cmdSetAffinity(co::ICommand& command);
 
     LB_TS_VAR(_nodeThread);
@@ -27,6 +27,7 @@
 
 #include "channel.h"
 #include "client.h"
+#include "commandQueue.h"
 #include "config.h"
 #include "exception.h"
 #include "frame.h"
@@ -48,6 +49,7 @@
 #include <eq/fabric/leafVisitor.h>
 #include <eq/fabric/task.h>
 
+#include <atomic>
 #include <boost/lexical_cast.hpp>
 #include <co/global.h>
 #include <co/objectICommand.h>
@@ -122,11 +124,11 @@ private:
 };
 
 /** Asynchronous, per-pipe readback thread. */
-class TransferThread : public co::Worker
+class TransferThread : public eq::Worker
 {
 public:
     explicit TransferThread(const uint32_t index)
-        : co::Worker(co::Global::getCommandQueueLimit())
+        : eq::Worker(co::Global::getCommandQueueLimit())
         , _index(index)
         , _qThread(nullptr)
         , _stop(false)
@@ -135,7 +137,7 @@ public:
 
     bool init() override
     {
-        if (!co::Worker::init())
+        if (!eq::Worker::init())
             return false;
         setName(std::string("Tfer") + boost::lexical_cast<std::string>(_index));
 #ifdef EQ_QT_USED
@@ -170,6 +172,7 @@ public:
         , state(STATE_STOPPED)
         , currentFrame(0)
         , frameTime(0)
+        , idle(1.f)
         , thread(0)
         , transferThread(index)
     {
@@ -206,6 +209,9 @@ public:
     /** The base time for the currently active frame. */
     int64_t frameTime;
 
+    /** The idle ratio of the last frame, reported with the frame finish. */
+    std::atomic<float> idle;
+
     /** All assembly frames used by the pipe during rendering. */
     FrameHash frames;
 
@@ -300,7 +306,8 @@ void Pipe::attach(const uint128_t& id, const uint32_t instanceID)
     registerCommand(fabric::CMD_PIPE_DESTROY_WINDOW,
                     PipeFunc(this, &Pipe::_cmdDestroyWindow), queue);
     registerCommand(fabric::CMD_PIPE_FRAME_START,
-                    PipeFunc(this, &Pipe::_cmdFrameStart), queue);
+                    PipeFunc(this, &Pipe::_cmdFrameStart),
+                    getPipeThreadPriorityQueue());
     registerCommand(fabric::CMD_PIPE_FRAME_FINISH,
                     PipeFunc(this, &Pipe::_cmdFrameFinish), queue);
     registerCommand(fabric::CMD_PIPE_FRAME_DRAW_FINISH,
@@ -324,6 +331,9 @@ void Pipe::setDirty(const uint64_t bits)
 
 bool Pipe::isWindowSystemAvailable(const std::string& name) const
 {
+    if (name == "CPU")
+        return true;
+
     bool available = false;
     if (name != "Qt")
     {
@@ -410,6 +420,8 @@ WindowSystem Pipe::selectWindowSystem() const
         LBTHROW(std::runtime_error(msg.str()));
     }
     return WindowSystem("Qt");
+#else
+    return WindowSystem("CPU");
 #endif
 }
 
@@ -571,14 +583,22 @@ MessagePump* Pipe::getMessagePump()
 co::CommandQueue* Pipe::getPipeThreadQueue()
 {
     if (_impl->thread)
-        return _impl->thread->getWorkerQueue();
+        return _impl->thread->getWorkerQueue()->getDispatchQueue();
+
+    return getNode()->getMainThreadQueue();
+}
+
+co::CommandQueue* Pipe::getPipeThreadPriorityQueue()
+{
+    if (_impl->thread)
+        return _impl->thread->getWorkerQueue()->getPriorityQueue();
 
     return getNode()->getMainThreadQueue();
 }
 
 co::CommandQueue* Pipe::getTransferThreadQueue()
 {
-    return _impl->transferThread.getWorkerQueue();
+    return _impl->transferThread.getWorkerQueue()->getDispatchQueue();
 }
 
 co::CommandQueue* Pipe::getMainThreadQueue()
@@ -890,6 +910,11 @@ uint32_t Pipe::getFinishedFrame() const
     return _impl->finishedFrame.get();
 }
 
+float Pipe::getIdleRatio() const
+{
+    return _impl->idle;
+}
+
 WindowSystem Pipe::getWindowSystem() const
 {
     return _impl->windowSystem;
@@ -1264,6 +1289,19 @@ bool Pipe::_cmdFrameStart(co::ICommand& cmd)
         waitEvent.statistic.totalTime =
             std::max(_impl->frameTime - lastFrameTime,
                      int64_t(1)); // avoid SIGFPE
+        if (_impl->thread)
+            _impl->idle = float(waitEvent.statistic.idleTime) /
+                          float(waitEvent.statistic.totalTime);
+    }
+    if (lastFrameTime > 0 && _impl->thread)
+    {
+        const CommandQueue::Stats& stats =
+            _impl->thread->getWorkerQueue()->resetStatistics();
+        PipeStatistics queueEvent(Statistic::PIPE_QUEUE, this);
+        queueEvent.statistic.queueWait =
+            stats.commands ? stats.waitTime / int64_t(stats.commands) : 0;
+        queueEvent.statistic.maxQueueWait = stats.maxWaitTime;
+        queueEvent.statistic.queueDepth = stats.depth;
     }
 
     LBASSERTINFO(_impl->currentFrame + 1 == frameNumber,
@@ -58,10 +58,11 @@ public:
 
     /** @name Data Access. */
     //@{
-    EQ_API co::CommandQueue* getPipeThreadQueue(); //!< @internal
-    co::CommandQueue* getMainThreadQueue();        //!< @internal
-    co::CommandQueue* getCommandThreadQueue();     //!< @internal
-    co::CommandQueue* getTransferThreadQueue();    //!< @internal
+    EQ_API co::CommandQueue* getPipeThreadQueue();  //!< @internal
+    co::CommandQueue* getMainThreadQueue();         //!< @internal
+    co::CommandQueue* getCommandThreadQueue();      //!< @internal
+    co::CommandQueue* getPipeThreadPriorityQueue(); //!< @internal
+    co::CommandQueue* getTransferThreadQueue();     //!< @internal
 
     /** @return the parent configuration. @version 1.0 */
     EQ_API Config* getConfig();
@@ -95,6 +96,7 @@ public:
      */
     EQ_API uint32_t getCurrentFrame() const;
     EQ_API uint32_t getFinishedFrame() const; //!< @internal
+    float getIdleRatio() const;               //!< @internal
 
     /**
      * Return the window system used by this pipe.
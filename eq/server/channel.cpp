@@ -512,8 +512,11 @@ void Channel::output(std::ostream& os) const
 
         os << (i == IATTR_HINT_STATISTICS
                    ? "hint_statistics   "
-                   : i == IATTR_HINT_SENDTOKEN ? "hint_sendtoken    "
-                                               : "ERROR ")
+                   : i == IATTR_HINT_SENDTOKEN
+                         ? "hint_sendtoken    "
+                         : i == IATTR_HINT_TEMPORAL_DELTA
+                               ? "hint_temporal_delta "
+                               : "ERROR ")
            << static_cast<fabric::IAttribute>(value) << std::endl;
     }
     for (SAttribute i = static_cast<SAttribute>(0); i < SATTR_LAST;
@@ -142,6 +142,7 @@ Compound::Data::Data()
     , period(LB_UNDEFINED_UINT32)
     , phase(LB_UNDEFINED_UINT32)
     , maxFPS(std::numeric_limits<float>::max())
+    , quality(1.f)
 {
     const Global* global = Global::instance();
     for (int i = 0; i < IATTR_ALL; ++i)
@@ -1061,7 +1062,7 @@ void Compound::exit()
 void Compound::register_()
 {
     ServerPtr server = getServer();
-    const uint32_t latency = getConfig()->getLatency();
+    const uint32_t latency = getConfig()->getMaxLatency();
 
     for (Frames::const_iterator i = _outputFrames.begin();
          i != _outputFrames.end(); ++i)
@@ -1169,6 +1170,7 @@ void Compound::update(const uint32_t frameNumber)
 
     CompoundUpdateOutputVisitor updateOutputVisitor(frameNumber);
     accept(updateOutputVisitor);
+    updateOutputVisitor.joinSwapBarrierTrees();
 
     const FrameMap& outputFrames = updateOutputVisitor.getOutputFrames();
     const TileQueueMap& outputQueues = updateOutputVisitor.getOutputQueues();
@@ -1327,6 +1329,7 @@ void Compound::_updateInheritNode()
         _inherit.phase = _data.phase;
 
     _inherit.maxFPS = _data.maxFPS;
+    _inherit.quality *= _data.quality;
 
     if (_data.buffers != Frame::Buffer::undefined)
         _inherit.buffers = _data.buffers;
@@ -213,6 +213,9 @@ public:
     const Zoom& getZoom() const { return _data.zoom; }
     void setMaxFPS(const float fps) { _data.maxFPS = fps; }
     float getMaxFPS() const { return _data.maxFPS; }
+    /** Set the compression quality scale of the output frames. */
+    void setQuality(const float quality) { _data.quality = quality; }
+    float getQuality() const { return _data.quality; }
     void setUsage(const float usage)
     {
         LBASSERT(usage >= 0.f);
@@ -316,6 +319,7 @@ public:
     uint32_t getInheritPeriod() const { return _inherit.period; }
     uint32_t getInheritPhase() const { return _inherit.phase; }
     float getInheritMaxFPS() const { return _inherit.maxFPS; }
+    float getInheritQuality() const { return _inherit.quality; }
     int32_t getInheritIAttribute(const IAttribute attr) const
     {
         return _inherit.iAttributes[attr];
@@ -530,6 +534,7 @@ private:
         uint32_t phase;
         int32_t iAttributes[IATTR_ALL];
         float maxFPS;
+        float quality;
 
         // compound activation per eye
         uint32_t active[fabric::NUM_EYES];
@@ -22,6 +22,8 @@
 #include "frame.h"
 #include "frameData.h"
 #include "log.h"
+#include "node.h"
+#include "pipe.h"
 #include "server.h"
 #include "tileQueue.h"
 #include "window.h"
@@ -31,6 +33,9 @@
 #include <eq/fabric/iAttribute.h>
 #include <eq/fabric/tile.h>
 
+#include <algorithm>
+#include <sstream>
+
 namespace eq
 {
 namespace server
@@ -151,6 +156,9 @@ void CompoundUpdateOutputVisitor::_updateFrames(Compound* compound)
         // 4) (source) render context
         frameData->setContext(compound->setupRenderContext(EYE_CYCLOP));
 
+        // 5) compression quality
+        frameData->setQuality(compound->getInheritQuality());
+
         //----- Set frame parameters:
         // 1) offset is position wrt window, i.e., the channel position
         if (compound->getInheritChannel() == channel)
@@ -303,11 +311,85 @@ void CompoundUpdateOutputVisitor::_updateSwapBarriers(Compound* compound)
                 window->joinNVSwapBarrier(swapBarrier, _swapBarriers[name]);
         }
     }
+    else if (swapBarrier->isTree())
+        _joinSwapBarrierTree(swapBarrier, window);
     else
     {
         const std::string& name = swapBarrier->getName();
         _swapBarriers[name] = window->joinSwapBarrier(_swapBarriers[name]);
     }
 }
+
+void CompoundUpdateOutputVisitor::_joinSwapBarrierTree(
+    SwapBarrierConstPtr swapBarrier, Window* window)
+{
+    SwapBarrierTree& tree = _swapBarrierTrees[swapBarrier->getName()];
+    tree.fanIn = swapBarrier->getFanIn();
+
+    // The first window of a pipe enters the barrier for all its windows
+    const Pipe* pipe = window->getPipe();
+    const Windows& pipeWindows = pipe->getWindows();
+    for (Window*& other : tree.windows)
+    {
+        if (other->getPipe() != pipe)
+            continue;
+
+        if (std::find(pipeWindows.begin(), pipeWindows.end(), window) <
+            std::find(pipeWindows.begin(), pipeWindows.end(), other))
+        {
+            other = window;
+        }
+        return;
+    }
+    tree.windows.push_back(window);
+}
+
+void CompoundUpdateOutputVisitor::joinSwapBarrierTrees()
+{
+    for (const auto& i : _swapBarrierTrees)
+    {
+        const SwapBarrierTree& swapBarrierTree = i.second;
+        const Windows& windows = swapBarrierTree.windows;
+
+        std::vector<const Node*> nodes;
+        std::vector<uint32_t> groups;
+        for (const Window* window : windows)
+        {
+            const Node* node = window->getNode();
+            const size_t group =
+                std::find(nodes.begin(), nodes.end(), node) - nodes.begin();
+            if (group == nodes.size())
+                nodes.push_back(node);
+            groups.push_back(uint32_t(group));
+        }
+
+        const SwapBarrier::Tree& tree =
+            SwapBarrier::buildTree(groups, swapBarrierTree.fanIn);
+        co::Barriers barriers;
+        for (size_t j = 0; j < tree.members.size(); ++j)
+        {
+            co::Barrier* barrier = windows[tree.masters[j]]->newSwapBarrier();
+            barrier->setHeight(uint32_t(tree.members[j].size()));
+            barriers.push_back(barrier);
+
+            std::ostringstream name; // for commit in Compound::update
+            name << i.first << '#' << j;
+            _swapBarriers[name.str()] = barrier;
+        }
+
+        for (size_t j = 0; j < windows.size(); ++j)
+        {
+            const std::vector<size_t>& path = tree.paths[j];
+            if (path.empty())
+                continue;
+
+            co::Barriers barrierPath;
+            for (const size_t barrier : path)
+                barrierPath.push_back(barriers[barrier]);
+            windows[j]->joinSwapBarrierTree(barrierPath,
+                                            !tree.isRoot(path.back()));
+        }
+    }
+}
 }
 }
@@ -22,6 +22,8 @@
 #include "compound.h"        // nested type
 #include "compoundVisitor.h" // base class
 
+#include <map>
+
 namespace eq
 {
 namespace server
@@ -38,6 +40,9 @@ public:
     /** Visit all compounds. */
     virtual VisitorResult visit(Compound* compound);
 
+    /** Set up the tree swap barriers of the visited compounds. */
+    void joinSwapBarrierTrees();
+
     const Compound::BarrierMap& getSwapBarriers() const
     {
         return _swapBarriers;
@@ -52,12 +57,24 @@ private:
     const uint32_t _frameNumber;
 
     Compound::BarrierMap _swapBarriers;
+
+    struct SwapBarrierTree
+    {
+        SwapBarrierTree()
+            : fanIn(0)
+        {
+        }
+        uint32_t fanIn;
+        Windows windows; //!< one per pipe
+    };
+    std::map<std::string, SwapBarrierTree> _swapBarrierTrees;
     Compound::FrameMap _outputFrames;
     Compound::TileQueueMap _outputTileQueues;
 
     void _updateQueues(Compound* compound);
     void _updateFrames(Compound* compound);
     void _updateSwapBarriers(Compound* compound);
+    void _joinSwapBarrierTree(SwapBarrierConstPtr swapBarrier, Window* window);
     void _updateZoom(const Compound* compound, Frame* frame);
 
     void _generateTiles(TileQueue* queue, Compound* compound);
@@ -39,11 +39,17 @@
 #include <eq/fabric/event.h>
 #include <eq/fabric/iAttribute.h>
 #include <eq/fabric/paths.h>
+#include <eq/fabric/statistic.h>
 
 #include <co/objectICommand.h>
 
 #include <boost/foreach.hpp>
+#include <lunchbox/atomic.h>
 #include <lunchbox/sleep.h>
+#include <lunchbox/thread.h>
+
+#include <cstring>
+#include <memory>
 
 #include "channelStopFrameVisitor.h"
 #include "configDeregistrator.h"
@@ -60,6 +66,44 @@ typedef co::CommandFunc<Config> ConfigFunc;
 using fabric::ON;
 using fabric::OFF;
 
+namespace
+{
+/**
+ * Connects or launches nodes taken from a shared list and waits for each
+ * launched process, until the list is exhausted.
+ */
+class ConnectThread : public lunchbox::Thread
+{
+public:
+    ConnectThread(const Nodes& nodes, lunchbox::a_int32_t& next)
+        : _nodes(nodes)
+        , _next(next)
+        , _result(true)
+    {
+    }
+
+    bool getResult() const { return _result; }
+protected:
+    void run() final
+    {
+        for (int32_t i = _next++; i < int32_t(_nodes.size()); i = _next++)
+        {
+            // the launch timeout starts when this node's launch starts
+            const lunchbox::Clock clock;
+            Node* node = _nodes[i];
+            if (!node->connect() || !node->syncLaunch(clock))
+                _result = false;
+        }
+    }
+
+private:
+    const Nodes& _nodes;
+    lunchbox::a_int32_t& _next;
+    bool _result;
+};
+typedef std::unique_ptr<ConnectThread> ConnectThreadPtr;
+}
+
 Config::Config(ServerPtr parent)
     : Super(parent)
     , _currentFrame(0)
@@ -68,6 +112,7 @@ Config::Config(ServerPtr parent)
     , _state(STATE_UNUSED)
     , _needsFinish(false)
     , _lastCheck(0)
+    , _lastFrameStart(0)
     , _private(0)
 {
     const Global* global = Global::instance();
@@ -581,8 +626,16 @@ bool Config::_updateRunning(const bool canFail)
 
 bool Config::_connectNodes()
 {
+    // Connect new nodes concurrently, so that slow or dead hosts do not delay
+    // the others. At most IATTR_LAUNCH_CONCURRENCY nodes are connected or
+    // launched at once, to bound the number of threads and launch processes
+    // on large clusters. Running render clients do not launch further nodes,
+    // since each launched process connects back to the node which launched it
+    // and would not be known to the server.
     bool success = true;
-    lunchbox::Clock clock;
+    const lunchbox::Clock clock;
+    Nodes newNodes;
+
     const Nodes& nodes = getNodes();
     for (Nodes::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
     {
@@ -590,17 +643,43 @@ bool Config::_connectNodes()
         if (!node->isActive())
             continue;
 
-        if (!node->connect())
+        if (!node->getNode() && node->isStopped())
+            newNodes.push_back(node);
+        else if (!node->connect() || !node->syncLaunch(clock))
             success = false;
     }
 
-    for (Nodes::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
+    const size_t nThreads =
+        std::min(newNodes.size(),
+                 size_t(std::max(1, getIAttribute(IATTR_LAUNCH_CONCURRENCY))));
+    lunchbox::a_int32_t next(0);
+    std::vector<ConnectThreadPtr> threads;
+    for (size_t i = 0; i < nThreads; ++i)
     {
-        Node* node = *i;
-        if (node->isActive() && !node->syncLaunch(clock))
-            success = false;
+        threads.emplace_back(new ConnectThread(newNodes, next));
+        if (!threads.back()->start())
+        {
+            LBWARN << "Could not start connect thread" << std::endl;
+            threads.pop_back();
+        }
+    }
+
+    if (threads.empty()) // connect sequentially
+    {
+        for (Node* node : newNodes)
+            if (!node->connect() || !node->syncLaunch(lunchbox::Clock()))
+                success = false;
     }
 
+    for (ConnectThreadPtr& thread : threads)
+    {
+        thread->join();
+        if (!thread->getResult())
+            success = false;
+    }
+    LBLOG(LOG_INIT) << "Connected " << newNodes.size() << " nodes using "
+                    << threads.size() << " threads in " << clock.getTime64()
+                    << " ms" << std::endl;
     return success;
 }
 
@@ -784,6 +863,9 @@ bool Config::_init(const uint128_t& initID)
     _currentFrame = 0;
     _finishedFrame = 0;
     _initID = initID;
+    _latencyController.setRange(getLatency(), getMaxLatency());
+    _latencyController.reset(getLatency());
+    _lastFrameStart = 0;
 
     for (auto compound : _compounds)
         compound->init();
@@ -862,11 +944,12 @@ bool Config::exit()
 //---------------------------------------------------------------------------
 // frame
 //---------------------------------------------------------------------------
-void Config::_startFrame(const uint128_t& frameID)
+void Config::_startFrame(const uint128_t& frameID, const int64_t waitTime)
 {
     LBASSERT(_state == STATE_RUNNING);
     _verifyFrameFinished(_currentFrame);
     _syncClock();
+    _adaptLatency(waitTime);
 
     ++_currentFrame;
     ++_incarnation;
@@ -907,7 +990,7 @@ void Config::_verifyFrameFinished(const uint32_t frameNumber)
     {
         Node* node = *i;
         if (node->isRunning() &&
-            node->getFinishedFrame() + getLatency() < frameNumber)
+            node->getFinishedFrame() + getMaxLatency() < frameNumber)
         {
             NodeFailedVisitor nodeFailedVisitor;
             node->accept(nodeFailedVisitor);
@@ -915,6 +998,61 @@ void Config::_verifyFrameFinished(const uint32_t frameNumber)
     }
 }
 
+void Config::_adaptLatency(const int64_t waitTime)
+{
+    if (!_latencyController.isEnabled())
+        return;
+
+    const int64_t time = getServer()->getTime();
+    const int64_t frameTime = _lastFrameStart > 0 ? time - _lastFrameStart : 0;
+    _lastFrameStart = time;
+
+    float idle = 1.f;
+    const Nodes& nodes = getNodes();
+    for (Nodes::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
+    {
+        const Node* node = *i;
+        if (node->isRunning())
+            idle = std::min(idle, node->getIdleRatio());
+    }
+
+    _latencyController.addSample(float(frameTime), float(waitTime), idle);
+    const uint32_t latency = _latencyController.update();
+    if (latency == getLatency())
+        return;
+
+    // All buffers are sized for the max latency, no need to visit the config
+    LBLOG(LOG_TASKS) << "Adapt latency " << getLatency() << " -> " << latency
+                     << " frame time " << _latencyController.getFrameTime()
+                     << " wait " << _latencyController.getWaitTime()
+                     << " idle " << _latencyController.getIdle() << std::endl;
+    setLatency(latency);
+
+    Statistic stat;
+    stat.serial = getSerial();
+    stat.time = time;
+    stat.originator = getID();
+    stat.type = Statistic::CONFIG_LATENCY;
+    stat.frameNumber = _currentFrame + 1;
+    stat.task = 0;
+    stat.plugins[0] = 0;
+    stat.plugins[1] = 0;
+    stat.startTime = time;
+    stat.endTime = time + 1;
+    stat.idleTime = int64_t(_latencyController.getWaitTime());
+    stat.totalTime = int64_t(_latencyController.getFrameTime());
+    stat.ratio = _latencyController.getIdle();
+    stat.currentFPS = 0.f;
+    stat.averageFPS = 0.f;
+    stat.latency = latency;
+    const std::string name = getName().empty() ? "config" : getName();
+    strncpy(stat.resourceName, name.c_str(), 31);
+    stat.resourceName[31] = 0;
+
+    send(findApplicationNetNode(), fabric::CMD_CONFIG_EVENT)
+        << EVENT_STATISTIC << stat;
+}
+
 void Config::notifyNodeFrameFinished(const uint32_t frameNumber)
 {
     if (_finishedFrame >= frameNumber) // node finish already done
@@ -961,13 +1099,12 @@ void Config::_flushAllFrames()
 
 void Config::changeLatency(const uint32_t latency)
 {
-    if (getLatency() == latency)
-        return;
-
-    setLatency(latency);
+    // changed by the application, which sets the new lower bound
+    _latencyController.setRange(latency, getMaxLatency());
+    _latencyController.reset(latency);
 
     // update latency on all frames and barriers
-    ChangeLatencyVisitor visitor(latency);
+    ChangeLatencyVisitor visitor(getMaxLatency());
     accept(visitor);
 }
 
@@ -1073,7 +1210,8 @@ bool Config::_cmdStartFrame(co::ICommand& cmd)
 
     LBVERB << "handle config frame start " << command << std::endl;
 
-    _startFrame(command.read<uint128_t>());
+    const uint128_t& frameID = command.read<uint128_t>();
+    _startFrame(frameID, command.read<int64_t>());
 
     if (_state == STATE_STOPPED)
     {
@@ -20,8 +20,9 @@
 #ifndef EQSERVER_CONFIG_H
 #define EQSERVER_CONFIG_H
 
-#include "server.h" // used in inline method
-#include "state.h"  // enum
+#include "latencyController.h" // member
+#include "server.h"            // used in inline method
+#include "state.h"             // enum
 #include "types.h"
 #include "visitorResult.h" // enum
 #include <eq/server/api.h>
@@ -251,6 +252,12 @@ private:
 
     int64_t _lastCheck;
 
+    /** Adapts the latency up to IATTR_MAX_LATENCY. */
+    LatencyController _latencyController;
+
+    /** The server time of the last frame start, or 0. */
+    int64_t _lastFrameStart;
+
     struct Private;
     Private* _private; // placeholder for binary-compatible changes
 
@@ -275,7 +282,8 @@ private:
     void _verifyFrameFinished(const uint32_t frameNumber);
     bool _init(const uint128_t& initID);
 
-    void _startFrame(const uint128_t& frameID);
+    void _startFrame(const uint128_t& frameID, int64_t waitTime);
+    void _adaptLatency(int64_t waitTime);
     void _flushAllFrames();
     //@}
 
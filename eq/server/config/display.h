@@ -20,6 +20,7 @@
 #define EQSERVER_CONFIG_DISPLAY_H
 
 #include "../types.h"
+#include <eq/server/api.h>
 
 namespace eq
 {
@@ -30,7 +31,8 @@ namespace config
 class Display
 {
 public:
-    static void discoverLocal(Config* config, const ConfigParams& params);
+    static EQSERVER_API void discoverLocal(Config* config,
+                                           const ConfigParams& params);
 };
 }
 }
@@ -62,6 +62,7 @@
 
 #include <cmath>
 #include <cstdio>
+#include <unordered_map>
 
 #define USE_IPv4
 
@@ -561,7 +562,7 @@ Compound* Resources::_addMonoCompound(Compound* root, const Channels& channels,
         compound = _addDBCompound(root, activeDBChannels, params);
     }
     else if (name == EQ_SERVER_CONFIG_LAYOUT_DB_DS)
-        compound = _addDSCompound(root, activeDBChannels);
+        compound = _addDSCompound(root, activeDBChannels, true);
     else if (name == EQ_SERVER_CONFIG_LAYOUT_DB_2D)
     {
         LBASSERT(!multiProcess);
@@ -677,6 +678,65 @@ void Resources::_fill2DCompound(Compound* compound, const Channels& channels)
     }
 }
 
+namespace
+{
+typedef std::vector<Channels> ChannelGroups;
+
+/**
+ * Group the channels by their node, in the order of their first appearance.
+ *
+ * Returns one group per channel if grouping is disabled or does not reduce
+ * the number of images composited over the network.
+ */
+ChannelGroups _groupChannels(const Channels& channels, const bool byNode)
+{
+    ChannelGroups groups;
+    if (byNode)
+    {
+        std::unordered_map<const Node*, size_t> indices;
+        for (Channel* channel : channels)
+        {
+            const Node* node = channel->getNode();
+            const auto i = indices.find(node);
+            if (i == indices.end())
+            {
+                indices[node] = groups.size();
+                groups.push_back(Channels(1, channel));
+            }
+            else
+                groups[i->second].push_back(channel);
+        }
+    }
+
+    if (groups.size() > 1 && groups.size() < channels.size())
+        return groups;
+
+    groups.clear();
+    for (Channel* channel : channels)
+        groups.push_back(Channels(1, channel));
+    return groups;
+}
+
+/** @return the range of the given channels out of all channels. */
+Range _getRange(const size_t begin, const size_t size, const size_t total)
+{
+    const size_t end = begin + size;
+    return Range(float(begin) / float(total),
+                 end == total ? 1.f : float(end) / float(total));
+}
+
+/** @return the channel compositing the group, the destination if included */
+Channel* _getGroupChannel(const Compound* compound, const Channels& group)
+{
+    const Segment* segment = compound->getChannel()->getSegment();
+    const Channel* outputChannel = segment ? segment->getChannel() : 0;
+    for (Channel* channel : group)
+        if (channel == outputChannel)
+            return channel;
+    return group.front();
+}
+}
+
 Compound* Resources::_addDBCompound(Compound* root, const Channels& channels,
                                     fabric::ConfigParams params)
 {
@@ -694,24 +754,42 @@ Compound* Resources::_addDBCompound(Compound* root, const Channels& channels,
         compound->addEqualizer(new LoadEqualizer(params.getEqualizer()));
     }
 
-    const Compounds& children = _addSources(compound, channels);
-    const size_t step = size_t(100000.0f / float(children.size()));
+    // The load equalizer measures the draw time of its direct children and
+    // can't see the draw tasks of nested node compounds.
+    const bool byNode = name == EQ_SERVER_CONFIG_LAYOUT_DB_STATIC;
+    const ChannelGroups& groups = _groupChannels(channels, byNode);
+
     size_t start = 0;
-    for (CompoundsCIter i = children.begin(); i != children.end(); ++i)
+    for (const Channels& group : groups)
     {
-        Compound* child = *i;
-        if (i + 1 == children.end()) // last - correct rounding 'error'
-            child->setRange(Range(float(start) / 100000.f, 1.f));
-        else
-            child->setRange(
-                Range(float(start) / 100000.f, float(start + step) / 100000.f));
-        start += step;
+        Channel* groupChannel = _getGroupChannel(compound, group);
+        _addSources(compound, Channels(1, groupChannel));
+
+        Compound* child = compound->getChildren().back();
+        child->setRange(_getRange(start, group.size(), channels.size()));
+        start += group.size();
+
+        if (group.size() > 1)
+            _addNodeCompound(child, group);
     }
 
     return compound;
 }
 
-Compound* Resources::_addDSCompound(Compound* root, const Channels& channels)
+void Resources::_addNodeCompound(Compound* compound, const Channels& channels)
+{
+    // composite all local images before sending one image over the network
+    compound->setName(channels.front()->getNode()->getName());
+    compound->setBuffers(Frame::Buffer::color | Frame::Buffer::depth);
+
+    const Compounds& children = _addSources(compound, channels);
+    size_t start = 0;
+    for (Compound* child : children)
+        child->setRange(_getRange(start++, 1, children.size()));
+}
+
+Compound* Resources::_addDSCompound(Compound* root, const Channels& channels,
+                                    const bool byNode)
 {
     const Channel* channel = root->getChannel();
     const Layout* layout = channel->getLayout();
@@ -720,21 +798,26 @@ Compound* Resources::_addDSCompound(Compound* root, const Channels& channels)
     Compound* compound = new Compound(root);
     compound->setName(name);
 
-    const Compounds& children = _addSources(compound, channels);
+    const ChannelGroups& groups = _groupChannels(channels, byNode);
+    for (const Channels& group : groups)
+        _addSources(compound, Channels(1, _getGroupChannel(compound, group)));
+
+    const Compounds& children = compound->getChildren();
     const size_t step = size_t(100000.0f / float(children.size()));
 
     size_t start = 0;
+    size_t first = 0;
     for (CompoundsCIter i = children.begin(); i != children.end(); ++i)
     {
         Compound* child = *i;
+        const Channels& group = groups[i - children.begin()];
 
         // leaf draw + tile readback compound
         Compound* drawChild = new Compound(child);
-        if (i + 1 == children.end()) // last - correct rounding 'error'
-            drawChild->setRange(Range(float(start) / 100000.f, 1.f));
-        else
-            drawChild->setRange(
-                Range(float(start) / 100000.f, float(start + step) / 100000.f));
+        drawChild->setRange(_getRange(first, group.size(), channels.size()));
+        first += group.size();
+        if (group.size() > 1)
+            _addNodeCompound(drawChild, group);
 
         size_t y = 0;
         for (CompoundsCIter j = children.begin(); j != children.end(); ++j)
@@ -818,7 +901,7 @@ Compound* Resources::_addDB2DCompound(Compound* root, const Channels& channels,
     // TODO: Optimized compositing?
     root->setBuffers(Frame::Buffer::color | Frame::Buffer::depth);
     const Channels& dbChannels = _filter(channels, " mt mp ");
-    Compound* compound = _addDSCompound(root, dbChannels);
+    Compound* compound = _addDSCompound(root, dbChannels, false);
 
     const Compounds& children = compound->getChildren();
     for (CompoundsCIter i = children.begin(); i != children.end(); ++i)
@@ -855,9 +938,11 @@ const Compounds& Resources::_addSources(Compound* compound,
                                         const Channels& channels,
                                         const bool destChannelFrame)
 {
+    // the channel of the compound, e.g., of a node compound, is in place
     const Channel* rootChannel = compound->getChannel();
     const Segment* segment = rootChannel->getSegment();
-    const Channel* outputChannel = segment ? segment->getChannel() : 0;
+    const Channel* outputChannel =
+        segment ? segment->getChannel() : rootChannel;
 
     for (ChannelsCIter i = channels.begin(); i != channels.end(); ++i)
     {
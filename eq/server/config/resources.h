@@ -20,6 +20,7 @@
 #define EQSERVER_CONFIG_RESOURCES_H
 
 #include "../types.h"
+#include <eq/server/api.h>
 
 #define EQ_SERVER_CONFIG_LAYOUT_SIMPLE "Simple"
 #define EQ_SERVER_CONFIG_LAYOUT_2D_STATIC "Static2D"
@@ -42,9 +43,10 @@ public:
     static bool discover(ServerPtr server, Config* config,
                          const std::string& session,
                          const fabric::ConfigParams& params);
-    static Channels configureSourceChannels(Config* config);
-    static void configure(const Compounds& compounds, const Channels& channels,
-                          const fabric::ConfigParams& params);
+    static EQSERVER_API Channels configureSourceChannels(Config* config);
+    static EQSERVER_API void configure(const Compounds& compounds,
+                                       const Channels& channels,
+                                       const fabric::ConfigParams& params);
 
 private:
     static Compound* _addMonoCompound(Compound* root, const Channels& channels,
@@ -56,7 +58,9 @@ private:
                                     fabric::ConfigParams params);
     static Compound* _addDBCompound(Compound* root, const Channels& channels,
                                     fabric::ConfigParams params);
-    static Compound* _addDSCompound(Compound* root, const Channels& channels);
+    static Compound* _addDSCompound(Compound* root, const Channels& channels,
+                                    bool byNode);
+    static void _addNodeCompound(Compound* compound, const Channels& channels);
     static Compound* _addDB2DCompound(Compound* root, const Channels& channels,
                                       fabric::ConfigParams params);
     static Compound* _addSubpixelCompound(Compound* root, const Channels&);
@@ -35,31 +35,31 @@ public:
     virtual VisitorResult visit(Observer* observer)
     {
         // double commit on update/delete
-        return _register(observer, observer->getConfig()->getLatency() + 1);
+        return _register(observer, observer->getConfig()->getMaxLatency() + 1);
     }
 
     virtual VisitorResult visit(Segment* segment)
     {
         // double commit on update/delete
-        return _register(segment, segment->getConfig()->getLatency() + 1);
+        return _register(segment, segment->getConfig()->getMaxLatency() + 1);
     }
 
     virtual VisitorResult visitPost(Canvas* canvas)
     {
         // double commit on update/delete
-        return _register(canvas, canvas->getConfig()->getLatency() + 1);
+        return _register(canvas, canvas->getConfig()->getMaxLatency() + 1);
     }
 
     virtual VisitorResult visit(View* view)
     {
         // double commit on update/delete
-        return _register(view, view->getConfig()->getLatency() + 1);
+        return _register(view, view->getConfig()->getMaxLatency() + 1);
     }
 
     virtual VisitorResult visitPost(Layout* layout)
     {
         // double commit on update/delete
-        return _register(layout, layout->getConfig()->getLatency() + 1);
+        return _register(layout, layout->getConfig()->getMaxLatency() + 1);
     }
 
     virtual VisitorResult visit(Channel* channel)
@@ -0,0 +1,88 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "compositeModel.h"
+
+#include <lunchbox/debug.h>
+
+#include <algorithm>
+
+namespace eq
+{
+namespace server
+{
+CompositeModel::CompositeModel()
+    : _totalTime(0)
+    , _compressTime(0)
+{
+}
+
+void CompositeModel::clear()
+{
+    _tasks.clear();
+    _totalTime = 0;
+    _compressTime = 0;
+}
+
+void CompositeModel::add(const uint32_t taskID, const bool isDestination,
+                         const int64_t compositeTime,
+                         const int64_t assembleTime,
+                         const int64_t compressTime)
+{
+    Task& task = _tasks[taskID];
+    task.isDestination = isDestination;
+    task.time = isDestination ? compositeTime + assembleTime : compositeTime;
+    task.compressTime = isDestination ? 0 : compressTime;
+
+    _totalTime += compositeTime + assembleTime + task.compressTime;
+    _compressTime += task.compressTime;
+}
+
+int64_t CompositeModel::getCompositeTime(const uint32_t taskID) const
+{
+    const auto i = _tasks.find(taskID);
+    if (i == _tasks.end())
+        return 0;
+
+    const Task& task = i->second;
+    if (!task.isDestination)
+        return task.time;
+
+    // The destination receives, decompresses and assembles all inputs
+    return task.time + _compressTime;
+}
+
+float CompositeModel::getResources(const uint32_t taskID, const float resources,
+                                   const float totalResources,
+                                   const float renderTime) const
+{
+    const float compositeTime = float(getCompositeTime(taskID));
+    if (compositeTime == 0.f || resources == 0.f || totalResources <= 0.f)
+        return resources;
+
+    const float taskTime = renderTime * resources / totalResources;
+    const float clampedTime = std::min(compositeTime, taskTime);
+    const float totalTime = renderTime + float(_totalTime);
+    const float timePerResource = totalTime / totalResources;
+    if (timePerResource <= 0.f)
+        return resources;
+
+    // may become negative due to fp rounding
+    return std::max(resources - clampedTime / timePerResource, 0.f);
+}
+}
+}
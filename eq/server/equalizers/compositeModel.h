@@ -0,0 +1,94 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQS_COMPOSITEMODEL_H
+#define EQS_COMPOSITEMODEL_H
+
+#include <eq/server/api.h>
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace eq
+{
+namespace server
+{
+/**
+ * The compositing cost model of the load equalizer for one frame.
+ *
+ * The tasks of a frame are added once per update, after which the cost of each
+ * task is looked up in constant time. Sources pay their readback and
+ * transmission, the destination the assembly and decompression of all inputs.
+ */
+class CompositeModel
+{
+public:
+    /** Construct a new, empty model. */
+    EQSERVER_API CompositeModel();
+
+    /** Remove all tasks. */
+    EQSERVER_API void clear();
+
+    /**
+     * Add the compositing times of one task.
+     *
+     * @param taskID the task identifier of the compound.
+     * @param isDestination true if the task assembles all inputs.
+     * @param compositeTime the readback and transmit time.
+     * @param assembleTime the assembly time.
+     * @param compressTime the compression time, which estimates the
+     *                     decompression time on the destination.
+     */
+    EQSERVER_API void add(uint32_t taskID, bool isDestination,
+                          int64_t compositeTime, int64_t assembleTime,
+                          int64_t compressTime);
+
+    /** @return the compositing time on the critical path of a task. */
+    EQSERVER_API int64_t getCompositeTime(uint32_t taskID) const;
+
+    /** @return the compositing time on the critical path of all tasks. */
+    int64_t getTotalCompositeTime() const { return _totalTime; }
+
+    /**
+     * Reduce the resources of a task by its compositing cost, so that all
+     * tasks spend the same time per frame rendering and compositing.
+     *
+     * @param taskID the task identifier of the compound.
+     * @param resources the resources of the task.
+     * @param totalResources the resources of all tasks.
+     * @param renderTime the render time of all tasks.
+     * @return the resources available for rendering.
+     */
+    EQSERVER_API float getResources(uint32_t taskID, float resources,
+                                    float totalResources,
+                                    float renderTime) const;
+
+private:
+    struct Task
+    {
+        bool isDestination;
+        int64_t time; //!< composite and assemble time
+        int64_t compressTime;
+    };
+    std::unordered_map<uint32_t, Task> _tasks;
+    int64_t _totalTime;
+    int64_t _compressTime; //!< of all sources
+};
+}
+}
+
+#endif // EQS_COMPOSITEMODEL_H
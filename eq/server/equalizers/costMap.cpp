@@ -0,0 +1,284 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "costMap.h"
+
+#include <lunchbox/debug.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+static const float MAX_VELOCITY = .25f; // normalized units per frame
+static const size_t SPLIT_ITERATIONS = 20;
+
+/** @return the overlap of [start, end] with [cellStart, cellEnd]. */
+inline float _overlap(const float start, const float end, const float cellStart,
+                      const float cellEnd)
+{
+    return std::max(0.f, std::min(end, cellEnd) - std::max(start, cellStart));
+}
+
+/** The cells touched by a viewport, [start, end) in each dimension. */
+struct Cells
+{
+    Cells(const Vector2i& size, const Viewport& vp)
+        : xStart(std::max(0, int(vp.x * size.x())))
+        , xEnd(std::min(size.x(), int(std::ceil(vp.getXEnd() * size.x()))))
+        , yStart(std::max(0, int(vp.y * size.y())))
+        , yEnd(std::min(size.y(), int(std::ceil(vp.getYEnd() * size.y()))))
+    {
+    }
+
+    const int xStart;
+    const int xEnd;
+    const int yStart;
+    const int yEnd;
+};
+}
+
+CostMap::CostMap()
+    : _size(0, 0)
+    , _centroid(0.f, 0.f)
+    , _velocity(0.f, 0.f)
+    , _hasData(false)
+    , _hasCentroid(false)
+    , _predictive(true)
+{
+}
+
+void CostMap::resize(const Vector2i& size)
+{
+    LBASSERT(size.x() >= 0 && size.y() >= 0);
+    _size = size;
+
+    const size_t nCells = size_t(std::max(0, size.x() * size.y()));
+    _cost.assign(nCells, 0.f);
+    _predicted.assign(nCells, 0.f);
+    _samples.assign(nCells, 0.f);
+    _coverage.assign(nCells, 0.f);
+    clear();
+}
+
+void CostMap::clear()
+{
+    std::fill(_cost.begin(), _cost.end(), 0.f);
+    std::fill(_predicted.begin(), _predicted.end(), 0.f);
+    std::fill(_samples.begin(), _samples.end(), 0.f);
+    std::fill(_coverage.begin(), _coverage.end(), 0.f);
+    _centroid = Vector2f(0.f, 0.f);
+    _velocity = Vector2f(0.f, 0.f);
+    _hasData = false;
+    _hasCentroid = false;
+}
+
+void CostMap::addSample(const Viewport& vp, const float time)
+{
+    if (!isValid() || !vp.hasArea() || time < 0.f)
+        return;
+
+    const float cellW = 1.f / float(_size.x());
+    const float cellH = 1.f / float(_size.y());
+    const float cellArea = cellW * cellH;
+    const float area = vp.getArea();
+
+    const Cells cells(_size, vp);
+
+    for (int j = cells.yStart; j < cells.yEnd; ++j)
+    {
+        const float oy =
+            _overlap(vp.y, vp.getYEnd(), j * cellH, (j + 1) * cellH);
+        for (int i = cells.xStart; i < cells.xEnd; ++i)
+        {
+            const float ox =
+                _overlap(vp.x, vp.getXEnd(), i * cellW, (i + 1) * cellW);
+            const float overlap = ox * oy;
+            if (overlap <= 0.f)
+                continue;
+
+            const size_t index = j * _size.x() + i;
+            _samples[index] += time * overlap / area;
+            _coverage[index] += overlap / cellArea;
+        }
+    }
+}
+
+bool CostMap::commit(const float damping)
+{
+    LBASSERT(damping >= 0.f && damping <= 1.f);
+    bool committed = false;
+
+    for (size_t i = 0; i < _cost.size(); ++i)
+    {
+        if (_coverage[i] <= 0.f)
+            continue;
+
+        const float measured = _samples[i] / _coverage[i];
+        if (_hasData)
+            _cost[i] = damping * _cost[i] + (1.f - damping) * measured;
+        else
+            _cost[i] = measured;
+
+        _samples[i] = 0.f;
+        _coverage[i] = 0.f;
+        committed = true;
+    }
+
+    if (!committed)
+        return false;
+
+    _hasData = true;
+    _updateCentroid();
+    _predict(damping);
+    return true;
+}
+
+void CostMap::_updateCentroid()
+{
+    float total = 0.f;
+    Vector2f centroid(0.f, 0.f);
+
+    for (int j = 0; j < _size.y(); ++j)
+    {
+        const float y = (j + .5f) / float(_size.y());
+        for (int i = 0; i < _size.x(); ++i)
+        {
+            const float cost = _cost[j * _size.x() + i];
+            const float x = (i + .5f) / float(_size.x());
+            centroid.x() += x * cost;
+            centroid.y() += y * cost;
+            total += cost;
+        }
+    }
+
+    if (total <= 0.f)
+        return;
+
+    centroid /= total;
+    if (_hasCentroid)
+    {
+        // running average of the centroid motion of the last frames
+        Vector2f delta = centroid - _centroid;
+        delta.x() = std::max(-MAX_VELOCITY, std::min(delta.x(), MAX_VELOCITY));
+        delta.y() = std::max(-MAX_VELOCITY, std::min(delta.y(), MAX_VELOCITY));
+        _velocity = (_velocity + delta) * .5f;
+    }
+    _centroid = centroid;
+    _hasCentroid = true;
+}
+
+void CostMap::_predict(const float damping)
+{
+    if (!_predictive || (_velocity.x() == 0.f && _velocity.y() == 0.f))
+    {
+        _predicted = _cost;
+        return;
+    }
+
+    // Shift the histogram by the velocity, bilinear sampling in cell space.
+    // The damped histogram lags damping/(1-damping) frames behind, and the
+    // prediction is for the next frame.
+    const float frames = 1.f / std::max(1.f - damping, .1f);
+    const float dx = _velocity.x() * _size.x() * frames;
+    const float dy = _velocity.y() * _size.y() * frames;
+    const int maxX = _size.x() - 1;
+    const int maxY = _size.y() - 1;
+
+    for (int j = 0; j < _size.y(); ++j)
+    {
+        const float y = std::max(0.f, std::min(float(maxY), j - dy));
+        const int y0 = int(y);
+        const int y1 = std::min(y0 + 1, maxY);
+        const float fy = y - y0;
+
+        for (int i = 0; i < _size.x(); ++i)
+        {
+            const float x = std::max(0.f, std::min(float(maxX), i - dx));
+            const int x0 = int(x);
+            const int x1 = std::min(x0 + 1, maxX);
+            const float fx = x - x0;
+
+            const float bottom = (1.f - fx) * _cost[y0 * _size.x() + x0] +
+                                 fx * _cost[y0 * _size.x() + x1];
+            const float top = (1.f - fx) * _cost[y1 * _size.x() + x0] +
+                              fx * _cost[y1 * _size.x() + x1];
+            _predicted[j * _size.x() + i] = (1.f - fy) * bottom + fy * top;
+        }
+    }
+}
+
+float CostMap::getCost(const Viewport& vp) const
+{
+    if (!_hasData || !vp.hasArea())
+        return 0.f;
+
+    const float cellW = 1.f / float(_size.x());
+    const float cellH = 1.f / float(_size.y());
+    const float cellArea = cellW * cellH;
+
+    const Cells cells(_size, vp);
+
+    float cost = 0.f;
+    for (int j = cells.yStart; j < cells.yEnd; ++j)
+    {
+        const float oy =
+            _overlap(vp.y, vp.getYEnd(), j * cellH, (j + 1) * cellH);
+        for (int i = cells.xStart; i < cells.xEnd; ++i)
+        {
+            const float ox =
+                _overlap(vp.x, vp.getXEnd(), i * cellW, (i + 1) * cellW);
+            cost += _predicted[j * _size.x() + i] * ox * oy / cellArea;
+        }
+    }
+    return cost;
+}
+
+float CostMap::computeSplit(const Viewport& vp, const bool vertical,
+                            float fraction) const
+{
+    fraction = std::max(0.f, std::min(fraction, 1.f));
+    const float total = getCost(vp);
+    if (total <= 0.f)
+        return fraction;
+
+    // The cost is monotonic in the split position, bisect for the target
+    const float target = total * fraction;
+    float low = 0.f;
+    float high = 1.f;
+    for (size_t i = 0; i < SPLIT_ITERATIONS; ++i)
+    {
+        const float split = .5f * (low + high);
+        Viewport left = vp;
+        if (vertical)
+            left.w = vp.w * split;
+        else
+            left.h = vp.h * split;
+
+        if (getCost(left) < target)
+            low = split;
+        else
+            high = split;
+    }
+    return .5f * (low + high);
+}
+}
+}
@@ -0,0 +1,155 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQS_COSTMAP_H
+#define EQS_COSTMAP_H
+
+#include "../types.h"
+#include <eq/server/api.h>
+
+#include <eq/fabric/range.h>    // inline method
+#include <eq/fabric/viewport.h> // inline method
+
+#include <vector>
+
+namespace eq
+{
+namespace server
+{
+/**
+ * A coarse histogram of the rendering cost over a 2D viewport or DB range.
+ *
+ * Load samples of arbitrary regions are distributed uniformly onto the cells
+ * they cover. Since the regions reported by the render channels change from
+ * frame to frame, the histogram gradually resolves the non-uniform cost
+ * distribution within each region. The cost centroid is tracked over time and
+ * used to extrapolate the cost distribution of the next frame.
+ *
+ * DB ranges are mapped onto the x axis, i.e., the map should have a height of
+ * one cell for DB decompositions.
+ */
+class CostMap
+{
+public:
+    /** Construct a new, invalid cost map. */
+    EQSERVER_API CostMap();
+
+    /** Resize and clear the cost map. */
+    EQSERVER_API void resize(const Vector2i& size);
+
+    /** @return the number of cells in each dimension. */
+    const Vector2i& getSize() const { return _size; }
+
+    /** @return true if the cost map has at least one cell. */
+    bool isValid() const { return _size.x() > 0 && _size.y() > 0; }
+
+    /** @return true if cost samples have been committed. */
+    bool hasData() const { return _hasData; }
+
+    /** Clear all accumulated cost data. */
+    EQSERVER_API void clear();
+
+    /** @name Data Accumulation. */
+    //@{
+    /** Add the time spent rendering the given viewport. */
+    EQSERVER_API void addSample(const Viewport& vp, float time);
+
+    /** Add the time spent rendering the given range. */
+    void addSample(const Range& range, const float time)
+    {
+        addSample(_toViewport(range), time);
+    }
+
+    /**
+     * Merge all samples since the last commit into the cost histogram.
+     *
+     * @param damping the weight of the previous cost in each sampled cell.
+     * @return true if any sample was committed.
+     */
+    EQSERVER_API bool commit(float damping);
+    //@}
+
+    /** @name Prediction. */
+    //@{
+    /**
+     * Enable or disable motion extrapolation.
+     *
+     * When enabled, the predicted cost is the current histogram shifted by the
+     * motion of the cost centroid during the last committed frames.
+     */
+    void setPredictive(const bool onOff) { _predictive = onOff; }
+
+    /** @return true if motion extrapolation is enabled. */
+    bool isPredictive() const { return _predictive; }
+
+    /** @return the extrapolated motion per frame in normalized coordinates. */
+    const Vector2f& getVelocity() const { return _velocity; }
+    //@}
+
+    /** @name Cost Queries. */
+    //@{
+    /** @return the predicted cost of the given viewport. */
+    EQSERVER_API float getCost(const Viewport& vp) const;
+
+    /** @return the predicted cost of the given range. */
+    float getCost(const Range& range) const
+    {
+        return getCost(_toViewport(range));
+    }
+
+    /**
+     * Compute a split which equalizes the predicted cost.
+     *
+     * @param vp the viewport to split.
+     * @param vertical split along x if true, along y otherwise.
+     * @param fraction the fraction of the cost to assign to the left/bottom.
+     * @return the split position relative to vp, in [0,1].
+     */
+    EQSERVER_API float computeSplit(const Viewport& vp, bool vertical,
+                                    float fraction) const;
+
+    /** @return the relative split of the range at the given cost fraction. */
+    float computeSplit(const Range& range, const float fraction) const
+    {
+        return computeSplit(_toViewport(range), true, fraction);
+    }
+    //@}
+
+private:
+    Vector2i _size;
+    std::vector<float> _cost;      //!< committed cost per cell
+    std::vector<float> _predicted; //!< extrapolated cost per cell
+    std::vector<float> _samples;   //!< uncommitted cost per cell
+    std::vector<float> _coverage;  //!< uncommitted area per cell
+    Vector2f _centroid;
+    Vector2f _velocity;
+    bool _hasData;
+    bool _hasCentroid;
+    bool _predictive;
+
+    static Viewport _toViewport(const Range& range)
+    {
+        return Viewport(range.start, 0.f, range.getSize(), 1.f);
+    }
+
+    void _updateCentroid();
+    void _predict(float damping);
+};
+}
+}
+
+#endif // EQS_COSTMAP_H
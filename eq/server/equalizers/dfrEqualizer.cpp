@@ -30,11 +30,11 @@ namespace eq
 {
 namespace server
 {
-static const float MINSIZE = 128.f; // pixels
+static const float MINSIZE = 128.f;  // pixels
+static const float MINQUALITY = .5f; // compression quality at low zoom
 
 DFREqualizer::DFREqualizer()
-    : _current(getFrameRate())
-    , _lastTime(0)
+    : _lastTime(0)
 {
     LBINFO << "New DFREqualizer @" << (void*)this << std::endl;
 }
@@ -77,20 +77,14 @@ void DFREqualizer::notifyUpdatePre(Compound* compound, const uint32_t /*frame*/)
     if (isFrozen() || !compound->isActive() || !isActive())
     {
         compound->setZoom(Zoom::NONE);
+        compound->setQuality(1.f);
+        _controller.reset(1.f);
         return;
     }
 
     LBASSERT(getDamping() >= 0.f);
     LBASSERT(getDamping() <= 1.f);
 
-    const float factor =
-        (sqrtf(_current / getFrameRate()) - 1.f) * getDamping() + 1.f;
-
-    Zoom newZoom(compound->getZoom());
-    newZoom *= factor;
-
-    // LBINFO << _current << ": " << factor << " = " << newZoom << std::endl;
-
     // clip zoom factor to min, max( channel pvp )
     const Compound* parent = compound->getParent();
     const PixelViewport& pvp = parent->getInheritPixelViewport();
@@ -104,11 +98,19 @@ void DFREqualizer::notifyUpdatePre(Compound* compound, const uint32_t /*frame*/)
         LB_MIN(static_cast<float>(channelPVP.w) / static_cast<float>(pvp.w),
                static_cast<float>(channelPVP.h) / static_cast<float>(pvp.h));
 
-    newZoom.x() = LB_MAX(newZoom.x(), minZoom);
-    newZoom.x() = LB_MIN(newZoom.x(), maxZoom);
-    newZoom.y() = newZoom.x();
+    // the controller adapts the fraction of rendered pixels
+    _controller.setTarget(1000.f / getFrameRate());
+    _controller.setSmoothing(getDamping());
+    const float maxLevel = maxZoom * maxZoom;
+    _controller.setRange(LB_MIN(minZoom * minZoom, maxLevel), maxLevel);
+
+    const float zoom = sqrtf(_controller.update());
+    compound->setZoom(Zoom(zoom, zoom));
+    compound->setQuality(LB_MAX(MINQUALITY, LB_MIN(zoom, 1.f)));
 
-    compound->setZoom(newZoom);
+    LBLOG(LOG_LB1) << "Frame time " << _controller.getMean() << " +- "
+                   << sqrtf(_controller.getVariance()) << " zoom " << zoom
+                   << std::endl;
 }
 
 void DFREqualizer::notifyLoadData(Channel* channel, const uint32_t frameNumber,
@@ -143,7 +145,7 @@ void DFREqualizer::notifyLoadData(Channel* channel, const uint32_t frameNumber,
     if (_lastTime <= 0 || time <= 0)
         return;
 
-    _current = 1000.0f / static_cast<float>(time);
+    _controller.addSample(static_cast<float>(time));
     LBLOG(LOG_LB1) << "Frame " << frameNumber << " channel "
                    << channel->getName() << " time " << time << std::endl;
 }
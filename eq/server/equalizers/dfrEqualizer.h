@@ -18,8 +18,9 @@
 #ifndef EQS_DFREQUALIZER_H
 #define EQS_DFREQUALIZER_H
 
-#include "../channelListener.h" // base class
-#include "equalizer.h"          // base class
+#include "../channelListener.h"  // base class
+#include "equalizer.h"           // base class
+#include "frameTimeController.h" // member
 
 #include <deque>
 #include <map>
@@ -30,7 +31,12 @@ namespace server
 {
 std::ostream& operator<<(std::ostream& os, const DFREqualizer*);
 
-/** Tries to maintain a constant frame rate by adapting the compound zoom.*/
+/**
+ * Tries to maintain a constant frame rate by adapting the compound zoom.
+ *
+ * The zoom is driven by a frame time controller, and the compression quality of
+ * the compound's output frames is lowered together with the resolution.
+ */
 class DFREqualizer : public Equalizer, protected ChannelListener
 {
 public:
@@ -53,8 +59,8 @@ protected:
     void notifyChildAdded(Compound*, Compound*) override {}
     void notifyChildRemove(Compound*, Compound*) override {}
 private:
-    float _current;    //!< Framerate of the last finished frame
-    int64_t _lastTime; //!< Last frames' timestamp
+    FrameTimeController _controller; //!< Rendered pixel fraction
+    int64_t _lastTime;               //!< Last frames' timestamp
 };
 }
 }
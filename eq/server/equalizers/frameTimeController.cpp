@@ -0,0 +1,129 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "frameTimeController.h"
+
+#include <lunchbox/debug.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+// PID gains on the relative frame time error. The controller is in velocity
+// form, i.e., it computes the relative level change per frame.
+static const float KP = .2f;
+static const float KI = .3f;
+static const float KD = .05f;
+
+// hysteresis: start correcting above 15%, stop below 5% relative error
+static const float ERROR_LEAVE = .15f;
+static const float ERROR_ENTER = .05f;
+
+// the aimed frame time keeps this many standard deviations headroom
+static const float JITTER_WEIGHT = 1.f;
+static const float VARIANCE_SMOOTHING = .9f;
+}
+
+FrameTimeController::FrameTimeController()
+    : _target(10.f)
+    , _smoothing(.5f)
+    , _minLevel(0.f)
+    , _maxLevel(1.f)
+    , _level(1.f)
+{
+    reset(1.f);
+}
+
+void FrameTimeController::setRange(const float minLevel, const float maxLevel)
+{
+    LBASSERT(minLevel <= maxLevel);
+    _minLevel = minLevel;
+    _maxLevel = maxLevel;
+    _level = std::max(_minLevel, std::min(_level, _maxLevel));
+}
+
+void FrameTimeController::reset(const float level)
+{
+    _level = std::max(_minLevel, std::min(level, _maxLevel));
+    _mean = 0.f;
+    _variance = 0.f;
+    _error = 0.f;
+    _lastError = 0.f;
+    _hasSamples = false;
+    _newSamples = false;
+    _settled = true;
+}
+
+void FrameTimeController::addSample(const float time)
+{
+    if (time <= 0.f)
+        return;
+
+    _newSamples = true;
+    if (!_hasSamples)
+    {
+        _mean = time;
+        _variance = 0.f;
+        _hasSamples = true;
+        return;
+    }
+
+    const float delta = time - _mean;
+    _mean = _smoothing * _mean + (1.f - _smoothing) * time;
+    _variance = VARIANCE_SMOOTHING * _variance +
+                (1.f - VARIANCE_SMOOTHING) * delta * delta;
+}
+
+float FrameTimeController::update()
+{
+    if (!_newSamples || _target <= 0.f)
+        return _level;
+    _newSamples = false;
+
+    const float deviation = std::sqrt(_variance);
+    const float target = std::max(_target - JITTER_WEIGHT * deviation,
+                                  .5f * _target);
+    const float error = (target - _mean) / target;
+    const float proportional = error - _error;
+    const float derivative = error - 2.f * _error + _lastError;
+    _lastError = _error;
+    _error = error;
+
+    if (_settled)
+    {
+        if (std::abs(error) < ERROR_LEAVE)
+            return _level;
+        _settled = false;
+    }
+    else if (std::abs(error) < ERROR_ENTER)
+    {
+        _settled = true;
+        return _level;
+    }
+
+    const float change = KP * proportional + KI * error + KD * derivative;
+    const float level = _level * std::max(1.f + change, .5f);
+    _level = std::max(_minLevel, std::min(level, _maxLevel));
+    return _level;
+}
+}
+}
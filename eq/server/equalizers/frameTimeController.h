@@ -0,0 +1,98 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQS_FRAMETIMECONTROLLER_H
+#define EQS_FRAMETIMECONTROLLER_H
+
+#include <eq/server/api.h>
+
+namespace eq
+{
+namespace server
+{
+/**
+ * A PID controller holding the frame time at a target by adapting a level.
+ *
+ * The level is the relative amount of work per frame, e.g., the fraction of
+ * rendered pixels. The controller tracks the mean and variance of the measured
+ * frame times and aims at a mean one standard deviation below the target, so
+ * that most frames meet the target. Small errors are ignored with hysteresis
+ * to avoid a constantly changing level.
+ */
+class FrameTimeController
+{
+public:
+    /** Construct a new controller at the full level. */
+    EQSERVER_API FrameTimeController();
+
+    /** Set the target frame time in milliseconds. */
+    void setTarget(const float time) { _target = time; }
+
+    /** @return the target frame time in milliseconds. */
+    float getTarget() const { return _target; }
+
+    /** Set the weight of the history in the frame time statistics. */
+    void setSmoothing(const float smoothing) { _smoothing = smoothing; }
+
+    /** Set the range of the level. */
+    EQSERVER_API void setRange(float minLevel, float maxLevel);
+
+    /** Reset the statistics and controller state to the given level. */
+    EQSERVER_API void reset(float level);
+
+    /** Add the time of a finished frame. */
+    EQSERVER_API void addSample(float time);
+
+    /**
+     * Compute the level for the next frame from the samples since the last
+     * update.
+     *
+     * @return the new level.
+     */
+    EQSERVER_API float update();
+
+    /** @return the current level. */
+    float getLevel() const { return _level; }
+
+    /** @return the smoothed frame time. */
+    float getMean() const { return _mean; }
+
+    /** @return the smoothed frame time variance. */
+    float getVariance() const { return _variance; }
+
+    /** @return true if the frame time is within the hysteresis band. */
+    bool isSettled() const { return _settled; }
+
+private:
+    float _target;
+    float _smoothing;
+    float _minLevel;
+    float _maxLevel;
+    float _level;
+
+    float _mean;
+    float _variance;
+    float _error;
+    float _lastError;
+    bool _hasSamples;
+    bool _newSamples;
+    bool _settled;
+};
+}
+}
+
+#endif // EQS_FRAMETIMECONTROLLER_H
@@ -37,6 +37,8 @@ std::ostream& operator<<(std::ostream& os, const LoadEqualizer::Node*);
 
 LoadEqualizer::LoadEqualizer()
     : _tree(0)
+    , _totalResources(0.f)
+    , _totalTime(0.f)
 {
     LBVERB << "New LoadEqualizer @" << (void*)this << std::endl;
 }
@@ -44,6 +46,8 @@ LoadEqualizer::LoadEqualizer()
 LoadEqualizer::LoadEqualizer(const fabric::Equalizer& from)
     : Equalizer(from)
     , _tree(0)
+    , _totalResources(0.f)
+    , _totalTime(0.f)
 {
 }
 
@@ -91,6 +95,7 @@ void LoadEqualizer::notifyUpdatePre(Compound* compound,
         _history.back().first = frameNumber;
     }
 
+    _updateCosts();
     _update(_tree, Viewport(), Range());
     _computeSplit();
 }
@@ -172,10 +177,13 @@ void LoadEqualizer::notifyLoadData(Channel* channel, const uint32_t frameNumber,
             LBASSERTINFO(taskID > 0, channel->getName());
 
             // gather relevant load data
+            const bool isDB = getMode() == MODE_DB;
             int64_t startTime = std::numeric_limits<int64_t>::max();
             int64_t endTime = 0;
             bool loadSet = false;
             int64_t transmitTime = 0;
+            int64_t readbackTime = 0;
+            int64_t compressTime = 0;
             for (size_t k = 0; k < statistics.size(); ++k)
             {
                 const Statistic& stat = statistics[k];
@@ -188,13 +196,23 @@ void LoadEqualizer::notifyLoadData(Channel* channel, const uint32_t frameNumber,
 
                 switch (stat.type)
                 {
+                case Statistic::CHANNEL_READBACK:
+                    // full-size readback in DB does not scale with the range
+                    readbackTime += stat.endTime - stat.startTime;
+                    if (isDB)
+                        break;
+                // no break;
                 case Statistic::CHANNEL_CLEAR:
                 case Statistic::CHANNEL_DRAW:
-                case Statistic::CHANNEL_READBACK:
                     startTime = LB_MIN(startTime, stat.startTime);
                     endTime = LB_MAX(endTime, stat.endTime);
                     break;
 
+                // part of transmit, estimates decompression on destination
+                case Statistic::CHANNEL_FRAME_COMPRESS:
+                    compressTime += stat.endTime - stat.startTime;
+                    break;
+
                 case Statistic::CHANNEL_ASYNC_READBACK:
                 case Statistic::CHANNEL_FRAME_TRANSMIT:
                     transmitTime += stat.endTime - stat.startTime;
@@ -219,10 +237,16 @@ void LoadEqualizer::notifyLoadData(Channel* channel, const uint32_t frameNumber,
             data.vp.apply(region); // Update ROI
             data.time = endTime - startTime;
             data.time = LB_MAX(data.time, 1);
-            data.time = LB_MAX(data.time, transmitTime);
             data.assembleTime = LB_MAX(data.assembleTime, 0);
+            data.compressTime = compressTime;
+            if (isDB) // readback and transmission do not scale with the range
+                data.compositeTime = readbackTime + LB_MAX(transmitTime, 0);
+            else
+                data.time = LB_MAX(data.time, transmitTime);
+
             LBLOG(LOG_LB2) << "Added time " << data.time << " (+"
-                           << data.assembleTime << ") for "
+                           << data.assembleTime << ", +" << data.compositeTime
+                           << ") for "
                            << channel->getName() << " " << data.vp << ", "
                            << data.range << " @ " << frameNumber << std::endl;
             return;
@@ -350,29 +374,20 @@ void LoadEqualizer::_updateLeaf(Node* node)
     node->boundary2i = getBoundary2i();
     node->resistancef = getResistancef();
     node->resistance2i = getResistance2i();
-    if (!compound->hasDestinationChannel())
-        return;
 
-    const float nResources = _getTotalResources();
-    if (getAssembleOnlyLimit() <= nResources - node->resources)
+    if (compound->hasDestinationChannel() &&
+        getAssembleOnlyLimit() <= _totalResources - node->resources)
     {
         node->resources = 0.f;
         return; // OPT
     }
 
-    const float time = float(_getTotalTime());
-    const float assembleTime = float(_getAssembleTime());
-    if (assembleTime == 0.f || node->resources == 0.f)
-        return;
-
-    const float timePerResource = time / (nResources - node->resources);
-    const float renderTime = timePerResource * node->resources;
-
-    const float clampedAssembleTime = LB_MIN(assembleTime, renderTime);
-    const float newTimePerResource = (time + clampedAssembleTime) / nResources;
-    node->resources -= (clampedAssembleTime / newTimePerResource);
-    if (node->resources < 0.f) // may happen due to fp rounding
-        node->resources = 0.f;
+    // Balance the critical path of the pipelined frame: Reduce the resources of
+    // each leaf by its compositing cost, so that all leaves spend the same time
+    // per frame rendering and compositing.
+    node->resources =
+        _compositeModel.getResources(compound->getTaskID(), node->resources,
+                                     _totalResources, _totalTime);
 }
 
 void LoadEqualizer::_updateNode(Node* node, const Viewport& vp,
@@ -499,22 +514,19 @@ int64_t LoadEqualizer::_getTotalTime()
     return totalTime;
 }
 
-int64_t LoadEqualizer::_getAssembleTime()
+void LoadEqualizer::_updateCosts()
 {
+    _totalResources = _getTotalResources();
+    _totalTime = float(_getTotalTime());
+    _compositeModel.clear();
     if (getDamping() >= 1.f)
-        return 0;
+        return;
 
     const LBFrameData& frameData = _history.front();
-    const LBDatas& items = frameData.second;
-
-    int64_t assembleTime = 0;
-    for (LBDatas::const_iterator i = items.begin(); i != items.end(); ++i)
-    {
-        const Data& data = *i;
-        LBASSERT(assembleTime == 0 || data.assembleTime == 0);
-        assembleTime += data.assembleTime;
-    }
-    return assembleTime;
+    for (const Data& data : frameData.second)
+        _compositeModel.add(data.taskID, data.destTaskID != 0,
+                            data.compositeTime, data.assembleTime,
+                            data.compressTime);
 }
 
 void LoadEqualizer::_computeSplit()
@@ -557,7 +569,7 @@ void LoadEqualizer::_computeSplit()
 #endif
     }
 
-    const float time = float(_getTotalTime());
+    const float time = _totalTime;
     LBLOG(LOG_LB2) << "Render time " << time << " for " << _tree->resources
                    << " resources" << std::endl;
     if (_tree->resources > 0.f)
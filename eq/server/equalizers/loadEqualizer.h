@@ -20,6 +20,7 @@
 #define EQS_LOADEQUALIZER_H
 
 #include "../channelListener.h" // base class
+#include "compositeModel.h"     // member
 #include "equalizer.h"          // base class
 
 #include <eq/fabric/range.h>    // member
@@ -99,6 +100,8 @@ private:
             , destTaskID(0)
             , time(-1)
             , assembleTime(0)
+            , compositeTime(0)
+            , compressTime(0)
         {
         }
         Channel* channel;
@@ -108,6 +111,8 @@ private:
         Range range;
         int64_t time;
         int64_t assembleTime;
+        int64_t compositeTime; //!< DB readback and transmit time
+        int64_t compressTime;  //!< estimates decompression at destination
     };
 
     typedef std::vector<Data> LBDatas;
@@ -115,6 +120,11 @@ private:
 
     std::deque<LBFrameData> _history;
 
+    /** Costs of the front-most _history, computed once per update. */
+    CompositeModel _compositeModel;
+    float _totalResources;
+    float _totalTime;
+
     //-------------------- Methods --------------------
     /** @return true if we have a valid LB tree */
     Node* _buildTree(const Compounds& children);
@@ -128,9 +138,8 @@ private:
     /** get the total time used by the rendering. */
     int64_t _getTotalTime();
 
-    /** get the assembly time used by the compound which use
-        the destination Channel. */
-    int64_t _getAssembleTime();
+    /** Compute the costs of the front-most _history used by all leaves. */
+    void _updateCosts();
 
     /** Obsolete _history so that front-most item is youngest available. */
     void _checkHistory();
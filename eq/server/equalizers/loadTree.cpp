@@ -0,0 +1,179 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "loadTree.h"
+
+#include "../log.h"
+
+#include <lunchbox/debug.h>
+
+#include <cmath>
+
+namespace eq
+{
+namespace server
+{
+LoadTree::LoadTree()
+    : _tolerance(.005f)
+{
+}
+
+void LoadTree::clear()
+{
+    _nodes.clear();
+}
+
+size_t LoadTree::addLeaf()
+{
+    _nodes.push_back(Node());
+    return _nodes.size() - 1;
+}
+
+size_t LoadTree::addNode(const size_t left, const size_t right)
+{
+    LBASSERT(left < _nodes.size() && right < _nodes.size());
+    LBASSERT(_nodes[left].parent == NONE && _nodes[right].parent == NONE);
+
+    const size_t id = _nodes.size();
+    _nodes.push_back(Node());
+    Node& node = _nodes.back();
+    node.left = left;
+    node.right = right;
+    _nodes[left].parent = id;
+    _nodes[right].parent = id;
+
+    node.resources = _nodes[left].resources + _nodes[right].resources;
+    node.time = _nodes[left].time + _nodes[right].time;
+    node.dirty = true;
+    return id;
+}
+
+void LoadTree::setResources(const size_t leaf, const float resources)
+{
+    Node& node = _nodes[leaf];
+    LBASSERT(node.left == NONE);
+    if (node.resources == resources)
+        return;
+
+    node.resources = resources;
+    _propagate(leaf);
+}
+
+void LoadTree::setTime(const size_t leaf, const int64_t time)
+{
+    Node& node = _nodes[leaf];
+    LBASSERT(node.left == NONE);
+    if (node.time == time)
+        return;
+
+    node.time = time;
+    _propagate(leaf);
+}
+
+void LoadTree::_propagate(const size_t id)
+{
+    for (size_t i = _nodes[id].parent; i != NONE; i = _nodes[i].parent)
+    {
+        Node& node = _nodes[i];
+        const Node& left = _nodes[node.left];
+        const Node& right = _nodes[node.right];
+
+        node.resources = left.resources + right.resources;
+        if (left.resources == 0.f)
+            node.time = right.time;
+        else if (right.resources == 0.f)
+            node.time = left.time;
+        else
+            node.time = left.time + right.time;
+
+        node.dirty = left.dirty || right.dirty || _isImbalanced(node);
+    }
+}
+
+bool LoadTree::_isImbalanced(const Node& node) const
+{
+    const Node& left = _nodes[node.left];
+    const Node& right = _nodes[node.right];
+
+    if (left.resources == 0.f)
+        return node.split != 0.f;
+    if (right.resources == 0.f)
+        return node.split != 1.f;
+
+    const float leftRate = float(left.time) / left.resources;
+    const float rightRate = float(right.time) / right.resources;
+    return std::abs(leftRate - rightRate) > _tolerance * (leftRate + rightRate);
+}
+
+size_t LoadTree::update(const float damping)
+{
+    if (_nodes.empty())
+        return 0;
+    return _update(getRoot(), damping);
+}
+
+size_t LoadTree::_update(const size_t id, const float damping)
+{
+    Node& node = _nodes[id];
+    if (!node.dirty) // leaf, or no new imbalance in subtree
+        return 0;
+    node.dirty = false;
+
+    const size_t leftID = node.left;
+    const size_t rightID = node.right;
+    if (!_isImbalanced(node)) // keep split
+        return _update(leftID, damping) + _update(rightID, damping);
+
+    const Node& left = _nodes[node.left];
+    const Node& right = _nodes[node.right];
+
+    // easy outs
+    if (left.resources == 0.f)
+    {
+        node.split = 0.f;
+        return 1;
+    }
+    if (right.resources == 0.f)
+    {
+        node.split = 1.f;
+        return 1;
+    }
+
+    // new split
+    const float target = node.time * left.resources / node.resources;
+    const float leftTime = float(left.time);
+    const float rightTime = float(right.time);
+    float split = 0.f;
+
+    if (leftTime >= target)
+        split = target / leftTime * node.split;
+    else
+    {
+        const float timeLeft = target - leftTime;
+        split = node.split + timeLeft / rightTime * (1.f - node.split);
+    }
+
+    LBLOG(LOG_LB2) << "Should split at " << split << " (" << target << ": "
+                   << leftTime << " by " << left.resources << "/" << rightTime
+                   << " by " << right.resources << ")" << std::endl;
+    node.split = (1.f - damping) * split + damping * node.split;
+    LBLOG(LOG_LB2) << "Dampened split at " << node.split << std::endl;
+
+    return 1 + _update(leftID, damping) + _update(rightID, damping);
+}
+}
+}
@@ -0,0 +1,149 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQS_LOADTREE_H
+#define EQS_LOADTREE_H
+
+#include "../types.h"
+#include <eq/server/api.h>
+
+#include <vector>
+
+namespace eq
+{
+namespace server
+{
+/**
+ * Hierarchical load aggregation and split computation of a binary split tree.
+ *
+ * The tree is built bottom-up from leaves and inner nodes. Load updates of a
+ * leaf are propagated as summaries along its path to the root, so that each
+ * inner node holds the aggregated load of its subtree. When the subtrees are
+ * formed per render node, the upper splits balance the nodes against each
+ * other using their summaries.
+ *
+ * An inner node is dirty when its summary changed since the last update and
+ * its children are imbalanced by more than the tolerance. Updates only descend
+ * into subtrees containing dirty nodes, and keep the splits of balanced nodes.
+ */
+class LoadTree
+{
+public:
+    static const size_t NONE = size_t(-1);
+
+    /** Construct a new, empty load tree. */
+    EQSERVER_API LoadTree();
+
+    /** @name Tree construction. */
+    //@{
+    /** Remove all nodes. */
+    EQSERVER_API void clear();
+
+    /** @return the identifier of a new leaf. */
+    EQSERVER_API size_t addLeaf();
+
+    /** @return the identifier of a new inner node of the given children. */
+    EQSERVER_API size_t addNode(size_t left, size_t right);
+
+    /** @return the identifier of the root node. */
+    size_t getRoot() const { return _nodes.empty() ? NONE : _nodes.size() - 1; }
+
+    /** @return the number of leaves and inner nodes. */
+    size_t getSize() const { return _nodes.size(); }
+    //@}
+
+    /** @name Load data. */
+    //@{
+    /** Set the resources of a leaf, updating the summaries. */
+    EQSERVER_API void setResources(size_t leaf, float resources);
+
+    /** Set the last render time of a leaf, updating the summaries. */
+    EQSERVER_API void setTime(size_t leaf, int64_t time);
+
+    /** @return the aggregated resources of a node. */
+    float getResources(const size_t node) const
+    {
+        return _nodes[node].resources;
+    }
+
+    /** @return the aggregated render time of a node. */
+    int64_t getTime(const size_t node) const { return _nodes[node].time; }
+    //@}
+
+    /** @name Split computation. */
+    //@{
+    /**
+     * Recompute the splits of all dirty inner nodes.
+     *
+     * @param damping the weight of the current split.
+     * @return the number of recomputed splits.
+     */
+    EQSERVER_API size_t update(float damping);
+
+    /**
+     * Set the relative difference of the children's time per resource below
+     * which a split is kept, default 0.5%.
+     */
+    void setTolerance(const float tolerance) { _tolerance = tolerance; }
+
+    /** @return the tolerance of the split computation. */
+    float getTolerance() const { return _tolerance; }
+
+    /** Set the current, possibly constrained, split of an inner node. */
+    void setSplit(const size_t node, const float split)
+    {
+        _nodes[node].split = split;
+    }
+
+    /** @return the relative split of an inner node. */
+    float getSplit(const size_t node) const { return _nodes[node].split; }
+    //@}
+
+private:
+    struct Node
+    {
+        Node()
+            : left(NONE)
+            , right(NONE)
+            , parent(NONE)
+            , resources(0.f)
+            , time(1)
+            , split(.5f)
+            , dirty(false)
+        {
+        }
+
+        size_t left;
+        size_t right;
+        size_t parent;
+        float resources; //!< total amount of resources of subtree
+        int64_t time;    //!< total render time of subtree
+        float split;     //!< 0..1 local split
+        bool dirty;      //!< subtree has splits to recompute
+    };
+
+    std::vector<Node> _nodes;
+    float _tolerance;
+
+    void _propagate(size_t node);
+    bool _isImbalanced(const Node& node) const;
+    size_t _update(size_t node, float damping);
+};
+}
+}
+
+#endif // EQS_LOADTREE_H
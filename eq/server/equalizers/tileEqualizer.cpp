@@ -67,7 +67,7 @@ public:
         server->registerObject(input);
         input->setTileSize(_tileSize);
         input->setName(_name);
-        input->setAutoObsolete(compound->getConfig()->getLatency());
+        input->setAutoObsolete(compound->getConfig()->getMaxLatency());
 
         compound->addInputTileQueue(input);
         return TRAVERSE_CONTINUE;
@@ -140,7 +140,7 @@ void TileEqualizer::_createQueues(Compound* compound)
         server->registerObject(output);
         output->setTileSize(getTileSize());
         output->setName(name);
-        output->setAutoObsolete(compound->getConfig()->getLatency());
+        output->setAutoObsolete(compound->getConfig()->getMaxLatency());
 
         compound->addOutputTileQueue(output);
     }
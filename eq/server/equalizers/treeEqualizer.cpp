@@ -19,6 +19,7 @@
 #include "treeEqualizer.h"
 
 #include "../compound.h"
+#include "../config.h"
 #include "../log.h"
 
 #include <eq/fabric/statistic.h>
@@ -32,7 +33,9 @@ std::ostream& operator<<(std::ostream& os, const TreeEqualizer::Node*);
 
 // The tree load balancer organizes the children in a binary tree. At each
 // level, a relative split position is determined by balancing the left subtree
-// against the right subtree.
+// against the right subtree. Consecutive children of a render node form a
+// subtree, so that the upper levels balance the render nodes using their summed
+// load.
 
 TreeEqualizer::TreeEqualizer()
     : _tree(0)
@@ -55,7 +58,7 @@ TreeEqualizer::~TreeEqualizer()
 }
 
 void TreeEqualizer::notifyUpdatePre(Compound* compound,
-                                    const uint32_t /*frame*/)
+                                    const uint32_t frameNumber)
 {
     if (isFrozen() || !compound->isActive() || !isActive())
         return;
@@ -81,40 +84,77 @@ void TreeEqualizer::notifyUpdatePre(Compound* compound,
 
     // compute new data
     _update(_tree);
-    _split(_tree);
+    _updateCostMap(frameNumber);
+    if (!_costMap.hasData()) // else split during _assign using cost map
+        _loadTree.update(getDamping());
     _assign(_tree, Viewport(), Range());
     LBLOG(LOG_LB2) << "LB tree: " << _tree;
 }
 
 TreeEqualizer::Node* TreeEqualizer::_buildTree(const Compounds& compounds)
 {
+    // group consecutive children only, to keep the order of the tiles/ranges
+    std::vector<Compounds> groups;
+    const server::Node* last = 0;
+    for (Compound* compound : compounds)
+    {
+        const Channel* channel = compound->getChannel();
+        LBASSERT(channel);
+        const server::Node* node = channel->getNode();
+        if (groups.empty() || node != last)
+            groups.push_back(Compounds());
+        groups.back().push_back(compound);
+        last = node;
+    }
+
+    if (groups.size() == 1 || groups.size() == compounds.size())
+        return _buildTree(compounds, 0, compounds.size()); // no groups
+    return _buildTree(groups, 0, groups.size());
+}
+
+TreeEqualizer::Node* TreeEqualizer::_buildTree(
+    const std::vector<Compounds>& groups, const size_t begin, const size_t end)
+{
+    LBASSERT(end > begin);
+    if (end - begin == 1)
+    {
+        const Compounds& group = groups[begin];
+        return _buildTree(group, 0, group.size());
+    }
+
+    const size_t middle = begin + ((end - begin) >> 1);
+    Node* node = new Node;
+    node->left = _buildTree(groups, begin, middle);
+    node->right = _buildTree(groups, middle, end);
+    node->id = _loadTree.addNode(node->left->id, node->right->id);
+    return node;
+}
+
+TreeEqualizer::Node* TreeEqualizer::_buildTree(const Compounds& compounds,
+                                               const size_t begin,
+                                               const size_t end)
+{
+    LBASSERT(end > begin);
     Node* node = new Node;
 
-    const size_t size = compounds.size();
-    if (size == 1)
+    if (end - begin == 1)
     {
-        Compound* compound = compounds.front();
+        Compound* compound = compounds[begin];
 
         node->compound = compound;
+        node->id = _loadTree.addLeaf();
 
         Channel* channel = compound->getChannel();
         LBASSERT(channel);
         channel->addListener(this);
+        _leaves.insert(std::make_pair(channel, node));
         return node;
     }
 
-    const size_t middle = size >> 1;
-
-    Compounds left;
-    for (size_t i = 0; i < middle; ++i)
-        left.push_back(compounds[i]);
-
-    Compounds right;
-    for (size_t i = middle; i < size; ++i)
-        right.push_back(compounds[i]);
-
-    node->left = _buildTree(left);
-    node->right = _buildTree(right);
+    const size_t middle = begin + ((end - begin) >> 1);
+    node->left = _buildTree(compounds, begin, middle);
+    node->right = _buildTree(compounds, middle, end);
+    node->id = _loadTree.addNode(node->left->id, node->right->id);
     return node;
 }
 
@@ -136,24 +176,21 @@ void TreeEqualizer::_clearTree(Node* node)
     }
 }
 
-void TreeEqualizer::notifyLoadData(Channel* channel, const uint32_t /*frame*/,
+void TreeEqualizer::notifyLoadData(Channel* channel, const uint32_t frameNumber,
                                    const Statistics& statistics,
-                                   const Viewport& /*region*/)
+                                   const Viewport& region)
 {
-    _notifyLoadData(_tree, channel, statistics);
+    const auto range = _leaves.equal_range(channel);
+    for (auto i = range.first; i != range.second; ++i)
+        _notifyLoadData(i->second, channel, frameNumber, statistics, region);
 }
 
 void TreeEqualizer::_notifyLoadData(Node* node, Channel* channel,
-                                    const Statistics& statistics)
+                                    const uint32_t frameNumber,
+                                    const Statistics& statistics,
+                                    const Viewport& region)
 {
-    if (!node)
-        return;
-
-    _notifyLoadData(node->left, channel, statistics);
-    _notifyLoadData(node->right, channel, statistics);
-
-    if (!node->compound || node->compound->getChannel() != channel)
-        return;
+    LBASSERT(node->compound && node->compound->getChannel() == channel);
 
     // gather relevant load data
     const uint32_t taskID = node->compound->getTaskID();
@@ -194,9 +231,73 @@ void TreeEqualizer::_notifyLoadData(Node* node, Channel* channel,
     if (startTime == std::numeric_limits<int64_t>::max())
         return;
 
-    node->time = endTime - startTime;
-    node->time = LB_MAX(node->time, 1);
-    node->time = LB_MAX(node->time, timeTransmit);
+    int64_t time = endTime - startTime;
+    time = LB_MAX(time, 1);
+    time = LB_MAX(time, timeTransmit);
+    _loadTree.setTime(node->id, time);
+
+    if (_costMap.isValid())
+        _addCostSample(channel, frameNumber, region, time);
+}
+
+void TreeEqualizer::_updateCostMap(const uint32_t frameNumber)
+{
+    const Vector2i& size = getCostMapSize();
+    if (size.x() == 0 || size.y() == 0)
+    {
+        if (_costMap.isValid())
+        {
+            _costMap.resize(Vector2i(0, 0));
+            _history.clear();
+        }
+        return;
+    }
+
+    const Vector2i mapSize(size.x(), getMode() == MODE_DB ? 1 : size.y());
+    if (_costMap.getSize() != mapSize)
+    {
+        _costMap.resize(mapSize);
+        _history.clear();
+    }
+
+    _costMap.commit(getDamping());
+
+    // forget areas of frames which will not deliver load data anymore
+    const uint32_t latency = getConfig()->getMaxLatency() + 3;
+    while (!_history.empty() && _history.front().first + latency < frameNumber)
+        _history.pop_front();
+
+    _history.push_back(FrameAreas(frameNumber, Areas()));
+}
+
+void TreeEqualizer::_addCostSample(Channel* channel, const uint32_t frameNumber,
+                                   const Viewport& region, const int64_t time)
+{
+    for (const FrameAreas& frameAreas : _history)
+    {
+        if (frameAreas.first != frameNumber)
+            continue;
+
+        for (const Area& area : frameAreas.second)
+        {
+            if (area.channel != channel)
+                continue;
+
+            if (getMode() == MODE_DB)
+                _costMap.addSample(area.range, float(time));
+            else
+            {
+                Viewport vp = area.vp;
+                vp.apply(region); // ROI
+                _costMap.addSample(vp, float(time));
+            }
+            LBLOG(LOG_LB2) << "Cost sample " << time << " for "
+                           << channel->getName() << " " << area.vp << ", "
+                           << area.range << " @ " << frameNumber << std::endl;
+            return;
+        }
+        return;
+    }
 }
 
 void TreeEqualizer::_update(Node* node)
@@ -213,6 +314,7 @@ void TreeEqualizer::_update(Node* node)
 
         LBASSERT(node->mode != MODE_2D);
         node->resources = compound->isActive() ? compound->getUsage() : 0.f;
+        _loadTree.setResources(node->id, node->resources);
         node->maxSize.x() = pvp.w;
         node->maxSize.y() = pvp.h;
         node->boundaryf = getBoundaryf();
@@ -252,7 +354,6 @@ void TreeEqualizer::_update(Node* node)
         node->boundaryf = node->right->boundaryf;
         node->resistance2i = node->right->resistance2i;
         node->resistancef = node->right->resistancef;
-        node->time = node->right->time;
     }
     else if (node->right->resources == 0.f)
     {
@@ -261,7 +362,6 @@ void TreeEqualizer::_update(Node* node)
         node->boundaryf = node->left->boundaryf;
         node->resistance2i = node->left->resistance2i;
         node->resistancef = node->left->resistancef;
-        node->time = node->left->time;
     }
     else
     {
@@ -319,59 +419,14 @@ void TreeEqualizer::_update(Node* node)
         default:
             LBUNIMPLEMENTED;
         }
-
-        node->time = node->left->time + node->right->time;
     }
 }
 
-void TreeEqualizer::_split(Node* node)
-{
-    if (node->compound)
-        return;
-    LBASSERT(node->left && node->right);
-
-    Node* left = node->left;
-    Node* right = node->right;
-    // easy outs
-    if (left->resources == 0.f)
-    {
-        node->split = 0.f;
-        return;
-    }
-    if (right->resources == 0.f)
-    {
-        node->split = 1.f;
-        return;
-    }
-
-    // new split
-    const float target = node->time * left->resources / node->resources;
-    const float leftTime = float(left->time);
-    float split = 0.f;
-    const float rightTime = float(right->time);
-
-    if (leftTime >= target)
-        split = target / leftTime * node->split;
-    else
-    {
-        const float timeLeft = target - leftTime;
-        split = node->split + timeLeft / rightTime * (1.f - node->split);
-    }
-
-    LBLOG(LOG_LB2) << "Should split at " << split << " (" << target << ": "
-                   << leftTime << " by " << left->resources << "/" << rightTime
-                   << " by " << right->resources << ")" << std::endl;
-    node->split = (1.f - getDamping()) * split + getDamping() * node->split;
-    LBLOG(LOG_LB2) << "Dampened split at " << node->split << std::endl;
-
-    _split(left);
-    _split(right);
-}
-
 void TreeEqualizer::_assign(Node* node, const Viewport& vp, const Range& range)
 {
-    LBLOG(LOG_LB2) << "assign " << vp << ", " << range << " time " << node->time
-                   << " split " << node->split << std::endl;
+    LBLOG(LOG_LB2) << "assign " << vp << ", " << range << " time "
+                   << _loadTree.getTime(node->id) << " split " << node->split
+                   << std::endl;
     LBASSERTINFO(vp.isValid(), vp);
     LBASSERTINFO(range.isValid(), range);
     LBASSERTINFO(node->resources > 0.f || !vp.hasArea() || !range.hasData(),
@@ -387,9 +442,38 @@ void TreeEqualizer::_assign(Node* node, const Viewport& vp, const Range& range)
         compound->setRange(range);
         LBLOG(LOG_LB2) << compound->getChannel()->getName() << " set " << vp
                        << ", " << range << std::endl;
+
+        if (_costMap.isValid() && !_history.empty())
+            _history.back().second.push_back(
+                Area(compound->getChannel(), vp, range));
         return;
     }
 
+    node->split = _loadTree.getSplit(node->id);
+
+    // Split on the predicted cost. Not dampened, since the cost map is already
+    // dampened and dampening the split would reintroduce the lag the
+    // prediction compensates.
+    if (_costMap.hasData() && node->resources > 0.f)
+    {
+        const float fraction = node->left->resources / node->resources;
+        switch (node->mode)
+        {
+        case MODE_VERTICAL:
+            node->split = _costMap.computeSplit(vp, true, fraction);
+            break;
+        case MODE_HORIZONTAL:
+            node->split = _costMap.computeSplit(vp, false, fraction);
+            break;
+        case MODE_DB:
+            node->split = _costMap.computeSplit(range, fraction);
+            break;
+        default:
+            LBUNIMPLEMENTED;
+        }
+        LBLOG(LOG_LB2) << "Predicted split at " << node->split << std::endl;
+    }
+
     switch (node->mode)
     {
     case MODE_VERTICAL:
@@ -584,6 +668,9 @@ void TreeEqualizer::_assign(Node* node, const Viewport& vp, const Range& range)
     default:
         LBUNIMPLEMENTED;
     }
+
+    // base the next split on the constrained split
+    _loadTree.setSplit(node->id, node->split);
 }
 
 std::ostream& operator<<(std::ostream& os, const TreeEqualizer::Node* node)
@@ -631,6 +718,10 @@ std::ostream& operator<<(std::ostream& os, const TreeEqualizer* lb)
     if (lb->getResistancef() != .0f)
         os << "    resistance " << lb->getResistancef() << std::endl;
 
+    if (lb->getCostMapSize() != Vector2i(0, 0))
+        os << "    cost_map [ " << lb->getCostMapSize().x() << " "
+           << lb->getCostMapSize().y() << " ]" << std::endl;
+
     os << '}' << std::endl << lunchbox::enableFlush;
     return os;
 }
@@ -20,12 +20,15 @@
 #define EQS_TREEEQUALIZER_H
 
 #include "../channelListener.h" // base class
+#include "costMap.h"            // member
 #include "equalizer.h"          // base class
+#include "loadTree.h"           // member
 
 #include <eq/fabric/range.h>    // member
 #include <eq/fabric/viewport.h> // member
 
 #include <deque>
+#include <unordered_map>
 #include <vector>
 
 namespace eq
@@ -34,7 +37,16 @@ namespace server
 {
 std::ostream& operator<<(std::ostream& os, const TreeEqualizer*);
 
-/** Adapts the 2D tiling or DB range of the attached compound's children. */
+/**
+ * Adapts the 2D tiling or DB range of the attached compound's children.
+ *
+ * If a cost map size is set, the splits are computed from a predicted cost
+ * histogram instead of the last frame's total time of each subtree.
+ *
+ * Consecutive children on the same render node are grouped, keeping the
+ * children's order. Each group forms a subtree, and the groups are balanced
+ * against each other using their aggregated load.
+ */
 class TreeEqualizer : public Equalizer, protected ChannelListener
 {
 public:
@@ -67,7 +79,7 @@ private:
             , oldsplit(0.0f)
             , boundaryf(0.0f)
             , resistancef(0.0f)
-            , time(1)
+            , id(LoadTree::NONE)
         {
         }
         ~Node()
@@ -88,28 +100,63 @@ private:
         float resistancef;
         Vector2i resistance2i;
         Vector2i maxSize;
-        int64_t time;
+        size_t id; //<! The corresponding node in the load tree
     };
     friend std::ostream& operator<<(std::ostream& os, const Node* node);
     typedef std::vector<Node*> LBNodes;
 
     Node* _tree; // <! The binary split tree of all children
 
+    typedef std::unordered_multimap<const Channel*, Node*> LeafMap;
+    LeafMap _leaves;    //!< leaf nodes by channel
+    LoadTree _loadTree; //!< aggregated load and computed splits of _tree
+
+    struct Area
+    {
+        Area(Channel* channel_, const Viewport& vp_, const Range& range_)
+            : channel(channel_)
+            , vp(vp_)
+            , range(range_)
+        {
+        }
+
+        Channel* channel;
+        Viewport vp;
+        Range range;
+    };
+    typedef std::vector<Area> Areas;
+    typedef std::pair<uint32_t, Areas> FrameAreas;
+
+    CostMap _costMap;                //!< cost histogram, if enabled
+    std::deque<FrameAreas> _history; //!< assigned areas of the last frames
+
     //-------------------- Methods --------------------
-    /** @return true if we have a valid LB tree */
+    /** @return the split tree over the children, grouped by render node. */
     Node* _buildTree(const Compounds& children);
 
+    /** @return the split tree over the given groups. */
+    Node* _buildTree(const std::vector<Compounds>& groups, size_t begin,
+                     size_t end);
+
+    /** @return the split tree over the given children. */
+    Node* _buildTree(const Compounds& children, size_t begin, size_t end);
+
     /** Clear the tree, does not delete the nodes. */
     void _clearTree(Node* node);
 
-    void _notifyLoadData(Node* node, Channel* channel,
-                         const Statistics& statistics);
+    void _notifyLoadData(Node* node, Channel* channel, uint32_t frameNumber,
+                         const Statistics& statistics, const Viewport& region);
+
+    /** Resize the cost map if needed, and commit the last load data. */
+    void _updateCostMap(uint32_t frameNumber);
+
+    /** Add the load of a leaf to the cost map. */
+    void _addCostSample(Channel* channel, uint32_t frameNumber,
+                        const Viewport& region, int64_t time);
 
     /** Update all node fields influencing the split */
     void _update(Node* node);
 
-    /** Adjust the split of each node based on the front-most _history. */
-    void _split(Node* node);
     void _assign(Node* node, const Viewport& vp, const Range& range);
 };
 }
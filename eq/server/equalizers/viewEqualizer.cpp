@@ -382,7 +382,7 @@ void ViewEqualizer::_update(const uint32_t frameNumber)
     for (size_t i = 0; i < size; ++i)
     {
         Listener& listener = _listeners[i];
-        LBASSERTINFO(listener.getNLoads() <= getConfig()->getLatency() + 3,
+        LBASSERTINFO(listener.getNLoads() <= getConfig()->getMaxLatency() + 3,
                      listener);
 
         float& leftOver = leftOvers[i];
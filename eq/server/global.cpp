@@ -66,6 +66,8 @@ void Global::_setupDefaults()
 
     _configFAttributes[Config::FATTR_EYE_BASE] = 0.05f;
     _configIAttributes[Config::IATTR_ROBUSTNESS] = fabric::AUTO;
+    _configIAttributes[Config::IATTR_MAX_LATENCY] = fabric::OFF;
+    _configIAttributes[Config::IATTR_LAUNCH_CONCURRENCY] = 16;
 
     // node
     for (uint32_t i = 0; i < Node::CATTR_ALL; ++i)
@@ -75,6 +77,7 @@ void Global::_setupDefaults()
 
     _nodeIAttributes[Node::IATTR_LAUNCH_TIMEOUT] = 60000; // ms
     _nodeIAttributes[Node::IATTR_HINT_AFFINITY] = fabric::AUTO;
+    _nodeIAttributes[Node::IATTR_HINT_BATCH_TASKS] = fabric::OFF;
     _nodeSAttributes[Node::SATTR_LAUNCH_COMMAND] =
         "ssh -n %h %c --eq-logfile %q%d/%h.%n.log%q";
 #ifdef WIN32
@@ -124,6 +127,7 @@ void Global::_setupDefaults()
     _channelIAttributes[Channel::IATTR_HINT_STATISTICS] = fabric::NICEST;
 #endif
     _channelIAttributes[Channel::IATTR_HINT_SENDTOKEN] = fabric::OFF;
+    _channelIAttributes[Channel::IATTR_HINT_TEMPORAL_DELTA] = fabric::OFF;
 
     // compound
     for (uint32_t i = 0; i < Compound::IATTR_ALL; ++i)
@@ -0,0 +1,181 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "latencyController.h"
+
+#include <lunchbox/debug.h>
+
+#include <algorithm>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+// frames averaged per decision, after skipping the frames a change needs to
+// fill or drain the pipeline
+static const uint32_t WINDOW = 8;
+
+// raise if the application waits and the pipes idle above these ratios
+static const float WAIT_RAISE = .1f;
+static const float IDLE_RAISE = .1f;
+
+// lower if the application waits or the pipes idle below these ratios
+static const float WAIT_LOWER = .02f;
+static const float IDLE_LOWER = .02f;
+
+// a raise has to gain, a lower may lose at most this relative frame time
+static const float GAIN = .05f;
+
+// windows before a reverted change is probed again
+static const uint32_t BACKOFF = 16;
+}
+
+LatencyController::LatencyController()
+    : _minLatency(1)
+    , _maxLatency(1)
+    , _latency(1)
+{
+    reset(1);
+}
+
+void LatencyController::setRange(const uint32_t minLatency,
+                                 const uint32_t maxLatency)
+{
+    LBASSERT(minLatency <= maxLatency);
+    _minLatency = minLatency;
+    _maxLatency = maxLatency;
+    _latency = std::max(_minLatency, std::min(_latency, _maxLatency));
+}
+
+void LatencyController::reset(const uint32_t latency)
+{
+    _latency = std::max(_minLatency, std::min(latency, _maxLatency));
+    _decision = KEEP;
+    _skip = _latency;
+    _clearWindow();
+
+    _frameTime = 0.f;
+    _waitTime = 0.f;
+    _idle = 1.f;
+    _hasWindow = false;
+
+    _probe = KEEP;
+    _probeTime = 0.f;
+    _raiseBackoff = 0;
+    _lowerBackoff = 0;
+}
+
+void LatencyController::addSample(const float frameTime, const float waitTime,
+                                  const float idle)
+{
+    if (frameTime <= 0.f)
+        return;
+    if (_skip > 0)
+    {
+        --_skip;
+        return;
+    }
+
+    _frameTimeSum += frameTime;
+    _waitTimeSum += waitTime;
+    _idleSum += idle;
+    if (++_samples < WINDOW)
+        return;
+
+    const float samples = float(_samples);
+    _frameTime = _frameTimeSum / samples;
+    _waitTime = _waitTimeSum / samples;
+    _idle = _idleSum / samples;
+    _hasWindow = true;
+    _clearWindow();
+}
+
+uint32_t LatencyController::update()
+{
+    _decision = KEEP;
+    if (!_hasWindow || !isEnabled())
+        return _latency;
+    _hasWindow = false;
+
+    if (_raiseBackoff > 0)
+        --_raiseBackoff;
+    if (_lowerBackoff > 0)
+        --_lowerBackoff;
+
+    const Decision probe = _probe;
+    _probe = KEEP;
+    switch (probe)
+    {
+    case RAISE:
+        if (_frameTime >= _probeTime * (1.f - GAIN))
+        {
+            _raiseBackoff = BACKOFF;
+            _change(REVERT, _latency - 1);
+        }
+        return _latency;
+
+    case LOWER:
+        if (_frameTime > _probeTime * (1.f + GAIN))
+        {
+            _lowerBackoff = BACKOFF;
+            _change(REVERT, _latency + 1);
+        }
+        return _latency;
+
+    default:
+        break;
+    }
+
+    const float wait = _waitTime / _frameTime;
+    if (_latency < _maxLatency && _raiseBackoff == 0 && wait > WAIT_RAISE &&
+        _idle > IDLE_RAISE)
+    {
+        _change(RAISE, _latency + 1);
+    }
+    else if (_latency > _minLatency && _lowerBackoff == 0 &&
+             (wait < WAIT_LOWER || _idle < IDLE_LOWER))
+    {
+        _change(LOWER, _latency - 1);
+    }
+    return _latency;
+}
+
+void LatencyController::_clearWindow()
+{
+    _samples = 0;
+    _frameTimeSum = 0.f;
+    _waitTimeSum = 0.f;
+    _idleSum = 0.f;
+}
+
+void LatencyController::_change(const Decision decision,
+                                const uint32_t latency)
+{
+    if (decision != REVERT)
+    {
+        _probe = decision;
+        _probeTime = _frameTime;
+    }
+    _decision = decision;
+    _latency = std::max(_minLatency, std::min(latency, _maxLatency));
+    _skip = _latency;
+    _clearWindow();
+}
+}
+}
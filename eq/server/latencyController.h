@@ -0,0 +1,131 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQS_LATENCYCONTROLLER_H
+#define EQS_LATENCYCONTROLLER_H
+
+#include <eq/server/api.h>
+
+#include <cstdint>
+
+namespace eq
+{
+namespace server
+{
+/**
+ * Adapts the config latency between a lower and an upper bound.
+ *
+ * The controller averages the frame time, the time the application waits for
+ * the rendering and the pipe idle ratio over a window of frames. A waiting
+ * application with idle pipes is limited by synchronization, and the latency
+ * is raised to pipeline more frames. An application which does not wait, or
+ * saturated pipes, gain nothing from pipelining, and the latency is lowered
+ * for interactivity. Each change is a probe: a raise without a frame time gain
+ * or a lower with a frame time loss is reverted, and the same change is not
+ * tried again for a while.
+ */
+class LatencyController
+{
+public:
+    /** The decision of the last update. */
+    enum Decision
+    {
+        KEEP,  //!< The latency is unchanged
+        RAISE, //!< The latency was raised for throughput
+        LOWER, //!< The latency was lowered for interactivity
+        REVERT //!< The last change did not pay off and was undone
+    };
+
+    /** Construct a new, disabled controller. */
+    EQSERVER_API LatencyController();
+
+    /** Set the range of the latency. */
+    EQSERVER_API void setRange(uint32_t minLatency, uint32_t maxLatency);
+
+    /** @return the lower bound of the latency. */
+    uint32_t getMinLatency() const { return _minLatency; }
+
+    /** @return the upper bound of the latency. */
+    uint32_t getMaxLatency() const { return _maxLatency; }
+
+    /** @return true if the range allows latency changes. */
+    bool isEnabled() const { return _maxLatency > _minLatency; }
+
+    /** Reset the statistics and controller state to the given latency. */
+    EQSERVER_API void reset(uint32_t latency);
+
+    /**
+     * Add the timing of a frame.
+     *
+     * @param frameTime the time between two frame starts in milliseconds.
+     * @param waitTime the time the application waited for the rendering.
+     * @param idle the idle ratio of the least idle pipe.
+     */
+    EQSERVER_API void addSample(float frameTime, float waitTime, float idle);
+
+    /**
+     * Compute the latency for the next frame from the samples since the last
+     * update.
+     *
+     * @return the new latency.
+     */
+    EQSERVER_API uint32_t update();
+
+    /** @return the current latency. */
+    uint32_t getLatency() const { return _latency; }
+
+    /** @return the decision of the last update. */
+    Decision getDecision() const { return _decision; }
+
+    /** @return the mean frame time of the last window. */
+    float getFrameTime() const { return _frameTime; }
+
+    /** @return the mean application wait time of the last window. */
+    float getWaitTime() const { return _waitTime; }
+
+    /** @return the mean pipe idle ratio of the last window. */
+    float getIdle() const { return _idle; }
+
+private:
+    uint32_t _minLatency;
+    uint32_t _maxLatency;
+    uint32_t _latency;
+    Decision _decision;
+
+    uint32_t _skip;    // samples to skip while the pipeline adapts
+    uint32_t _samples; // samples in the current window
+    float _frameTimeSum;
+    float _waitTimeSum;
+    float _idleSum;
+
+    float _frameTime;
+    float _waitTime;
+    float _idle;
+    bool _hasWindow;
+
+    Decision _probe;        // last change under evaluation, or KEEP
+    float _probeTime;       // mean frame time before the probe
+    uint32_t _raiseBackoff; // windows without raising
+    uint32_t _lowerBackoff; // windows without lowering
+
+    void _clearWindow();
+    void _change(Decision decision, uint32_t latency);
+};
+}
+}
+
+#endif // EQS_LATENCYCONTROLLER_H
@@ -102,6 +102,7 @@
 %token EQTOKEN_GLOBAL
 %token EQTOKEN_CHANNEL_IATTR_HINT_STATISTICS
 %token EQTOKEN_CHANNEL_IATTR_HINT_SENDTOKEN
+%token EQTOKEN_CHANNEL_IATTR_HINT_TEMPORAL_DELTA
 %token EQTOKEN_CHANNEL_SATTR_DUMP_IMAGE
 %token EQTOKEN_COMPOUND_IATTR_STEREO_MODE
 %token EQTOKEN_COMPOUND_IATTR_STEREO_ANAGLYPH_LEFT_MASK
@@ -114,10 +115,13 @@
 %token EQTOKEN_CONNECTION_IATTR_PORT
 %token EQTOKEN_CONFIG_FATTR_EYE_BASE
 %token EQTOKEN_CONFIG_IATTR_ROBUSTNESS
+%token EQTOKEN_CONFIG_IATTR_MAX_LATENCY
+%token EQTOKEN_CONFIG_IATTR_LAUNCH_CONCURRENCY
 %token EQTOKEN_NODE_SATTR_LAUNCH_COMMAND
 %token EQTOKEN_NODE_CATTR_LAUNCH_COMMAND_QUOTE
 %token EQTOKEN_NODE_IATTR_THREAD_MODEL
 %token EQTOKEN_NODE_IATTR_HINT_AFFINITY
+%token EQTOKEN_NODE_IATTR_HINT_BATCH_TASKS
 %token EQTOKEN_NODE_IATTR_HINT_STATISTICS
 %token EQTOKEN_NODE_IATTR_LAUNCH_TIMEOUT
 %token EQTOKEN_PIPE_IATTR_HINT_THREAD
@@ -160,10 +164,12 @@
 %token EQTOKEN_HINT_DECORATION
 %token EQTOKEN_HINT_STATISTICS
 %token EQTOKEN_HINT_SENDTOKEN
+%token EQTOKEN_HINT_TEMPORAL_DELTA
 %token EQTOKEN_HINT_SWAPSYNC
 %token EQTOKEN_HINT_DRAWABLE
 %token EQTOKEN_HINT_THREAD
 %token EQTOKEN_HINT_AFFINITY
+%token EQTOKEN_HINT_BATCH_TASKS
 %token EQTOKEN_HINT_SCREENSAVER
 %token EQTOKEN_HINT_GRAB_POINTER
 %token EQTOKEN_PLANES_COLOR
@@ -234,6 +240,8 @@
 %token EQTOKEN_OPENCV_CAMERA
 %token EQTOKEN_VRPN_TRACKER
 %token EQTOKEN_ROBUSTNESS
+%token EQTOKEN_MAX_LATENCY
+%token EQTOKEN_LAUNCH_CONCURRENCY
 %token EQTOKEN_THREAD_MODEL
 %token EQTOKEN_ASYNC
 %token EQTOKEN_DRAW_SYNC
@@ -268,6 +276,7 @@
 %token EQTOKEN_LATENCY
 %token EQTOKEN_SWAPBARRIER
 %token EQTOKEN_NVGROUP
+%token EQTOKEN_FANIN
 %token EQTOKEN_NVBARRIER
 %token EQTOKEN_OUTPUTFRAME
 %token EQTOKEN_INPUTFRAME
@@ -287,6 +296,7 @@
 %token EQTOKEN_DB
 %token EQTOKEN_BOUNDARY
 %token EQTOKEN_RESISTANCE
+%token EQTOKEN_COSTMAP
 %token EQTOKEN_ZOOM
 %token EQTOKEN_MONO
 %token EQTOKEN_STEREO
@@ -375,6 +385,16 @@ global:
          eq::server::Global::instance()->setConfigIAttribute(
              eq::server::Config::IATTR_ROBUSTNESS, $2 );
      }
+     | EQTOKEN_CONFIG_IATTR_MAX_LATENCY IATTR
+     {
+         eq::server::Global::instance()->setConfigIAttribute(
+             eq::server::Config::IATTR_MAX_LATENCY, $2 );
+     }
+     | EQTOKEN_CONFIG_IATTR_LAUNCH_CONCURRENCY IATTR
+     {
+         eq::server::Global::instance()->setConfigIAttribute(
+             eq::server::Config::IATTR_LAUNCH_CONCURRENCY, $2 );
+     }
      | EQTOKEN_NODE_SATTR_LAUNCH_COMMAND STRING
      {
          eq::server::Global::instance()->setNodeSAttribute(
@@ -395,6 +415,11 @@ global:
          eq::server::Global::instance()->setNodeIAttribute(
              eq::server::Node::IATTR_HINT_AFFINITY, $2 );
      }
+     | EQTOKEN_NODE_IATTR_HINT_BATCH_TASKS IATTR
+     {
+         eq::server::Global::instance()->setNodeIAttribute(
+             eq::server::Node::IATTR_HINT_BATCH_TASKS, $2 );
+     }
      | EQTOKEN_NODE_IATTR_LAUNCH_TIMEOUT UNSIGNED
      {
          eq::server::Global::instance()->setNodeIAttribute(
@@ -530,6 +555,11 @@ global:
          eq::server::Global::instance()->setChannelIAttribute(
              eq::server::Channel::IATTR_HINT_SENDTOKEN, $2 );
      }
+     | EQTOKEN_CHANNEL_IATTR_HINT_TEMPORAL_DELTA IATTR
+     {
+         eq::server::Global::instance()->setChannelIAttribute(
+             eq::server::Channel::IATTR_HINT_TEMPORAL_DELTA, $2 );
+     }
      | EQTOKEN_COMPOUND_IATTR_STEREO_MODE IATTR
      {
          eq::server::Global::instance()->setCompoundIAttribute(
@@ -610,6 +640,10 @@ configAttribute:
                              eq::server::Config::FATTR_EYE_BASE, $2 ); }
     | EQTOKEN_ROBUSTNESS IATTR { config->setIAttribute(
                                  eq::server::Config::IATTR_ROBUSTNESS, $2 ); }
+    | EQTOKEN_MAX_LATENCY IATTR { config->setIAttribute(
+                                  eq::server::Config::IATTR_MAX_LATENCY, $2 ); }
+    | EQTOKEN_LAUNCH_CONCURRENCY IATTR { config->setIAttribute(
+                              eq::server::Config::IATTR_LAUNCH_CONCURRENCY, $2 ); }
 
 node: appNode | renderNode
 renderNode: EQTOKEN_NODE '{' {
@@ -667,6 +701,9 @@ nodeAttribute:
         }
     | EQTOKEN_HINT_AFFINITY IATTR
         { node->setIAttribute( eq::server::Node::IATTR_HINT_AFFINITY, $2 ); }
+    | EQTOKEN_HINT_BATCH_TASKS IATTR
+        { node->setIAttribute( eq::server::Node::IATTR_HINT_BATCH_TASKS,
+                               $2 ); }
 
 
 pipe: EQTOKEN_PIPE '{'
@@ -784,6 +821,9 @@ channelAttribute:
     | EQTOKEN_HINT_SENDTOKEN IATTR
         { channel->setIAttribute( eq::server::Channel::IATTR_HINT_SENDTOKEN,
                                   $2 ); }
+    | EQTOKEN_HINT_TEMPORAL_DELTA IATTR
+        { channel->setIAttribute(
+              eq::server::Channel::IATTR_HINT_TEMPORAL_DELTA, $2 ); }
     | EQTOKEN_DUMP_IMAGE STRING
         { channel->setSAttribute( eq::server::Channel::SATTR_DUMP_IMAGE,
                                   $2 ); }
@@ -1231,6 +1271,8 @@ treeEqualizerField:
     | EQTOKEN_RESISTANCE '[' UNSIGNED UNSIGNED ']'
         { treeEqualizer->setResistance( eq::fabric::Vector2i( $3, $4 )); }
     | EQTOKEN_RESISTANCE FLOAT  { treeEqualizer->setResistance( $2 ); }
+    | EQTOKEN_COSTMAP '[' UNSIGNED UNSIGNED ']'
+        { treeEqualizer->setCostMapSize( eq::fabric::Vector2i( $3, $4 )); }
 
 treeEqualizerMode:
     EQTOKEN_2D           { $$ = eq::server::TreeEqualizer::MODE_2D; }
@@ -1252,6 +1294,7 @@ swapBarrierFields: /*null*/ | swapBarrierFields swapBarrierField
 swapBarrierField: EQTOKEN_NAME STRING { swapBarrier->setName( $2 ); }
     | EQTOKEN_NVGROUP IATTR { swapBarrier->setNVSwapGroup( $2 ); }
     | EQTOKEN_NVBARRIER IATTR { swapBarrier->setNVSwapBarrier( $2 ); }
+    | EQTOKEN_FANIN UNSIGNED { swapBarrier->setFanIn( $2 ); }
 
 
 
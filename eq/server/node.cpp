@@ -34,6 +34,7 @@
 #include <eq/fabric/paths.h>
 
 #include <co/barrier.h>
+#include <co/oCommand.h>
 #include <co/global.h>
 #include <co/objectICommand.h>
 
@@ -76,15 +77,38 @@ bool _containsPrefix(const std::string& str, const Strings& prefixes)
 
     return false;
 }
+
+/** Records the start of each command written into the buffer. */
+class TaskBuffer : public co::BufferConnection
+{
+public:
+    explicit TaskBuffer(std::vector<uint64_t>& offsets)
+        : _offsets(offsets)
+    {
+    }
+
+protected:
+    // A command is written in one piece when it is sent, which may be after
+    // the next command has been created.
+    int64_t write(const void* buffer, const uint64_t bytes) override
+    {
+        _offsets.push_back(getBuffer().getSize());
+        return co::BufferConnection::write(buffer, bytes);
+    }
+
+private:
+    std::vector<uint64_t>& _offsets;
+};
 }
 
 Node::Node(Config* parent)
     : Super(parent)
     , _active(0)
     , _finishedFrame(0)
+    , _idle(1.f)
     , _flushedFrame(0)
     , _state(STATE_STOPPED)
-    , _bufferedTasks(new co::BufferConnection)
+    , _bufferedTasks(new TaskBuffer(_taskOffsets))
     , _lastDrawPipe(0)
 {
     const Global* global = Global::instance();
@@ -392,6 +416,7 @@ void Node::configInit(const uint128_t& initID, const uint32_t frameNumber)
     const Config* config = getConfig();
     _flushedFrame = config->getFinishedFrame();
     _finishedFrame = config->getFinishedFrame();
+    _idle = 1.f;
     _frameIDs.clear();
 
     LBLOG(LOG_INIT) << "Create node" << std::endl;
@@ -488,7 +513,7 @@ void Node::update(const uint128_t& frameID, const uint32_t frameNumber)
     LBLOG(LOG_TASKS) << "TASK node tasks finish " << std::endl;
 
     _finish(frameNumber);
-    flushSendBuffer();
+    _flushFrameTasks();
 }
 
 uint32_t Node::_getFinishLatency() const
@@ -575,7 +600,7 @@ co::Barrier* Node::getBarrier()
     if (_barriers.empty())
     {
         co::Barrier* barrier = new co::Barrier(getServer(), _node->getNodeID());
-        barrier->setAutoObsolete(getConfig()->getLatency() + 1);
+        barrier->setAutoObsolete(getConfig()->getMaxLatency() + 1);
         return barrier;
     }
     // else
@@ -643,6 +668,38 @@ EventOCommand Node::sendError(const uint32_t error)
 void Node::flushSendBuffer()
 {
     _bufferedTasks->sendBuffer(_node->getConnection());
+    _taskOffsets.clear();
+}
+
+void Node::_flushFrameTasks()
+{
+    if (getIAttribute(IATTR_HINT_BATCH_TASKS) != fabric::ON ||
+        _taskOffsets.size() < 2)
+    {
+        flushSendBuffer();
+        return;
+    }
+
+    // Send all tasks as one command, which the render client splits into the
+    // individual task commands. This saves the per-command receive overhead.
+    lunchbox::Bufferb& buffer = _bufferedTasks->getBuffer();
+    LBASSERT(_taskOffsets.front() == 0);
+    _taskOffsets.push_back(buffer.getSize());
+
+    std::vector<uint64_t> sizes(_taskOffsets.size() - 1);
+    for (size_t i = 0; i < sizes.size(); ++i)
+        sizes[i] = _taskOffsets[i + 1] - _taskOffsets[i];
+
+    co::OCommand(co::Connections(1, _node->getConnection()),
+                 fabric::CMD_CLIENT_FRAME_TASKS, co::COMMANDTYPE_NODE)
+        << uint64_t(sizes.size())
+        << co::Array<const uint64_t>(sizes.data(), sizes.size())
+        << co::Array<const uint8_t>(buffer.getData(), buffer.getSize());
+
+    LBLOG(LOG_TASKS) << "TASK node send " << sizes.size() << " tasks in "
+                     << buffer.getSize() << " bytes" << std::endl;
+    buffer.setSize(0);
+    _taskOffsets.clear();
 }
 
 //===========================================================================
@@ -676,6 +733,7 @@ bool Node::_cmdFrameFinishReply(co::ICommand& cmd)
     const uint32_t frameNumber = command.read<uint32_t>();
 
     _finishedFrame = frameNumber;
+    _idle = command.read<float>();
     getConfig()->notifyNodeFrameFinished(frameNumber);
 
     return true;
@@ -757,7 +815,9 @@ void Node::output(std::ostream& os) const
                          ? "thread_model         "
                          : i == Node::IATTR_HINT_AFFINITY
                                ? "hint_affinity        "
-                               : "ERROR")
+                               : i == Node::IATTR_HINT_BATCH_TASKS
+                                     ? "hint_batch_tasks     "
+                                     : "ERROR")
            << static_cast<fabric::IAttribute>(value) << std::endl;
     }
 
@@ -87,6 +87,9 @@ public:
     const Pipe* getLastDrawPipe() const { return _lastDrawPipe; }
     /** @return the number of the last finished frame. @internal */
     uint32_t getFinishedFrame() const { return _finishedFrame; }
+
+    /** @return the pipe idle ratio of the last finished frame. @internal */
+    float getIdleRatio() const { return _idle; }
     //@}
 
     /**
@@ -257,6 +260,9 @@ private:
     /** The number of the last finished frame. */
     uint32_t _finishedFrame;
 
+    /** The idle ratio of the least idle pipe in the last finished frame. */
+    float _idle;
+
     /** The number of the last flushed frame (frame finish command sent). */
     uint32_t _flushedFrame;
 
@@ -269,6 +275,9 @@ private:
     /** Task commands for the current operation. */
     co::BufferConnectionPtr _bufferedTasks;
 
+    /** The start of each command written to _bufferedTasks. */
+    std::vector<uint64_t> _taskOffsets;
+
     /** The last draw pipe for this entity */
     const Pipe* _lastDrawPipe;
 
@@ -295,6 +304,9 @@ private:
     /** Send the frame finish command for the given frame number. */
     void _sendFrameFinish(const uint32_t frameNumber);
 
+    /** Send the buffered frame tasks, as one command if batching is on. */
+    void _flushFrameTasks();
+
     /* ICommand handler functions. */
     bool _cmdConfigInitReply(co::ICommand& command);
     bool _cmdConfigExitReply(co::ICommand& command);
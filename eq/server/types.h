@@ -36,6 +36,7 @@ class Compound;
 class CompoundListener;
 class CompoundVisitor;
 class Config;
+class CostMap;
 class ConfigVisitor;
 class DFREqualizer;
 class Equalizer;
@@ -130,6 +131,7 @@ using fabric::SwapBarrier;
 using fabric::SwapBarrierConstPtr;
 using fabric::SwapBarrierPtr;
 using fabric::Tile;
+using fabric::Vector2f;
 using fabric::Vector2i;
 using fabric::Vector3f;
 using fabric::Vector3ub;
@@ -210,6 +210,7 @@ void Window::_resetSwapBarriers()
     _nvNetBarrier = 0;
     _masterBarriers.clear();
     _barriers.clear();
+    _barrierTrees.clear();
 }
 
 co::Barrier* Window::joinSwapBarrier(co::Barrier* barrier)
@@ -265,6 +266,19 @@ co::Barrier* Window::joinSwapBarrier(co::Barrier* barrier)
     return barrier;
 }
 
+void Window::joinSwapBarrierTree(const co::Barriers& path, const bool release)
+{
+    _swapFinish = true;
+    _barrierTrees.push_back(std::make_pair(path, release));
+}
+
+co::Barrier* Window::newSwapBarrier()
+{
+    co::Barrier* barrier = getNode()->getBarrier();
+    _masterBarriers.push_back(barrier);
+    return barrier;
+}
+
 co::Barrier* Window::joinNVSwapBarrier(SwapBarrierConstPtr swapBarrier,
                                        co::Barrier* netBarrier)
 {
@@ -449,6 +463,17 @@ void Window::_updateSwap(const uint32_t frameNumber)
                          << co::ObjectVersion(barrier) << std::endl;
     }
 
+    for (const auto& tree : _barrierTrees)
+    {
+        co::ObjectVersions path;
+        for (const co::Barrier* barrier : tree.first)
+            path.push_back(co::ObjectVersion(barrier));
+
+        send(fabric::CMD_WINDOW_TREE_BARRIER) << path << tree.second;
+        LBLOG(LOG_TASKS) << "TASK tree barrier, " << path.size() << " levels"
+                         << std::endl;
+    }
+
     if (_nvNetBarrier)
     {
         if (_nvNetBarrier->getHeight() <= 1)
@@ -109,6 +109,18 @@ public:
     co::Barrier* joinNVSwapBarrier(SwapBarrierConstPtr swapBarrier,
                                    co::Barrier* netBarrier);
 
+    /**
+     * Join a tree swap barrier for the next update.
+     *
+     * @param path the barriers to enter, bottom up.
+     * @param release true if the topmost barrier is not the root.
+     * @sa SwapBarrier::enter()
+     */
+    void joinSwapBarrierTree(const co::Barriers& path, bool release);
+
+    /** @return a new barrier served by this window's node for this frame. */
+    co::Barrier* newSwapBarrier();
+
     /** @return true if this window has entered a NV_swap_group. */
     bool hasNVSwapBarrier() const { return (_nvSwapBarrier != 0); }
     /** The last drawing channel for this entity. @internal */
@@ -181,6 +193,8 @@ private:
     co::Barriers _masterBarriers;
     /** The list of slave swap barriers for the current frame. */
     co::Barriers _barriers;
+    /** The tree swap barrier paths and release flags for this frame. */
+    std::vector<std::pair<co::Barriers, bool>> _barrierTrees;
 
     /** The hardware swap barrier to use. */
     SwapBarrierConstPtr _nvSwapBarrier;
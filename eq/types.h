@@ -43,6 +43,7 @@ class EventICommand;
 class Frame;
 class FrameData;
 class Image;
+class ImageWriter;
 class Layout;
 class MessagePump;
 class Node;
@@ -18,14 +18,13 @@
 
 #include "view.h"
 
-#include "compositor.h"
 #include "config.h"
 #include "eventICommand.h"
 #include "image.h"
-#include "imageOp.h"
 #include "layout.h"
 #include "observer.h"
 #include "pipe.h"
+#include "pixelData.h"
 #include "server.h"
 
 #include <eq/fabric/commands.h>
@@ -33,52 +32,211 @@
 
 #include <co/dataIStream.h>
 #include <co/dataOStream.h>
+#include <lunchbox/clock.h>
 #include <lunchbox/scopedMutex.h>
 #include <lunchbox/spinLock.h>
 
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <vector>
+
 namespace eq
 {
+namespace
+{
+// recycled full-view images kept for later screenshots
+static const size_t MAX_FREE_IMAGES = 2;
+
+/** @return the area of the union of the given viewports within the view. */
+float _getCoverage(const std::vector<Viewport>& tiles)
+{
+    // sweep the vertical slabs between all tile edges, merging the covered
+    // vertical intervals of each slab
+    std::vector<float> xs;
+    for (const Viewport& vp : tiles)
+    {
+        xs.push_back(std::max(vp.x, 0.f));
+        xs.push_back(std::min(vp.getXEnd(), 1.f));
+    }
+    std::sort(xs.begin(), xs.end());
+    xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+
+    float coverage = 0.f;
+    std::vector<std::pair<float, float>> intervals;
+    for (size_t i = 1; i < xs.size(); ++i)
+    {
+        const float x = (xs[i - 1] + xs[i]) * .5f;
+        intervals.clear();
+        for (const Viewport& vp : tiles)
+            if (vp.x <= x && vp.getXEnd() >= x)
+                intervals.emplace_back(std::max(vp.y, 0.f),
+                                       std::min(vp.getYEnd(), 1.f));
+        std::sort(intervals.begin(), intervals.end());
+
+        float height = 0.f;
+        float end = 0.f;
+        for (const auto& interval : intervals)
+        {
+            const float start = std::max(interval.first, end);
+            if (interval.second > start)
+            {
+                height += interval.second - start;
+                end = interval.second;
+            }
+        }
+        coverage += height * (xs[i] - xs[i - 1]);
+    }
+    return coverage;
+}
+}
+
 namespace detail
 {
 class View
 {
 public:
+    View()
+        : recording(false)
+    {
+    }
+
     lunchbox::SpinLock eventLock; //!< event-handling resize synchronizer
 
     /** Unmodified, baseline view frustum data, used for resizing. */
     Frustum baseFrustum;
 
+    /** A full-view screenshot assembled from the channel tiles. */
     struct Screenshot
     {
-        std::unique_ptr<eq::Image> _image;
-        Viewport _viewport;
-
-        bool isComplete() const { return _viewport == Viewport::FULL; }
-        void composite(const Viewport& viewport, const eq::Image& image)
+        Screenshot()
+            : buffers(Frame::Buffer::none)
         {
-            if (!_image)
-            {
-                _viewport = viewport;
-                _image.reset(new eq::Image(image));
-                return;
-            }
-
-            ImageOps ops;
-            ImageOp current;
-            current.image = _image.get();
-            ImageOp newImage;
-            newImage.image = &image;
-
-            ops.push_back(current);
-            ops.push_back(newImage);
-            _image.reset(
-                new eq::Image(*Compositor::mergeImagesCPU(ops, false)));
-            _viewport.unite(viewport);
         }
+
+        std::unique_ptr<eq::Image> image;
+        Frame::Buffer buffers;       //!< buffers allocated in image
+        std::vector<Viewport> tiles; //!< the viewports of the received tiles
+
+        /** @return true if the tiles cover the view, overlaps counted once. */
+        bool isComplete() const { return _getCoverage(tiles) >= .9999f; }
     };
 
-    std::map<uint32_t, Screenshot> screenshot;
+    typedef std::pair<uint32_t, std::unique_ptr<eq::Image>> RecordedImage;
+
+    std::map<uint32_t, Screenshot> screenshots; //!< frames in assembly
+    std::deque<RecordedImage> recorded;         //!< complete frames
+    std::unique_ptr<eq::Image> popped; //!< last popRecordedImage() result
+    std::vector<std::unique_ptr<eq::Image>> freeImages;
     eq::View::ScreenshotFunc screenshotFunc;
+    bool recording;
+
+    std::unique_ptr<eq::Image> obtainImage()
+    {
+        if (freeImages.empty())
+            return std::unique_ptr<eq::Image>(new eq::Image);
+
+        std::unique_ptr<eq::Image> image = std::move(freeImages.back());
+        freeImages.pop_back();
+        return image;
+    }
+
+    void releaseImage(std::unique_ptr<eq::Image> image)
+    {
+        if (image && freeImages.size() < MAX_FREE_IMAGES)
+            freeImages.push_back(std::move(image));
+    }
+
+    void clearScreenshots()
+    {
+        for (auto& i : screenshots)
+            releaseImage(std::move(i.second.image));
+        for (auto& i : recorded)
+            releaseImage(std::move(i.second));
+        releaseImage(std::move(popped));
+        screenshots.clear();
+        recorded.clear();
+    }
+
+    /** Drop frames older than the completed one, their tiles are lost. */
+    void clearScreenshots(const uint32_t frameNumber)
+    {
+        while (!screenshots.empty() &&
+               screenshots.begin()->first < frameNumber)
+        {
+            releaseImage(std::move(screenshots.begin()->second.image));
+            screenshots.erase(screenshots.begin());
+        }
+    }
+
+    /** Copy one received tile into the full-view screenshot image. */
+    void composite(Screenshot& screenshot, const Viewport& vp,
+                   const Frame::Buffer buffer, const PixelData& tile)
+    {
+        if (!screenshot.image)
+        {
+            screenshot.image = obtainImage();
+            const PixelViewport pvp(0, 0, std::lround(tile.pvp.w / vp.w),
+                                    std::lround(tile.pvp.h / vp.h));
+            screenshot.image->setPixelViewport(pvp);
+        }
+
+        eq::Image& image = *screenshot.image;
+        if (!(screenshot.buffers & buffer))
+        {
+            _allocate(image, buffer, tile);
+            screenshot.buffers |= buffer;
+        }
+        else if (image.getExternalFormat(buffer) != tile.externalFormat ||
+                 image.getPixelSize(buffer) != tile.pixelSize)
+        {
+            LBWARN << "Ignoring screenshot tile of incompatible format"
+                   << std::endl;
+            return;
+        }
+
+        const PixelViewport& pvp = image.getPixelViewport();
+        const int32_t x = std::lround(vp.x * pvp.w);
+        const int32_t y = std::lround(vp.y * pvp.h);
+        const int32_t w = std::min(tile.pvp.w, pvp.w - x);
+        const int32_t h = std::min(tile.pvp.h, pvp.h - y);
+        if (w <= 0 || h <= 0)
+            return;
+
+        const size_t pixelSize = tile.pixelSize;
+        const size_t srcStride = tile.pvp.w * pixelSize;
+        const size_t dstStride = pvp.w * pixelSize;
+        const uint8_t* src = reinterpret_cast<const uint8_t*>(tile.pixels);
+        uint8_t* dst = image.getPixelPointer(buffer) + y * dstStride +
+                       x * pixelSize;
+
+        for (int32_t i = 0; i < h; ++i)
+            memcpy(dst + i * dstStride, src + i * srcStride, w * pixelSize);
+    }
+
+private:
+    void _allocate(eq::Image& image, const Frame::Buffer buffer,
+                   const PixelData& tile)
+    {
+        // all tiles are overwritten, reuse pixel memory without clearing it
+        if (image.getExternalFormat(buffer) == tile.externalFormat &&
+            image.getPixelSize(buffer) == tile.pixelSize &&
+            image.getInternalFormat(buffer) == tile.internalFormat &&
+            image.getPixelDataSize(buffer) ==
+                image.getPixelViewport().getArea() * tile.pixelSize)
+        {
+            image.validatePixelData(buffer);
+            return;
+        }
+
+        PixelData data;
+        data.internalFormat = tile.internalFormat;
+        data.externalFormat = tile.externalFormat;
+        data.pixelSize = tile.pixelSize;
+        data.pvp = image.getPixelViewport();
+        data.pixels = 0;
+        image.setPixelData(buffer, data); // allocates and clears
+    }
 };
 }
 
@@ -207,13 +365,74 @@ void View::enableScreenshot(Frame::Buffer buffers, const ScreenshotFunc& func)
 void View::disableScreenshot()
 {
     Super::_setScreenshotBuffers(Frame::Buffer::none);
+    _impl->recording = false;
+    _impl->clearScreenshots();
+}
+
+void View::setRecording(const Frame::Buffer buffers)
+{
+    Super::_setScreenshotBuffers(buffers);
+    _impl->recording = buffers != Frame::Buffer::none;
+    _impl->clearScreenshots();
+}
+
+const Image* View::popRecordedImage(uint32_t& frameNumber,
+                                    const uint32_t timeout)
+{
+    Config* config = getConfig();
+    const lunchbox::Clock clock;
+    while (_impl->recorded.empty() && _impl->recording)
+    {
+        uint32_t wait = timeout;
+        if (timeout != LB_TIMEOUT_INDEFINITE)
+        {
+            const int64_t elapsed = clock.getTime64();
+            if (elapsed >= int64_t(timeout))
+                break;
+            wait = timeout - uint32_t(elapsed);
+        }
+
+        EventICommand event = config->getNextEvent(wait);
+        if (!event.isValid())
+            break;
+        config->handleEvent(event);
+    }
+
+    if (_impl->recorded.empty())
+        return 0;
+
+    _impl->releaseImage(std::move(_impl->popped));
+    frameNumber = _impl->recorded.front().first;
+    _impl->popped = std::move(_impl->recorded.front().second);
+    _impl->recorded.pop_front();
+    return _impl->popped.get();
 }
 
 void View::sendScreenshotEvent(const Viewport& viewport,
                                const uint32_t frameNumber, const Image& image)
 {
-    getConfig()->sendEvent(EVENT_VIEW_SCREENSHOT) << getID() << viewport
-                                                  << frameNumber << image;
+    // Send the raw tiles, which are copied straight from the received command
+    // into the full-view image by _handleScreenshot
+    const Frame::Buffer buffers = getScreenshotBuffers();
+    const Frame::Buffer types[] = {Frame::Buffer::color, Frame::Buffer::depth};
+    uint32_t nBuffers = 0;
+    for (const Frame::Buffer buffer : types)
+        if ((buffers & buffer) && image.hasPixelData(buffer))
+            ++nBuffers;
+
+    EventOCommand event = getConfig()->sendEvent(EVENT_VIEW_SCREENSHOT);
+    event << getID() << viewport << frameNumber << nBuffers;
+    for (const Frame::Buffer buffer : types)
+    {
+        if (!(buffers & buffer) || !image.hasPixelData(buffer))
+            continue;
+
+        const PixelData& data = image.getPixelData(buffer);
+        const size_t size = data.pvp.getArea() * data.pixelSize;
+        event << uint32_t(buffer) << data.internalFormat
+              << data.externalFormat << data.pixelSize << data.pvp
+              << co::Array<void>(data.pixels, size);
+    }
 }
 
 bool View::handleEvent(EventICommand& command)
@@ -230,17 +449,55 @@ bool View::_handleScreenshot(EventICommand& command)
 {
     const auto& vp = command.read<Viewport>();
     const auto frameNumber = command.read<uint32_t>();
-    const auto& newImage = command.read<Image>();
+    const auto nBuffers = command.read<uint32_t>();
 
-    auto& screenshot = _impl->screenshot[frameNumber];
-    screenshot.composite(vp, newImage);
+    // tiles still in flight after disableScreenshot() or setRecording()
+    if (getScreenshotBuffers() == Frame::Buffer::none)
+        return true;
 
-    if (screenshot.isComplete())
+    auto& screenshot = _impl->screenshots[frameNumber];
+    for (uint32_t i = 0; i < nBuffers; ++i)
     {
-        _impl->screenshotFunc(frameNumber, *screenshot._image);
-        _impl->screenshot.erase(frameNumber);
+        const Frame::Buffer buffer = Frame::Buffer(command.read<uint32_t>());
+        PixelData tile;
+        command >> tile.internalFormat >> tile.externalFormat >>
+            tile.pixelSize >> tile.pvp;
+
+        const size_t size = tile.pvp.getArea() * tile.pixelSize;
+        tile.pixels = const_cast<void*>(command.getRemainingBuffer(size));
+        if (tile.pvp.hasArea())
+            _impl->composite(screenshot, vp, buffer, tile);
+        tile.pixels = 0;
     }
 
+    screenshot.tiles.push_back(vp);
+    if (!screenshot.isComplete())
+        return true;
+
+    std::unique_ptr<Image> image = std::move(screenshot.image);
+    _impl->screenshots.erase(frameNumber);
+    _impl->clearScreenshots(frameNumber);
+    if (!image)
+        return true;
+
+    if (_impl->screenshotFunc)
+        _impl->screenshotFunc(frameNumber, *image);
+
+    if (!_impl->recording)
+    {
+        _impl->releaseImage(std::move(image));
+        return true;
+    }
+
+    const size_t maxRecorded = getConfig()->getMaxLatency() + 1;
+    while (_impl->recorded.size() >= maxRecorded)
+    {
+        LBVERB << "Dropping recorded screenshot of frame "
+               << _impl->recorded.front().first << std::endl;
+        _impl->releaseImage(std::move(_impl->recorded.front().second));
+        _impl->recorded.pop_front();
+    }
+    _impl->recorded.emplace_back(frameNumber, std::move(image));
     return true;
 }
 }
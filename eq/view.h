@@ -111,12 +111,46 @@ public:
     /** Stop recording of screenshots. @version 2.1 */
     EQ_API void disableScreenshot();
 
+    /**
+     * Record full-view screenshots of the given buffers.
+     *
+     * The tiles of all destination channels of this view are assembled into a
+     * view-sized image on the application node while processing events. Up to
+     * latency+1 complete screenshots are queued for popRecordedImage(); when
+     * the queue is full, the oldest screenshot is dropped so that recording
+     * never stalls rendering. Frame::Buffer::none stops recording and clears
+     * the queue. To be called only on the application node.
+     *
+     * @param buffers bitmask of buffers to capture in screenshot image
+     * @version 2.1
+     */
+    EQ_API void setRecording(Frame::Buffer buffers);
+
+    /**
+     * Get the oldest recorded screenshot.
+     *
+     * Handles config events until a screenshot is available, recording is
+     * stopped or the timeout expires. A timeout of 0 does not block. The
+     * returned image is owned by this view and valid until the next call to
+     * popRecordedImage(), setRecording() or disableScreenshot(). Not thread
+     * safe, to be called from the application main thread.
+     *
+     * @param frameNumber returns the frame number of the screenshot.
+     * @param timeout time in ms to wait for a screenshot.
+     * @return the screenshot, or 0 if none is available.
+     * @version 2.1
+     */
+    EQ_API const Image* popRecordedImage(
+        uint32_t& frameNumber,
+        uint32_t timeout = LB_TIMEOUT_INDEFINITE);
+
     /** @internal */
     bool handleEvent(EventICommand& command);
 
     /** @internal */
-    void sendScreenshotEvent(const Viewport& viewport,
-                             const uint32_t frameNumber, const Image& image);
+    EQ_API void sendScreenshotEvent(const Viewport& viewport,
+                                    const uint32_t frameNumber,
+                                    const Image& image);
     //@}
 
 protected:
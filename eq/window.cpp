@@ -42,6 +42,7 @@
 #include <eq/fabric/leafVisitor.h>
 #include <eq/fabric/pointerEvent.h>
 #include <eq/fabric/sizeEvent.h>
+#include <eq/fabric/swapBarrier.h>
 #include <eq/fabric/task.h>
 #include <eq/util/objectManager.h>
 
@@ -92,6 +93,7 @@ void Window::attach(const uint128_t& id, const uint32_t instanceID)
     Super::attach(id, instanceID);
 
     co::CommandQueue* queue = getPipeThreadQueue();
+    co::CommandQueue* priorityQ = getPipe()->getPipeThreadPriorityQueue();
 
     registerCommand(fabric::CMD_WINDOW_CREATE_CHANNEL,
                     WindowFunc(this, &Window::_cmdCreateChannel), queue);
@@ -102,7 +104,8 @@ void Window::attach(const uint128_t& id, const uint32_t instanceID)
     registerCommand(fabric::CMD_WINDOW_CONFIG_EXIT,
                     WindowFunc(this, &Window::_cmdConfigExit), queue);
     registerCommand(fabric::CMD_WINDOW_FRAME_START,
-                    WindowFunc(this, &Window::_cmdFrameStart), queue);
+                    WindowFunc(this, &Window::_cmdFrameStart),
+                    priorityQ);
     registerCommand(fabric::CMD_WINDOW_FRAME_FINISH,
                     WindowFunc(this, &Window::_cmdFrameFinish), queue);
     registerCommand(fabric::CMD_WINDOW_FLUSH,
@@ -115,8 +118,11 @@ void Window::attach(const uint128_t& id, const uint32_t instanceID)
                     WindowFunc(this, &Window::_cmdBarrier), queue);
     registerCommand(fabric::CMD_WINDOW_NV_BARRIER,
                     WindowFunc(this, &Window::_cmdNVBarrier), queue);
+    registerCommand(fabric::CMD_WINDOW_TREE_BARRIER,
+                    WindowFunc(this, &Window::_cmdTreeBarrier), queue);
     registerCommand(fabric::CMD_WINDOW_SWAP,
-                    WindowFunc(this, &Window::_cmdSwap), queue);
+                    WindowFunc(this, &Window::_cmdSwap),
+                    priorityQ);
     registerCommand(fabric::CMD_WINDOW_FRAME_DRAW_FINISH,
                     WindowFunc(this, &Window::_cmdFrameDrawFinish), queue);
     registerCommand(fabric::CMD_WINDOW_RESIZE,
@@ -1044,6 +1050,30 @@ bool Window::_cmdNVBarrier(co::ICommand& cmd)
     return true;
 }
 
+bool Window::_cmdTreeBarrier(co::ICommand& cmd)
+{
+    co::ObjectICommand command(cmd);
+    const co::ObjectVersions& path = command.read<co::ObjectVersions>();
+    const bool release = command.read<bool>();
+
+    LBLOG(LOG_TASKS) << "TASK tree swap barrier  " << getName() << std::endl;
+
+    Node* node = getNode();
+    co::Barriers barriers;
+    for (const co::ObjectVersion& barrier : path)
+    {
+        co::Barrier* netBarrier = node->getBarrier(barrier);
+        if (!netBarrier)
+            return true;
+        barriers.push_back(netBarrier);
+    }
+
+    WindowStatistics stat(Statistic::WINDOW_SWAP_BARRIER, this);
+    const uint32_t timeout = getConfig()->getTimeout() / 2;
+    LBCHECK(fabric::SwapBarrier::enter(barriers, release, timeout));
+    return true;
+}
+
 bool Window::_cmdSwap(co::ICommand& cmd)
 {
     co::ObjectICommand command(cmd);
@@ -505,6 +505,7 @@ private:
     bool _cmdFinish(co::ICommand& command);
     bool _cmdBarrier(co::ICommand& command);
     bool _cmdNVBarrier(co::ICommand& command);
+    bool _cmdTreeBarrier(co::ICommand& command);
     bool _cmdSwap(co::ICommand& command);
     bool _cmdFrameDrawFinish(co::ICommand& command);
     bool _cmdResize(co::ICommand& command);
@@ -27,12 +27,51 @@
  */
 
 #include "channel.h"
-#include <eq/system.h>
+
+#include <eq/config.h>
+#include <eq/cpu/window.h>
 #include <eq/window.h>
-#include <eq/x11/window.h>
+
+#include <algorithm>
 
 namespace eqCpu
 {
+namespace
+{
+/** A screen-aligned rectangle in normalized view coordinates. */
+struct Quad
+{
+    float x, y, w, h, depth;
+    uint32_t color;
+};
+
+// RGBA in memory order
+uint32_t _rgba(const uint8_t r, const uint8_t g, const uint8_t b)
+{
+    const uint8_t pixel[4] = {r, g, b, 255};
+    uint32_t value;
+    std::copy(pixel, pixel + 4, reinterpret_cast<uint8_t*>(&value));
+    return value;
+}
+
+const Quad _scene[] = {
+    {.05f, .05f, .5f, .5f, .5f, _rgba(255, 0, 0)},
+    {.25f, .15f, .5f, .5f, .4f, _rgba(0, 255, 0)},
+    {.45f, .25f, .5f, .5f, .6f, _rgba(0, 0, 255)},
+    {.15f, .45f, .5f, .5f, .3f, _rgba(255, 255, 0)},
+    {.35f, .35f, .3f, .3f, .2f, _rgba(0, 255, 255)},
+    {.60f, .60f, .3f, .3f, .7f, _rgba(255, 0, 255)},
+    {.05f, .70f, .2f, .2f, .1f, _rgba(255, 255, 255)},
+    {.75f, .05f, .2f, .2f, .8f, _rgba(128, 128, 128)}};
+const size_t _nQuads = sizeof(_scene) / sizeof(Quad);
+
+eq::cpu::Window* _getCPUWindow(eq::Channel* channel)
+{
+    return static_cast<eq::cpu::Window*>(
+        channel->getWindow()->getSystemWindow());
+}
+}
+
 Channel::Channel(eq::Window* parent)
     : eq::Channel(parent)
 {
@@ -40,35 +79,65 @@ Channel::Channel(eq::Window* parent)
 
 void Channel::frameDraw(const eq::uint128_t&)
 {
-    eq::x11::Window* x11Window =
-        static_cast<eq::x11::Window*>(getWindow()->getSystemWindow());
-    Display* display = x11Window->getXDisplay();
-    XID drawable = x11Window->getXDrawable();
-    const int screen = DefaultScreen(display);
-
-    XFillRectangle(display, drawable, DefaultGC(display, screen), 20, 20, 50,
-                   50);
+    eq::cpu::Window* window = _getCPUWindow(this);
+    uint32_t* colors = window->getColorBuffer();
+    uint32_t* depths = window->getDepthBuffer();
+    const int32_t width = window->getWidth();
+
+    // sort-first: map the quads from the destination into our viewport
+    const eq::PixelViewport& pvp = getPixelViewport();
+    const eq::Viewport& vp = getViewport();
+    const eq::Range& range = getRange();
+
+    for (size_t i = 0; i < _nQuads; ++i)
+    {
+        // sort-last: each quad is one database element
+        const float position = (float(i) + .5f) / float(_nQuads);
+        if (position < range.start || position >= range.end)
+            continue;
+
+        const Quad& quad = _scene[i];
+        eq::PixelViewport area(
+            pvp.x + int32_t((quad.x - vp.x) / vp.w * pvp.w + .5f),
+            pvp.y + int32_t((quad.y - vp.y) / vp.h * pvp.h + .5f),
+            int32_t(quad.w / vp.w * pvp.w + .5f),
+            int32_t(quad.h / vp.h * pvp.h + .5f));
+        area.intersect(pvp);
+        area.intersect(
+            eq::PixelViewport(0, 0, window->getWidth(), window->getHeight()));
+        if (!area.hasArea())
+            continue;
+
+        const uint32_t depth = uint32_t(quad.depth * 4294967295.f);
+        for (int32_t y = area.y; y < area.getYEnd(); ++y)
+        {
+            uint32_t* color = colors + y * width;
+            uint32_t* z = depths + y * width;
+            for (int32_t x = area.x; x < area.getXEnd(); ++x)
+            {
+                if (depth >= z[x])
+                    continue;
+                z[x] = depth;
+                color[x] = quad.color;
+            }
+        }
+    }
 }
 
 void Channel::frameClear(const eq::uint128_t&)
 {
-    const eq::PixelViewport& pvp = getPixelViewport();
-    eq::x11::Window* x11Window =
-        static_cast<eq::x11::Window*>(getWindow()->getSystemWindow());
-    Display* display = x11Window->getXDisplay();
-    XID drawable = x11Window->getXDrawable();
-
-    XClearArea(display, drawable, pvp.x, pvp.y, pvp.w, pvp.h, false);
+    _getCPUWindow(this)->clear(getPixelViewport(), _rgba(0, 0, 0));
 }
 
-void Channel::frameReadback(const eq::uint128_t&, const eq::Frames&)
+void Channel::frameReadback(const eq::uint128_t&, const eq::Frames& frames)
 {
-    LBUNIMPLEMENTED;
+    _getCPUWindow(this)->readback(frames, getRegions(), getContext());
 }
 
-void Channel::frameAssemble(const eq::uint128_t&, const eq::Frames&)
+void Channel::frameAssemble(const eq::uint128_t&, const eq::Frames& frames)
 {
-    LBUNIMPLEMENTED;
+    _getCPUWindow(this)->assemble(frames, getPixelViewport(), false,
+                                  getConfig()->getTimeout());
 }
 
 void Channel::setupAssemblyState()
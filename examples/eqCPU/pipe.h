@@ -46,7 +46,7 @@ protected:
     eq::MessagePump* createMessagePump() final { return 0; }
     eq::WindowSystem selectWindowSystem() const final
     {
-        return eq::WindowSystem("GLX");
+        return eq::WindowSystem("CPU");
     }
 };
 }
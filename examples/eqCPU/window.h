@@ -36,11 +36,12 @@ namespace eqCpu
 class Window : public eq::Window
 {
 public:
-    Window(eq::Pipe* parent);
+    Window(eq::Pipe* parent)
+        : eq::Window(parent)
+    {
+    }
 
 protected:
-    bool configInitSystemWindow(const eq::uint128_t& initID) final;
-
     bool configInitGL(const eq::uint128_t&) final { return true; }
     bool configExitGL() final { return true; }
 };
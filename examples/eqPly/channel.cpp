@@ -604,6 +604,18 @@ void Channel::_drawModel(const Model* scene)
     state.setProjectionModelViewMatrix(projection * view * model);
     state.setRange(triply::Range(&getRange().start));
 
+    const InitData& initData = static_cast<Config*>(getConfig())->getInitData();
+    if (useOrtho()) // screen space error assumes a perspective projection
+        state.setLODThreshold(0.f);
+    else
+    {
+        const eq::PixelViewport& pvp = getPixelViewport();
+        const eq::Matrix4f modelViewInv = (view * model).inverse();
+        state.setLODThreshold(initData.getLODThreshold());
+        state.setLODProjection(modelViewInv.getTranslation(),
+                               projection(1, 1) * pvp.h * .5f);
+    }
+
     const eq::Pipe* pipe = getPipe();
     const GLuint program = state.getProgram(pipe);
     if (program != VertexBufferState::INVALID)
@@ -615,7 +627,6 @@ void Channel::_drawModel(const Model* scene)
     if (program != VertexBufferState::INVALID)
         glUseProgram(0);
 
-    const InitData& initData = static_cast<Config*>(getConfig())->getInitData();
     if (initData.useROI())
         // declare empty region in case nothing is in frustum
         declareRegion(eq::PixelViewport());
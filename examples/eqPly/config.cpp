@@ -144,6 +144,8 @@ void Config::_loadModels()
 
             if (_initData.useInvertedFaces())
                 model->useInvertedFaces();
+            if (_initData.useCompactData())
+                model->useCompactData();
 
             if (!model->readFromFile(filename.c_str()))
             {
@@ -55,6 +55,8 @@ InitData::InitData()
     , _renderMode(triply::RENDER_MODE_DISPLAY_LIST)
     , _useGLSL(false)
     , _invFaces(false)
+    , _compact(false)
+    , _lodThreshold(0.f)
     , _logo(true)
     , _roi(true)
 {
@@ -68,13 +70,13 @@ InitData::~InitData()
 void InitData::getInstanceData(co::DataOStream& os)
 {
     os << _frameDataID << _windowSystem << _renderMode << _useGLSL << _invFaces
-       << _logo << _roi;
+       << _compact << _lodThreshold << _logo << _roi;
 }
 
 void InitData::applyInstanceData(co::DataIStream& is)
 {
     is >> _frameDataID >> _windowSystem >> _renderMode >> _useGLSL >>
-        _invFaces >> _logo >> _roi;
+        _invFaces >> _compact >> _lodThreshold >> _logo >> _roi;
     LBASSERT(_frameDataID != 0);
 }
 }
@@ -46,6 +46,8 @@ public:
     triply::RenderMode getRenderMode() const { return _renderMode; }
     bool useGLSL() const { return _useGLSL; }
     bool useInvertedFaces() const { return _invFaces; }
+    bool useCompactData() const { return _compact; }
+    float getLODThreshold() const { return _lodThreshold; }
     bool showLogo() const { return _logo; }
     bool useROI() const { return _roi; }
 protected:
@@ -62,6 +64,8 @@ protected:
     }
     void enableGLSL() { _useGLSL = true; }
     void enableInvertedFaces() { _invFaces = true; }
+    void enableCompactData() { _compact = true; }
+    void setLODThreshold(const float pixels) { _lodThreshold = pixels; }
     void disableLogo() { _logo = false; }
     void disableROI() { _roi = false; }
 private:
@@ -70,6 +74,8 @@ private:
     triply::RenderMode _renderMode;
     bool _useGLSL;
     bool _invFaces;
+    bool _compact;
+    float _lodThreshold;
     bool _logo;
     bool _roi;
 };
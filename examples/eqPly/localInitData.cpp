@@ -68,6 +68,9 @@ LocalInitData& LocalInitData::operator=(const LocalInitData& from)
         enableGLSL();
     if (from.useInvertedFaces())
         enableInvertedFaces();
+    if (from.useCompactData())
+        enableCompactData();
+    setLODThreshold(from.getLODThreshold());
     if (!from.showLogo())
         disableLogo();
     if (!from.useROI())
@@ -100,6 +103,8 @@ void LocalInitData::parseArguments(const int argc, char** argv)
     std::string userDefinedRenderMode("");
     bool userDefinedUseGLSL(false);
     bool userDefinedInvertFaces(false);
+    bool userDefinedCompactData(false);
+    float userDefinedLODThreshold(0.f);
     bool userDefinedDisableLogo(false);
     bool userDefinedDisableROI(false);
 
@@ -129,6 +134,11 @@ void LocalInitData::parseArguments(const int argc, char** argv)
         "invertFaces,i",
         po::bool_switch(&userDefinedInvertFaces)->default_value(false),
         "Invert faces (valid during binary file creation)")(
+        "compact,q",
+        po::bool_switch(&userDefinedCompactData)->default_value(false),
+        "Use quantized, compact vertex data")(
+        "lod,l", po::value<float>(&userDefinedLODThreshold),
+        "Maximum screen space error in pixels for simplified rendering")(
         "cameraPath,a", po::value<std::string>(&_pathFilename),
         "File containing camera path animation")(
         "noOverlay,o",
@@ -203,6 +213,12 @@ void LocalInitData::parseArguments(const int argc, char** argv)
     if (userDefinedInvertFaces)
         enableInvertedFaces();
 
+    if (userDefinedCompactData)
+        enableCompactData();
+
+    if (variableMap.count("lod") > 0)
+        setLODThreshold(userDefinedLODThreshold);
+
     if (userDefinedDisableLogo)
         disableLogo();
 
@@ -0,0 +1,132 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Eyescale Software GmbH nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "boxCuller.h"
+
+#include <vmmlib/frustumCuller.hpp>
+
+#include <algorithm>
+
+namespace triply
+{
+namespace
+{
+// boxes per block, a block is tested by one thread
+const size_t BLOCK_SIZE = 1024;
+}
+
+void BoxCuller::clear()
+{
+    _minX.clear();
+    _minY.clear();
+    _minZ.clear();
+    _maxX.clear();
+    _maxY.clear();
+    _maxZ.clear();
+}
+
+void BoxCuller::add(const BoundingBox& box)
+{
+    const Vertex& min = box.getMin();
+    const Vertex& max = box.getMax();
+    _minX.push_back(min.x());
+    _minY.push_back(min.y());
+    _minZ.push_back(min.z());
+    _maxX.push_back(max.x());
+    _maxY.push_back(max.y());
+    _maxZ.push_back(max.z());
+}
+
+void BoxCuller::test(const Matrix4f& pmv, std::vector<uint8_t>& result) const
+{
+    // clip planes of the frustum, inside is a * x + b * y + c * z + d >= 0
+    Vector4f planes[6];
+    for (size_t i = 0; i < 4; ++i)
+    {
+        planes[0][i] = pmv(3, i) + pmv(0, i); // left
+        planes[1][i] = pmv(3, i) - pmv(0, i); // right
+        planes[2][i] = pmv(3, i) + pmv(1, i); // bottom
+        planes[3][i] = pmv(3, i) - pmv(1, i); // top
+        planes[4][i] = pmv(3, i) + pmv(2, i); // near
+        planes[5][i] = pmv(3, i) - pmv(2, i); // far
+    }
+
+    const ssize_t nBoxes = ssize_t(size());
+    const ssize_t nBlocks = (nBoxes + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    result.resize(nBoxes);
+
+#pragma omp parallel for if (nBlocks > 1)
+    for (ssize_t i = 0; i < nBlocks; ++i)
+    {
+        const size_t begin = i * BLOCK_SIZE;
+        const size_t end = std::min(begin + BLOCK_SIZE, size_t(nBoxes));
+        _test(planes, begin, end, result.data());
+    }
+}
+
+void BoxCuller::_test(const Vector4f* planes, const size_t begin,
+                      const size_t end, uint8_t* result) const
+{
+    uint8_t outside[BLOCK_SIZE] = {0};
+    uint8_t partial[BLOCK_SIZE] = {0};
+    const size_t length = end - begin;
+
+    for (size_t i = 0; i < 6; ++i)
+    {
+        const Vector4f& plane = planes[i];
+        const float a = plane[0];
+        const float b = plane[1];
+        const float c = plane[2];
+        const float d = plane[3];
+
+        // the corner farthest along the plane normal decides if the box is
+        // outside, the nearest if it intersects the plane
+        const float* farX = (a >= 0.f ? _maxX.data() : _minX.data()) + begin;
+        const float* farY = (b >= 0.f ? _maxY.data() : _minY.data()) + begin;
+        const float* farZ = (c >= 0.f ? _maxZ.data() : _minZ.data()) + begin;
+        const float* nearX = (a >= 0.f ? _minX.data() : _maxX.data()) + begin;
+        const float* nearY = (b >= 0.f ? _minY.data() : _maxY.data()) + begin;
+        const float* nearZ = (c >= 0.f ? _minZ.data() : _maxZ.data()) + begin;
+
+        for (size_t j = 0; j < length; ++j)
+        {
+            const float farDistance = a * farX[j] + b * farY[j] + c * farZ[j];
+            const float nearDistance =
+                a * nearX[j] + b * nearY[j] + c * nearZ[j];
+            outside[j] |= uint8_t(farDistance + d < 0.f);
+            partial[j] |= uint8_t(nearDistance + d < 0.f);
+        }
+    }
+
+    for (size_t j = 0; j < length; ++j)
+        result[begin + j] = uint8_t(
+            outside[j] ? vmml::VISIBILITY_NONE
+                       : partial[j] ? vmml::VISIBILITY_PARTIAL
+                                    : vmml::VISIBILITY_FULL);
+}
+}
@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2009-2015, Stefan.Eilemann@epfl.ch
+/* Copyright (c) 2026, agent <agent@local>
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted provided that the following conditions are met:
@@ -26,37 +26,56 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include "window.h"
-#include <eq/glx/pipe.h>
-#include <eq/pipe.h>
-#include <eq/x11/window.h>
+#ifndef PLYLIB_BOXCULLER_H
+#define PLYLIB_BOXCULLER_H
 
-namespace eqCpu
+#include "typedefs.h"
+#include <triply/api.h>
+
+#include <vector>
+
+namespace triply
 {
-Window::Window(eq::Pipe* parent)
-    : eq::Window(parent)
+/**
+ * Frustum culling of many bounding boxes at once.
+ *
+ * The boxes are stored as a structure of arrays, and tested in blocks which
+ * are distributed over OpenMP threads. Within a block, each frustum plane is
+ * tested against all boxes in a branch-free loop, which the compiler
+ * vectorizes. The results are the same as for vmml::FrustumCullerf::test().
+ */
+class BoxCuller
 {
-}
+public:
+    /** Remove all boxes. */
+    TRIPLY_API void clear();
 
-bool Window::configInitSystemWindow(const eq::uint128_t& initID)
-{
-    eq::Pipe* pipe = getPipe();
-    eq::glx::Pipe* glxPipe =
-        dynamic_cast<eq::glx::Pipe*>(pipe->getSystemPipe());
+    /** Append a box. */
+    TRIPLY_API void add(const BoundingBox& box);
 
-    if (!glxPipe)
-        return eq::Window::configInitSystemWindow(initID);
+    /** @return the number of boxes. */
+    size_t size() const { return _minX.size(); }
 
-    eq::x11::Window* systemWindow =
-        new eq::x11::Window(*this, getSettings(), glxPipe->getXDisplay());
+    /**
+     * Test all boxes against the frustum of the given matrix.
+     *
+     * @param pmv the projection * model view matrix.
+     * @param result the vmml::Visibility of each box.
+     */
+    TRIPLY_API void test(const Matrix4f& pmv,
+                         std::vector<uint8_t>& result) const;
 
-    if (!systemWindow->configInit())
-    {
-        delete systemWindow;
-        return false;
-    }
+private:
+    std::vector<float> _minX;
+    std::vector<float> _minY;
+    std::vector<float> _minZ;
+    std::vector<float> _maxX;
+    std::vector<float> _maxY;
+    std::vector<float> _maxZ;
 
-    setSystemWindow(systemWindow);
-    return true;
-}
+    void _test(const Vector4f* planes, size_t begin, size_t end,
+               uint8_t* result) const;
+};
 }
+
+#endif // PLYLIB_BOXCULLER_H
@@ -0,0 +1,226 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Eyescale Software GmbH nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "compactData.h"
+
+#include "vertexBufferData.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace triply
+{
+namespace
+{
+const float QUANTIZATION_RANGE = 32767.f;
+const float OCT_RANGE = 127.f;
+
+inline float _sign(const float value)
+{
+    return value < 0.f ? -1.f : 1.f;
+}
+
+template <class T>
+void _write(std::ostream& os, const std::vector<T>& vector)
+{
+    const size_t length = vector.size();
+    os.write(reinterpret_cast<const char*>(&length), sizeof(size_t));
+    if (length > 0)
+        os.write(reinterpret_cast<const char*>(vector.data()),
+                 length * sizeof(T));
+}
+
+template <class T>
+void _read(char** addr, std::vector<T>& vector)
+{
+    size_t length;
+    memRead(reinterpret_cast<char*>(&length), addr, sizeof(size_t));
+    vector.resize(length);
+    if (length > 0)
+        memRead(reinterpret_cast<char*>(vector.data()), addr,
+                length * sizeof(T));
+}
+}
+
+void CompactData::encode(const VertexBufferData& data, const Index vertexStart,
+                         const Index vertexLength, const Index indexStart,
+                         const Index indexLength)
+{
+    // quantization space: leaf bounding box, same scale on all axes
+    center = Vertex(0.f);
+    scale = 1.f;
+    if (vertexLength > 0)
+    {
+        BoundingBox box{data.vertices[vertexStart],
+                        data.vertices[vertexStart]};
+        for (Index i = vertexStart + 1; i < vertexStart + vertexLength; ++i)
+            box.merge(data.vertices[i]);
+
+        center = box.getCenter();
+        const float extent = box.getSize().find_max() * .5f;
+        if (extent > 0.f)
+            scale = extent / QUANTIZATION_RANGE;
+    }
+
+    vertices.resize(vertexLength);
+    normals.resize(vertexLength);
+    for (Index i = 0; i < vertexLength; ++i)
+    {
+        const Vertex position = (data.vertices[vertexStart + i] - center) /
+                                scale;
+        for (size_t j = 0; j < 3; ++j)
+            vertices[i][j] = int16_t(std::round(position[j]));
+        normals[i] = encodeNormal(data.normals[vertexStart + i]);
+    }
+
+    if (data.colors.empty())
+        colors.clear();
+    else
+        colors.assign(data.colors.begin() + vertexStart,
+                      data.colors.begin() + vertexStart + vertexLength);
+
+    // zigzag-encoded deltas as LEB128, vertices are numbered in order of
+    // first use within the leaf, which keeps most deltas small
+    nIndices = indexLength;
+    indices.clear();
+    indices.reserve(indexLength);
+    int32_t last = 0;
+    for (Index i = indexStart; i < indexStart + indexLength; ++i)
+    {
+        const int32_t index = data.indices[i];
+        const int32_t delta = index - last;
+        uint32_t value = (uint32_t(delta) << 1) ^ uint32_t(delta >> 31);
+        last = index;
+
+        while (value >= 0x80)
+        {
+            indices.push_back(uint8_t(value | 0x80));
+            value >>= 7;
+        }
+        indices.push_back(uint8_t(value));
+    }
+}
+
+void CompactData::decodeIndices(std::vector<ShortIndex>& out) const
+{
+    out.resize(nIndices);
+    int32_t last = 0;
+    size_t pos = 0;
+    for (size_t i = 0; i < nIndices; ++i)
+    {
+        uint32_t value = 0;
+        for (uint32_t shift = 0;; shift += 7)
+        {
+            const uint8_t byte = indices[pos++];
+            value |= uint32_t(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                break;
+        }
+
+        last += int32_t(value >> 1) ^ -int32_t(value & 1);
+        out[i] = ShortIndex(last);
+    }
+}
+
+void CompactData::decodeNormals(std::vector<ByteNormal>& out) const
+{
+    out.resize(normals.size());
+    for (size_t i = 0; i < normals.size(); ++i)
+    {
+        const Normal normal = decodeNormal(normals[i]);
+        for (size_t j = 0; j < 3; ++j)
+            out[i][j] = int8_t(std::round(normal[j] * OCT_RANGE));
+    }
+}
+
+size_t CompactData::getSize() const
+{
+    return sizeof(center) + sizeof(scale) + sizeof(nIndices) +
+           vertices.size() * sizeof(QuantizedVertex) +
+           colors.size() * sizeof(Color) +
+           normals.size() * sizeof(OctNormal) + indices.size();
+}
+
+void CompactData::toStream(std::ostream& os) const
+{
+    os.write(reinterpret_cast<const char*>(&center), sizeof(center));
+    os.write(reinterpret_cast<const char*>(&scale), sizeof(scale));
+    os.write(reinterpret_cast<const char*>(&nIndices), sizeof(nIndices));
+    _write(os, vertices);
+    _write(os, colors);
+    _write(os, normals);
+    _write(os, indices);
+}
+
+void CompactData::fromMemory(char** addr)
+{
+    memRead(reinterpret_cast<char*>(&center), addr, sizeof(center));
+    memRead(reinterpret_cast<char*>(&scale), addr, sizeof(scale));
+    memRead(reinterpret_cast<char*>(&nIndices), addr, sizeof(nIndices));
+    _read(addr, vertices);
+    _read(addr, colors);
+    _read(addr, normals);
+    _read(addr, indices);
+}
+
+OctNormal CompactData::encodeNormal(const Normal& normal)
+{
+    const float length =
+        std::abs(normal.x()) + std::abs(normal.y()) + std::abs(normal.z());
+    if (length == 0.f)
+        return OctNormal(0, 0);
+
+    float x = normal.x() / length;
+    float y = normal.y() / length;
+    if (normal.z() < 0.f) // fold lower hemisphere
+    {
+        const float foldedX = (1.f - std::abs(y)) * _sign(x);
+        y = (1.f - std::abs(x)) * _sign(y);
+        x = foldedX;
+    }
+    return OctNormal(int8_t(std::round(x * OCT_RANGE)),
+                     int8_t(std::round(y * OCT_RANGE)));
+}
+
+Normal CompactData::decodeNormal(const OctNormal& encoded)
+{
+    float x = encoded.x() / OCT_RANGE;
+    float y = encoded.y() / OCT_RANGE;
+    const float z = 1.f - std::abs(x) - std::abs(y);
+    if (z < 0.f) // unfold lower hemisphere
+    {
+        const float unfoldedX = (1.f - std::abs(y)) * _sign(x);
+        y = (1.f - std::abs(x)) * _sign(y);
+        x = unfoldedX;
+    }
+
+    Normal normal(x, y, z);
+    normal.normalize();
+    return normal;
+}
+}
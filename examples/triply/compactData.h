@@ -0,0 +1,102 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Eyescale Software GmbH nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PLYLIB_COMPACTDATA_H
+#define PLYLIB_COMPACTDATA_H
+
+#include "typedefs.h"
+#include <triply/api.h>
+
+#include <vector>
+
+namespace triply
+{
+typedef vmml::vector<3, int16_t> QuantizedVertex;
+typedef vmml::vector<2, int8_t> OctNormal;
+typedef vmml::vector<3, int8_t> ByteNormal;
+
+/**
+ * Compact encoding of the vertex data of one kd-tree leaf.
+ *
+ * Positions are quantized to 16 bit relative to the center of the leaf, using
+ * the same scale on all axes. Normals are octahedral-encoded into two bytes.
+ * Indices are delta-coded variable-length integers. Colors are unchanged.
+ */
+class CompactData
+{
+public:
+    CompactData()
+        : scale(0.f)
+        , nIndices(0)
+    {
+    }
+
+    /** Encode the given vertices and leaf-relative indices. */
+    TRIPLY_API void encode(const VertexBufferData& data, Index vertexStart,
+                           Index vertexLength, Index indexStart,
+                           Index indexLength);
+
+    /** @return the decoded position of the given vertex. */
+    Vertex getVertex(const size_t i) const
+    {
+        return center +
+               Vertex(vertices[i].x(), vertices[i].y(), vertices[i].z()) *
+                   scale;
+    }
+
+    /** @return the decoded, unit length normal of the given vertex. */
+    Normal getNormal(const size_t i) const { return decodeNormal(normals[i]); }
+    /** Decode the triangle indices. */
+    TRIPLY_API void decodeIndices(std::vector<ShortIndex>& out) const;
+
+    /** Decode the normals to signed bytes, as used for GL_BYTE arrays. */
+    TRIPLY_API void decodeNormals(std::vector<ByteNormal>& out) const;
+
+    /** @return the number of bytes used by the encoded data. */
+    TRIPLY_API size_t getSize() const;
+
+    /** Write the encoded data to the given stream. */
+    TRIPLY_API void toStream(std::ostream& os) const;
+
+    /** Read the encoded data from the MMF address. */
+    TRIPLY_API void fromMemory(char** addr);
+
+    TRIPLY_API static OctNormal encodeNormal(const Normal& normal);
+    TRIPLY_API static Normal decodeNormal(const OctNormal& normal);
+
+    Vertex center; //!< center of the quantization
+    float scale;   //!< size of one quantization step
+    size_t nIndices;
+    std::vector<QuantizedVertex> vertices;
+    std::vector<Color> colors;
+    std::vector<OctNormal> normals;
+    std::vector<uint8_t> indices; //!< zigzag delta, LEB128 coded
+};
+}
+
+#endif // PLYLIB_COMPACTDATA_H
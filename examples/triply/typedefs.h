@@ -133,7 +133,7 @@ typedef ArrayWrapper<float, 2> Range;
 const Index LEAF_SIZE(21845);
 
 // binary mesh file version, increment if changing the file format
-const unsigned short FILE_VERSION(0x011a);
+const unsigned short FILE_VERSION(0x011c);
 
 // enumeration for the sort axis
 enum Axis
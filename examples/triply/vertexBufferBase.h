@@ -52,6 +52,15 @@ public:
     virtual const VertexBufferBase* getRight() const { return nullptr; }
     virtual VertexBufferBase* getLeft() { return nullptr; }
     virtual VertexBufferBase* getRight() { return nullptr; }
+
+    /** @return the simplified geometry replacing this subtree, or nullptr. */
+    virtual const VertexBufferBase* getProxy() const { return nullptr; }
+
+    /** @return the object space error of the proxy geometry. */
+    virtual float getError() const { return 0.f; }
+
+    /** @return true if the vertex data of the whole subtree is available. */
+    virtual bool isLoaded() const { return true; }
     TRIPLY_API virtual void updateBounds() = 0;
 
 protected:
@@ -82,6 +91,9 @@ protected:
 
     virtual void updateRange() = 0;
 
+    /** Replace the vertex data with its compact encoding. */
+    virtual void compact() {}
+
     friend class VertexBufferDist;
     virtual Type getType() const = 0;
 
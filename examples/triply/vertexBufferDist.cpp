@@ -29,28 +29,189 @@
 
 #include "vertexBufferDist.h"
 
+#include "vertexBufferData.h"
 #include "vertexBufferLeaf.h"
 #include "vertexBufferRoot.h"
 
+#include <lunchbox/clock.h>
+
+#include <algorithm>
+
 namespace triply
 {
+namespace
+{
+/** Add a range to a set of disjoint ranges, merging overlapping ones. */
+void _addRange(std::vector<Range>& ranges, const Range& range)
+{
+    Range merged = range;
+    std::vector<Range> result;
+    for (const Range& current : ranges)
+    {
+        if (current[1] < merged[0] || current[0] > merged[1])
+        {
+            result.push_back(current);
+            continue;
+        }
+        merged[0] = std::min(merged[0], current[0]);
+        merged[1] = std::max(merged[1], current[1]);
+    }
+    result.push_back(merged);
+    ranges.swap(result);
+}
+}
+
+/** The vertex data of one leaf, mapped on demand by slaves. */
+class VertexBufferDist::LeafData : public co::Object
+{
+public:
+    LeafData(VertexBufferLeaf& leaf, const co::CompressorInfo& compressor)
+        : _leaf(leaf)
+        , _compressor(compressor)
+    {
+    }
+
+    virtual ~LeafData()
+    {
+        if (getLocalNode())
+            getLocalNode()->releaseObject(this);
+    }
+
+    /** @return the size of the leaf data in bytes. */
+    size_t getSize() const
+    {
+        if (_leaf._compact)
+            return _leaf._compact->getSize();
+
+        const VertexBufferData& data = _leaf._globalData;
+        return data.vertices.size() * sizeof(Vertex) +
+               data.colors.size() * sizeof(Color) +
+               data.normals.size() * sizeof(Normal) +
+               data.indices.size() * sizeof(ShortIndex);
+    }
+
+    /** Serialize the vertex data of the given leaf. */
+    static void write(co::DataOStream& os, const VertexBufferLeaf& leaf)
+    {
+        const CompactData* compact = leaf._compact.get();
+        os << bool(compact);
+        if (compact)
+        {
+            os << compact->center << compact->scale
+               << uint64_t(compact->nIndices);
+            _write(os, compact->vertices);
+            _write(os, compact->colors);
+            _write(os, compact->normals);
+            _write(os, compact->indices);
+            return;
+        }
+
+        const VertexBufferData& data = leaf._globalData;
+        const size_t nVertices = leaf._vertexLength;
+        const size_t nIndices = leaf._indexLength;
+        const bool hasColors = !data.colors.empty();
+
+        os << uint64_t(nVertices) << uint64_t(nIndices) << hasColors;
+        _write(os, data.vertices, leaf._vertexStart, nVertices);
+        if (hasColors)
+            _write(os, data.colors, leaf._vertexStart, nVertices);
+        _write(os, data.normals, leaf._vertexStart, nVertices);
+        _write(os, data.indices, leaf._indexStart, nIndices);
+    }
+
+    /** Deserialize the vertex data into the local data of the given leaf. */
+    static void read(co::DataIStream& is, VertexBufferLeaf& leaf)
+    {
+        if (is.read<bool>())
+        {
+            std::unique_ptr<CompactData> compact(new CompactData);
+            is >> compact->center >> compact->scale;
+            compact->nIndices = is.read<uint64_t>();
+            _read(is, compact->vertices);
+            _read(is, compact->colors);
+            _read(is, compact->normals);
+            _read(is, compact->indices);
+            leaf._compact = std::move(compact);
+            return;
+        }
+
+        VertexBufferData& data = leaf._globalData;
+        const size_t nVertices = is.read<uint64_t>();
+        const size_t nIndices = is.read<uint64_t>();
+        const bool hasColors = is.read<bool>();
+
+        _read(is, data.vertices, nVertices);
+        if (hasColors)
+            _read(is, data.colors, nVertices);
+        _read(is, data.normals, nVertices);
+        _read(is, data.indices, nIndices);
+    }
+
+protected:
+    void getInstanceData(co::DataOStream& os) final { write(os, _leaf); }
+    void applyInstanceData(co::DataIStream& is) final { read(is, _leaf); }
+
+private:
+    VertexBufferLeaf& _leaf;
+    const co::CompressorInfo _compressor;
+
+    ChangeType getChangeType() const final { return STATIC; }
+    co::CompressorInfo chooseCompressor() const final { return _compressor; }
+    template <class T>
+    static void _write(co::DataOStream& os, const std::vector<T>& vector,
+                       const size_t start, const size_t length)
+    {
+        os << co::Array<void>(const_cast<T*>(vector.data() + start),
+                              length * sizeof(T));
+    }
+
+    template <class T>
+    static void _read(co::DataIStream& is, std::vector<T>& vector,
+                      const size_t length)
+    {
+        vector.resize(length);
+        is >> co::Array<void>(vector.data(), length * sizeof(T));
+    }
+
+    template <class T>
+    static void _write(co::DataOStream& os, const std::vector<T>& vector)
+    {
+        os << uint64_t(vector.size());
+        _write(os, vector, 0, vector.size());
+    }
+
+    template <class T>
+    static void _read(co::DataIStream& is, std::vector<T>& vector)
+    {
+        _read(is, vector, is.read<uint64_t>());
+    }
+};
+
 VertexBufferDist::VertexBufferDist(VertexBufferRoot& root, co::NodePtr master,
                                    co::LocalNodePtr localNode,
                                    const eq::uint128_t& modelID)
-    : VertexBufferDist(root, root, master, localNode, modelID)
+    : VertexBufferDist(root, root, modelID)
 {
+    const lunchbox::Clock clock;
+    static_cast<VertexBufferNode&>(_root)._loaded = false;
+    _mapTree(master, localNode);
+    _root._flatten();
+    LBINFO << "Mapped model tree of " << _root.getName() << " in "
+           << clock.getTime64() << " ms" << std::endl;
+
+    _root._mapData = [this](const Range& range) { mapData(range); };
 }
 
 VertexBufferDist::VertexBufferDist(VertexBufferRoot& root,
-                                   VertexBufferBase& node, co::NodePtr master,
-                                   co::LocalNodePtr localNode,
-                                   const eq::uint128_t& modelID)
+                                   VertexBufferBase& node,
+                                   const eq::uint128_t& id)
     : _root(root)
     , _node(node)
     , _changeType(STATIC)
+    , _masterID(id)
+    , _request(LB_UNDEFINED_UINT32)
+    , _dataSize(0)
 {
-    if (!localNode->mapObject(this, modelID, master, co::VERSION_FIRST))
-        throw std::runtime_error("Mapping of ply node failed");
 }
 
 VertexBufferDist::VertexBufferDist(VertexBufferRoot& root,
@@ -77,19 +238,192 @@ VertexBufferDist::VertexBufferDist(VertexBufferRoot& root,
     , _changeType(type)
     , _compressor(compressor == COMPRESSOR_AUTO ? co::Object::chooseCompressor()
                                                 : compressor)
+    , _request(LB_UNDEFINED_UINT32)
+    , _dataSize(0)
 {
+    if (node.getType() == Type::leaf)
+    {
+        _data.reset(
+            new LeafData(dynamic_cast<VertexBufferLeaf&>(node), _compressor));
+        if (!localNode->registerObject(_data.get()))
+            throw std::runtime_error("Register of ply leaf data failed");
+    }
+
     if (!localNode->registerObject(this))
         throw std::runtime_error("Register of ply node failed");
 }
 
 VertexBufferDist::~VertexBufferDist()
 {
+    if (_isRoot())
+    {
+        _root._mapData = nullptr;
+        // mapped objects can only be released once their mapping is finished
+        for (VertexBufferDist* leaf : _pending)
+            getLocalNode()->mapObjectSync(leaf->_request);
+    }
+
     _left.reset();
     _right.reset();
+    _data.reset();
     if (getLocalNode())
         getLocalNode()->releaseObject(this);
 }
 
+void VertexBufferDist::_mapTree(co::NodePtr master, co::LocalNodePtr localNode)
+{
+    // Map the tree breadth-first, issuing all requests of one level at once
+    std::vector<VertexBufferDist*> level(1, this);
+    std::vector<uint32_t> requests;
+    while (!level.empty())
+    {
+        requests.clear();
+        for (VertexBufferDist* dist : level)
+            requests.push_back(localNode->mapObjectNB(dist, dist->_masterID,
+                                                      co::VERSION_FIRST,
+                                                      master));
+
+        std::vector<VertexBufferDist*> next;
+        for (size_t i = 0; i < level.size(); ++i)
+        {
+            if (!localNode->mapObjectSync(requests[i]))
+                throw std::runtime_error("Mapping of ply node failed");
+
+            VertexBufferDist* dist = level[i];
+            if (dist->_left)
+                next.push_back(dist->_left.get());
+            if (dist->_right)
+                next.push_back(dist->_right.get());
+        }
+        level.swap(next);
+    }
+}
+
+bool VertexBufferDist::mapData(const Range& range)
+{
+    LBASSERT(_isRoot());
+    std::lock_guard<std::mutex> lock(_lock);
+    if (!_pending.empty())
+        _syncData();
+
+    for (const Range& mapped : _mappedRanges)
+        if (mapped[0] <= range[0] && mapped[1] >= range[1])
+            return true;
+
+    std::vector<VertexBufferDist*> leaves;
+    _findUnmapped(range, leaves);
+    if (leaves.empty())
+    {
+        _addRange(_mappedRanges, range);
+        return true;
+    }
+
+    // request the missing data, the proxies are drawn until it is synced
+    co::LocalNodePtr localNode = getLocalNode();
+    co::NodePtr master = getMasterNode();
+    if (_pending.empty())
+        _clock.reset();
+
+    for (VertexBufferDist* leaf : leaves)
+    {
+        if (leaf->_data) // already requested
+            continue;
+
+        leaf->_data.reset(new LeafData(
+            dynamic_cast<VertexBufferLeaf&>(leaf->_node), _compressor));
+        leaf->_request = localNode->mapObjectNB(leaf->_data.get(),
+                                                leaf->_dataID,
+                                                co::VERSION_FIRST, master);
+        _pending.push_back(leaf);
+    }
+    return false;
+}
+
+size_t VertexBufferDist::getDataSize() const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return _dataSize;
+}
+
+void VertexBufferDist::_syncData()
+{
+    // only served requests are synced, which does not block the rendering
+    co::LocalNodePtr localNode = getLocalNode();
+    size_t nSynced = 0;
+    for (auto i = _pending.begin(); i != _pending.end();)
+    {
+        VertexBufferDist* leaf = *i;
+        if (!localNode->isRequestReady(leaf->_request))
+        {
+            ++i;
+            continue;
+        }
+
+        const bool mapped = localNode->mapObjectSync(leaf->_request);
+        leaf->_request = LB_UNDEFINED_UINT32;
+        i = _pending.erase(i);
+        if (!mapped)
+        {
+            // called during cullDraw: keep the leaf unloaded, its proxy is
+            // drawn instead, and do not request it again
+            LBERROR << "Mapping of ply leaf data of " << _root.getName()
+                    << " failed, drawing its proxy geometry" << std::endl;
+            continue;
+        }
+
+        dynamic_cast<VertexBufferLeaf&>(leaf->_node)._loaded = true;
+        _dataSize += leaf->_data->getSize();
+        ++nSynced;
+    }
+
+    if (nSynced == 0)
+        return;
+
+    _updateLoaded();
+    if (_pending.empty())
+        LBINFO << "Mapped leaf data of " << _root.getName() << " in "
+               << _clock.getTime64() << " ms, " << (_dataSize >> 10)
+               << " KB resident" << std::endl;
+}
+
+bool VertexBufferDist::_updateLoaded()
+{
+    if (_node.isLoaded())
+        return true;
+    if (_node.getType() == Type::leaf)
+        return false;
+
+    bool loaded = true;
+    if (_left)
+        loaded = _left->_updateLoaded() && loaded;
+    if (_right)
+        loaded = _right->_updateLoaded() && loaded;
+    static_cast<VertexBufferNode&>(_node)._loaded = loaded;
+    return loaded;
+}
+
+void VertexBufferDist::_findUnmapped(const Range& range,
+                                     std::vector<VertexBufferDist*>& leaves)
+{
+    // same range test as VertexBufferRoot::cullDraw
+    if (_node.isLoaded() || _node._range[0] >= range[1] ||
+        _node._range[1] < range[0])
+    {
+        return;
+    }
+
+    if (_node.getType() == Type::leaf)
+    {
+        leaves.push_back(this);
+        return;
+    }
+
+    if (_left)
+        _left->_findUnmapped(range, leaves);
+    if (_right)
+        _right->_findUnmapped(range, leaves);
+}
+
 void VertexBufferDist::getInstanceData(co::DataOStream& os)
 {
     if (_left)
@@ -105,18 +439,27 @@ void VertexBufferDist::getInstanceData(co::DataOStream& os)
     os << _node._boundingBox << _node._range;
 
     if (_isRoot())
-    {
-        const VertexBufferData& data = _root._data;
-        os << data.vertices << data.colors << data.normals << data.indices
-           << _root._name;
-    }
+        os << _root._name << _root.hasColors() << _root._compact;
+
     if (_node.getType() == Type::leaf)
     {
         const VertexBufferLeaf& leaf =
             dynamic_cast<const VertexBufferLeaf&>(_node);
 
-        os << uint64_t(leaf._vertexStart) << uint64_t(leaf._indexStart)
-           << uint64_t(leaf._indexLength) << leaf._vertexLength;
+        os << uint64_t(leaf._indexLength) << leaf._vertexLength
+           << _data->getID();
+        return;
+    }
+
+    // the proxies are small and part of the tree structure
+    const VertexBufferNode& node = dynamic_cast<const VertexBufferNode&>(_node);
+    const VertexBufferLeaf* proxy = node._proxy.get();
+    os << node._error << bool(proxy);
+    if (proxy)
+    {
+        os << proxy->_boundingBox << proxy->_range
+           << uint64_t(proxy->_indexLength) << proxy->_vertexLength;
+        LeafData::write(os, *proxy);
     }
 }
 
@@ -130,21 +473,19 @@ void VertexBufferDist::applyInstanceData(co::DataIStream& is)
     is >> _node._boundingBox >> _node._range;
 
     if (_isRoot())
-    {
-        VertexBufferData& data = _root._data;
-        is >> data.vertices >> data.colors >> data.normals >> data.indices >>
-            _root._name;
-    }
+        is >> _root._name >> _root._hasColors >> _root._compact;
+
     switch (_node.getType())
     {
     case Type::leaf:
     {
+        // data is mapped on demand into the leaf, see mapData()
         VertexBufferLeaf& leaf = dynamic_cast<VertexBufferLeaf&>(_node);
-        uint64_t i1, i2, i3;
-        is >> i1 >> i2 >> i3 >> leaf._vertexLength;
-        leaf._vertexStart = size_t(i1);
-        leaf._indexStart = size_t(i2);
-        leaf._indexLength = size_t(i3);
+        uint64_t indexLength;
+        is >> indexLength >> leaf._vertexLength >> _dataID;
+        leaf._vertexStart = 0;
+        leaf._indexStart = 0;
+        leaf._indexLength = size_t(indexLength);
         return;
     }
     case Type::node:
@@ -157,15 +498,27 @@ void VertexBufferDist::applyInstanceData(co::DataIStream& is)
     }
 
     VertexBufferNode& node = dynamic_cast<VertexBufferNode&>(_node);
+    bool hasProxy;
+    is >> node._error >> hasProxy;
+    if (hasProxy)
+    {
+        node._proxy.reset(new VertexBufferLeaf);
+        VertexBufferLeaf& proxy = *node._proxy;
+        uint64_t indexLength;
+        is >> proxy._boundingBox >> proxy._range >> indexLength >>
+            proxy._vertexLength;
+        proxy._indexLength = size_t(indexLength);
+        LeafData::read(is, proxy);
+    }
+
+    // children are mapped by _mapTree()
     node._left = _createNode(leftType);
     if (node._left)
-        _left.reset(new VertexBufferDist(_root, *node._left, getMasterNode(),
-                                         getLocalNode(), leftID));
+        _left.reset(new VertexBufferDist(_root, *node._left, leftID));
 
     node._right = _createNode(rightType);
     if (node._right)
-        _right.reset(new VertexBufferDist(_root, *node._right, getMasterNode(),
-                                          getLocalNode(), rightID));
+        _right.reset(new VertexBufferDist(_root, *node._right, rightID));
 }
 
 std::unique_ptr<VertexBufferBase> VertexBufferDist::_createNode(
@@ -176,10 +529,19 @@ std::unique_ptr<VertexBufferBase> VertexBufferDist::_createNode(
     case Type::none:
         return nullptr;
     case Type::node:
-        return std::unique_ptr<VertexBufferBase>(new VertexBufferNode);
+    {
+        // loaded once all its leaves are, see _updateLoaded()
+        VertexBufferNode* node = new VertexBufferNode;
+        node->_loaded = false;
+        return std::unique_ptr<VertexBufferBase>(node);
+    }
     case Type::leaf:
-        return std::unique_ptr<VertexBufferBase>(
-            new VertexBufferLeaf(_root._data));
+    {
+        // loaded once its data is mapped, see _syncData()
+        VertexBufferLeaf* leaf = new VertexBufferLeaf;
+        leaf->_loaded = false;
+        return std::unique_ptr<VertexBufferBase>(leaf);
+    }
     default:
         throw std::runtime_error("Internal error: unexpected node type " +
                                  std::to_string(unsigned(type)));
@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2008-2016, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2008-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *                          Cedric Stalder <cedric.stalder@gmail.com>
  *
  * Redistribution and use in source and binary forms, with or without
@@ -34,13 +34,25 @@
 #include <triply/api.h>
 
 #include <co/co.h>
+#include <lunchbox/clock.h>
 #include <pression/data/CompressorInfo.h>
 
+#include <mutex>
+
 namespace triply
 {
 static const co::CompressorInfo COMPRESSOR_AUTO(-1.f, -1.f);
 
-/** Uses co::Object to distribute a model, holds a VertexBufferBase node. */
+/**
+ * Uses co::Object to distribute a model, holds a VertexBufferBase node.
+ *
+ * The tree structure is mapped when the slave is constructed. The vertex data
+ * of each leaf is a separate object, which is mapped on demand when a range
+ * containing the leaf is drawn. Clients rendering a part of the database
+ * therefore only receive and keep the data of their range. The mapping does
+ * not block the rendering, subtrees are drawn using their proxy geometry until
+ * their data has arrived.
+ */
 class VertexBufferDist : public co::Object
 {
 public:
@@ -56,6 +68,20 @@ public:
                                 const co::uint128_t& modelID);
     TRIPLY_API virtual ~VertexBufferDist();
 
+    /**
+     * Map the leaf data intersecting the given range without blocking.
+     *
+     * Requests the missing leaf data and applies the requests which have been
+     * served. Called automatically by the root node of a slave tree before
+     * drawing. Thread safe.
+     *
+     * @return true if all leaf data of the range is available.
+     */
+    TRIPLY_API bool mapData(const Range& range);
+
+    /** @return the size of the leaf data mapped by this slave in bytes. */
+    TRIPLY_API size_t getDataSize() const;
+
 protected:
     TRIPLY_API VertexBufferDist(VertexBufferRoot& root, VertexBufferBase& node,
                                 co::LocalNodePtr localNode,
@@ -64,15 +90,21 @@ protected:
 
     TRIPLY_API VertexBufferDist(triply::VertexBufferRoot& root,
                                 triply::VertexBufferBase& node,
-                                co::NodePtr master, co::LocalNodePtr localNode,
-                                const co::uint128_t& modelID);
+                                const co::uint128_t& id);
 
     TRIPLY_API void getInstanceData(co::DataOStream& os) override;
     TRIPLY_API void applyInstanceData(co::DataIStream& is) override;
 
 private:
+    class LeafData;
+
     bool _isRoot() const { return (void*)(&_root) == (void*)(&_node); }
     std::unique_ptr<VertexBufferBase> _createNode(Type) const;
+    void _mapTree(co::NodePtr master, co::LocalNodePtr localNode);
+    void _findUnmapped(const Range& range,
+                       std::vector<VertexBufferDist*>& leaves);
+    void _syncData();
+    bool _updateLoaded();
 
     ChangeType getChangeType() const final { return _changeType; }
     co::CompressorInfo chooseCompressor() const final { return _compressor; }
@@ -82,6 +114,17 @@ private:
     std::unique_ptr<VertexBufferDist> _right;
     const co::Object::ChangeType _changeType;
     const co::CompressorInfo _compressor;
+
+    co::uint128_t _masterID; // slave only, identifier for mapping
+    co::uint128_t _dataID;   // leaves only, identifier of the leaf data
+    std::unique_ptr<LeafData> _data;
+    uint32_t _request; // leaves only, pending request mapping _data
+
+    mutable std::mutex _lock;         // root only, serializes mapData()
+    std::vector<Range> _mappedRanges; // root only, fully mapped ranges
+    std::vector<VertexBufferDist*> _pending; // root only, leaves being mapped
+    lunchbox::Clock _clock;           // root only, started by first request
+    size_t _dataSize;                 // root only, size of the mapped data
 };
 }
 
@@ -91,6 +91,16 @@ void VertexBufferLeaf::updateBounds()
     }
 }
 
+/*  Replace the leaf's slice of the global data by its compact encoding.  */
+void VertexBufferLeaf::compact()
+{
+    _compact.reset(new CompactData);
+    _compact->encode(_globalData, _vertexStart, _vertexLength, _indexStart,
+                     _indexLength);
+    _vertexStart = 0;
+    _indexStart = 0;
+}
+
 /*  Compute the range of this child.  */
 void VertexBufferLeaf::updateRange()
 {
@@ -153,27 +163,76 @@ void VertexBufferLeaf::setupRendering(VertexBufferState& state,
             data[0] = state.newDisplayList(key);
         }
         glNewList(data[0], GL_COMPILE);
-        renderImmediate(state);
+        if (_compact)
+            renderCompactImmediate(state);
+        else
+            renderImmediate(state);
         glEndList();
         break;
     }
     }
 }
 
+/*  Set up rendering of compact leaf nodes.  */
+void VertexBufferLeaf::setupCompactRendering(VertexBufferState& state,
+                                             GLuint* data) const
+{
+    const char* charThis = reinterpret_cast<const char*>(this);
+
+    // positions are drawn as GL_SHORT, see renderCompactBufferObject()
+    if (data[VERTEX_OBJECT] == state.INVALID)
+        data[VERTEX_OBJECT] = state.newBufferObject(charThis + 0);
+    glBindBuffer(GL_ARRAY_BUFFER, data[VERTEX_OBJECT]);
+    glBufferData(GL_ARRAY_BUFFER, _vertexLength * sizeof(QuantizedVertex),
+                 _compact->vertices.data(), GL_STATIC_DRAW);
+
+    // fixed function has no octahedral normals, expand them to GL_BYTE
+    std::vector<ByteNormal> normals;
+    _compact->decodeNormals(normals);
+    if (data[NORMAL_OBJECT] == state.INVALID)
+        data[NORMAL_OBJECT] = state.newBufferObject(charThis + 1);
+    glBindBuffer(GL_ARRAY_BUFFER, data[NORMAL_OBJECT]);
+    glBufferData(GL_ARRAY_BUFFER, _vertexLength * sizeof(ByteNormal),
+                 normals.data(), GL_STATIC_DRAW);
+
+    if (data[COLOR_OBJECT] == state.INVALID)
+        data[COLOR_OBJECT] = state.newBufferObject(charThis + 2);
+    if (state.useColors())
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, data[COLOR_OBJECT]);
+        glBufferData(GL_ARRAY_BUFFER, _vertexLength * sizeof(Color),
+                     _compact->colors.data(), GL_STATIC_DRAW);
+    }
+
+    std::vector<ShortIndex> indices;
+    _compact->decodeIndices(indices);
+    if (data[INDEX_OBJECT] == state.INVALID)
+        data[INDEX_OBJECT] = state.newBufferObject(charThis + 3);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, data[INDEX_OBJECT]);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, _indexLength * sizeof(ShortIndex),
+                 indices.data(), GL_STATIC_DRAW);
+}
+
 /*  Draw the leaf.  */
 void VertexBufferLeaf::draw(VertexBufferState& state) const
 {
-    if (state.stopRendering())
+    if (state.stopRendering() || !_loaded)
         return;
 
     state.updateRegion(_boundingBox);
     switch (state.getRenderMode())
     {
     case RENDER_MODE_IMMEDIATE:
-        renderImmediate(state);
+        if (_compact)
+            renderCompactImmediate(state);
+        else
+            renderImmediate(state);
         return;
     case RENDER_MODE_BUFFER_OBJECT:
-        renderBufferObject(state);
+        if (_compact)
+            renderCompactBufferObject(state);
+        else
+            renderBufferObject(state);
         return;
     case RENDER_MODE_DISPLAY_LIST:
     default:
@@ -209,6 +268,41 @@ void VertexBufferLeaf::renderBufferObject(VertexBufferState& state) const
     glDrawElements(GL_TRIANGLES, GLsizei(_indexLength), GL_UNSIGNED_SHORT, 0);
 }
 
+/*  Render the compact leaf with buffer objects.  */
+void VertexBufferLeaf::renderCompactBufferObject(VertexBufferState& state) const
+{
+    GLuint buffers[4];
+    for (int i = 0; i < 4; ++i)
+        buffers[i] =
+            state.getBufferObject(reinterpret_cast<const char*>(this) + i);
+    if (buffers[VERTEX_OBJECT] == state.INVALID ||
+        buffers[NORMAL_OBJECT] == state.INVALID ||
+        buffers[COLOR_OBJECT] == state.INVALID ||
+        buffers[INDEX_OBJECT] == state.INVALID)
+
+        setupCompactRendering(state, buffers);
+
+    // dequantize positions on the GPU, the root enables GL_RESCALE_NORMAL
+    const Vertex& center = _compact->center;
+    const float scale = _compact->scale;
+    glPushMatrix();
+    glTranslatef(center.x(), center.y(), center.z());
+    glScalef(scale, scale, scale);
+
+    if (state.useColors())
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, buffers[COLOR_OBJECT]);
+        glColorPointer(3, GL_UNSIGNED_BYTE, 0, 0);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[NORMAL_OBJECT]);
+    glNormalPointer(GL_BYTE, 0, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[VERTEX_OBJECT]);
+    glVertexPointer(3, GL_SHORT, 0, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers[INDEX_OBJECT]);
+    glDrawElements(GL_TRIANGLES, GLsizei(_indexLength), GL_UNSIGNED_SHORT, 0);
+    glPopMatrix();
+}
+
 /*  Render the leaf with a display list.  */
 inline void VertexBufferLeaf::renderDisplayList(VertexBufferState& state) const
 {
@@ -240,6 +334,26 @@ inline void VertexBufferLeaf::renderImmediate(VertexBufferState& state) const
     glEnd();
 }
 
+/*  Render the compact leaf with immediate mode primitives.  */
+inline void VertexBufferLeaf::renderCompactImmediate(
+    VertexBufferState& state) const
+{
+    std::vector<ShortIndex> indices;
+    _compact->decodeIndices(indices);
+
+    glBegin(GL_TRIANGLES);
+    for (const ShortIndex i : indices)
+    {
+        if (state.useColors())
+            glColor3ubv(&_compact->colors[i][0]);
+        const Normal normal = _compact->getNormal(i);
+        const Vertex vertex = _compact->getVertex(i);
+        glNormal3fv(&normal[0]);
+        glVertex3fv(&vertex[0]);
+    }
+    glEnd();
+}
+
 /*  Read leaf node from memory.  */
 void VertexBufferLeaf::fromMemory(char** addr, VertexBufferData& globalData)
 {
@@ -254,6 +368,13 @@ void VertexBufferLeaf::fromMemory(char** addr, VertexBufferData& globalData)
     memRead(reinterpret_cast<char*>(&_vertexLength), addr, sizeof(ShortIndex));
     memRead(reinterpret_cast<char*>(&_indexStart), addr, sizeof(Index));
     memRead(reinterpret_cast<char*>(&_indexLength), addr, sizeof(Index));
+
+    bool compact;
+    memRead(reinterpret_cast<char*>(&compact), addr, sizeof(bool));
+    if (!compact)
+        return;
+    _compact.reset(new CompactData);
+    _compact->fromMemory(addr);
 }
 
 /*  Write leaf node to output stream.  */
@@ -266,5 +387,10 @@ void VertexBufferLeaf::toStream(std::ostream& os)
     os.write(reinterpret_cast<char*>(&_vertexLength), sizeof(ShortIndex));
     os.write(reinterpret_cast<char*>(&_indexStart), sizeof(Index));
     os.write(reinterpret_cast<char*>(&_indexLength), sizeof(Index));
+
+    const bool compact = bool(_compact);
+    os.write(reinterpret_cast<const char*>(&compact), sizeof(bool));
+    if (compact)
+        _compact->toStream(os);
 }
 }
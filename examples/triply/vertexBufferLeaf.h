@@ -30,7 +30,12 @@
 #ifndef PLYLIB_VERTEXBUFFERLEAF_H
 #define PLYLIB_VERTEXBUFFERLEAF_H
 
+#include "compactData.h"    // member
 #include "vertexBufferBase.h"
+#include "vertexBufferData.h" // member
+
+#include <atomic>
+#include <memory>
 
 namespace triply
 {
@@ -44,11 +49,28 @@ public:
         , _indexStart(0)
         , _indexLength(0)
         , _vertexLength(0)
+        , _loaded(true)
+    {
+    }
+
+    /** Construct a leaf holding its own data, used for distributed leaves. */
+    VertexBufferLeaf()
+        : _localData(new VertexBufferData)
+        , _globalData(*_localData)
+        , _vertexStart(0)
+        , _indexStart(0)
+        , _indexLength(0)
+        , _vertexLength(0)
+        , _loaded(true)
     {
     }
     virtual ~VertexBufferLeaf() {}
     virtual void draw(VertexBufferState& state) const;
     virtual Index getNumberOfVertices() const { return _indexLength; }
+    bool isLoaded() const final { return _loaded; }
+
+    /** @return the compact vertex data, or nullptr if not compacted. */
+    const CompactData* getCompactData() const { return _compact.get(); }
 protected:
     void toStream(std::ostream& os) final;
     void fromMemory(char** addr, VertexBufferData& globalData) final;
@@ -58,19 +80,27 @@ protected:
                    boost::progress_display&) final;
     void updateBounds() final;
     void updateRange() final;
+    void compact() final;
     Type getType() const final { return Type::leaf; }
 private:
     void setupRendering(VertexBufferState& state, GLuint* data) const;
     void renderImmediate(VertexBufferState& state) const;
     void renderDisplayList(VertexBufferState& state) const;
     void renderBufferObject(VertexBufferState& state) const;
+    void setupCompactRendering(VertexBufferState& state, GLuint* data) const;
+    void renderCompactImmediate(VertexBufferState& state) const;
+    void renderCompactBufferObject(VertexBufferState& state) const;
 
     friend class VertexBufferDist;
+    friend class VertexBufferNode;
+    std::unique_ptr<VertexBufferData> _localData;
     VertexBufferData& _globalData;
+    std::unique_ptr<CompactData> _compact;
     Index _vertexStart;
     Index _indexStart;
     Index _indexLength;
     ShortIndex _vertexLength;
+    std::atomic<bool> _loaded; //!< false while mapped by VertexBufferDist
 };
 }
 
@@ -35,6 +35,9 @@
 
 namespace triply
 {
+// grid cells along the longest axis of a node for its proxy geometry
+static const size_t LOD_RESOLUTION = 32;
+
 inline static bool _subdivide(const Index length, const size_t depth)
 {
     return (length > LEAF_SIZE) || (depth < 3 && length > 1);
@@ -78,10 +81,32 @@ void VertexBufferNode::setupTree(VertexData& data, const Index start,
                      globalData, progress);
     _right->setupTree(data, median, rightLength, newAxisRight, depth + 1,
                       globalData, progress);
+    _setupProxy(data, start, length);
     if (depth == 3)
         ++progress;
 }
 
+/*  Create the simplified geometry used when the node is small on screen.  */
+void VertexBufferNode::_setupProxy(const VertexData& data, const Index start,
+                                   const Index length)
+{
+    std::unique_ptr<VertexBufferLeaf> proxy(new VertexBufferLeaf);
+    VertexBufferData& proxyData = *proxy->_localData;
+    const float error = data.simplify(start, length, LOD_RESOLUTION, proxyData);
+
+    // keep the error monotonic for the traversal, parents are never finer
+    _error = std::max(error, std::max(_left->getError(), _right->getError()));
+
+    // only worth it if it significantly reduces the triangle count
+    if (proxyData.indices.empty() || proxyData.indices.size() > length * 3 / 2)
+        return;
+
+    proxy->_vertexLength = ShortIndex(proxyData.vertices.size());
+    proxy->_indexLength = proxyData.indices.size();
+    proxy->updateBounds();
+    _proxy = std::move(proxy);
+}
+
 void VertexBufferNode::updateBounds()
 {
     _left->updateBounds();
@@ -100,6 +125,20 @@ void VertexBufferNode::updateRange()
     // set node range to min/max of the children's ranges
     _range[0] = std::min(_left->getRange()[0], _right->getRange()[0]);
     _range[1] = std::max(_left->getRange()[1], _right->getRange()[1]);
+    if (_proxy)
+        _proxy->_range = _range;
+}
+
+/*  Compact the vertex data of the children.  */
+void VertexBufferNode::compact()
+{
+    _left->compact();
+    _right->compact();
+    if (_proxy)
+    {
+        _proxy->compact();
+        _proxy->_localData->clear();
+    }
 }
 
 /*  Draw the node by rendering the children.  */
@@ -123,6 +162,16 @@ void VertexBufferNode::fromMemory(char** addr, VertexBufferData& globalData)
                             std::to_string(unsigned(nodeType)));
     VertexBufferBase::fromMemory(addr, globalData);
 
+    memRead(reinterpret_cast<char*>(&_error), addr, sizeof(float));
+    bool hasProxy;
+    memRead(reinterpret_cast<char*>(&hasProxy), addr, sizeof(bool));
+    if (hasProxy)
+    {
+        _proxy.reset(new VertexBufferLeaf);
+        _proxy->_localData->fromMemory(addr);
+        _proxy->fromMemory(addr, *_proxy->_localData);
+    }
+
     // read left child (peek ahead)
     memRead(reinterpret_cast<char*>(&nodeType), addr, sizeof(nodeType));
     if (nodeType != Type::node && nodeType != Type::leaf)
@@ -156,6 +205,16 @@ void VertexBufferNode::toStream(std::ostream& os)
     const Type nodeType = Type::node;
     os.write(reinterpret_cast<const char*>(&nodeType), sizeof(nodeType));
     VertexBufferBase::toStream(os);
+
+    os.write(reinterpret_cast<const char*>(&_error), sizeof(float));
+    const bool hasProxy = bool(_proxy);
+    os.write(reinterpret_cast<const char*>(&hasProxy), sizeof(bool));
+    if (hasProxy)
+    {
+        _proxy->_localData->toStream(os);
+        _proxy->toStream(os);
+    }
+
     _left->toStream(os);
     _right->toStream(os);
 }
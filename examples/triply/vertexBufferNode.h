@@ -31,6 +31,7 @@
 #define PLYLIB_VERTEXBUFFERNODE_H
 
 #include "vertexBufferBase.h"
+#include "vertexBufferLeaf.h" // member
 #include <triply/api.h>
 
 namespace triply
@@ -39,7 +40,11 @@ namespace triply
 class VertexBufferNode : public VertexBufferBase
 {
 public:
-    VertexBufferNode() {}
+    VertexBufferNode()
+        : _error(0.f)
+        , _loaded(true)
+    {
+    }
     virtual ~VertexBufferNode() {}
     TRIPLY_API void draw(VertexBufferState& state) const override;
     Index getNumberOfVertices() const override
@@ -51,6 +56,9 @@ public:
     const VertexBufferBase* getRight() const override { return _right.get(); }
     VertexBufferBase* getLeft() override { return _left.get(); }
     VertexBufferBase* getRight() override { return _right.get(); }
+    const VertexBufferBase* getProxy() const override { return _proxy.get(); }
+    float getError() const override { return _error; }
+    bool isLoaded() const override { return _loaded; }
 protected:
     TRIPLY_API void toStream(std::ostream& os) override;
     TRIPLY_API void fromMemory(char** addr, VertexBufferData& globalData) final;
@@ -61,11 +69,19 @@ protected:
                               boost::progress_display&) override;
     TRIPLY_API void updateBounds() override;
     TRIPLY_API void updateRange() override;
+    TRIPLY_API void compact() override;
     Type getType() const override { return Type::node; }
 private:
+    void _setupProxy(const VertexData& data, Index start, Index length);
+
     friend class VertexBufferDist;
     std::unique_ptr<VertexBufferBase> _left;
     std::unique_ptr<VertexBufferBase> _right;
+
+    /** Vertex-clustered geometry of the subtree, a leaf with local data. */
+    std::unique_ptr<VertexBufferLeaf> _proxy;
+    float _error; //!< max vertex displacement of the proxy, object space
+    std::atomic<bool> _loaded; //!< all leaves loaded, see VertexBufferDist
 };
 }
 #endif // PLYLIB_VERTEXBUFFERNODE_H
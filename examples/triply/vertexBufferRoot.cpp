@@ -42,18 +42,18 @@
 
 namespace triply
 {
-using vmml::FrustumCullerf;
-
 /*  Determine number of bits used by the current architecture.  */
 size_t getArchitectureBits();
 /*  Determine whether the current architecture is little endian or not.  */
 bool isArchitectureLittleEndian();
 /*  Construct architecture dependent file name.  */
-std::string getArchitectureFilename(const std::string& filename);
+std::string getArchitectureFilename(const std::string& filename, bool compact);
 
 VertexBufferRoot::VertexBufferRoot(const std::string& filename)
     : VertexBufferNode()
     , _invertFaces(false)
+    , _compact(false)
+    , _hasColors(false)
 {
     if (!readFromFile(filename))
         throw std::runtime_error("Can't read " + filename);
@@ -70,8 +70,43 @@ void VertexBufferRoot::setupTree(VertexData& data,
 
     VertexBufferNode::setupTree(data, 0, data.triangles.size(), axis, 0, _data,
                                 progress);
+    _hasColors = !_data.colors.empty();
     VertexBufferNode::updateBounds();
     VertexBufferNode::updateRange();
+
+    if (_compact)
+    {
+        VertexBufferNode::compact();
+        _data.clear();
+    }
+    _flatten();
+}
+
+/*  Flatten the tree breadth-first for the batched frustum culling.  */
+void VertexBufferRoot::_flatten()
+{
+    _flatNodes.assign(1, this);
+    _flatChildren.clear();
+    _flatBoxes.clear();
+
+    for (size_t i = 0; i < _flatNodes.size(); ++i)
+    {
+        const VertexBufferBase* node = _flatNodes[i];
+        const VertexBufferBase* left = node->getLeft();
+        const VertexBufferBase* right = node->getRight();
+        _flatBoxes.add(node->getBoundingBox());
+
+        if (!left)
+        {
+            PLYLIBASSERT(!right);
+            _flatChildren.push_back(0);
+            continue;
+        }
+        PLYLIBASSERT(right);
+        _flatChildren.push_back(uint32_t(_flatNodes.size()));
+        _flatNodes.push_back(left);
+        _flatNodes.push_back(right);
+    }
 }
 
 // #define LOGCULL
@@ -79,96 +114,111 @@ void VertexBufferRoot::cullDraw(VertexBufferState& state) const
 {
     _beginRendering(state);
 
+    if (_mapData)
+        _mapData(state.getRange());
+
+    std::vector<const VertexBufferBase*> nodes;
+    cull(state, nodes);
+
 #ifdef LOGCULL
     size_t verticesRendered = 0;
-    size_t verticesOverlap = 0;
 #endif
+    for (const VertexBufferBase* node : nodes)
+    {
+        if (state.stopRendering())
+            break;
+
+        node->draw(state);
+        state.notifyVisible(node->getBoundingBox());
+#ifdef LOGCULL
+        verticesRendered += node->getNumberOfVertices();
+#endif
+    }
 
+    _endRendering(state);
+
+#ifdef LOGCULL
+    PLYLIBINFO << getName() << " rendered "
+               << verticesRendered * 100 / getNumberOfVertices()
+               << "% of model in " << nodes.size() << " nodes" << std::endl;
+#endif
+}
+
+void VertexBufferRoot::cull(const VertexBufferState& state,
+                            std::vector<const VertexBufferBase*>& nodes) const
+{
+    PLYLIBASSERT(!_flatNodes.empty());
     const Range& range = state.getRange();
-    const FrustumCullerf culler(state.getProjectionModelViewMatrix());
+    const float threshold = state.getLODThreshold();
+
+    // view frustum culling of all nodes
+    std::vector<uint8_t> visibilities;
+    if (state.useFrustumCulling())
+        _flatBoxes.test(state.getProjectionModelViewMatrix(), visibilities);
+    else
+        visibilities.assign(_flatNodes.size(), vmml::VISIBILITY_FULL);
 
     // start with root node
-    std::vector<const triply::VertexBufferBase*> candidates;
-    candidates.push_back(this);
+    std::vector<uint32_t> candidates;
+    candidates.push_back(0);
 
     while (!candidates.empty())
     {
-        if (state.stopRendering())
-            return;
-
-        const triply::VertexBufferBase* treeNode = candidates.back();
+        const uint32_t index = candidates.back();
         candidates.pop_back();
+        const triply::VertexBufferBase* treeNode = _flatNodes[index];
+        const float* nodeRange = treeNode->getRange();
 
         // completely out of range check
-        if (treeNode->getRange()[0] >= range[1] ||
-            treeNode->getRange()[1] < range[0])
-        {
+        if (nodeRange[0] >= range[1] || nodeRange[1] < range[0])
             continue;
-        }
 
-        // bounding sphere view frustum culling
         const vmml::Visibility visibility =
-            state.useFrustumCulling() ? culler.test(treeNode->getBoundingBox())
-                                      : vmml::VISIBILITY_FULL;
-        switch (visibility)
-        {
-        case vmml::VISIBILITY_FULL:
-            // if fully visible and fully in range, render it
-            if (treeNode->getRange()[0] >= range[0] &&
-                treeNode->getRange()[1] < range[1])
-            {
-                treeNode->draw(state);
-                state.notifyVisible(treeNode->getBoundingBox());
-#ifdef LOGCULL
-                verticesRendered += treeNode->getNumberOfVertices();
-#endif
-                break;
-            }
-        // partial range, fall through to partial visibility
+            vmml::Visibility(visibilities[index]);
+        if (visibility == vmml::VISIBILITY_NONE)
+            continue;
 
-        case vmml::VISIBILITY_PARTIAL:
+        const bool inRange = nodeRange[0] >= range[0];
+        const bool loaded = treeNode->isLoaded();
+
+        // level of detail, or data still being mapped: the proxy replaces the
+        // whole subtree, use it only if all of it is drawn by this range
+        const VertexBufferBase* proxy = treeNode->getProxy();
+        if (proxy && inRange && nodeRange[1] <= range[1] &&
+            (!loaded ||
+             (threshold > 0.f &&
+              state.getScreenSpaceError(treeNode->getBoundingBox(),
+                                        treeNode->getError()) <= threshold)))
         {
-            const triply::VertexBufferBase* left = treeNode->getLeft();
-            const triply::VertexBufferBase* right = treeNode->getRight();
-
-            if (!left && !right)
-            {
-                if (treeNode->getRange()[0] >= range[0])
-                {
-                    treeNode->draw(state);
-                    state.notifyVisible(treeNode->getBoundingBox());
-#ifdef LOGCULL
-                    verticesRendered += treeNode->getNumberOfVertices();
-                    if (visibility == vmml::VISIBILITY_PARTIAL)
-                        verticesOverlap += treeNode->getNumberOfVertices();
-#endif
-                }
-                // else drop, to be drawn by 'previous' channel
-            }
-            else
-            {
-                if (left)
-                    candidates.push_back(left);
-                if (right)
-                    candidates.push_back(right);
-            }
-            break;
+            nodes.push_back(proxy);
+            continue;
         }
-        case vmml::VISIBILITY_NONE:
-            // do nothing
-            break;
+
+        const uint32_t left = _flatChildren[index];
+        const bool isLeaf = left == 0;
+
+        // if fully visible and fully in range, render it unless the level of
+        // detail or missing data might select proxies further down
+        if (visibility == vmml::VISIBILITY_FULL && inRange &&
+            nodeRange[1] < range[1] &&
+            (isLeaf || (loaded && threshold <= 0.f)))
+        {
+            nodes.push_back(treeNode);
+            continue;
         }
-    }
 
-    _endRendering(state);
+        // partial visibility or partial range
+        if (isLeaf)
+        {
+            if (inRange)
+                nodes.push_back(treeNode);
+            // else drop, to be drawn by 'previous' channel
+            continue;
+        }
 
-#ifdef LOGCULL
-    const size_t verticesTotal = model->getNumberOfVertices();
-    PLYLIBINFO << getName() << " rendered "
-               << verticesRendered * 100 / verticesTotal
-               << "% of model, overlap <= "
-               << verticesOverlap * 100 / verticesTotal << "%" << std::endl;
-#endif
+        candidates.push_back(left);
+        candidates.push_back(left + 1);
+    }
 }
 
 /*  Set up the common OpenGL state for rendering of all nodes.  */
@@ -180,6 +230,11 @@ void VertexBufferRoot::_beginRendering(VertexBufferState& state) const
 #ifdef GL_ARB_vertex_buffer_object
     case RENDER_MODE_BUFFER_OBJECT:
         glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+        if (_compact) // leaves scale normals with the dequantization
+        {
+            glPushAttrib(GL_ENABLE_BIT);
+            glEnable(GL_RESCALE_NORMAL);
+        }
         glEnableClientState(GL_VERTEX_ARRAY);
         glEnableClientState(GL_NORMAL_ARRAY);
         if (state.useColors())
@@ -194,6 +249,8 @@ void VertexBufferRoot::_beginRendering(VertexBufferState& state) const
 /*  Delegate rendering to node routine.  */
 void VertexBufferRoot::draw(VertexBufferState& state) const
 {
+    if (_mapData)
+        _mapData(_range);
     VertexBufferNode::draw(state);
 }
 
@@ -209,6 +266,8 @@ void VertexBufferRoot::_endRendering(VertexBufferState& state) const
 #define glewGetContext state.glewGetContext
         glBindBuffer(GL_ARRAY_BUFFER_ARB, 0);
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
+        if (_compact)
+            glPopAttrib();
         glPopClientAttrib();
     }
 #endif
@@ -233,11 +292,12 @@ bool isArchitectureLittleEndian()
 }
 
 /*  Construct architecture dependent file name.  */
-std::string getArchitectureFilename(const std::string& filename)
+std::string getArchitectureFilename(const std::string& filename,
+                                    const bool compact)
 {
     std::ostringstream oss;
     oss << filename << (isArchitectureLittleEndian() ? ".le" : ".be");
-    oss << getArchitectureBits() << ".bin";
+    oss << getArchitectureBits() << (compact ? ".compact.bin" : ".bin");
     return oss.str();
 }
 
@@ -368,7 +428,7 @@ bool VertexBufferRoot::_readBinary(std::string filename)
 /*  Read binary kd-tree representation, construct from ply if unavailable.  */
 bool VertexBufferRoot::readFromFile(const std::string& filename)
 {
-    if (_readBinary(getArchitectureFilename(filename)))
+    if (_readBinary(getArchitectureFilename(filename, _compact)))
     {
         _name = filename;
         return true;
@@ -386,7 +446,7 @@ bool VertexBufferRoot::writeToFile(const std::string& filename)
 {
     bool result = false;
 
-    std::ofstream output(getArchitectureFilename(filename).c_str(),
+    std::ofstream output(getArchitectureFilename(filename, _compact).c_str(),
                          std::ios::out | std::ios::binary);
     if (output)
     {
@@ -429,8 +489,11 @@ void VertexBufferRoot::fromMemory(char* start)
             "Error reading binary file. Expected root node, "
             "got " +
             std::to_string(unsigned(nodeType)));
+    memRead(reinterpret_cast<char*>(&_compact), addr, sizeof(bool));
+    memRead(reinterpret_cast<char*>(&_hasColors), addr, sizeof(bool));
     _data.fromMemory(addr);
     VertexBufferNode::fromMemory(addr, _data);
+    _flatten();
 }
 
 /*  Write root node to output stream and continue with other nodes.  */
@@ -440,6 +503,8 @@ void VertexBufferRoot::toStream(std::ostream& os)
     os.write(reinterpret_cast<char*>(&version), sizeof(size_t));
     const Type nodeType = Type::root;
     os.write(reinterpret_cast<const char*>(&nodeType), sizeof(nodeType));
+    os.write(reinterpret_cast<const char*>(&_compact), sizeof(bool));
+    os.write(reinterpret_cast<const char*>(&_hasColors), sizeof(bool));
     _data.toStream(os);
     VertexBufferNode::toStream(os);
 }
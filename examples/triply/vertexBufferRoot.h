@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2007-2016, Tobias Wolf <twolf@access.unizh.ch>
+/* Copyright (c) 2007-2017, Tobias Wolf <twolf@access.unizh.ch>
  *                          Stefan Eilemann <eile@equalizergraphics.com>
  *
  * Redistribution and use in source and binary forms, with or without
@@ -30,10 +30,13 @@
 #ifndef PLYLIB_VERTEXBUFFERROOT_H
 #define PLYLIB_VERTEXBUFFERROOT_H
 
+#include "boxCuller.h" // member
 #include "vertexBufferData.h"
 #include "vertexBufferNode.h"
 #include <triply/api.h>
 
+#include <functional>
+
 namespace triply
 {
 /*  The class for kd-tree root nodes.  */
@@ -43,18 +46,39 @@ public:
     VertexBufferRoot()
         : VertexBufferNode()
         , _invertFaces(false)
+        , _compact(false)
+        , _hasColors(false)
     {
     }
     TRIPLY_API VertexBufferRoot(const std::string& filename);
 
     TRIPLY_API virtual void cullDraw(VertexBufferState& state) const;
+
+    /**
+     * Select the nodes to draw for the given state.
+     *
+     * Applies the range, frustum culling and level of detail selection of
+     * cullDraw() without rendering. The result contains subtrees and proxy
+     * geometry, each to be drawn with its draw() method. All node bounding
+     * boxes are frustum culled in one parallel batch before the traversal.
+     * Thread safe.
+     */
+    TRIPLY_API void cull(const VertexBufferState& state,
+                         std::vector<const VertexBufferBase*>& nodes) const;
     TRIPLY_API virtual void draw(VertexBufferState& state) const;
 
     TRIPLY_API void setupTree(VertexData& data, boost::progress_display&);
     TRIPLY_API bool writeToFile(const std::string& filename);
     TRIPLY_API bool readFromFile(const std::string& filename);
-    bool hasColors() const { return !_data.colors.empty(); }
+    bool hasColors() const { return _hasColors; }
     void useInvertedFaces() { _invertFaces = true; }
+
+    /**
+     * Store the leaves in compact form, with quantized positions, encoded
+     * normals and delta-coded indices. Must be set before reading a model.
+     */
+    void useCompactData() { _compact = true; }
+    bool isCompact() const { return _compact; }
     const std::string& getName() const { return _name; }
 protected:
     TRIPLY_API void toStream(std::ostream& os) final;
@@ -64,13 +88,24 @@ private:
     bool _constructFromPly(const std::string& filename);
     bool _readBinary(std::string filename);
 
+    void _flatten();
     void _beginRendering(VertexBufferState& state) const;
     void _endRendering(VertexBufferState& state) const;
 
     friend class VertexBufferDist;
     VertexBufferData _data;
     bool _invertFaces;
+    bool _compact;
+    bool _hasColors;
     std::string _name;
+
+    // breadth-first node array for culling, see _flatten()
+    std::vector<const VertexBufferBase*> _flatNodes;
+    std::vector<uint32_t> _flatChildren; // left child index, 0 for leaves
+    BoxCuller _flatBoxes;
+
+    /** Makes the data of the given range available, set by a slave dist. */
+    std::function<void(const Range&)> _mapData;
 };
 }
 
@@ -28,10 +28,14 @@
 
 #include "vertexBufferState.h"
 
+#include <cmath>
+
 namespace triply
 {
 VertexBufferState::VertexBufferState(const GLEWContext* glewContext)
-    : _glewContext(glewContext)
+    : _pixelsPerUnit(0.f)
+    , _lodThreshold(0.f)
+    , _glewContext(glewContext)
     , _renderMode(RENDER_MODE_DISPLAY_LIST)
     , _useColors(false)
     , _useFrustumCulling(true)
@@ -39,7 +43,6 @@ VertexBufferState::VertexBufferState(const GLEWContext* glewContext)
     _range[0] = 0.f;
     _range[1] = 1.f;
     resetRegion();
-    PLYLIBASSERT(glewContext);
 }
 
 void VertexBufferState::setRenderMode(const RenderMode mode)
@@ -101,6 +104,25 @@ void VertexBufferState::updateRegion(const BoundingBox& box)
     _region[3] = std::max(_region[3], normalized[3]);
 }
 
+float VertexBufferState::getScreenSpaceError(const BoundingBox& box,
+                                             const float error) const
+{
+    // error is projected at the closest point of the box
+    const Vertex& min = box.getMin();
+    const Vertex& max = box.getMax();
+    float distance2 = 0.f;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const float delta =
+            std::max(std::max(min[i] - _eye[i], _eye[i] - max[i]), 0.f);
+        distance2 += delta * delta;
+    }
+
+    if (distance2 == 0.f) // eye within box
+        return error > 0.f ? std::numeric_limits<float>::max() : 0.f;
+    return error * _pixelsPerUnit / std::sqrt(distance2);
+}
+
 Vector4f VertexBufferState::getRegion() const
 {
     if (_region[0] > _region[2] || _region[1] > _region[3])
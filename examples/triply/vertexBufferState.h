@@ -73,6 +73,31 @@ public:
 
     TRIPLY_API void setRange(const Range& range) { _range = range; }
     TRIPLY_API const Range& getRange() const { return _range; }
+
+    /**
+     * Set the maximum screen space error in pixels for level of detail
+     * selection. Subtrees whose proxy geometry is within the threshold are
+     * drawn simplified. 0 disables level of detail, the default.
+     */
+    void setLODThreshold(const float pixels) { _lodThreshold = pixels; }
+    float getLODThreshold() const { return _lodThreshold; }
+
+    /**
+     * Set the perspective parameters for the screen space error.
+     *
+     * @param eye the eye position in model coordinates.
+     * @param pixelsPerUnit the size in pixels of one model unit at a distance
+     *                      of one, e.g., projection(1,1) * viewport height / 2.
+     */
+    void setLODProjection(const Vertex& eye, const float pixelsPerUnit)
+    {
+        _eye = eye;
+        _pixelsPerUnit = pixelsPerUnit;
+    }
+
+    /** @return the projected size in pixels of an error within the box. */
+    TRIPLY_API float getScreenSpaceError(const BoundingBox& box,
+                                         float error) const;
     TRIPLY_API void resetRegion();
     TRIPLY_API virtual void updateRegion(const BoundingBox& box);
     virtual void declareRegion(const Vector4f&) {}
@@ -95,6 +120,9 @@ protected:
     TRIPLY_API virtual ~VertexBufferState() {}
     Matrix4f _pmvMatrix; //!< projection * modelView matrix
     Range _range;        //!< normalized [0,1] part of the model to draw
+    Vertex _eye;         //!< eye position in model coordinates
+    float _pixelsPerUnit;
+    float _lodThreshold;
     const GLEWContext* const _glewContext;
     RenderMode _renderMode;
     Vector4f _region; //!< normalized x1 y1 x2 y2 region from cullDraw
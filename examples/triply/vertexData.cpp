@@ -29,9 +29,13 @@
 
 #include "vertexData.h"
 #include "ply.h"
+#include "vertexBufferData.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstdlib>
+#include <unordered_map>
+#include <unordered_set>
 
 #if ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 4)))
 #include <parallel/algorithm>
@@ -362,3 +366,127 @@ void VertexData::sort(const Index start, const Index length, const Axis axis)
     ::sort(triangles.begin() + start, triangles.begin() + start + length,
            _TriangleSort(*this, axis));
 }
+
+/*  Simplify the triangles from start to start + length by vertex clustering. */
+float VertexData::simplify(const Index start, const Index length,
+                           const size_t resolution,
+                           VertexBufferData& result) const
+{
+    PLYLIBASSERT(length > 0);
+    PLYLIBASSERT(resolution > 0 && resolution <= 32);
+    result.clear();
+
+    BoundingBox box{vertices[triangles[start][0]],
+                    vertices[triangles[start][0]]};
+    for (Index t = start; t < start + length; ++t)
+        for (size_t v = 0; v < 3; ++v)
+            box.merge(vertices[triangles[t][v]]);
+
+    const float maxSize = box.getSize().find_max();
+    const float cellSize = maxSize > 0.f ? maxSize / float(resolution) : 1.f;
+    const Vertex& origin = box.getMin();
+
+    // accumulate each referenced vertex once into its cell's cluster
+    struct Cluster
+    {
+        Vertex position;
+        Normal normal;
+        Vertex color;
+        size_t count;
+        ShortIndex index; // in result, assigned when first used
+    };
+    std::vector<Cluster> clusters;
+    std::unordered_map<size_t, size_t> cells;
+    std::unordered_map<Index, size_t> vertexCluster;
+    const bool hasColors = !colors.empty();
+
+    auto getCluster = [&](const Index vertex) -> size_t {
+        const auto known = vertexCluster.find(vertex);
+        if (known != vertexCluster.end())
+            return known->second;
+
+        size_t key = 0;
+        for (int i = 2; i >= 0; --i)
+        {
+            const float cell = (vertices[vertex][i] - origin[i]) / cellSize;
+            key = key * resolution +
+                  std::min(size_t(std::max(cell, 0.f)), resolution - 1);
+        }
+
+        const auto cell = cells.find(key);
+        size_t index = clusters.size();
+        if (cell == cells.end())
+        {
+            cells[key] = index;
+            clusters.push_back(Cluster{Vertex::ZERO, Normal::ZERO,
+                                       Vertex::ZERO, 0, 0});
+        }
+        else
+            index = cell->second;
+
+        Cluster& cluster = clusters[index];
+        cluster.position += vertices[vertex];
+        cluster.normal += normals[vertex];
+        if (hasColors)
+            cluster.color += Vertex(colors[vertex].x(), colors[vertex].y(),
+                                    colors[vertex].z());
+        ++cluster.count;
+        vertexCluster[vertex] = index;
+        return index;
+    };
+
+    // keep non-degenerate, unique triangles
+    std::vector<vmml::vector<3, size_t>> kept;
+    std::unordered_set<uint64_t> unique;
+    for (Index t = start; t < start + length; ++t)
+    {
+        const vmml::vector<3, size_t> triangle(getCluster(triangles[t][0]),
+                                               getCluster(triangles[t][1]),
+                                               getCluster(triangles[t][2]));
+        if (triangle[0] == triangle[1] || triangle[1] == triangle[2] ||
+            triangle[0] == triangle[2])
+        {
+            continue;
+        }
+
+        uint64_t sorted[3] = {triangle[0], triangle[1], triangle[2]};
+        std::sort(sorted, sorted + 3);
+        if (unique.insert(sorted[0] | (sorted[1] << 16) | (sorted[2] << 32))
+                .second)
+        {
+            kept.push_back(triangle);
+        }
+    }
+
+    // emit the clusters used by the remaining triangles
+    for (const auto& triangle : kept)
+    {
+        for (size_t v = 0; v < 3; ++v)
+        {
+            Cluster& cluster = clusters[triangle[v]];
+            if (cluster.count > 0)
+            {
+                const float weight = 1.f / float(cluster.count);
+                cluster.index = ShortIndex(result.vertices.size());
+                cluster.count = 0;
+
+                Normal normal = cluster.normal;
+                if (normal.squared_length() > 0.f)
+                    normal.normalize();
+                result.vertices.push_back(cluster.position * weight);
+                result.normals.push_back(normal);
+                if (hasColors)
+                {
+                    const Vertex color = cluster.color * weight;
+                    result.colors.push_back(
+                        Color(uint8_t(color.x() + .5f),
+                              uint8_t(color.y() + .5f),
+                              uint8_t(color.z() + .5f)));
+                }
+            }
+            result.indices.push_back(cluster.index);
+        }
+    }
+
+    return cellSize * std::sqrt(3.f);
+}
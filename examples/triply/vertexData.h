@@ -53,6 +53,23 @@ public:
     TRIPLY_API Axis getLongestAxis(const size_t start,
                                    const size_t elements) const;
 
+    /**
+     * Simplify the given triangles by vertex clustering.
+     *
+     * The vertices are merged in a regular grid of cubic cells, with the given
+     * number of cells along the longest axis of the triangles' bounding box.
+     * Triangles collapsing within one cell are dropped.
+     *
+     * @param start the first triangle.
+     * @param length the number of triangles.
+     * @param resolution the number of cells along the longest axis, at most
+     *                   32 to stay within ShortIndex range.
+     * @param result the simplified mesh, indices relative to its vertices.
+     * @return the object space error, i.e., the diagonal of one cell.
+     */
+    TRIPLY_API float simplify(Index start, Index length, size_t resolution,
+                              VertexBufferData& result) const;
+
     void useInvertedFaces() { _invertFaces = true; }
     std::vector<Vertex> vertices;
     std::vector<Color> colors;
@@ -0,0 +1,200 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+// Tests the order, completeness and priority of the eq::CommandQueue lanes with
+// concurrent producers, including the overflow of the lock-free ring
+
+#include <eq/commandQueue.h>
+
+#include <co/buffer.h>
+#include <co/commands.h>
+#include <co/iCommand.h>
+#include <co/init.h>
+#include <co/node.h>
+#include <lunchbox/test.h>
+#include <lunchbox/thread.h>
+
+#include <memory>
+
+namespace
+{
+const uint32_t nProducers = 4;
+const uint32_t nCommands = 20000; // per producer, overflows the ring
+const uint32_t timeout = 10000;
+
+/** @return a command carrying the producer as command and an index. */
+co::ICommand _newCommand(co::NodePtr sender, const uint32_t producer,
+                         const uint32_t index)
+{
+    const uint64_t size = sizeof(uint64_t) + 3 * sizeof(uint32_t);
+    const uint32_t type = co::COMMANDTYPE_NODE;
+
+    co::BufferPtr buffer = new co::Buffer;
+    buffer->append(reinterpret_cast<const uint8_t*>(&size), sizeof(size));
+    buffer->append(reinterpret_cast<const uint8_t*>(&type), sizeof(type));
+    buffer->append(reinterpret_cast<const uint8_t*>(&producer),
+                   sizeof(producer));
+    buffer->append(reinterpret_cast<const uint8_t*>(&index), sizeof(index));
+    return co::ICommand(0, sender, buffer);
+}
+
+/** @return the index of the next command of the given producer. */
+uint32_t _pop(eq::CommandQueue& queue, const uint32_t producer)
+{
+    co::ICommand command = queue.pop(timeout);
+    TEST(command.isValid());
+    TESTINFO(command.getCommand() == producer,
+             command.getCommand() << " != " << producer);
+    return command.read<uint32_t>();
+}
+
+/** Pushes its commands, alternating between the lanes when priority. */
+class Producer : public lunchbox::Thread
+{
+public:
+    Producer(eq::CommandQueue& queue, const uint32_t id, const bool priority)
+        : _queue(queue)
+        , _id(id)
+        , _priority(priority)
+    {
+    }
+
+    void run() override
+    {
+        for (uint32_t i = 0; i < nCommands; ++i)
+        {
+            if (_priority && (i & 1))
+                _queue.pushPriority(_newCommand(0, _id, i));
+            else
+                _queue.push(_newCommand(0, _id, i));
+        }
+    }
+
+private:
+    eq::CommandQueue& _queue;
+    const uint32_t _id;
+    const bool _priority;
+};
+
+/**
+ * Pop the commands of all producers, started before or while popping. Each
+ * producer's commands have to be dequeued exactly once and in order.
+ */
+void _testProducers(const bool concurrent, const bool priority)
+{
+    eq::CommandQueue queue(0);
+    std::vector<std::unique_ptr<Producer>> producers;
+    for (uint32_t i = 0; i < nProducers; ++i)
+    {
+        producers.emplace_back(new Producer(queue, i, priority));
+        TEST(producers.back()->start());
+    }
+    if (!concurrent)
+    {
+        for (auto& producer : producers)
+            TEST(producer->join());
+        TEST(queue.getSize() == nProducers * nCommands);
+    }
+
+    std::vector<uint32_t> next(nProducers, 0);
+    for (uint32_t i = 0; i < nProducers * nCommands; ++i)
+    {
+        co::ICommand command = queue.pop(timeout);
+        TEST(command.isValid());
+        const uint32_t producer = command.getCommand();
+        TESTINFO(producer < nProducers, producer);
+
+        const uint32_t index = command.read<uint32_t>();
+        TESTINFO(index == next[producer], "producer " << producer << ": "
+                                                      << index << " != "
+                                                      << next[producer]);
+        ++next[producer];
+    }
+
+    for (auto& producer : producers)
+        TEST(producer->join());
+    TEST(queue.isEmpty());
+    TEST(queue.getSize() == 0);
+    TEST(!queue.tryPop().isValid());
+}
+
+/** Pushes one command after a delay, while the consumer blocks in pop(). */
+class DelayedProducer : public lunchbox::Thread
+{
+public:
+    explicit DelayedProducer(eq::CommandQueue& queue)
+        : _queue(queue)
+    {
+    }
+
+    void run() override
+    {
+        lunchbox::sleep(50);
+        _queue.push(_newCommand(0, 0, 42));
+    }
+
+private:
+    eq::CommandQueue& _queue;
+};
+}
+
+int main(int argc, char** argv)
+{
+    TEST(co::init(argc, argv));
+    {
+        _testProducers(false, false); // ring full, drained from overflow
+        _testProducers(true, false);  // consumer racing ring and overflow
+        _testProducers(true, true);   // and the priority lane
+
+        // a priority command overtakes the older commands of other senders
+        eq::CommandQueue queue(0);
+        co::NodePtr first = new co::Node;
+        co::NodePtr second = new co::Node;
+        co::CommandQueue* priorityQueue = queue.getPriorityQueue();
+        co::CommandQueue* dispatchQueue = queue.getDispatchQueue();
+        TEST(eq::CommandQueue::get(priorityQueue) == &queue);
+        TEST(eq::CommandQueue::get(dispatchQueue) == &queue);
+
+        dispatchQueue->push(_newCommand(first, 0, 0));
+        dispatchQueue->push(_newCommand(second, 1, 1));
+        priorityQueue->push(_newCommand(second, 1, 2));
+        TEST(queue.getSize() == 3);
+        TEST(_pop(queue, 0) == 0);
+        TEST(_pop(queue, 1) == 1); // not overtaken by its own priority command
+        TEST(_pop(queue, 1) == 2);
+
+        dispatchQueue->push(_newCommand(second, 1, 3));
+        priorityQueue->push(_newCommand(first, 0, 4));
+        TEST(_pop(queue, 0) == 4);
+        TEST(_pop(queue, 1) == 3);
+        TEST(queue.isEmpty());
+
+        // pop times out on an empty queue and blocks until a push
+        TEST(!queue.pop(10).isValid());
+        DelayedProducer producer(queue);
+        TEST(producer.start());
+        TEST(_pop(queue, 0) == 42);
+        TEST(producer.join());
+
+        queue.push(_newCommand(first, 0, 5));
+        queue.flush();
+        TEST(queue.isEmpty());
+    }
+    TEST(co::exit());
+    return EXIT_SUCCESS;
+}
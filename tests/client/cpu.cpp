@@ -0,0 +1,268 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Runs 2D, DB and tile compounds headless on the CPU window system and checks
+// their output and scaling against a single channel rendering everything.
+
+#include <eq/cpu/window.h>
+#include <eq/eq.h>
+#include <lunchbox/test.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <thread>
+
+namespace
+{
+const size_t nFrames = 20;
+const float drawCost = 40.f; // ms to draw the whole scene
+
+/** A screen-aligned rectangle in normalized view coordinates. */
+struct Quad
+{
+    float x, y, w, h, depth;
+    uint32_t color;
+};
+
+const Quad _scene[] = {{.05f, .05f, .5f, .5f, .5f, 0xff0000ffu},
+                       {.25f, .15f, .5f, .5f, .4f, 0xff00ff00u},
+                       {.45f, .25f, .5f, .5f, .6f, 0xffff0000u},
+                       {.15f, .45f, .5f, .5f, .3f, 0xff00ffffu},
+                       {.35f, .35f, .3f, .3f, .2f, 0xffffff00u},
+                       {.60f, .60f, .3f, .3f, .7f, 0xffff00ffu},
+                       {.05f, .70f, .2f, .2f, .1f, 0xffffffffu},
+                       {.75f, .05f, .2f, .2f, .8f, 0xff808080u}};
+const size_t _nQuads = sizeof(_scene) / sizeof(Quad);
+
+std::vector<uint32_t> _result; // destination pixels of the last frame
+
+eq::cpu::Window* _getCPUWindow(eq::Channel* channel)
+{
+    return static_cast<eq::cpu::Window*>(
+        channel->getWindow()->getSystemWindow());
+}
+
+class Pipe : public eq::Pipe
+{
+public:
+    explicit Pipe(eq::Node* parent)
+        : eq::Pipe(parent)
+    {
+    }
+
+protected:
+    eq::WindowSystem selectWindowSystem() const final
+    {
+        return eq::WindowSystem("CPU");
+    }
+};
+
+class Channel : public eq::Channel
+{
+public:
+    explicit Channel(eq::Window* parent)
+        : eq::Channel(parent)
+    {
+    }
+
+protected:
+    void frameClear(const eq::uint128_t&) final
+    {
+        _getCPUWindow(this)->clear(getPixelViewport(), 0xff000000u);
+    }
+
+    void frameDraw(const eq::uint128_t&) final
+    {
+        eq::cpu::Window* window = _getCPUWindow(this);
+        uint32_t* colors = window->getColorBuffer();
+        uint32_t* depths = window->getDepthBuffer();
+        const int32_t width = window->getWidth();
+        const eq::PixelViewport& pvp = getPixelViewport();
+        const eq::Viewport& vp = getViewport();
+        const eq::Range& range = getRange();
+
+        for (size_t i = 0; i < _nQuads; ++i)
+        {
+            const float position = (float(i) + .5f) / float(_nQuads);
+            if (position < range.start || position >= range.end)
+                continue;
+
+            const Quad& quad = _scene[i];
+            eq::PixelViewport area(
+                pvp.x + int32_t(std::floor((quad.x - vp.x) / vp.w * pvp.w)),
+                pvp.y + int32_t(std::floor((quad.y - vp.y) / vp.h * pvp.h)),
+                int32_t(quad.w / vp.w * pvp.w + .5f),
+                int32_t(quad.h / vp.h * pvp.h + .5f));
+            area.intersect(pvp);
+            if (!area.hasArea())
+                continue;
+
+            const uint32_t depth = uint32_t(quad.depth * 4294967295.f);
+            for (int32_t y = area.y; y < area.getYEnd(); ++y)
+            {
+                uint32_t* color = colors + y * width;
+                uint32_t* z = depths + y * width;
+                for (int32_t x = area.x; x < area.getXEnd(); ++x)
+                {
+                    if (depth >= z[x])
+                        continue;
+                    z[x] = depth;
+                    color[x] = quad.color;
+                }
+            }
+        }
+
+        // simulated rendering cost, proportional to the assigned work
+        const float cost = drawCost * vp.getArea() * (range.end - range.start);
+        std::this_thread::sleep_for(
+            std::chrono::microseconds(int64_t(cost * 1000.f)));
+    }
+
+    void frameReadback(const eq::uint128_t&, const eq::Frames& frames) final
+    {
+        _getCPUWindow(this)->readback(frames, getRegions(), getContext());
+    }
+
+    void frameAssemble(const eq::uint128_t&, const eq::Frames& frames) final
+    {
+        _getCPUWindow(this)->assemble(frames, getPixelViewport(), false,
+                                      getConfig()->getTimeout());
+    }
+
+    void frameViewFinish(const eq::uint128_t& frameID) final
+    {
+        eq::Channel::frameViewFinish(frameID);
+        if (getName() != "destination")
+            return;
+
+        eq::cpu::Window* window = _getCPUWindow(this);
+        const eq::PixelViewport& pvp = getPixelViewport();
+        _result.resize(pvp.getArea());
+        for (int32_t y = 0; y < pvp.h; ++y)
+        {
+            const uint32_t* row = window->getColorBuffer() +
+                                  (pvp.y + y) * window->getWidth() + pvp.x;
+            std::copy(row, row + pvp.w, _result.begin() + y * pvp.w);
+        }
+    }
+
+    void setupAssemblyState() final {}
+    void resetAssemblyState() final {}
+};
+
+class NodeFactory : public eq::NodeFactory
+{
+public:
+    eq::Pipe* createPipe(eq::Node* parent) final { return new Pipe(parent); }
+    eq::Channel* createChannel(eq::Window* parent) final
+    {
+        return new Channel(parent);
+    }
+};
+
+/** @return the time per frame of the given config in ms. */
+float _testConfig(eq::ClientPtr client, const std::string& filename)
+{
+    eq::ServerPtr server = new eq::Server;
+    eq::Global::setConfig(filename);
+    TEST(client->connectServer(server));
+
+    eq::fabric::ConfigParams configParams;
+    eq::Config* config = server->chooseConfig(configParams);
+    TESTINFO(config, filename);
+    TESTINFO(config->init(eq::uint128_t()), filename);
+
+    config->startFrame(eq::uint128_t()); // warm up
+    config->finishAllFrames();
+
+    const lunchbox::Clock clock;
+    for (size_t i = 0; i < nFrames; ++i)
+    {
+        config->startFrame(eq::uint128_t());
+        config->finishFrame();
+    }
+    config->finishAllFrames();
+    const float time = clock.getTimef() / float(nFrames);
+
+    TESTINFO(config->exit(), filename);
+    server->releaseConfig(config);
+    client->disconnectServer(server);
+    return time;
+}
+
+/** @return the fraction of pixels differing from the reference. */
+float _compare(const std::vector<uint32_t>& reference,
+               const std::vector<uint32_t>& result)
+{
+    if (reference.size() != result.size() || reference.empty())
+        return 1.f;
+
+    size_t differences = 0;
+    for (size_t i = 0; i < reference.size(); ++i)
+        if (reference[i] != result[i])
+            ++differences;
+    return float(differences) / float(reference.size());
+}
+}
+
+int main(int argc, char** argv)
+{
+    NodeFactory nodeFactory;
+    TEST(eq::init(argc, argv, &nodeFactory));
+
+    eq::ClientPtr client = new eq::Client;
+    TEST(client->initLocal(argc, argv));
+
+    lunchbox::Strings configs = lunchbox::searchDirectory("cpu", ".*\\.eqc");
+    lunchbox::usort(configs); // reference config first
+    TEST(configs.size() > 1);
+
+    std::vector<uint32_t> reference;
+    float referenceTime = 0.f;
+    std::cout << "CONFIG,               MS/FRAME, SPEEDUP" << std::endl;
+
+    for (const std::string& name : configs)
+    {
+        _result.clear();
+        const float time = _testConfig(client, "./cpu/" + name);
+        if (reference.empty())
+        {
+            reference.swap(_result);
+            referenceTime = time;
+            TEST(!reference.empty());
+        }
+        else
+        {
+            const float difference = _compare(reference, _result);
+            TESTINFO(difference < .01f, name << ": " << difference * 100.f
+                                             << "% of the pixels differ");
+            TESTINFO(time < referenceTime * .75f,
+                     name << " does not scale: " << time << " ms/frame, "
+                          << referenceTime << " ms/frame using one channel");
+        }
+
+        std::cout << std::setw(20) << name << ", " << std::setw(9) << time
+                  << ", " << std::setw(7) << referenceTime / time << std::endl;
+    }
+
+    client->exitLocal();
+    TESTINFO(client->getRefCount() == 1, client->getRefCount());
+    eq::exit();
+    return EXIT_SUCCESS;
+}
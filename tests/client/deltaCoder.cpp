@@ -0,0 +1,194 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+// Tests the round trip, the keyframes and the resync of the temporal delta
+// coding of image buffers
+
+#include <lunchbox/test.h>
+
+#include <eq/detail/deltaCoder.h>
+#include <eq/image.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+#include <lunchbox/rng.h>
+#include <pression/plugins/compressor.h>
+
+#include <cstring>
+
+using eq::detail::DeltaCoder;
+
+namespace
+{
+const eq::Frame::Buffer buffer = eq::Frame::Buffer::color;
+const int32_t tileSize = DeltaCoder::TILE_SIZE;
+
+void _setBuffer(eq::Image& image, const eq::PixelViewport& pvp)
+{
+    eq::PixelData pixels;
+    pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+    pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+    pixels.pixelSize = 4;
+    pixels.pvp = pvp;
+    image.setPixelViewport(pvp);
+    image.setPixelData(buffer, pixels); // allocates and clears
+
+    lunchbox::RNG rng;
+    uint32_t* data = reinterpret_cast<uint32_t*>(image.getPixelPointer(buffer));
+    for (uint32_t i = 0; i < pvp.getArea(); ++i)
+        data[i] = rng.get<uint32_t>();
+}
+
+/** Change one pixel in the tile containing the given position. */
+void _change(eq::Image& image, const int32_t x, const int32_t y)
+{
+    uint32_t* data = reinterpret_cast<uint32_t*>(image.getPixelPointer(buffer));
+    data[y * image.getPixelViewport().w + x] ^= 0xffu;
+}
+
+size_t _countTiles(const DeltaCoder& coder)
+{
+    const std::vector<uint8_t>& mask = coder.getMask();
+    size_t count = 0;
+    for (const uint8_t byte : mask)
+        for (size_t i = 0; i < 8; ++i)
+            count += (byte >> i) & 1u;
+    return count;
+}
+
+bool _equals(const eq::PixelData& result, const eq::Image& image)
+{
+    const eq::PixelViewport& pvp = image.getPixelViewport();
+    return result.pvp == pvp && result.pixelSize == 4 &&
+           ::memcmp(result.pixels, image.getPixelPointer(buffer),
+                    pvp.getArea() * 4) == 0;
+}
+
+/** Send the last encoding of the encoder, @return true on success. */
+bool _transmit(DeltaCoder& encoder, DeltaCoder& decoder,
+               const eq::Image& image)
+{
+    const DeltaCoder::Header& header = encoder.getHeader();
+    if (header.mode == DeltaCoder::MODE_KEYFRAME)
+    {
+        decoder.setKeyframe(header, image, buffer);
+        return true;
+    }
+
+    TEST(header.mode == DeltaCoder::MODE_TILES);
+    TEST(header.maskSize == encoder.getMask().size());
+    eq::PixelData result;
+    const eq::PixelData& tiles = encoder.getTiles().getPixelData(buffer);
+    if (!decoder.decode(header, encoder.getMask().data(), tiles, buffer,
+                        result))
+    {
+        return false;
+    }
+    TEST(_equals(result, image));
+    return true;
+}
+}
+
+int main(int, char**)
+{
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(0, 0, &nodeFactory));
+    {
+        // not a multiple of the tile size, to have partial tiles
+        const eq::PixelViewport pvp(0, 0, 5 * tileSize + 17, 3 * tileSize + 9);
+        eq::Image image;
+        _setBuffer(image, pvp);
+
+        DeltaCoder encoder;
+        DeltaCoder decoder;
+
+        // initial keyframe
+        TEST(!encoder.encode(image, buffer));
+        TEST(encoder.getHeader().mode == DeltaCoder::MODE_KEYFRAME);
+        TEST(encoder.getHeader().maskSize == 0);
+        TEST(_transmit(encoder, decoder, image));
+
+        // round trip of changed tiles, including the partial corner tile
+        _change(image, 0, 0);
+        _change(image, pvp.w - 1, pvp.h - 1);
+        TEST(encoder.encode(image, buffer));
+        TEST(_countTiles(encoder) == 2);
+        TEST(encoder.getTiles().getPixelViewport().h == 2 * tileSize);
+        TEST(_transmit(encoder, decoder, image));
+
+        // unchanged image: one tile keeps the data path uniform
+        TEST(encoder.encode(image, buffer));
+        TEST(_countTiles(encoder) == 1);
+        TEST(_transmit(encoder, decoder, image));
+
+        // keyframe on request
+        encoder.requestKeyframe();
+        TEST(!encoder.encode(image, buffer));
+        TEST(_transmit(encoder, decoder, image));
+
+        // keyframe when most tiles changed
+        for (int32_t y = 0; y < pvp.h; y += tileSize)
+            for (int32_t x = 0; x < pvp.w; x += tileSize)
+                _change(image, x, y);
+        TEST(!encoder.encode(image, buffer));
+        TEST(_transmit(encoder, decoder, image));
+
+        // periodic keyframe
+        size_t nDeltas = 0;
+        for (;;)
+        {
+            _change(image, tileSize, tileSize);
+            if (!encoder.encode(image, buffer))
+                break;
+            TEST(_transmit(encoder, decoder, image));
+            ++nDeltas;
+            TESTINFO(nDeltas <= 1000, "no periodic keyframe");
+        }
+        TEST(nDeltas > 1);
+        TEST(_transmit(encoder, decoder, image));
+
+        // lost delta: the decoder detects the gap and resyncs on a keyframe
+        _change(image, 2 * tileSize, 0);
+        TEST(encoder.encode(image, buffer)); // not transmitted
+        _change(image, 2 * tileSize, 0);
+        TEST(encoder.encode(image, buffer));
+        TEST(!_transmit(encoder, decoder, image));
+
+        encoder.requestKeyframe();
+        TEST(!encoder.encode(image, buffer));
+        TEST(_transmit(encoder, decoder, image));
+        _change(image, 3 * tileSize, tileSize);
+        TEST(encoder.encode(image, buffer));
+        TEST(_transmit(encoder, decoder, image));
+
+        // keyframe on a size change; stale deltas are rejected
+        const DeltaCoder::Header stale = encoder.getHeader();
+        const std::vector<uint8_t> staleMask = encoder.getMask();
+        const eq::PixelViewport smaller(0, 0, pvp.w / 2, pvp.h / 2);
+        _setBuffer(image, smaller);
+        TEST(!encoder.encode(image, buffer));
+        TEST(_transmit(encoder, decoder, image));
+
+        eq::PixelData result;
+        TEST(!decoder.decode(stale, staleMask.data(),
+                             encoder.getTiles().getPixelData(buffer), buffer,
+                             result));
+    }
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
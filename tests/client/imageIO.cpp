@@ -21,11 +21,23 @@
 
 #include <boost/filesystem.hpp>
 #include <eq/image.h>
+#include <eq/imageWriter.h>
 #include <eq/init.h>
 #include <eq/nodeFactory.h>
+#include <lunchbox/buffer.h>
 #include <lunchbox/file.h>
 #include <lunchbox/memoryMap.h>
 
+namespace
+{
+std::string _getAsyncFilename(const std::string& filename)
+{
+    const boost::filesystem::path path(filename);
+    return path.parent_path().string() + "/out_async_" +
+           path.filename().string();
+}
+}
+
 int main(int argc, char** argv)
 {
     // setup
@@ -79,6 +91,45 @@ int main(int argc, char** argv)
         TESTINFO(memcmp(origPtr + 512, copyPtr + 512, orig.getSize() - 512) ==
                      0,
                  inFilename);
+
+        // fast path formats
+        const eq::PixelViewport& pvp = image.getPixelViewport();
+        const size_t nPixels = pvp.getArea();
+        lunchbox::Bufferb raw;
+        TEST(image.encodeImage(raw, "out.raw", eq::Frame::Buffer::color));
+        TEST(raw.getSize() == image.getPixelDataSize(eq::Frame::Buffer::color));
+
+        lunchbox::Bufferb ppm;
+        TEST(image.encodeImage(ppm, "out.ppm", eq::Frame::Buffer::color));
+        TESTINFO(ppm.getSize() > nPixels * 3, inFilename);
+        TEST(memcmp(ppm.getData(), "P6\n", 3) == 0);
+    }
+
+    // asynchronous writes produce the same files
+    {
+        eq::ImageWriter writer;
+        for (const std::string& inFilename : images)
+        {
+            TEST(image.readImage(inFilename, eq::Frame::Buffer::color));
+            writer.write(image, eq::Frame::Buffer::color,
+                         _getAsyncFilename(inFilename));
+        }
+        writer.finish();
+    }
+    for (const std::string& inFilename : images)
+    {
+        lunchbox::MemoryMap orig;
+        lunchbox::MemoryMap copy;
+        const uint8_t* origPtr =
+            reinterpret_cast<const uint8_t*>(orig.map(inFilename));
+        const std::string copyFilename = _getAsyncFilename(inFilename);
+        const uint8_t* copyPtr =
+            reinterpret_cast<const uint8_t*>(copy.map(copyFilename));
+        TESTINFO(copyPtr, inFilename);
+        TESTINFO(orig.getSize() == copy.getSize(), inFilename);
+        TESTINFO(memcmp(origPtr + 512, copyPtr + 512, orig.getSize() - 512) ==
+                     0,
+                 inFilename);
     }
 
     eq::exit();
@@ -0,0 +1,267 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+// Tests the assembly of full-view screenshots from overlapping destination
+// channels, the bounded recording queue and popRecordedImage.
+
+#include <eq/cpu/window.h>
+#include <eq/eq.h>
+#include <lunchbox/test.h>
+#include <pression/plugins/compressor.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+namespace
+{
+const int32_t width = 100;
+const int32_t height = 50;
+const size_t nFrames = 5;
+
+/** Overlapping segments, the first two cover more than the view together. */
+struct Segment
+{
+    const char* name;
+    float x, w;
+    uint32_t color;
+};
+
+const Segment _segments[] = {{"left", 0.f, .7f, 0xff0000ffu},
+                             {"center", .3f, .4f, 0xff00ff00u},
+                             {"right", .7f, .3f, 0xffff0000u}};
+const size_t _nSegments = sizeof(_segments) / sizeof(Segment);
+
+class Pipe : public eq::Pipe
+{
+public:
+    explicit Pipe(eq::Node* parent)
+        : eq::Pipe(parent)
+    {
+    }
+
+protected:
+    eq::WindowSystem selectWindowSystem() const final
+    {
+        return eq::WindowSystem("CPU");
+    }
+};
+
+/** Fills its segment and sends it as the screenshot tile. */
+class Channel : public eq::Channel
+{
+public:
+    explicit Channel(eq::Window* parent)
+        : eq::Channel(parent)
+    {
+    }
+
+protected:
+    void frameClear(const eq::uint128_t&) final {}
+
+    void frameDraw(const eq::uint128_t&) final
+    {
+        for (const Segment& segment : _segments)
+            if (getName() == segment.name)
+                _getCPUWindow()->clear(getPixelViewport(), segment.color);
+    }
+
+    void frameViewFinish(const eq::uint128_t&) final
+    {
+        eq::View* view = getView();
+        if (view->getScreenshotBuffers() == eq::Frame::Buffer::none)
+            return;
+
+        // the last tile arrives after the overlapping ones cover the view area
+        if (getName() == "right")
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        eq::cpu::Window* window = _getCPUWindow();
+        const eq::PixelViewport& pvp = getPixelViewport();
+        eq::PixelData pixels;
+        pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+        pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+        pixels.pixelSize = 4;
+        pixels.pvp = pvp;
+
+        eq::Image image;
+        image.setPixelViewport(pvp);
+        image.setPixelData(eq::Frame::Buffer::color, pixels);
+        uint32_t* data = reinterpret_cast<uint32_t*>(
+            image.getPixelPointer(eq::Frame::Buffer::color));
+        for (int32_t y = 0; y < pvp.h; ++y)
+        {
+            const uint32_t* row = window->getColorBuffer() +
+                                  (pvp.y + y) * window->getWidth() + pvp.x;
+            std::copy(row, row + pvp.w, data + y * pvp.w);
+        }
+
+        view->sendScreenshotEvent(getViewport(), getPipe()->getCurrentFrame(),
+                                  image);
+    }
+
+private:
+    eq::cpu::Window* _getCPUWindow()
+    {
+        return static_cast<eq::cpu::Window*>(getWindow()->getSystemWindow());
+    }
+};
+
+class NodeFactory : public eq::NodeFactory
+{
+public:
+    eq::Pipe* createPipe(eq::Node* parent) final { return new Pipe(parent); }
+    eq::Channel* createChannel(eq::Window* parent) final
+    {
+        return new Channel(parent);
+    }
+};
+
+/** Writes a config with one view on a canvas of overlapping segments. */
+std::string _writeConfig()
+{
+    const std::string name = "screenshot.eqc";
+    std::ofstream file(name.c_str());
+
+    file << "#Equalizer 1.2 ascii" << std::endl
+         << "server" << std::endl
+         << "{" << std::endl
+         << "    connection { hostname \"127.0.0.1\" }" << std::endl
+         << "    config" << std::endl
+         << "    {" << std::endl
+         << "        latency 1" << std::endl
+         << "        appNode" << std::endl
+         << "        {" << std::endl;
+    for (const Segment& segment : _segments)
+        file << "            pipe { window { viewport [ 0 0 "
+             << int32_t(segment.w * width) << " " << height
+             << " ] channel { name \"" << segment.name << "\" }}}"
+             << std::endl;
+    file << "        }" << std::endl
+         << "        observer {}" << std::endl
+         << "        layout { view { observer 0 }}" << std::endl
+         << "        canvas" << std::endl
+         << "        {" << std::endl
+         << "            layout 0" << std::endl
+         << "            wall {}" << std::endl;
+    for (const Segment& segment : _segments)
+        file << "            segment { channel \"" << segment.name
+             << "\" viewport [ " << segment.x << " 0 " << segment.w
+             << " 1 ] }" << std::endl;
+    file << "        }" << std::endl;
+    for (size_t i = 0; i < _nSegments; ++i)
+        file << "        compound { channel ( segment " << i
+             << " view 0 ) }" << std::endl;
+    file << "    }" << std::endl << "}" << std::endl;
+    return name;
+}
+
+/** Checks the size and the non-overlapping areas of a screenshot. */
+void _testImage(const eq::Image& image)
+{
+    const eq::PixelViewport& pvp = image.getPixelViewport();
+    TESTINFO(pvp == eq::PixelViewport(0, 0, width, height), pvp);
+
+    const uint32_t* data = reinterpret_cast<const uint32_t*>(
+        image.getPixelPointer(eq::Frame::Buffer::color));
+    for (int32_t y = 0; y < height; ++y)
+        for (int32_t x = 0; x < width; ++x)
+        {
+            const uint32_t pixel = data[y * width + x];
+            if (x < 30)
+                TESTINFO(pixel == _segments[0].color, x << ", " << y);
+            else if (x < 70)
+                TESTINFO(pixel == _segments[0].color ||
+                             pixel == _segments[1].color,
+                         x << ", " << y);
+            else
+                TESTINFO(pixel == _segments[2].color, x << ", " << y);
+        }
+}
+}
+
+int main(int argc, char** argv)
+{
+    NodeFactory nodeFactory;
+    TEST(eq::init(argc, argv, &nodeFactory));
+
+    eq::ClientPtr client = new eq::Client;
+    TEST(client->initLocal(argc, argv));
+
+    eq::ServerPtr server = new eq::Server;
+    eq::Global::setConfig(_writeConfig());
+    TEST(client->connectServer(server));
+
+    eq::fabric::ConfigParams configParams;
+    eq::Config* config = server->chooseConfig(configParams);
+    TEST(config);
+    TEST(config->init(eq::uint128_t()));
+
+    eq::View* view = config->getLayouts().front()->getViews().front();
+    uint32_t frameNumber = 0;
+    TEST(!view->popRecordedImage(frameNumber)); // not recording
+
+    view->setRecording(eq::Frame::Buffer::color);
+
+    // non-blocking and timed pop without frames in flight
+    lunchbox::Clock clock;
+    TEST(!view->popRecordedImage(frameNumber, 0));
+    TESTINFO(clock.getTimef() < 50.f, clock.getTimef());
+
+    clock.reset();
+    TEST(!view->popRecordedImage(frameNumber, 100));
+    TESTINFO(clock.getTimef() >= 90.f, clock.getTimef());
+
+    // blocking pop assembles the frame from all tiles, overlaps count once
+    config->startFrame(eq::uint128_t());
+    const eq::Image* image = view->popRecordedImage(frameNumber);
+    TEST(image);
+    TESTINFO(frameNumber == config->getCurrentFrame(), frameNumber);
+    _testImage(*image);
+    config->finishAllFrames();
+
+    // at most latency+1 screenshots are queued, the oldest ones are dropped
+    for (size_t i = 0; i < nFrames; ++i)
+    {
+        config->startFrame(eq::uint128_t());
+        config->finishFrame();
+    }
+    config->finishAllFrames();
+    config->handleEvents();
+
+    const uint32_t maxRecorded = config->getLatency() + 1;
+    const uint32_t lastFrame = config->getCurrentFrame();
+    for (uint32_t i = 0; i < maxRecorded; ++i)
+    {
+        image = view->popRecordedImage(frameNumber, 0);
+        TEST(image);
+        TESTINFO(frameNumber == lastFrame - maxRecorded + 1 + i,
+                 frameNumber << " of " << lastFrame);
+        _testImage(*image);
+    }
+    TEST(!view->popRecordedImage(frameNumber, 0));
+
+    view->setRecording(eq::Frame::Buffer::none);
+    TEST(config->exit());
+    server->releaseConfig(config);
+    TEST(client->disconnectServer(server));
+    TEST(client->exitLocal());
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,209 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include <lunchbox/test.h>
+
+#include <eq/compositor.h>
+#include <eq/image.h>
+#include <eq/imageOp.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+#include <lunchbox/rng.h>
+#include <pression/plugins/compressor.h>
+
+#include <cstring>
+#include <memory>
+
+namespace
+{
+// small, tile-sharing and tile-crossing regions of one output frame
+const eq::PixelViewport regions[] = {eq::PixelViewport(10, 5, 40, 30),
+                                     eq::PixelViewport(100, 70, 130, 90),
+                                     eq::PixelViewport(240, 100, 20, 20),
+                                     eq::PixelViewport(300, 200, 150, 90)};
+const size_t nRegions = sizeof(regions) / sizeof(eq::PixelViewport);
+
+typedef std::vector<std::unique_ptr<eq::Image>> Storage;
+
+void _setBuffer(eq::Image& image, const eq::Frame::Buffer buffer,
+                const uint32_t format)
+{
+    eq::PixelData pixels;
+    pixels.internalFormat = buffer == eq::Frame::Buffer::color
+                                ? EQ_COMPRESSOR_DATATYPE_RGBA
+                                : EQ_COMPRESSOR_DATATYPE_DEPTH;
+    pixels.externalFormat = format;
+    pixels.pixelSize = 4;
+    pixels.pvp = image.getPixelViewport();
+    image.setPixelData(buffer, pixels); // allocates and clears
+
+    lunchbox::RNG rng;
+    uint32_t* data =
+        reinterpret_cast<uint32_t*>(image.getPixelPointer(buffer));
+    for (uint32_t i = 0; i < image.getPixelViewport().getArea(); ++i)
+        data[i] = rng.get<uint32_t>() >> 1; // never at the far plane
+}
+
+eq::Image* _newImage(Storage& storage, const eq::PixelViewport& pvp,
+                     const bool depth)
+{
+    storage.emplace_back(new eq::Image);
+    eq::Image* image = storage.back().get();
+    image->setPixelViewport(pvp);
+    image->setAlphaUsage(true);
+    _setBuffer(*image, eq::Frame::Buffer::color, EQ_COMPRESSOR_DATATYPE_RGBA);
+    if (depth)
+        _setBuffer(*image, eq::Frame::Buffer::depth,
+                   EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT);
+    return image;
+}
+
+eq::ImageOp _newOp(eq::Image* image)
+{
+    eq::ImageOp op;
+    op.image = image;
+    op.buffers = image->hasPixelData(eq::Frame::Buffer::depth)
+                     ? eq::Frame::Buffer::color | eq::Frame::Buffer::depth
+                     : eq::Frame::Buffer::color;
+    op.offset = eq::Vector2i(0, 0);
+    return op;
+}
+
+bool _equals(const eq::Image& lhs, const eq::Image& rhs,
+             const eq::Frame::Buffer buffer)
+{
+    return lhs.getPixelViewport() == rhs.getPixelViewport() &&
+           lhs.getPixelDataSize(buffer) == rhs.getPixelDataSize(buffer) &&
+           ::memcmp(lhs.getPixelPointer(buffer), rhs.getPixelPointer(buffer),
+                    lhs.getPixelDataSize(buffer)) == 0;
+}
+
+/**
+ * Composite the regions over a background, once directly and once packed.
+ * Pixels of the packed tiles which belong to no region must not change the
+ * background.
+ */
+void _testCompositing(const bool depth, const bool blend)
+{
+    eq::PixelViewport all;
+    for (const eq::PixelViewport& pvp : regions)
+        all.merge(pvp);
+
+    Storage storage;
+    eq::Images images;
+    eq::ImageOps ops(1, _newOp(_newImage(storage, all, depth)));
+    for (const eq::PixelViewport& pvp : regions)
+    {
+        images.push_back(_newImage(storage, pvp, depth));
+        ops.push_back(_newOp(images.back()));
+    }
+
+    const eq::Image* result = eq::Compositor::mergeImagesCPU(ops, blend);
+    TEST(result);
+    const eq::Image expected(*result);
+
+    eq::Image sparse;
+    TEST(sparse.packTiles(images));
+    eq::ImageOps sparseOps(1, ops.front());
+    sparseOps.push_back(_newOp(&sparse));
+
+    result = eq::Compositor::mergeImagesCPU(sparseOps, blend);
+    TEST(result);
+    TESTINFO(_equals(*result, expected, eq::Frame::Buffer::color),
+             "depth " << depth << " blend " << blend);
+    if (depth)
+        TEST(_equals(*result, expected, eq::Frame::Buffer::depth));
+
+    sparse.flush();
+    for (auto& image : storage)
+        image->flush();
+}
+}
+
+int main(int, char**)
+{
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(0, 0, &nodeFactory));
+
+    Storage storage;
+    eq::Images images;
+    for (const eq::PixelViewport& pvp : regions)
+        images.push_back(_newImage(storage, pvp, true));
+
+    eq::Image sparse;
+    TEST(sparse.packTiles(images));
+    TEST(sparse.isSparse());
+    TEST(sparse.getPixelViewport() == eq::PixelViewport(10, 5, 440, 285));
+    TEST(sparse.getCoverage() ==
+         eq::PixelViewports(regions, regions + nRegions));
+
+    // 7x5 tiles of the union, of which 1 + 6 + 0 + 6 are touched
+    const eq::PixelData& tiles = sparse.getPixelData(eq::Frame::Buffer::color);
+    TESTINFO(tiles.pvp.h == 13 * eq::Image::TILE_SIZE, tiles.pvp);
+    TEST(tiles.pvp.w == eq::Image::TILE_SIZE);
+
+    // CPU compositing of the sparse image equals the regions
+    _testCompositing(true, false); // sort-last
+    _testCompositing(false, false);
+    _testCompositing(false, true); // sort-last with transparency
+
+    // unpacking restores the pixels of all regions
+    eq::Image dense;
+    sparse.unpackTiles(dense);
+    TEST(!dense.isSparse());
+    TEST(dense.getPixelViewport() == sparse.getPixelViewport());
+
+    const eq::PixelViewport& densePVP = dense.getPixelViewport();
+    const uint32_t* pixels = reinterpret_cast<const uint32_t*>(
+        dense.getPixelPointer(eq::Frame::Buffer::color));
+    for (size_t i = 0; i < images.size(); ++i)
+    {
+        const eq::PixelViewport& pvp = regions[i];
+        const uint32_t* in = reinterpret_cast<const uint32_t*>(
+            images[i]->getPixelPointer(eq::Frame::Buffer::color));
+        for (int32_t y = 0; y < pvp.h; ++y)
+            TEST(::memcmp(pixels + (pvp.y - densePVP.y + y) * densePVP.w +
+                              pvp.x - densePVP.x,
+                          in + y * pvp.w, pvp.w * 4) == 0);
+    }
+
+    // unpacking a covered area restores its image, as drawn on the GPU
+    for (size_t i = 0; i < images.size(); ++i)
+    {
+        sparse.unpackTiles(dense, regions[i]);
+        TEST(_equals(dense, *images[i], eq::Frame::Buffer::color));
+        TEST(_equals(dense, *images[i], eq::Frame::Buffer::depth));
+    }
+
+    // images with different buffers can't be packed
+    eq::Image colorOnly;
+    colorOnly.setPixelViewport(eq::PixelViewport(0, 0, 10, 10));
+    _setBuffer(colorOnly, eq::Frame::Buffer::color,
+               EQ_COMPRESSOR_DATATYPE_RGBA);
+    images.push_back(&colorOnly);
+    TEST(!sparse.packTiles(images));
+
+    sparse.flush();
+    dense.flush();
+    colorOnly.flush();
+    for (auto& image : storage)
+        image->flush();
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the layout of tree swap barriers
+
+#include <eq/fabric/swapBarrier.h>
+#include <lunchbox/test.h>
+
+using eq::fabric::SwapBarrier;
+
+namespace
+{
+typedef std::vector<size_t> Indices;
+
+Indices _indices(const size_t a)
+{
+    return Indices(1, a);
+}
+
+Indices _indices(const size_t a, const size_t b)
+{
+    Indices indices(1, a);
+    indices.push_back(b);
+    return indices;
+}
+
+Indices _indices(const size_t a, const size_t b, const size_t c)
+{
+    Indices indices = _indices(a, b);
+    indices.push_back(c);
+    return indices;
+}
+}
+
+int main(int, char**)
+{
+    { // one participant needs no barrier
+        const SwapBarrier::Tree& tree =
+            SwapBarrier::buildTree(std::vector<uint32_t>(1, 0), 2);
+        TEST(tree.members.empty());
+        TEST(tree.paths.size() == 1);
+        TEST(tree.paths[0].empty());
+    }
+    { // one node: the node barrier is the root
+        const SwapBarrier::Tree& tree =
+            SwapBarrier::buildTree(std::vector<uint32_t>(2, 7), 2);
+        TEST(tree.members.size() == 1);
+        TEST(tree.isRoot(0));
+        TEST(tree.members[0] == _indices(0, 1));
+        TEST(tree.paths[0] == _indices(0));
+        TEST(tree.paths[1] == _indices(0));
+    }
+    { // three nodes with two, one and three pipes, binary tree
+        std::vector<uint32_t> groups;
+        groups.push_back(0);
+        groups.push_back(0);
+        groups.push_back(1);
+        groups.push_back(2);
+        groups.push_back(2);
+        groups.push_back(2);
+        const SwapBarrier::Tree& tree = SwapBarrier::buildTree(groups, 2);
+
+        TESTINFO(tree.members.size() == 4, tree.members.size());
+        TEST(tree.masters[0] == 0 && tree.masters[1] == 3);
+        TEST(tree.masters[2] == 0 && tree.masters[3] == 0);
+        TEST(tree.members[0] == _indices(0, 1));
+        TEST(tree.members[1] == _indices(3, 4, 5));
+        TEST(tree.members[2] == _indices(0, 2));
+        TEST(tree.members[3] == _indices(0, 3));
+        TEST(tree.isRoot(3));
+        TEST(!tree.isRoot(2));
+
+        TEST(tree.paths[0] == _indices(0, 2, 3));
+        TEST(tree.paths[1] == _indices(0));
+        TEST(tree.paths[2] == _indices(2));
+        TEST(tree.paths[3] == _indices(1, 3));
+        TEST(tree.paths[4] == _indices(1));
+        TEST(tree.paths[5] == _indices(1));
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,136 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+// Compares the batched triply::BoxCuller with per-box frustum culling
+
+#include <triply/boxCuller.h>
+#include <lunchbox/clock.h>
+#include <lunchbox/test.h>
+#include <vmmlib/frustum.hpp>
+#include <vmmlib/frustumCuller.hpp>
+
+#include <cmath>
+#include <iomanip>
+
+namespace
+{
+const size_t nFrusta = 64;
+
+/** Deterministic noise in [0, 1]. */
+float _random(uint32_t& seed)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return float(seed >> 8) / float(1u << 24);
+}
+
+/** Small boxes in [-1, 1]^3, like the deep levels of a kd-tree. */
+std::vector<triply::BoundingBox> _createBoxes(const size_t nBoxes)
+{
+    uint32_t seed = 17;
+    std::vector<triply::BoundingBox> boxes;
+    boxes.reserve(nBoxes);
+    for (size_t i = 0; i < nBoxes; ++i)
+    {
+        const triply::Vertex center(_random(seed) * 2.f - 1.f,
+                                    _random(seed) * 2.f - 1.f,
+                                    _random(seed) * 2.f - 1.f);
+        const triply::Vertex size(_random(seed) * .1f, _random(seed) * .1f,
+                                  _random(seed) * .1f);
+        boxes.push_back(triply::BoundingBox(center - size, center + size));
+    }
+    return boxes;
+}
+
+/** Cameras at distance 3 looking at the origin from random directions. */
+std::vector<triply::Matrix4f> _createFrusta()
+{
+    uint32_t seed = 42;
+    const vmml::Frustumf frustum(-.5f, .5f, -.5f, .5f, 1.f, 10.f);
+    const triply::Matrix4f projection = frustum.computePerspectiveMatrix();
+
+    std::vector<triply::Matrix4f> frusta;
+    for (size_t i = 0; i < nFrusta; ++i)
+    {
+        const float phi = _random(seed) * 2.f * float(M_PI);
+        const float z = _random(seed) * 2.f - 1.f;
+        const float r = std::sqrt(1.f - z * z);
+        const triply::Vertex eye(r * std::cos(phi) * 3.f,
+                                 r * std::sin(phi) * 3.f, z * 3.f);
+        const triply::Vertex up = std::abs(z) > .9f
+                                      ? triply::Vertex(1.f, 0.f, 0.f)
+                                      : triply::Vertex(0.f, 0.f, 1.f);
+        const triply::Matrix4f view(eye, triply::Vertex(), up);
+        frusta.push_back(projection * view);
+    }
+    return frusta;
+}
+}
+
+int main(int, char**)
+{
+    std::cout << "   BOXES, PER BOX MS, BATCH MS, SPEEDUP, MISMATCHES"
+              << std::endl;
+    std::cout.setf(std::ios::right, std::ios::adjustfield);
+    std::cout.precision(4);
+
+    const std::vector<triply::Matrix4f> frusta = _createFrusta();
+    for (size_t nBoxes = 1024; nBoxes <= 1024 * 1024; nBoxes <<= 2)
+    {
+        const std::vector<triply::BoundingBox> boxes = _createBoxes(nBoxes);
+        triply::BoxCuller culler;
+        for (const triply::BoundingBox& box : boxes)
+            culler.add(box);
+
+        std::vector<uint8_t> expected(nBoxes * nFrusta);
+        lunchbox::Clock clock;
+        for (size_t i = 0; i < nFrusta; ++i)
+        {
+            const vmml::FrustumCullerf reference(frusta[i]);
+            for (size_t j = 0; j < nBoxes; ++j)
+                expected[i * nBoxes + j] = uint8_t(reference.test(boxes[j]));
+        }
+        const float perBoxTime = clock.getTimef() / float(nFrusta);
+
+        std::vector<std::vector<uint8_t>> results(nFrusta);
+        clock.reset();
+        for (size_t i = 0; i < nFrusta; ++i)
+            culler.test(frusta[i], results[i]);
+        const float batchTime = clock.getTimef() / float(nFrusta);
+
+        // corners exactly on a plane may differ due to rounding
+        size_t mismatches = 0;
+        size_t visible = 0;
+        for (size_t i = 0; i < nFrusta; ++i)
+        {
+            for (size_t j = 0; j < nBoxes; ++j)
+            {
+                if (results[i][j] != expected[i * nBoxes + j])
+                    ++mismatches;
+                if (results[i][j] != vmml::VISIBILITY_NONE)
+                    ++visible;
+            }
+        }
+
+        std::cout << std::setw(8) << nBoxes << ", " << std::setw(11)
+                  << perBoxTime << ", " << std::setw(8) << batchTime << ", "
+                  << std::setw(7) << perBoxTime / batchTime << ", "
+                  << std::setw(10) << mismatches << std::endl;
+
+        TEST(visible > 0 && visible < nBoxes * nFrusta);
+        TESTINFO(mismatches * 10000 <= nBoxes * nFrusta, mismatches);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,79 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+// Measures the size and the encode and decode speed of compact triply leaves
+
+#include "../triply/mesh.h"
+
+#include <triply/compactData.h>
+#include <lunchbox/clock.h>
+#include <lunchbox/test.h>
+
+#include <cmath>
+#include <iomanip>
+
+using triply::CompactData;
+
+namespace
+{
+const size_t nLoops = 20;
+}
+
+int main(int, char**)
+{
+    std::cout << "VERTICES,  RAW KB, COMPACT KB, RATIO, ENCODE MB/S, "
+              << "DECODE MB/S" << std::endl;
+    std::cout.setf(std::ios::right, std::ios::adjustfield);
+    std::cout.precision(5);
+
+    triply::VertexBufferData data;
+    for (size_t size = 32; size <= 256; size <<= 1)
+    {
+        test::createMesh(data, size - 1); // leaves hold at most 64k vertices
+        const size_t nVertices = data.vertices.size();
+        const size_t rawSize = test::getSize(data);
+
+        CompactData compact;
+        lunchbox::Clock clock;
+        for (size_t i = 0; i < nLoops; ++i)
+            compact.encode(data, 0, nVertices, 0, data.indices.size());
+        const float encodeTime = clock.getTimef();
+
+        // decode as done for rendering buffer objects
+        std::vector<triply::ShortIndex> indices;
+        std::vector<triply::ByteNormal> normals;
+        clock.reset();
+        for (size_t i = 0; i < nLoops; ++i)
+        {
+            compact.decodeIndices(indices);
+            compact.decodeNormals(normals);
+        }
+        const float decodeTime = clock.getTimef();
+
+        const float megaBytes = float(rawSize * nLoops) / 1024.f / 1024.f;
+        const float ratio = float(rawSize) / float(compact.getSize());
+        std::cout << std::setw(8) << nVertices << ", " << std::setw(7)
+                  << (rawSize >> 10) << ", " << std::setw(10)
+                  << (compact.getSize() >> 10) << ", " << std::setw(5)
+                  << ratio << ", " << std::setw(11)
+                  << megaBytes / encodeTime * 1000.f << ", " << std::setw(11)
+                  << megaBytes / decodeTime * 1000.f << std::endl;
+
+        TEST(indices == data.indices);
+        TESTINFO(ratio > 1.5f, ratio);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,434 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Benchmarks the CPU compositing paths and all image compressors on synthetic
+// images. Prints one CSV line per measurement:
+//   compositor [--resolution WxH] [--inputs N] [--sparsity S] [--overlap O]
+//              [--repeat N]
+// Without options, a default matrix of all parameters is run.
+
+#define TEST_RUNTIME 1200 // seconds
+#include <lunchbox/test.h>
+
+#include <eq/compositor.h>
+#include <eq/image.h>
+#include <eq/imageOp.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+#include <lunchbox/clock.h>
+#include <pression/plugins/compressor.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <tuple>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+struct Setup
+{
+    int32_t width;
+    int32_t height;
+    size_t inputs;
+    float sparsity; // fraction of background pixels in each input
+    float overlap;  // 0: inputs tile the destination, 1: all are full-size
+};
+
+struct Timing
+{
+    float min;
+    float mean;
+    float max;
+};
+
+typedef std::unique_ptr<eq::Image> ImagePtr;
+typedef std::vector<ImagePtr> ImagePtrs;
+
+const uint32_t BLOCK_SIZE = 16; // granularity of the background
+const uint32_t FAR_DEPTH = 0xffffffffu;
+
+uint32_t _hash(uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+bool _isBackground(const int32_t x, const int32_t y, const uint32_t seed,
+                   const float sparsity)
+{
+    const uint32_t block = uint32_t(y) / BLOCK_SIZE * 65536u +
+                           uint32_t(x) / BLOCK_SIZE + seed * 0x9e3779b9u;
+    return float(_hash(block) & 0xffffu) < sparsity * 65536.f;
+}
+
+/** @return the pixel viewport of the given input in the destination. */
+eq::PixelViewport _getPVP(const Setup& setup, const size_t input)
+{
+    const int32_t tile = setup.width / int32_t(setup.inputs);
+    const int32_t width =
+        tile + int32_t(setup.overlap * float(setup.width - tile));
+    const int32_t x = std::min(int32_t(input) * tile, setup.width - width);
+
+    // the last input also covers the remainder of the division
+    if (input + 1 == setup.inputs)
+        return eq::PixelViewport(x, 0, setup.width - x, setup.height);
+    return eq::PixelViewport(x, 0, width, setup.height);
+}
+
+void _setBuffer(eq::Image& image, const eq::Frame::Buffer buffer,
+                const uint32_t format)
+{
+    eq::PixelData pixels;
+    pixels.internalFormat = buffer == eq::Frame::Buffer::color
+                                ? EQ_COMPRESSOR_DATATYPE_RGBA
+                                : EQ_COMPRESSOR_DATATYPE_DEPTH;
+    pixels.externalFormat = format;
+    pixels.pixelSize = 4;
+    pixels.pvp = image.getPixelViewport();
+    image.setPixelData(buffer, pixels); // allocates and clears
+}
+
+/**
+ * Fill an image with synthetic pixels.
+ *
+ * Foreground pixels carry a noisy gradient, pre-multiplied by alpha when
+ * blending, and a depth slope unique to the input. Background pixels are
+ * transparent black at the far plane and cover the sparsity fraction in
+ * blocks, which gives the run lengths of rendered images.
+ */
+void _generate(eq::Image& image, const eq::PixelViewport& pvp,
+               const uint32_t seed, const float sparsity, const bool depth,
+               const bool blend)
+{
+    image.setPixelViewport(pvp);
+    image.setAlphaUsage(true);
+    _setBuffer(image, eq::Frame::Buffer::color, EQ_COMPRESSOR_DATATYPE_RGBA);
+    if (depth)
+        _setBuffer(image, eq::Frame::Buffer::depth,
+                   EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT);
+
+    uint32_t* color = reinterpret_cast<uint32_t*>(
+        image.getPixelPointer(eq::Frame::Buffer::color));
+    uint32_t* depths =
+        depth ? reinterpret_cast<uint32_t*>(
+                    image.getPixelPointer(eq::Frame::Buffer::depth))
+              : nullptr;
+    const uint32_t alpha = blend ? 128 : 255;
+
+#pragma omp parallel for
+    for (int32_t y = 0; y < pvp.h; ++y)
+    {
+        for (int32_t x = 0; x < pvp.w; ++x)
+        {
+            const size_t i = size_t(y) * pvp.w + x;
+            const int32_t gx = pvp.x + x;
+            const int32_t gy = pvp.y + y;
+            if (_isBackground(gx, gy, seed, sparsity))
+            {
+                color[i] = 0;
+                if (depths)
+                    depths[i] = FAR_DEPTH;
+                continue;
+            }
+
+            const uint32_t noise = _hash(uint32_t(i) ^ seed) & 0x3u;
+            const uint32_t r = (uint32_t(gx) & 0xffu) ^ noise;
+            const uint32_t g = (uint32_t(gy) & 0xffu) ^ noise;
+            const uint32_t b = (seed * 37u) & 0xffu;
+            color[i] = (r * alpha >> 8) | (g * alpha >> 8) << 8 |
+                       (b * alpha >> 8) << 16 | alpha << 24;
+            if (depths)
+                depths[i] = 0x10000000u + (seed << 24) +
+                            (uint32_t(gx + gy) << 8);
+        }
+    }
+}
+
+size_t _getPeakMemory() // KB
+{
+#ifdef _WIN32
+    return 0;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    return size_t(usage.ru_maxrss) / 1024;
+#else
+    return size_t(usage.ru_maxrss);
+#endif
+#endif
+}
+
+template <class F>
+Timing _time(const size_t repeat, const F& func)
+{
+    func(); // warm up, allocates output buffers
+
+    Timing timing = {std::numeric_limits<float>::max(), 0.f, 0.f};
+    lunchbox::Clock clock;
+    for (size_t i = 0; i < repeat; ++i)
+    {
+        clock.reset();
+        func();
+        const float time = clock.getTimef();
+        timing.min = std::min(timing.min, time);
+        timing.max = std::max(timing.max, time);
+        timing.mean += time;
+    }
+    timing.mean /= float(repeat);
+    return timing;
+}
+
+void _printHeader()
+{
+    std::cout << std::setw(10) << "KIND" << ", " << std::setw(16) << "NAME"
+              << ", " << std::setw(5) << "WIDTH" << ", " << std::setw(6)
+              << "HEIGHT" << ", " << std::setw(6) << "INPUTS" << ", "
+              << std::setw(8) << "SPARSITY" << ", " << std::setw(7)
+              << "OVERLAP" << ", " << std::setw(10) << "BYTES" << ", "
+              << std::setw(9) << "MS_MIN" << ", " << std::setw(9) << "MS_MEAN"
+              << ", " << std::setw(9) << "MS_MAX" << ", " << std::setw(9)
+              << "MB/S" << ", " << std::setw(8) << "PEAK_KB" << std::endl;
+}
+
+void _print(const std::string& kind, const std::string& name,
+            const Setup& setup, const uint64_t bytes, const Timing& timing)
+{
+    const float mbps = timing.mean > 0.f ? float(bytes) / 1024.f / 1024.f /
+                                               timing.mean * 1000.f
+                                         : 0.f;
+    std::cout << std::setw(10) << kind << ", " << std::setw(16) << name << ", "
+              << std::setw(5) << setup.width << ", " << std::setw(6)
+              << setup.height << ", " << std::setw(6) << setup.inputs << ", "
+              << std::setw(8) << setup.sparsity << ", " << std::setw(7)
+              << setup.overlap << ", " << std::setw(10) << bytes << ", "
+              << std::setw(9) << timing.min << ", " << std::setw(9)
+              << timing.mean << ", " << std::setw(9) << timing.max << ", "
+              << std::setw(9) << mbps << ", " << std::setw(8)
+              << _getPeakMemory() << std::endl;
+}
+
+/** Run the three CPU merge paths: 2D tiles, depth-sorted and blended. */
+void _testMerge(const Setup& setup, const size_t repeat)
+{
+    static const char* names[] = {"2D", "DB", "blend"};
+    for (size_t path = 0; path < 3; ++path)
+    {
+        const bool depth = path == 1;
+        const bool blend = path == 2;
+
+        ImagePtrs images;
+        eq::ImageOps ops;
+        uint64_t bytes = 0;
+        for (size_t i = 0; i < setup.inputs; ++i)
+        {
+            images.emplace_back(new eq::Image);
+            eq::Image& image = *images.back();
+            _generate(image, _getPVP(setup, i), uint32_t(i), setup.sparsity,
+                      depth, blend);
+
+            eq::ImageOp op;
+            op.image = &image;
+            op.buffers = eq::Frame::Buffer::color;
+            if (depth)
+                op.buffers |= eq::Frame::Buffer::depth;
+            ops.push_back(op);
+
+            bytes += image.getPixelDataSize(eq::Frame::Buffer::color);
+            if (depth)
+                bytes += image.getPixelDataSize(eq::Frame::Buffer::depth);
+        }
+
+        const eq::Image* result = nullptr;
+        const Timing timing = _time(repeat, [&] {
+            result = eq::Compositor::mergeImagesCPU(ops, blend);
+        });
+        TEST(result);
+        TESTINFO(result->getPixelViewport() ==
+                     eq::PixelViewport(0, 0, setup.width, setup.height),
+                 result->getPixelViewport());
+        _print("merge", names[path], setup, bytes, timing);
+    }
+}
+
+/** Run all compressors on a full-size opaque and a blended input. */
+void _testCompressors(const Setup& setup, const size_t repeat)
+{
+    const eq::PixelViewport pvp(0, 0, setup.width, setup.height);
+    for (size_t pass = 0; pass < 2; ++pass)
+    {
+        const bool blend = pass == 1;
+        eq::Image image;
+        eq::Image destImage;
+        _generate(image, pvp, 0, setup.sparsity, !blend, blend);
+
+        for (const eq::Frame::Buffer buffer :
+             {eq::Frame::Buffer::color, eq::Frame::Buffer::depth})
+        {
+            if (!image.hasPixelData(buffer))
+                continue;
+
+            const uint64_t bytes = image.getPixelDataSize(buffer);
+            for (const uint32_t name : image.findCompressors(buffer))
+            {
+                if (!image.allocCompressor(buffer, name))
+                    continue;
+
+                std::ostringstream os;
+                os << (buffer == eq::Frame::Buffer::color
+                           ? (blend ? "alpha" : "color")
+                           : "depth")
+                   << " 0x" << std::hex << name;
+
+                // Image caches the compressed data, toggle alpha to redo it
+                const eq::PixelData* pixels = nullptr;
+                const Timing compress = _time(repeat, [&] {
+                    image.setAlphaUsage(false);
+                    image.setAlphaUsage(true);
+                    pixels = &image.compressPixelData(buffer);
+                });
+                TEST(pixels);
+
+                const uint64_t compressed =
+                    pixels->compressedData.compressor == EQ_COMPRESSOR_NONE
+                        ? bytes
+                        : pixels->compressedData.getSize();
+                destImage.setPixelViewport(pvp);
+                const Timing decompress = _time(repeat, [&] {
+                    destImage.setPixelData(buffer, *pixels);
+                });
+
+                _print("compress", os.str(), setup, bytes, compress);
+                _print("decompress", os.str(), setup, compressed, decompress);
+            }
+        }
+    }
+}
+
+bool _parse(const int argc, char** argv, std::vector<Setup>& setups,
+            size_t& repeat)
+{
+    std::vector<std::pair<int32_t, int32_t>> resolutions = {{640, 480},
+                                                            {1920, 1080}};
+    std::vector<size_t> inputs = {2, 8};
+    std::vector<float> sparsities = {0.f, .8f};
+    std::vector<float> overlaps = {0.f, 1.f};
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string option = argv[i];
+        if (i + 1 >= argc)
+            return false;
+        std::istringstream value(argv[++i]);
+
+        if (option == "--resolution")
+        {
+            int32_t width = 0, height = 0;
+            char x = 0;
+            value >> width >> x >> height;
+            if (width <= 0 || height <= 0 || x != 'x')
+                return false;
+            resolutions = {{width, height}};
+        }
+        else if (option == "--inputs")
+        {
+            inputs.resize(1);
+            value >> inputs[0];
+        }
+        else if (option == "--sparsity")
+        {
+            sparsities.resize(1);
+            value >> sparsities[0];
+        }
+        else if (option == "--overlap")
+        {
+            overlaps.resize(1);
+            value >> overlaps[0];
+        }
+        else if (option == "--repeat")
+            value >> repeat;
+        else
+            return false;
+        if (value.fail())
+            return false;
+    }
+
+    for (const auto& resolution : resolutions)
+        for (const size_t nInputs : inputs)
+            for (const float sparsity : sparsities)
+                for (const float overlap : overlaps)
+                {
+                    if (nInputs == 0 || repeat == 0)
+                        return false;
+                    const Setup setup = {resolution.first, resolution.second,
+                                         nInputs, std::min(sparsity, 1.f),
+                                         std::min(std::max(overlap, 0.f), 1.f)};
+                    setups.push_back(setup);
+                }
+    return true;
+}
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<Setup> setups;
+    size_t repeat = 5;
+    if (!_parse(argc, argv, setups, repeat))
+    {
+        std::cerr << "Usage: " << argv[0] << " [--resolution WxH] [--inputs N]"
+                  << " [--sparsity 0..1] [--overlap 0..1] [--repeat N]"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(0, 0, &nodeFactory));
+
+    std::cout.setf(std::ios::right, std::ios::adjustfield);
+    std::cout.precision(5);
+    _printHeader();
+
+    // compressors don't depend on the composition parameters
+    std::set<std::tuple<int32_t, int32_t, float>> compressed;
+    for (const Setup& setup : setups)
+    {
+        _testMerge(setup, repeat);
+        if (compressed
+                .insert(std::make_tuple(setup.width, setup.height,
+                                        setup.sparsity))
+                .second)
+        {
+            _testCompressors(setup, repeat);
+        }
+    }
+
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
@@ -24,6 +24,8 @@
 #include <eq/nodeFactory.h>
 #include <eq/pixelData.h>
 
+#include <eq/compressor/compressorTypes.h>
+
 #include <co/global.h>
 
 #include <lunchbox/algorithm.h>
@@ -107,6 +109,11 @@ int main(int argc, char** argv)
             images.push_back("images/" + filename);
     }
 
+    // depth input images of the compositor test
+    candidates = lunchbox::searchDirectory(".", "Image_.*_depth\\.rgb");
+    lunchbox::usort(candidates);
+    images.insert(images.end(), candidates.begin(), candidates.end());
+
     candidates = lunchbox::searchDirectory(".", "Result.*\\.rgb");
     lunchbox::usort(candidates); // have a predictable order
     for (eq::Strings::const_iterator i = candidates.begin();
@@ -131,6 +138,8 @@ int main(int argc, char** argv)
     std::cout << images.size() << " test images X " << names.size()
               << " plugins" << std::endl;
     TESTINFO(names.size() > 23, names.size());
+    TEST(std::find(names.begin(), names.end(),
+                   EQ_COMPRESSOR_PREDICT_DEPTH_UNSIGNED_INT) != names.end());
 
     std::cout.setf(std::ios::right, std::ios::adjustfield);
     std::cout.precision(5);
@@ -298,8 +307,13 @@ int main(int argc, char** argv)
                                            quality);
                     break;
                 case 4:
-                    _compare<float>(data, destData, buffer,
-                                    image.getAlphaUsage(), nElem, quality);
+                    if (buffer == eq::Frame::Buffer::depth)
+                        _compare<uint32_t>(data, destData, buffer,
+                                           image.getAlphaUsage(), nElem,
+                                           quality);
+                    else
+                        _compare<float>(data, destData, buffer,
+                                        image.getAlphaUsage(), nElem, quality);
                     break;
                 default:
                     break;
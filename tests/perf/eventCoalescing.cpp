@@ -0,0 +1,424 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Injects synthetic X events of high-rate input devices, without a display, and
+// measures the glX event coalescing. Measures the delivery of batched events
+// to the application node.
+
+#include <eq/eq.h>
+#include <eq/fabric/commands.h>
+#include <lunchbox/clock.h>
+#include <lunchbox/test.h>
+
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+
+#ifdef GLX
+namespace
+{
+const size_t nFrames = 1000;
+const XID firstWindow = 42;
+
+/** Generates the events received by the pipe thread during one frame. */
+class Injector
+{
+public:
+    Injector(const size_t nWindows, const size_t motionRate)
+        : _nWindows(nWindows)
+        , _motionRate(motionRate)
+        , _frame(0)
+    {
+    }
+
+    /** Append the events of the next frame of a 60 Hz application. */
+    void inject(std::vector<XEvent>& events)
+    {
+        const size_t nMotions = _motionRate / 60;
+        for (size_t i = 0; i < nMotions; ++i)
+        {
+            for (size_t j = 0; j < _nWindows; ++j)
+                events.push_back(_motion(j, i));
+
+            if (_frame % 10 == 0 && i == nMotions / 2) // click in window 0
+            {
+                events.push_back(_button(0, ButtonPress));
+                events.push_back(_button(0, ButtonRelease));
+            }
+        }
+
+        if (_frame % 100 < 5) // interactive resize of the last window
+        {
+            const XID window = firstWindow + _nWindows - 1;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                events.push_back(_event(window, ConfigureNotify));
+                for (int count = 2; count >= 0; --count)
+                {
+                    XEvent expose = _event(window, Expose);
+                    expose.xexpose.count = count;
+                    events.push_back(expose);
+                }
+            }
+        }
+        ++_frame;
+    }
+
+private:
+    const size_t _nWindows;
+    const size_t _motionRate;
+    size_t _frame;
+
+    XEvent _event(const XID window, const int type) const
+    {
+        XEvent event;
+        memset(&event, 0, sizeof(event));
+        event.type = type;
+        event.xany.window = window;
+        return event;
+    }
+
+    XEvent _motion(const size_t window, const size_t i) const
+    {
+        XEvent event = _event(firstWindow + window, MotionNotify);
+        event.xmotion.x = int(i);
+        event.xmotion.y = int(_frame);
+        event.xmotion.state = (_frame % 2) ? Button1Mask : 0;
+        return event;
+    }
+
+    XEvent _button(const size_t window, const int type) const
+    {
+        XEvent event = _event(firstWindow + window, type);
+        event.xbutton.button = Button1;
+        return event;
+    }
+};
+
+size_t _count(const std::vector<XEvent>& events, const int type)
+{
+    size_t count = 0;
+    for (const XEvent& event : events)
+        if (event.type == type)
+            ++count;
+    return count;
+}
+
+/** Check that only superseded events were removed. */
+void _check(const std::vector<XEvent>& injected,
+            const std::vector<XEvent>& coalesced, const size_t nMotions)
+{
+    TEST(_count(coalesced, ButtonPress) == _count(injected, ButtonPress));
+    TEST(_count(coalesced, ButtonRelease) == _count(injected, ButtonRelease));
+    TEST(_count(coalesced, MotionNotify) <= _count(injected, MotionNotify));
+
+    // the last motion and expose event of each window survive
+    for (size_t i = 0; i < coalesced.size(); ++i)
+    {
+        const XEvent& event = coalesced[i];
+        if (event.type != MotionNotify)
+            continue;
+
+        bool last = true;
+        for (size_t j = i + 1; j < coalesced.size() && last; ++j)
+            if (coalesced[j].xany.window == event.xany.window)
+                last = false;
+        if (last)
+            TESTINFO(event.xmotion.x == int(nMotions - 1), event.xmotion.x);
+    }
+
+    // no two consecutive resize or expose events of a window remain
+    for (size_t i = 1; i < coalesced.size(); ++i)
+    {
+        const XEvent& event = coalesced[i];
+        for (size_t j = i; j > 0; --j)
+        {
+            const XEvent& previous = coalesced[j - 1];
+            if (previous.xany.window != event.xany.window)
+                continue;
+            TEST(previous.type != event.type || event.type == ButtonPress ||
+                 event.type == ButtonRelease ||
+                 (event.type == MotionNotify &&
+                  previous.xmotion.state != event.xmotion.state));
+            break;
+        }
+    }
+}
+
+struct Result
+{
+    float injected;  // events per frame
+    float delivered; // events per frame after coalescing
+    float time;      // us per frame
+};
+
+Result _run(const size_t nWindows, const size_t motionRate)
+{
+    Injector injector(nWindows, motionRate);
+    Result result = {0.f, 0.f, 0.f};
+    std::vector<XEvent> events;
+    lunchbox::Clock clock;
+    float time = 0.f;
+
+    for (size_t i = 0; i < nFrames; ++i)
+    {
+        events.clear();
+        injector.inject(events);
+        const std::vector<XEvent> injected = events;
+        result.injected += float(events.size());
+
+        clock.reset();
+        const size_t removed = eq::glx::EventHandler::coalesce(events);
+        time += clock.getTimef();
+
+        TEST(removed + events.size() == injected.size());
+        result.delivered += float(events.size());
+        _check(injected, events, motionRate / 60);
+    }
+
+    result.injected /= float(nFrames);
+    result.delivered /= float(nFrames);
+    result.time = time * 1000.f / float(nFrames);
+    return result;
+}
+}
+
+#endif
+
+namespace
+{
+const size_t nEvents = 20000;
+const size_t batchSizes[] = {0, 1, 16, 256}; // 0: no batch
+
+class Pipe : public eq::Pipe
+{
+public:
+    explicit Pipe(eq::Node* parent)
+        : eq::Pipe(parent)
+    {
+    }
+
+protected:
+    eq::WindowSystem selectWindowSystem() const final
+    {
+        return eq::WindowSystem("CPU");
+    }
+};
+
+class NodeFactory : public eq::NodeFactory
+{
+public:
+    eq::Pipe* createPipe(eq::Node* parent) final { return new Pipe(parent); }
+};
+
+/** Counts the event commands dispatched by the application node. */
+class Client : public eq::Client
+{
+public:
+    std::atomic<size_t> nEvents{0};  //!< single events, sent or split
+    std::atomic<size_t> nBatches{0}; //!< batched event commands
+
+    bool dispatchCommand(co::ICommand& command) override
+    {
+        if (command.getType() == co::COMMANDTYPE_OBJECT)
+        {
+            if (command.getCommand() == eq::fabric::CMD_CONFIG_EVENT)
+                ++nEvents;
+            else if (command.getCommand() == eq::fabric::CMD_CONFIG_EVENTS)
+                ++nBatches;
+        }
+        return eq::Client::dispatchCommand(command);
+    }
+};
+typedef lunchbox::RefPtr<Client> ClientPtr;
+
+std::string _writeConfig()
+{
+    const std::string name = "eventCoalescing.eqc";
+    std::ofstream file(name.c_str());
+    file << "#Equalizer 1.2 ascii" << std::endl
+         << "server" << std::endl
+         << "{" << std::endl
+         << "    connection { hostname \"127.0.0.1\" }" << std::endl
+         << "    config" << std::endl
+         << "    {" << std::endl
+         << "        appNode { pipe { window { viewport [ 0 0 64 64 ] "
+         << "channel { name \"channel\" }}}}" << std::endl
+         << "        compound { channel \"channel\" }" << std::endl
+         << "    }" << std::endl
+         << "}" << std::endl;
+    return name;
+}
+
+/** @return the variable-sized payload of the given event. */
+std::vector<uint8_t> _getPayload(const size_t event)
+{
+    return std::vector<uint8_t>((event % 64) * 4, uint8_t(event));
+}
+
+void _send(eq::Config* config, const size_t event)
+{
+    config->sendEvent(eq::EVENT_USER) << uint64_t(event) << _getPayload(event);
+}
+
+/** Checks that the split events arrive whole and in order. */
+void _receive(eq::Config* config, const uint32_t timeout, size_t& received)
+{
+    while (received < nEvents)
+    {
+        eq::EventICommand event = config->getNextEvent(timeout);
+        if (!event.isValid())
+        {
+            TESTINFO(timeout == 0, "event " << received << " lost");
+            return;
+        }
+
+        TEST(event.getEventType() == eq::EVENT_USER);
+        TESTINFO(event.read<uint64_t>() == received, received);
+        TESTINFO(event.read<std::vector<uint8_t>>() == _getPayload(received),
+                 received);
+        ++received;
+    }
+}
+
+struct BatchResult
+{
+    float time;     // us per event
+    size_t events;  // single event commands dispatched
+    size_t batches; // batched event commands received
+};
+
+/** Sends all events in batches of the given size to the application. */
+BatchResult _runBatches(eq::Config* config, ClientPtr client,
+                        const size_t batchSize)
+{
+    const size_t events = client->nEvents;
+    const size_t batches = client->nBatches;
+    const lunchbox::Clock clock;
+
+    size_t received = 0;
+    for (size_t i = 0; i < nEvents; i += std::max(batchSize, size_t(1)))
+    {
+        if (batchSize == 0)
+            _send(config, i);
+        else
+        {
+            eq::Config::startEventBatch();
+            for (size_t j = i; j < std::min(i + batchSize, nEvents); ++j)
+                _send(config, j);
+            eq::Config::finishEventBatch();
+        }
+        _receive(config, 0, received); // keep the delivery pipelined
+    }
+    _receive(config, 10000 /*ms*/, received);
+
+    const BatchResult result = {clock.getTimef() * 1000.f / float(nEvents),
+                                client->nEvents - events,
+                                client->nBatches - batches};
+
+    // batches are split into exactly their events
+    TESTINFO(result.events == nEvents, result.events);
+    if (batchSize > 1)
+        TESTINFO(result.batches == (nEvents + batchSize - 1) / batchSize,
+                 result.batches);
+    else
+        TESTINFO(result.batches == 0, result.batches);
+    return result;
+}
+
+/** Nested batches are sent when the outermost batch finishes. */
+void _testNesting(eq::Config* config, ClientPtr client)
+{
+    const size_t batches = client->nBatches;
+    eq::Config::startEventBatch();
+    eq::Config::startEventBatch();
+    _send(config, 0);
+    _send(config, 1);
+    eq::Config::finishEventBatch();
+    TEST(!config->getNextEvent(100 /*ms*/).isValid());
+    eq::Config::finishEventBatch();
+
+    for (uint64_t i = 0; i < 2; ++i)
+    {
+        eq::EventICommand event = config->getNextEvent(10000 /*ms*/);
+        TEST(event.isValid());
+        TEST(event.read<uint64_t>() == i);
+    }
+    TEST(client->nBatches == batches + 1);
+}
+}
+
+int main(int argc, char** argv)
+{
+#ifdef GLX
+    std::cout << "WINDOWS, RATE, INJECTED, DELIVERED, US/FRAME" << std::endl;
+    std::cout.setf(std::ios::right, std::ios::adjustfield);
+    std::cout.precision(5);
+
+    for (size_t nWindows = 1; nWindows <= 16; nWindows <<= 2)
+    {
+        for (size_t rate = 120; rate <= 1920; rate <<= 2)
+        {
+            const Result result = _run(nWindows, rate);
+            std::cout << std::setw(7) << nWindows << ", " << std::setw(4)
+                      << rate << ", " << std::setw(8) << result.injected
+                      << ", " << std::setw(9) << result.delivered << ", "
+                      << std::setw(8) << result.time << std::endl;
+
+            // mostly the last motion of each window remains
+            TESTINFO(result.delivered < 2.f * float(nWindows) + 4.f,
+                     result.delivered);
+        }
+    }
+#endif
+
+    NodeFactory nodeFactory;
+    TEST(eq::init(argc, argv, &nodeFactory));
+
+    ClientPtr client = new Client;
+    TEST(client->initLocal(argc, argv));
+
+    eq::ServerPtr server = new eq::Server;
+    eq::Global::setConfig(_writeConfig());
+    TEST(client->connectServer(server));
+
+    eq::fabric::ConfigParams configParams;
+    eq::Config* config = server->chooseConfig(configParams);
+    TEST(config);
+    TEST(config->init(eq::uint128_t()));
+    config->handleEvents(); // drop the init events
+
+    _testNesting(config, client);
+
+    std::cout << "BATCH, US/EVENT, EVENT CMDS, BATCH CMDS" << std::endl;
+    std::cout.setf(std::ios::right, std::ios::adjustfield);
+    std::cout.precision(5);
+    for (const size_t batchSize : batchSizes)
+    {
+        const BatchResult result = _runBatches(config, client, batchSize);
+        std::cout << std::setw(5) << batchSize << ", " << std::setw(8)
+                  << result.time << ", " << std::setw(10) << result.events
+                  << ", " << std::setw(10) << result.batches << std::endl;
+    }
+
+    TEST(config->exit());
+    server->releaseConfig(config);
+    TEST(client->disconnectServer(server));
+    TEST(client->exitLocal());
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
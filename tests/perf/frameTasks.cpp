@@ -0,0 +1,192 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Measures the frame start latency and the number of commands received by the
+// render node with and without batched frame task commands
+
+#define EQ_TEST_RUNTIME 300 // seconds
+#include <eq/eq.h>
+#include <eq/server/global.h>
+#include <lunchbox/lock.h>
+#include <lunchbox/scopedMutex.h>
+#include <lunchbox/test.h>
+
+#include <atomic>
+#include <iomanip>
+
+#ifdef _WIN32
+#define setenv(name, value, overwrite) _putenv_s(name, value)
+#endif
+
+#ifdef EQUALIZER_USE_HWSD
+namespace
+{
+const size_t nFrames = 200;
+
+lunchbox::Clock _clock;
+std::atomic<float> _frameStart(0.f); // time of the last Config::startFrame
+
+lunchbox::Lock _lock;
+float _latency = 0.f; // sum of the channel frame start latencies
+size_t _nLatencies = 0;
+
+/** Counts the commands received from the network. */
+class Client : public eq::Client
+{
+public:
+    std::atomic<size_t> nCommands{0};
+
+    bool dispatchCommand(co::ICommand& command) override
+    {
+        ++nCommands;
+        return eq::Client::dispatchCommand(command);
+    }
+};
+typedef lunchbox::RefPtr<Client> ClientPtr;
+
+class Channel : public eq::Channel
+{
+public:
+    explicit Channel(eq::Window* parent)
+        : eq::Channel(parent)
+    {
+    }
+
+protected:
+    void frameStart(const eq::uint128_t& frameID,
+                    const uint32_t frameNumber) override
+    {
+        const float latency = _clock.getTimef() - _frameStart;
+        {
+            lunchbox::ScopedWrite mutex(_lock);
+            _latency += latency;
+            ++_nLatencies;
+        }
+        eq::Channel::frameStart(frameID, frameNumber);
+    }
+};
+
+class NodeFactory : public eq::NodeFactory
+{
+public:
+    eq::Channel* createChannel(eq::Window* parent) final
+    {
+        return new Channel(parent);
+    }
+};
+
+struct Result
+{
+    float frameTime;    //!< mean time from frame start to finish in ms
+    float startLatency; //!< mean time from frame start to channel start in ms
+    float nCommands;    //!< commands received by the render node per frame
+};
+
+void _startFrame(eq::Config* config)
+{
+    _frameStart = _clock.getTimef();
+    config->startFrame(eq::uint128_t());
+    config->finishAllFrames();
+}
+
+Result _run(ClientPtr client, const int32_t batchTasks)
+{
+    eq::server::Global::instance()->setNodeIAttribute(
+        eq::server::Node::IATTR_HINT_BATCH_TASKS, batchTasks);
+
+    eq::ServerPtr server = new eq::Server;
+    TEST(client->connectServer(server));
+
+    eq::fabric::ConfigParams configParams;
+    eq::Config* config = server->chooseConfig(configParams);
+    Result result = {0.f, 0.f, 0.f};
+    if (config && config->init(eq::uint128_t()))
+    {
+        for (size_t i = 0; i < 10; ++i) // warm up
+            _startFrame(config);
+
+        _latency = 0.f;
+        _nLatencies = 0;
+        const size_t nCommands = client->nCommands;
+        const lunchbox::Clock clock;
+        for (size_t i = 0; i < nFrames; ++i)
+            _startFrame(config);
+
+        result.frameTime = clock.getTimef() / float(nFrames);
+        result.nCommands =
+            float(client->nCommands - nCommands) / float(nFrames);
+        TEST(_nLatencies > 0);
+        result.startLatency = _latency / float(_nLatencies);
+        config->exit();
+    }
+
+    if (config)
+        server->releaseConfig(config);
+    client->disconnectServer(server);
+    return result;
+}
+
+std::ostream& operator<<(std::ostream& os, const Result& result)
+{
+    return os << std::setw(9) << result.frameTime << ", " << std::setw(12)
+              << result.startLatency << ", " << std::setw(13)
+              << result.nCommands;
+}
+}
+
+int main(const int argc, char** argv)
+{
+#ifndef Darwin
+    ::setenv("EQ_WINDOW_IATTR_HINT_DRAWABLE", "-12" /*FBO*/, 1 /*overwrite*/);
+#endif
+    eq::Global::setConfig("configs/7-window.DB.2D.eqc");
+
+    NodeFactory nodeFactory;
+    TEST(eq::init(argc, argv, &nodeFactory));
+
+    ClientPtr client = new Client;
+    TEST(client->initLocal(argc, argv));
+
+    const Result unbatched = _run(client, eq::OFF);
+    const Result batched = _run(client, eq::ON);
+    if (unbatched.frameTime > 0.f && batched.frameTime > 0.f)
+    {
+        std::cout << "TASKS,    MS/FRAME, START LATENCY, COMMANDS/FRAME"
+                  << std::endl
+                  << "single,  " << unbatched << std::endl
+                  << "batched, " << batched << std::endl;
+        TESTINFO(batched.nCommands < unbatched.nCommands,
+                 batched.nCommands << " commands per frame using batching, "
+                                   << unbatched.nCommands << " without");
+    }
+    else
+        std::cerr << "Can't get configuration - no GPU available?" << std::endl;
+
+    client->exitLocal();
+    TESTINFO(client->getRefCount() == 1, client->getRefCount());
+    eq::exit();
+    return EXIT_SUCCESS;
+}
+
+#else
+
+int main(const int, char**)
+{
+    return EXIT_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,152 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+// Measures the throughput of the image writer shared by the channels of a node
+// for a 4K output at 30 fps, and checks that the shared streams are not
+// corrupted by the concurrent channels.
+
+#include <lunchbox/test.h>
+
+#include <eq/image.h>
+#include <eq/imageWriter.h>
+#include <eq/init.h>
+#include <eq/nodeFactory.h>
+#include <eq/pixelData.h>
+#include <lunchbox/clock.h>
+#include <lunchbox/thread.h>
+#include <pression/plugins/compressor.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <cstdio>
+#include <iomanip>
+#include <memory>
+
+namespace
+{
+const uint32_t width = 3840;
+const uint32_t height = 2160;
+const size_t nChannels = 4; // horizontal stripes of the output
+const size_t nFrames = 90;  // three seconds at 30 fps
+const float targetFPS = 30.f;
+const uint32_t stripe = height / nChannels;
+const size_t stripeSize = size_t(width) * stripe * 4;
+
+std::string _getFileName(const std::string& prefix, const size_t channel,
+                         const size_t frame)
+{
+    return prefix + boost::lexical_cast<std::string>(channel) + "_" +
+           boost::lexical_cast<std::string>(frame) + ".raw";
+}
+
+/** Queues the output stripe of one channel for each frame. */
+class Channel : public lunchbox::Thread
+{
+public:
+    Channel(eq::ImageWriter& writer, const size_t index,
+            const std::string& name)
+        : _writer(writer)
+        , _index(index)
+        , _name(name)
+    {
+        eq::PixelData pixels;
+        pixels.internalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+        pixels.externalFormat = EQ_COMPRESSOR_DATATYPE_RGBA;
+        pixels.pixelSize = 4;
+        pixels.pvp = eq::PixelViewport(0, index * stripe, width, stripe);
+        _image.setPixelViewport(pixels.pvp);
+        _image.setPixelData(eq::Frame::Buffer::color, pixels);
+
+        uint8_t* data = _image.getPixelPointer(eq::Frame::Buffer::color);
+        for (size_t i = 0; i < stripeSize; ++i)
+            data[i] = uint8_t(i * (index + 1));
+    }
+
+    void run() override
+    {
+        const bool stream = _name[0] == '|';
+        for (size_t i = 0; i < nFrames; ++i)
+            _writer.write(_image, eq::Frame::Buffer::color,
+                          stream ? _name : _getFileName(_name, _index, i));
+    }
+
+private:
+    eq::ImageWriter& _writer;
+    const size_t _index;
+    const std::string _name;
+    eq::Image _image;
+};
+
+/** @return the frames per second written to the given files or stream. */
+float _run(const std::string& name, const std::string& format)
+{
+    eq::ImageWriter writer;
+    writer.setStreamFormat(format);
+
+    std::vector<std::unique_ptr<Channel>> channels;
+    for (size_t i = 0; i < nChannels; ++i)
+        channels.emplace_back(new Channel(writer, i, name));
+
+    lunchbox::Clock clock;
+    for (auto& channel : channels)
+        TEST(channel->start());
+    for (auto& channel : channels)
+        TEST(channel->join());
+    writer.finish();
+    return float(nFrames) * 1000.f / clock.getTimef();
+}
+
+void _print(const std::string& output, const float fps)
+{
+    std::cout << std::setw(12) << output << ", " << std::setw(8) << fps << ", "
+              << (fps >= targetFPS ? "yes" : "no") << std::endl;
+}
+}
+
+int main(int argc, char** argv)
+{
+    eq::NodeFactory nodeFactory;
+    TEST(eq::init(argc, argv, &nodeFactory));
+
+    std::cout << "OUTPUT, FPS, 4K@30" << std::endl;
+    std::cout.setf(std::ios::right, std::ios::adjustfield);
+    std::cout.precision(5);
+
+    _print("raw files", _run("out_writer_", ".raw"));
+    for (size_t i = 0; i < nChannels; ++i)
+        for (size_t j = 0; j < nFrames; ++j)
+        {
+            const std::string file = _getFileName("out_writer_", i, j);
+            TESTINFO(boost::filesystem::file_size(file) == stripeSize, file);
+            ::remove(file.c_str());
+        }
+
+#ifndef _WIN32
+    // all channels share one pipe, which receives every image whole
+    const std::string streamFile = "out_writer_stream.raw";
+    _print("raw stream", _run("|cat > " + streamFile, ".raw"));
+    TEST(boost::filesystem::file_size(streamFile) ==
+         stripeSize * nChannels * nFrames);
+    ::remove(streamFile.c_str());
+
+    _print("ppm stream", _run("|cat > /dev/null", ".ppm"));
+#endif
+
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
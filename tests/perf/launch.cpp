@@ -0,0 +1,171 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+// Launches several local render client processes with different launch
+// concurrencies and reports the time to initialize the config.
+
+#include <eq/eq.h>
+#include <eq/server/global.h>
+#include <lunchbox/test.h>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+const size_t nNodes = 6;
+const int32_t concurrencies[] = {1, 3, int32_t(nNodes)};
+
+class Pipe : public eq::Pipe
+{
+public:
+    explicit Pipe(eq::Node* parent)
+        : eq::Pipe(parent)
+    {
+    }
+
+protected:
+    eq::WindowSystem selectWindowSystem() const final
+    {
+        return eq::WindowSystem("CPU");
+    }
+};
+
+class Channel : public eq::Channel
+{
+public:
+    explicit Channel(eq::Window* parent)
+        : eq::Channel(parent)
+    {
+    }
+
+protected:
+    void frameClear(const eq::uint128_t&) final {}
+    void frameDraw(const eq::uint128_t&) final {}
+};
+
+class NodeFactory : public eq::NodeFactory
+{
+public:
+    eq::Pipe* createPipe(eq::Node* parent) final { return new Pipe(parent); }
+    eq::Channel* createChannel(eq::Window* parent) final
+    {
+        return new Channel(parent);
+    }
+};
+
+/** Writes a config with nNodes render nodes, launched locally. */
+std::string _writeConfig(const int32_t concurrency)
+{
+    std::ostringstream name;
+    name << "launch." << concurrency << ".eqc";
+    std::ofstream file(name.str().c_str());
+
+    file << "#Equalizer 1.2 ascii" << std::endl
+         << "global" << std::endl
+         << "{" << std::endl
+         << "    EQ_NODE_SATTR_LAUNCH_COMMAND \"%c\"" << std::endl
+         << "    EQ_NODE_IATTR_LAUNCH_TIMEOUT 20000 #ms" << std::endl
+         << "}" << std::endl
+         << "server" << std::endl
+         << "{" << std::endl
+         << "    connection { hostname \"127.0.0.1\" }" << std::endl
+         << "    config" << std::endl
+         << "    {" << std::endl
+         << "        attributes { launch_concurrency " << concurrency << " }"
+         << std::endl
+         << "        appNode { connection { hostname \"127.0.0.1\" } }"
+         << std::endl;
+
+    for (size_t i = 0; i < nNodes; ++i)
+        file << "        node" << std::endl
+             << "        {" << std::endl
+             << "            connection { hostname \"127.0.0.1\" }"
+             << std::endl
+             << "            pipe { window { viewport [ 0 0 64 64 ] "
+             << "channel { name \"channel" << i << "\" }}}" << std::endl
+             << "        }" << std::endl;
+
+    for (size_t i = 0; i < nNodes; ++i)
+        file << "        compound" << std::endl
+             << "        {" << std::endl
+             << "            channel \"channel" << i << "\"" << std::endl
+             << "            wall" << std::endl
+             << "            {" << std::endl
+             << "                bottom_left  [ -.32 -.20 -.75 ]" << std::endl
+             << "                bottom_right [  .32 -.20 -.75 ]" << std::endl
+             << "                top_left     [ -.32  .20 -.75 ]" << std::endl
+             << "            }" << std::endl
+             << "        }" << std::endl;
+
+    file << "    }" << std::endl << "}" << std::endl;
+    return name.str();
+}
+
+/** @return the time to launch and initialize all render nodes in ms. */
+float _testLaunch(eq::ClientPtr client, const int32_t concurrency)
+{
+    const std::string filename = _writeConfig(concurrency);
+    eq::ServerPtr server = new eq::Server;
+    eq::Global::setConfig(filename);
+    TEST(client->connectServer(server));
+
+    eq::fabric::ConfigParams configParams;
+    eq::Config* config = server->chooseConfig(configParams);
+    TESTINFO(config, filename);
+    TESTINFO(config->getNodes().size() == nNodes + 1, config->getNodes().size());
+
+    const lunchbox::Clock clock;
+    TESTINFO(config->init(eq::uint128_t()), filename);
+    const float time = clock.getTimef();
+
+    // all render processes take part in a frame
+    config->startFrame(eq::uint128_t());
+    config->finishAllFrames();
+    TESTINFO(config->getErrors().empty(), filename);
+
+    TESTINFO(config->exit(), filename);
+    server->releaseConfig(config);
+    client->disconnectServer(server);
+    ::remove(filename.c_str());
+    return time;
+}
+}
+
+int main(int argc, char** argv)
+{
+    // also the entry point of the launched render clients
+    NodeFactory nodeFactory;
+    TEST(eq::init(argc, argv, &nodeFactory));
+
+    eq::ClientPtr client = new eq::Client;
+    TEST(client->initLocal(argc, argv));
+
+    std::cout << "NODES, CONCURRENCY, INIT MS" << std::endl;
+    for (const int32_t concurrency : concurrencies)
+        std::cout << std::setw(5) << nNodes << ", " << std::setw(11)
+                  << concurrency << ", " << std::setw(7)
+                  << _testLaunch(client, concurrency) << std::endl;
+
+    client->exitLocal();
+    TESTINFO(client->getRefCount() == 1, client);
+    eq::server::Global::clear();
+    TEST(eq::exit());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,200 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the scaling of the load balancing tree up to 1024 leaves
+
+#include <eq/server/equalizers/loadTree.h>
+#include <lunchbox/clock.h>
+#include <lunchbox/test.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+
+using eq::server::LoadTree;
+
+namespace
+{
+const size_t nFrames = 100;
+const float damping = .5f;
+
+/** Rendering cost density over the DB range, a hot spot on a background. */
+float _density(const float x, const float hotSpot)
+{
+    const float dx = x - hotSpot;
+    return 1.f + 20.f * std::exp(-dx * dx / .01f);
+}
+
+float _integrate(const float start, const float end, const float hotSpot)
+{
+    const size_t steps = 16;
+    const float step = (end - start) / float(steps);
+    float sum = 0.f;
+    for (size_t i = 0; i < steps; ++i)
+        sum += _density(start + (i + .5f) * step, hotSpot);
+    return sum * step;
+}
+
+/** A load tree with the leaf ranges of the last decomposition. */
+class Tree
+{
+public:
+    explicit Tree(const size_t nLeaves)
+    {
+        _build(0, nLeaves);
+        _ranges.resize(_children.size());
+        _assign(_tree.getRoot(), 0.f, 1.f);
+    }
+
+    /**
+     * Report the time of each leaf range and rebalance.
+     *
+     * @param hotSpot the position of the cost hot spot.
+     * @param elapsed accumulates the time spent in the load tree.
+     * @return the recomputed splits.
+     */
+    size_t update(const float hotSpot, float& elapsed)
+    {
+        std::vector<int64_t> times;
+        times.reserve(_leaves.size());
+        for (const size_t leaf : _leaves)
+        {
+            const Range& range = _ranges[leaf];
+            const float time = _integrate(range.first, range.second, hotSpot);
+            times.push_back(int64_t(time * 1000000.f));
+        }
+
+        lunchbox::Clock clock;
+        for (size_t i = 0; i < _leaves.size(); ++i)
+            _tree.setTime(_leaves[i], times[i]);
+        const size_t updated = _tree.update(damping);
+        elapsed += clock.getTimef();
+
+        _assign(_tree.getRoot(), 0.f, 1.f);
+        return updated;
+    }
+
+    /** @return the max/min ratio of the true leaf costs. */
+    float getImbalance(const float hotSpot) const
+    {
+        float minTime = std::numeric_limits<float>::max();
+        float maxTime = 0.f;
+        for (const size_t leaf : _leaves)
+        {
+            const Range& range = _ranges[leaf];
+            const float time = _integrate(range.first, range.second, hotSpot);
+            minTime = std::min(minTime, time);
+            maxTime = std::max(maxTime, time);
+        }
+        return maxTime / minTime;
+    }
+
+private:
+    typedef std::pair<size_t, size_t> Children;
+    typedef std::pair<float, float> Range;
+
+    LoadTree _tree;
+    std::vector<Children> _children;
+    std::vector<size_t> _leaves;
+    std::vector<Range> _ranges;
+
+    size_t _add(const size_t id, const Children& children)
+    {
+        _children.resize(id + 1);
+        _children[id] = children;
+        return id;
+    }
+
+    size_t _build(const size_t begin, const size_t end)
+    {
+        if (end - begin == 1)
+        {
+            const size_t id = _tree.addLeaf();
+            _tree.setResources(id, 1.f);
+            _leaves.push_back(id);
+            return _add(id, Children(LoadTree::NONE, LoadTree::NONE));
+        }
+
+        const size_t middle = begin + ((end - begin) >> 1);
+        const size_t left = _build(begin, middle);
+        const size_t right = _build(middle, end);
+        return _add(_tree.addNode(left, right), Children(left, right));
+    }
+
+    void _assign(const size_t id, const float start, const float end)
+    {
+        const Children& children = _children[id];
+        if (children.first == LoadTree::NONE)
+        {
+            _ranges[id] = Range(start, end);
+            return;
+        }
+
+        const float split = start + (end - start) * _tree.getSplit(id);
+        _assign(children.first, start, split);
+        _assign(children.second, split, end);
+    }
+};
+
+struct Result
+{
+    float time;      // ms per frame
+    float splits;    // recomputed splits per frame
+    float imbalance; // after convergence
+};
+
+Result _run(const size_t nLeaves)
+{
+    Tree tree(nLeaves);
+    Result result = {0.f, 0.f, 0.f};
+    for (size_t i = 0; i < nFrames; ++i) // converge
+        tree.update(.3f, result.time);
+
+    result.time = 0.f;
+    for (size_t i = 0; i < nFrames; ++i)
+        result.splits += tree.update(.3f, result.time);
+
+    result.time /= float(nFrames);
+    result.splits /= float(nFrames);
+    result.imbalance = tree.getImbalance(.3f);
+    return result;
+}
+}
+
+int main(int, char**)
+{
+    std::cout << "LEAVES,   MS/FRAME, US/LEAF, SPLITS/FRAME, IMBALANCE"
+              << std::endl;
+    std::cout.setf(std::ios::right, std::ios::adjustfield);
+    std::cout.precision(5);
+
+    for (size_t nLeaves = 16; nLeaves <= 1024; nLeaves <<= 2)
+    {
+        const Result result = _run(nLeaves);
+        std::cout << std::setw(6) << nLeaves << ", " << std::setw(10)
+                  << result.time << ", " << std::setw(7)
+                  << result.time * 1000.f / float(nLeaves) << ", "
+                  << std::setw(12) << result.splits << ", " << std::setw(9)
+                  << result.imbalance << std::endl;
+
+        // converged subtrees are not recomputed
+        TESTINFO(result.splits < float(nLeaves - 1), result.splits);
+        TESTINFO(result.imbalance < 1.5f, result.imbalance);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,192 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the latency of central and tree swap barriers with in-process nodes
+
+#include <eq/fabric/swapBarrier.h>
+
+#include <co/barrier.h>
+#include <co/connectionDescription.h>
+#include <co/init.h>
+#include <co/localNode.h>
+#include <lunchbox/clock.h>
+#include <lunchbox/test.h>
+#include <lunchbox/thread.h>
+
+#include <iomanip>
+#include <memory>
+
+using eq::fabric::SwapBarrier;
+
+namespace
+{
+const size_t nNodes = 16;
+const size_t nFrames = 200;
+const uint32_t timeout = 10000;
+
+co::LocalNodePtr _newNode()
+{
+    co::ConnectionDescriptionPtr desc = new co::ConnectionDescription;
+    desc->type = co::CONNECTIONTYPE_TCPIP;
+    desc->setHostname("127.0.0.1");
+
+    co::LocalNodePtr node = new co::LocalNode;
+    node->addConnectionDescription(desc);
+    TEST(node->listen());
+    return node;
+}
+
+/** One pipe thread entering its barrier path every frame. */
+class Participant : public lunchbox::Thread
+{
+public:
+    Participant(const co::Barriers& path, const bool release)
+        : _path(path)
+        , _release(release)
+    {
+    }
+
+    void run() override
+    {
+        for (size_t i = 0; i < nFrames; ++i)
+            TEST(SwapBarrier::enter(_path, _release, timeout));
+    }
+
+private:
+    const co::Barriers _path;
+    const bool _release;
+};
+
+/** @return the time per frame of nPipes participants per node. */
+float _run(std::vector<co::LocalNodePtr>& nodes, const size_t nPipes,
+           const uint32_t fanIn)
+{
+    std::vector<uint32_t> groups;
+    for (size_t i = 0; i < nodes.size(); ++i)
+        groups.insert(groups.end(), nPipes, uint32_t(i));
+
+    SwapBarrier::Tree tree;
+    if (fanIn > 1)
+        tree = SwapBarrier::buildTree(groups, fanIn);
+    else // central barrier on the first node
+    {
+        tree.masters.push_back(0);
+        tree.members.push_back(std::vector<size_t>());
+        for (size_t i = 0; i < groups.size(); ++i)
+        {
+            tree.members[0].push_back(i);
+            tree.paths.push_back(std::vector<size_t>(1, 0));
+        }
+    }
+
+    // masters are registered on the first node, mapped once on each node
+    co::LocalNodePtr server = nodes.front();
+    std::vector<std::unique_ptr<co::Barrier>> masters;
+    std::vector<std::unique_ptr<co::Barrier>> slaves;
+    std::vector<std::vector<co::Barrier*>> mapped(
+        tree.members.size(), std::vector<co::Barrier*>(nodes.size()));
+
+    for (size_t i = 0; i < tree.members.size(); ++i)
+    {
+        const size_t master = groups[tree.masters[i]];
+        masters.emplace_back(
+            new co::Barrier(server, nodes[master]->getNodeID(),
+                            uint32_t(tree.members[i].size())));
+        const co::ObjectVersion version(masters.back().get());
+
+        for (const size_t member : tree.members[i])
+        {
+            const size_t node = groups[member];
+            if (mapped[i][node])
+                continue;
+            slaves.emplace_back(new co::Barrier(nodes[node], version));
+            TEST(slaves.back()->isGood());
+            mapped[i][node] = slaves.back().get();
+        }
+    }
+
+    std::vector<std::unique_ptr<Participant>> participants;
+    for (size_t i = 0; i < groups.size(); ++i)
+    {
+        const std::vector<size_t>& path = tree.paths[i];
+        if (path.empty())
+            continue;
+
+        co::Barriers barriers;
+        for (const size_t barrier : path)
+            barriers.push_back(mapped[barrier][groups[i]]);
+        participants.emplace_back(
+            new Participant(barriers, !tree.isRoot(path.back())));
+    }
+
+    lunchbox::Clock clock;
+    for (auto& participant : participants)
+        TEST(participant->start());
+    for (auto& participant : participants)
+        TEST(participant->join());
+    const float time = clock.getTimef() / float(nFrames);
+
+    slaves.clear();
+    for (auto& master : masters)
+        server->deregisterObject(master.get());
+    return time;
+}
+}
+
+int main(int argc, char** argv)
+{
+    TEST(co::init(argc, argv));
+
+    std::vector<co::LocalNodePtr> nodes;
+    for (size_t i = 0; i < nNodes; ++i)
+    {
+        co::LocalNodePtr node = _newNode();
+        for (co::LocalNodePtr peer : nodes)
+        {
+            co::NodePtr proxy = new co::Node;
+            proxy->addConnectionDescription(
+                peer->getConnectionDescriptions().front());
+            TEST(node->connect(proxy));
+        }
+        nodes.push_back(node);
+    }
+
+    std::cout << "NODES, PIPES, BARRIER, MS/FRAME" << std::endl;
+    std::cout.setf(std::ios::right, std::ios::adjustfield);
+    std::cout.precision(5);
+
+    for (size_t nPipes = 1; nPipes <= 4; nPipes <<= 1)
+    {
+        const float central = _run(nodes, nPipes, 0);
+        std::cout << std::setw(5) << nNodes << ", " << std::setw(5) << nPipes
+                  << ", central, " << std::setw(8) << central << std::endl;
+
+        for (uint32_t fanIn = 2; fanIn <= 8; fanIn <<= 1)
+        {
+            const float time = _run(nodes, nPipes, fanIn);
+            std::cout << std::setw(5) << nNodes << ", " << std::setw(5)
+                      << nPipes << ",  tree " << fanIn << ", " << std::setw(8)
+                      << time << std::endl;
+        }
+    }
+
+    for (co::LocalNodePtr node : nodes)
+        TEST(node->close());
+    nodes.clear();
+    TEST(co::exit());
+    return EXIT_SUCCESS;
+}
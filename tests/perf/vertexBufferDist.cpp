@@ -0,0 +1,148 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+// Measures the startup time and the resident leaf data of triply slave trees
+// rendering a part of the model, using in-process nodes
+
+#include <triply/vertexBufferDist.h>
+#include <triply/vertexBufferRoot.h>
+#include <triply/vertexData.h>
+
+#include <co/connectionDescription.h>
+#include <co/init.h>
+#include <co/localNode.h>
+#include <lunchbox/clock.h>
+#include <lunchbox/test.h>
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+const size_t gridSize = 512;
+
+/** A tessellated unit sphere. */
+void _createSphere(triply::VertexData& data)
+{
+    for (size_t y = 0; y <= gridSize; ++y)
+    {
+        for (size_t x = 0; x < gridSize; ++x)
+        {
+            const float phi = float(x) / float(gridSize) * 2.f * float(M_PI);
+            const float theta = float(y) / float(gridSize) * float(M_PI);
+            const triply::Normal normal(std::sin(theta) * std::cos(phi),
+                                        std::sin(theta) * std::sin(phi),
+                                        std::cos(theta));
+            data.vertices.push_back(normal);
+            data.normals.push_back(normal);
+        }
+    }
+
+    for (size_t y = 0; y < gridSize; ++y)
+    {
+        for (size_t x = 0; x < gridSize; ++x)
+        {
+            const size_t i = y * gridSize + x;
+            const size_t right = y * gridSize + (x + 1) % gridSize;
+            data.triangles.push_back(
+                triply::Triangle(i, right, i + gridSize));
+            data.triangles.push_back(
+                triply::Triangle(i + gridSize, right, right + gridSize));
+        }
+    }
+}
+
+co::LocalNodePtr _newNode()
+{
+    co::ConnectionDescriptionPtr desc = new co::ConnectionDescription;
+    desc->type = co::CONNECTIONTYPE_TCPIP;
+    desc->setHostname("127.0.0.1");
+
+    co::LocalNodePtr node = new co::LocalNode;
+    node->addConnectionDescription(desc);
+    TEST(node->listen());
+    return node;
+}
+}
+
+int main(int argc, char** argv)
+{
+    TEST(co::init(argc, argv));
+
+    triply::VertexData data;
+    _createSphere(data);
+
+    std::ostringstream progressOut;
+    boost::progress_display progress(12, progressOut);
+    triply::VertexBufferRoot model;
+    model.setupTree(data, progress);
+
+    co::LocalNodePtr server = _newNode();
+    co::LocalNodePtr client = _newNode();
+    co::NodePtr master = new co::Node;
+    master->addConnectionDescription(
+        server->getConnectionDescriptions().front());
+    TEST(client->connect(master));
+
+    {
+        const triply::VertexBufferDist modelDist(model, server);
+
+        std::cout << "RANGE, STARTUP MS, MAPPING MS, RESIDENT KB" << std::endl;
+        std::cout.setf(std::ios::right, std::ios::adjustfield);
+        std::cout.precision(5);
+
+        size_t fullSize = 0;
+        for (float end = 1.f; end >= .125f; end *= .5f)
+        {
+            triply::Range range;
+            range[0] = 0.f;
+            range[1] = end;
+
+            triply::VertexBufferRoot slave;
+            lunchbox::Clock clock;
+            triply::VertexBufferDist dist(slave, master, client,
+                                          modelDist.getID());
+            const float startupTime = clock.getTimef();
+
+            clock.reset();
+            while (!dist.mapData(range)) // as done by the draw
+                std::this_thread::yield();
+            const float mappingTime = clock.getTimef();
+
+            const size_t size = dist.getDataSize();
+            if (end == 1.f)
+                fullSize = size;
+            else // only the data of the range is resident
+                TESTINFO(size < fullSize * (end + .125f),
+                         size << " of " << fullSize << " bytes mapped for "
+                              << end);
+
+            std::cout << std::setw(5) << end << ", " << std::setw(10)
+                      << startupTime << ", " << std::setw(10) << mappingTime
+                      << ", " << std::setw(11) << (size >> 10) << std::endl;
+        }
+    }
+
+    TEST(client->disconnect(master));
+    TEST(client->close());
+    TEST(server->close());
+    TEST(co::exit());
+    return EXIT_SUCCESS;
+}
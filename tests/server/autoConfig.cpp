@@ -0,0 +1,170 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the node-local compositing stage of the sort-last auto-configuration
+
+#include <eq/fabric/configParams.h>
+#include <eq/server/channel.h>
+#include <eq/server/compound.h>
+#include <eq/server/config.h>
+#include <eq/server/config/display.h>
+#include <eq/server/config/resources.h>
+#include <eq/server/global.h>
+#include <eq/server/layout.h>
+#include <eq/server/loader.h>
+#include <eq/server/node.h>
+#include <eq/server/pipe.h>
+#include <eq/server/server.h>
+
+#include <lunchbox/init.h>
+#include <lunchbox/test.h>
+
+#include <cmath>
+
+using namespace eq::server;
+
+namespace
+{
+// three render nodes with four, two and one GPU
+const size_t nPipes[] = {4, 2, 1};
+const size_t nNodes = sizeof(nPipes) / sizeof(size_t);
+const size_t nChannels = 7;
+
+/** @return the mono compound of the output compound using the layout. */
+const Compound* _findCompound(const Compounds& compounds,
+                              const std::string& name)
+{
+    for (const Compound* compound : compounds)
+    {
+        const Compound* segment = compound->getChildren().front();
+        if (segment->getChannel()->getLayout()->getName() == name)
+            return segment->getChildren().front();
+    }
+    return 0;
+}
+
+void _testDB(const Compound* compound)
+{
+    const Compounds& children = compound->getChildren();
+    TESTINFO(children.size() == nNodes, children.size());
+    TESTINFO(compound->getInputFrames().size() == nNodes,
+             compound->getInputFrames().size());
+
+    float start = 0.f;
+    for (size_t i = 0; i < nNodes; ++i)
+    {
+        const Compound* child = children[i];
+        const Compounds& local = child->getChildren();
+        const size_t nLocal = nPipes[i] > 1 ? nPipes[i] : 0;
+
+        TESTINFO(local.size() == nLocal, local.size());
+        TESTINFO(child->getInputFrames().size() == nLocal - (nLocal ? 1 : 0),
+                 child->getInputFrames().size());
+        TEST(child->getOutputFrames().size() == 1);
+        TESTINFO(std::abs(child->getRange().start - start) < 0.0001f,
+                 child->getRange());
+
+        const Node* node = child->getChannel()->getNode();
+        for (const Compound* leaf : local)
+            TEST(leaf->getChannel()->getNode() == node);
+        start += float(nPipes[i]) / float(nChannels);
+    }
+    TEST(children.back()->getRange().end == 1.f);
+}
+
+void _testDS(const Compound* compound)
+{
+    const Compounds& children = compound->getChildren();
+    TESTINFO(children.size() == nNodes, children.size());
+
+    for (size_t i = 0; i < nNodes; ++i)
+    {
+        const Compound* child = children[i];
+        TEST(child->getChildren().size() == 1);
+
+        // one tile per other node, composited locally before the readback
+        const Compound* drawChild = child->getChildren().front();
+        TESTINFO(child->getInputFrames().size() == nNodes - 1,
+                 child->getInputFrames().size());
+        TESTINFO(drawChild->getOutputFrames().size() == nNodes - 1,
+                 drawChild->getOutputFrames().size());
+        TEST(drawChild->getChildren().size() ==
+             (nPipes[i] > 1 ? nPipes[i] : 0));
+    }
+}
+}
+
+int main(int argc, char** argv)
+{
+    TEST(lunchbox::init(argc, argv));
+
+    ServerPtr server = new Server;
+    Config* config = new Config(server);
+
+    Node* appNode = new Node(config);
+    appNode->setApplicationNode(true);
+    Pipe* display = new Pipe(appNode);
+    display->setName("display mt mp"); // not used as a source
+    display->setPixelViewport(eq::fabric::PixelViewport(0, 0, 1920, 1200));
+
+    size_t gpu = 0;
+    for (size_t i = 0; i < nNodes; ++i)
+    {
+        Node* node = new Node(config);
+        std::ostringstream nodeName;
+        nodeName << "node_" << i + 1;
+        node->setName(nodeName.str());
+
+        for (size_t j = 0; j < nPipes[i]; ++j)
+        {
+            Pipe* pipe = new Pipe(node);
+            std::ostringstream name;
+            name << "GPU" << ++gpu << " mt mp";
+            pipe->setName(name.str());
+        }
+    }
+
+    const eq::fabric::ConfigParams params;
+    config::Display::discoverLocal(config, params);
+    const Compounds compounds = Loader::addOutputCompounds(server);
+    const Channels channels =
+        config::Resources::configureSourceChannels(config);
+    TESTINFO(channels.size() == nChannels, channels.size());
+    config::Resources::configure(compounds, channels, params);
+
+    const Compound* staticDB =
+        _findCompound(compounds, EQ_SERVER_CONFIG_LAYOUT_DB_STATIC);
+    TEST(staticDB);
+    _testDB(staticDB);
+
+    const Compound* directSend =
+        _findCompound(compounds, EQ_SERVER_CONFIG_LAYOUT_DB_DS);
+    TEST(directSend);
+    _testDS(directSend);
+
+    // the load equalizer balances the individual channels
+    const Compound* dynamicDB =
+        _findCompound(compounds, EQ_SERVER_CONFIG_LAYOUT_DB_DYNAMIC);
+    TEST(dynamicDB);
+    TESTINFO(dynamicDB->getChildren().size() == nChannels,
+             dynamicDB->getChildren().size());
+
+    Global::clear();
+    server->deleteConfigs(); // break server <-> config ref circle
+    TEST(lunchbox::exit());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,87 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Tests the compositing cost model of the load equalizer
+
+#include <eq/server/equalizers/compositeModel.h>
+#include <lunchbox/test.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+using eq::server::CompositeModel;
+
+namespace
+{
+const uint32_t destination = 1;
+const size_t nSources = 7;
+}
+
+int main(int, char**)
+{
+    CompositeModel model;
+    TEST(model.getCompositeTime(destination) == 0);
+    TEST(model.getResources(destination, 1.f, 8.f, 100.f) == 1.f);
+
+    // destination assembles, sources read back, transmit and compress
+    model.add(destination, true, 2, 10, 3);
+    for (size_t i = 0; i < nSources; ++i)
+        model.add(uint32_t(i + 2), false, 4, 0, 1);
+
+    TESTINFO(model.getCompositeTime(destination) == 2 + 10 + nSources,
+             model.getCompositeTime(destination));
+    TESTINFO(model.getCompositeTime(2) == 4, model.getCompositeTime(2));
+    TEST(model.getCompositeTime(42) == 0);
+    TESTINFO(model.getTotalCompositeTime() == 12 + nSources * 5,
+             model.getTotalCompositeTime());
+
+    // Equal resources spend the same time per frame rendering and compositing
+    const float renderTime = 800.f;
+    const float totalResources = float(nSources + 1);
+    std::vector<float> resources(nSources + 1);
+    float newResources = 0.f;
+    for (uint32_t i = 0; i <= nSources; ++i)
+    {
+        resources[i] =
+            model.getResources(i + 1, 1.f, totalResources, renderTime);
+        TEST(resources[i] > 0.f && resources[i] < 1.f);
+        newResources += resources[i];
+    }
+    TEST(resources[0] < resources[1]);
+
+    float minTime = std::numeric_limits<float>::max();
+    float maxTime = 0.f;
+    for (uint32_t i = 0; i <= nSources; ++i)
+    {
+        const float time = renderTime * resources[i] / newResources +
+                           float(model.getCompositeTime(i + 1));
+        minTime = std::min(minTime, time);
+        maxTime = std::max(maxTime, time);
+    }
+    TESTINFO(maxTime - minTime < .01f, minTime << " " << maxTime);
+
+    // The compositing cost is clamped to the render time of the task
+    const float clamped =
+        model.getResources(destination, 1.f, totalResources, 1.f);
+    TESTINFO(clamped > .9f && clamped < 1.f, clamped);
+
+    model.clear();
+    TEST(model.getCompositeTime(destination) == 0);
+    TEST(model.getTotalCompositeTime() == 0);
+    return EXIT_SUCCESS;
+}
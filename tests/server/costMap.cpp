@@ -0,0 +1,153 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Simulates cost map based load balancing on synthetic cost fields
+
+#include <eq/server/equalizers/costMap.h>
+#include <lunchbox/test.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace eq::server;
+
+namespace
+{
+const size_t nChannels = 4;
+const size_t nFrames = 60;
+
+/** A background cost plus a hot spot, e.g., a detailed model. */
+struct Field
+{
+    float x;
+    float y;
+
+    float density(const float px, const float py) const
+    {
+        const float dx = px - x;
+        const float dy = py - y;
+        return 1.f + 50.f * std::exp(-(dx * dx + dy * dy) / .005f);
+    }
+
+    float integrate(const Viewport& vp) const
+    {
+        const size_t steps = 64;
+        float sum = 0.f;
+        for (size_t j = 0; j < steps; ++j)
+            for (size_t i = 0; i < steps; ++i)
+                sum += density(vp.x + (i + .5f) * vp.w / steps,
+                               vp.y + (j + .5f) * vp.h / steps);
+        return sum * vp.getArea() / float(steps * steps);
+    }
+};
+
+/** Recursively split vp into nLeaves vertical stripes. */
+void _split(const CostMap& map, const Viewport& vp, const size_t nLeaves,
+            std::vector<Viewport>& result)
+{
+    if (nLeaves == 1)
+    {
+        result.push_back(vp);
+        return;
+    }
+
+    const size_t nLeft = nLeaves >> 1;
+    const float split = map.computeSplit(vp, true, float(nLeft) / nLeaves);
+    Viewport left = vp;
+    left.w = vp.w * split;
+    Viewport right = vp;
+    right.x = left.getXEnd();
+    right.w = vp.getXEnd() - right.x;
+
+    _split(map, left, nLeft, result);
+    _split(map, right, nLeaves - nLeft, result);
+}
+
+/** @return the max/min ratio of the true cost of the viewports. */
+float _imbalance(const Field& field, const std::vector<Viewport>& vps)
+{
+    float minTime = std::numeric_limits<float>::max();
+    float maxTime = 0.f;
+    for (const Viewport& vp : vps)
+    {
+        const float time = field.integrate(vp);
+        minTime = std::min(minTime, time);
+        maxTime = std::max(maxTime, time);
+    }
+    return maxTime / minTime;
+}
+
+/** Run a simulated balancing loop, @return the average late imbalance. */
+float _simulate(const bool predictive, const float speed)
+{
+    CostMap map;
+    map.resize(eq::fabric::Vector2i(32, 8));
+    map.setPredictive(predictive);
+
+    Field field = {.2f, .5f};
+    float imbalance = 0.f;
+    for (size_t frame = 0; frame < nFrames; ++frame)
+    {
+        std::vector<Viewport> vps;
+        _split(map, Viewport(), nChannels, vps);
+
+        if (frame >= nFrames / 2)
+            imbalance += _imbalance(field, vps);
+
+        for (const Viewport& vp : vps)
+            map.addSample(vp, field.integrate(vp));
+        TEST(map.commit(.5f));
+        field.x += speed;
+    }
+    return imbalance / float(nFrames - nFrames / 2);
+}
+}
+
+int main(int, char**)
+{
+    // empty map splits uniformly
+    CostMap map;
+    TEST(!map.isValid());
+    map.resize(eq::fabric::Vector2i(16, 1));
+    TEST(map.isValid());
+    TEST(!map.hasData());
+    TEST(map.computeSplit(eq::fabric::Range(), .25f) == .25f);
+
+    // uniform range cost
+    map.addSample(eq::fabric::Range(0.f, .5f), 10.f);
+    map.addSample(eq::fabric::Range(.5f, 1.f), 10.f);
+    TEST(map.commit(.5f));
+    TEST(!map.commit(.5f));
+    TESTINFO(std::abs(map.getCost(eq::fabric::Range()) - 20.f) < .001f,
+             map.getCost(eq::fabric::Range()));
+    TESTINFO(std::abs(map.computeSplit(eq::fabric::Range(), .5f) - .5f) < .001f,
+             map.computeSplit(eq::fabric::Range(), .5f));
+
+    // static hot spot: converges to a balanced decomposition
+    const float staticImbalance = _simulate(true, 0.f);
+    TESTINFO(staticImbalance < 1.25f, staticImbalance);
+
+    // moving hot spot: extrapolation beats the last frame's cost
+    const float motion = .01f;
+    const float predicted = _simulate(true, motion);
+    const float reactive = _simulate(false, motion);
+    TESTINFO(predicted < reactive, predicted << " >= " << reactive);
+    TESTINFO(predicted < 1.5f, predicted);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,126 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Simulates the frame time controller on a renderer with latency and jitter
+
+#include <eq/server/equalizers/frameTimeController.h>
+#include <lunchbox/test.h>
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+
+using eq::server::FrameTimeController;
+
+namespace
+{
+const size_t nFrames = 200;
+const size_t latency = 2;
+
+/** Deterministic noise in [-1, 1]. */
+float _noise(uint32_t& seed)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return float(seed >> 8) / float(1u << 23) - 1.f;
+}
+
+struct Result
+{
+    float mean;      // frame time after convergence
+    float deviation; // frame time standard deviation after convergence
+    size_t changes;  // level changes after convergence
+    float level;
+};
+
+/** Frame time is a fixed overhead plus the cost of the level. */
+Result _simulate(const float cost, const float jitter)
+{
+    FrameTimeController controller;
+    controller.setTarget(10.f);
+    controller.setRange(.01f, 1.f);
+
+    std::deque<float> levels(latency, 1.f);
+    uint32_t seed = 42;
+    Result result = {0.f, 0.f, 0, 0.f};
+    float sum2 = 0.f;
+    float lastLevel = controller.getLevel();
+
+    for (size_t i = 0; i < nFrames; ++i)
+    {
+        const float level = levels.front();
+        levels.pop_front();
+
+        const float time = 2.f + cost * level + jitter * _noise(seed);
+        controller.addSample(time);
+        levels.push_back(controller.update());
+
+        if (i < nFrames / 2)
+            continue;
+
+        result.mean += time;
+        sum2 += time * time;
+        if (controller.getLevel() != lastLevel)
+            ++result.changes;
+        lastLevel = controller.getLevel();
+    }
+
+    const float n = float(nFrames - nFrames / 2);
+    result.mean /= n;
+    const float variance = sum2 / n - result.mean * result.mean;
+    result.deviation = std::sqrt(std::max(0.f, variance));
+    result.level = controller.getLevel();
+    return result;
+}
+}
+
+int main(int, char**)
+{
+    // idle controller keeps its level
+    FrameTimeController controller;
+    TEST(controller.getLevel() == 1.f);
+    TEST(controller.update() == 1.f);
+
+    // within the hysteresis band nothing changes
+    controller.setTarget(10.f);
+    controller.addSample(9.5f);
+    TEST(controller.update() == 1.f);
+    TEST(controller.isSettled());
+
+    // too slow reduces the level
+    controller.addSample(20.f);
+    controller.addSample(20.f);
+    TEST(controller.update() < 1.f);
+    TEST(!controller.isSettled());
+
+    // converges to the target without jitter, and stays
+    Result result = _simulate(40.f, 0.f);
+    TESTINFO(std::abs(result.mean - 10.f) < 1.f, result.mean);
+    TESTINFO(result.changes < 5, result.changes);
+
+    // with jitter the mean keeps headroom and the level stays stable
+    result = _simulate(40.f, 2.f);
+    TESTINFO(result.mean < 10.f, result.mean);
+    TESTINFO(result.mean + result.deviation < 11.f,
+             result.mean << " + " << result.deviation);
+    TESTINFO(result.changes < 40, result.changes);
+
+    // cheap rendering saturates at the full level
+    result = _simulate(4.f, 0.f);
+    TESTINFO(result.level == 1.f, result.level);
+
+    return EXIT_SUCCESS;
+}
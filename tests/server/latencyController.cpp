@@ -0,0 +1,109 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Simulates the latency controller on a pipeline with application, rendering
+// and synchronization costs
+
+#include <eq/server/latencyController.h>
+#include <lunchbox/test.h>
+
+#include <algorithm>
+
+using eq::server::LatencyController;
+
+namespace
+{
+const size_t nFrames = 400;
+
+struct Result
+{
+    uint32_t latency; // at the end
+    size_t changes;   // latency changes
+    size_t atMin;     // frames at the lower bound
+};
+
+/**
+ * The frame time is the application time or the rendering time plus a
+ * synchronization cost, which is amortized over the frames in flight.
+ */
+Result _simulate(const float app, const float render, const float sync,
+                 const uint32_t latency)
+{
+    LatencyController controller;
+    controller.setRange(1, 4);
+    controller.reset(latency);
+
+    Result result = {0, 0, 0};
+    for (size_t i = 0; i < nFrames; ++i)
+    {
+        const float inFlight = float(controller.getLatency());
+        const float time = std::max(app, render + sync / inFlight);
+        controller.addSample(time, time - app, (time - render) / time);
+
+        if (controller.update() != uint32_t(inFlight))
+            ++result.changes;
+        if (controller.getLatency() == controller.getMinLatency())
+            ++result.atMin;
+    }
+    result.latency = controller.getLatency();
+    return result;
+}
+}
+
+int main(int, char**)
+{
+    // disabled controller keeps its latency
+    LatencyController controller;
+    TEST(!controller.isEnabled());
+    for (size_t i = 0; i < 100; ++i)
+        controller.addSample(30.f, 25.f, .5f);
+    TEST(controller.update() == 1);
+    TEST(controller.getDecision() == LatencyController::KEEP);
+
+    // synchronization bound: pipeline deeper, as long as it pays off
+    controller.setRange(1, 2);
+    controller.reset(1);
+    for (size_t i = 0; i < 8; ++i)
+        controller.addSample(30.f, 25.f, .5f);
+    TEST(controller.update() == 1); // first frame is skipped
+    controller.addSample(30.f, 25.f, .5f);
+    TEST(controller.update() == 2);
+    TEST(controller.getDecision() == LatencyController::RAISE);
+    TEST(controller.getFrameTime() == 30.f);
+
+    Result result = _simulate(5.f, 10.f, 20.f, 1);
+    TESTINFO(result.latency == 4, result.latency);
+    TESTINFO(result.changes == 3, result.changes);
+
+    // application bound: back to low latency, and stay there
+    result = _simulate(30.f, 10.f, 5.f, 4);
+    TESTINFO(result.latency == 1, result.latency);
+    TESTINFO(result.changes == 3, result.changes);
+
+    // rendering bound: pipelining does not help
+    result = _simulate(5.f, 20.f, 0.f, 1);
+    TESTINFO(result.latency == 1, result.latency);
+    TESTINFO(result.changes == 0, result.changes);
+
+    // idle pipes without a gain: probes are reverted and backed off
+    result = _simulate(20.f, 15.f, 0.f, 1);
+    TESTINFO(result.latency == 1, result.latency);
+    TESTINFO(result.changes < 10, result.changes);
+    TESTINFO(result.atMin > nFrames * 3 / 4, result.atMin);
+
+    return EXIT_SUCCESS;
+}
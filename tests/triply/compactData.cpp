@@ -0,0 +1,105 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+// Tests the round trip of the compact triply leaf encoding
+
+#include "mesh.h"
+
+#include <triply/compactData.h>
+#include <lunchbox/test.h>
+
+#include <cmath>
+#include <sstream>
+
+using triply::CompactData;
+
+namespace
+{
+const size_t gridSize = 64;
+
+void _compare(const triply::VertexBufferData& data, const CompactData& compact)
+{
+    TEST(compact.vertices.size() == data.vertices.size());
+    TEST(compact.colors == data.colors);
+
+    for (size_t i = 0; i < data.vertices.size(); ++i)
+    {
+        const triply::Vertex error = compact.getVertex(i) - data.vertices[i];
+        const float maxError = compact.scale * .51f;
+        TESTINFO(std::abs(error.x()) <= maxError &&
+                     std::abs(error.y()) <= maxError &&
+                     std::abs(error.z()) <= maxError,
+                 i << ": " << error << " > " << maxError);
+
+        const float cosine = compact.getNormal(i).dot(data.normals[i]);
+        TESTINFO(cosine > .999f, i << ": " << cosine);
+    }
+
+    std::vector<triply::ShortIndex> indices;
+    compact.decodeIndices(indices);
+    TEST(indices == data.indices);
+}
+}
+
+int main(int, char**)
+{
+    triply::VertexBufferData data;
+    test::createMesh(data, gridSize);
+
+    CompactData compact;
+    compact.encode(data, 0, data.vertices.size(), 0, data.indices.size());
+    _compare(data, compact);
+
+    const size_t size = test::getSize(data);
+    TESTINFO(compact.getSize() * 2 < size, compact.getSize() << " " << size);
+
+    // directions on the lower hemisphere and the octahedron edges
+    const triply::Normal normals[] = {
+        triply::Normal(0.f, 0.f, -1.f), triply::Normal(1.f, 0.f, 0.f),
+        triply::Normal(0.f, -1.f, 0.f), triply::Normal(.6f, -.48f, -.64f)};
+    for (const triply::Normal& normal : normals)
+    {
+        const triply::Normal decoded =
+            CompactData::decodeNormal(CompactData::encodeNormal(normal));
+        TESTINFO(decoded.dot(normal) > .999f, normal << " -> " << decoded);
+    }
+
+    // binary cache file round trip
+    std::ostringstream os;
+    compact.toStream(os);
+    std::string buffer = os.str();
+    char* addr = &buffer[0];
+
+    CompactData loaded;
+    loaded.fromMemory(&addr);
+    TEST(addr == &buffer[0] + buffer.size());
+    TEST(loaded.center == compact.center);
+    TEST(loaded.scale == compact.scale);
+    TEST(loaded.nIndices == compact.nIndices);
+    TEST(loaded.vertices == compact.vertices);
+    TEST(loaded.normals == compact.normals);
+    TEST(loaded.indices == compact.indices);
+    _compare(data, loaded);
+
+    // empty leaf
+    CompactData empty;
+    empty.encode(data, data.vertices.size(), 0, data.indices.size(), 0);
+    TEST(empty.vertices.empty());
+    TEST(empty.indices.empty());
+    TEST(empty.nIndices == 0);
+
+    return EXIT_SUCCESS;
+}
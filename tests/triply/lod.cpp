@@ -0,0 +1,174 @@
+
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+// Tests the level of detail selection of the triply kd-tree without OpenGL
+
+#include <triply/vertexBufferRoot.h>
+#include <triply/vertexBufferState.h>
+#include <triply/vertexData.h>
+#include <lunchbox/test.h>
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+using triply::VertexBufferBase;
+
+namespace
+{
+typedef std::vector<const VertexBufferBase*> Nodes;
+const size_t gridSize = 256;
+
+/** A tessellated unit sphere. */
+void _createSphere(triply::VertexData& data)
+{
+    for (size_t y = 0; y <= gridSize; ++y)
+    {
+        for (size_t x = 0; x < gridSize; ++x)
+        {
+            const float phi = float(x) / float(gridSize) * 2.f * float(M_PI);
+            const float theta = float(y) / float(gridSize) * float(M_PI);
+            const triply::Normal normal(std::sin(theta) * std::cos(phi),
+                                        std::sin(theta) * std::sin(phi),
+                                        std::cos(theta));
+            data.vertices.push_back(normal);
+            data.normals.push_back(normal);
+        }
+    }
+
+    for (size_t y = 0; y < gridSize; ++y)
+    {
+        for (size_t x = 0; x < gridSize; ++x)
+        {
+            const size_t i = y * gridSize + x;
+            const size_t right = y * gridSize + (x + 1) % gridSize;
+            data.triangles.push_back(
+                triply::Triangle(i, right, i + gridSize));
+            data.triangles.push_back(
+                triply::Triangle(i + gridSize, right, right + gridSize));
+        }
+    }
+}
+
+/** Checks the proxies and the monotonic error of the tree. */
+void _testTree(const VertexBufferBase& node)
+{
+    const VertexBufferBase* left = node.getLeft();
+    const VertexBufferBase* right = node.getRight();
+    if (!left)
+    {
+        TEST(!right);
+        TEST(!node.getProxy());
+        TEST(node.getError() == 0.f);
+        return;
+    }
+
+    TEST(node.getProxy());
+    const size_t proxyIndices = node.getProxy()->getNumberOfVertices();
+    TESTINFO(proxyIndices * 2 <= node.getNumberOfVertices(),
+             proxyIndices << " of " << node.getNumberOfVertices());
+    TEST(node.getError() >= left->getError());
+    TEST(node.getError() >= right->getError());
+    _testTree(*left);
+    _testTree(*right);
+}
+
+/** @return the number of rendered indices, checks full coverage. */
+size_t _testSelection(const triply::VertexBufferRoot& root,
+                      const triply::VertexBufferState& state)
+{
+    Nodes nodes;
+    root.cull(state, nodes);
+    TEST(!nodes.empty());
+
+    float coverage = 0.f;
+    size_t indices = 0;
+    for (const VertexBufferBase* node : nodes)
+    {
+        coverage += node->getRange()[1] - node->getRange()[0];
+        indices += node->getNumberOfVertices();
+    }
+    TESTINFO(std::abs(coverage - 1.f) < .0001f, coverage);
+    return indices;
+}
+}
+
+int main(int, char**)
+{
+    triply::VertexData data;
+    _createSphere(data);
+
+    std::ostringstream progressOut;
+    boost::progress_display progress(12, progressOut);
+    triply::VertexBufferRoot root;
+    root.setupTree(data, progress);
+    _testTree(root);
+
+    triply::VertexBufferStateSimple state(nullptr);
+    state.setFrustumCulling(false);
+
+    // error metric
+    const triply::BoundingBox box{triply::Vertex(-1.f), triply::Vertex(1.f)};
+    state.setLODProjection(triply::Vertex(0.f, 0.f, 11.f), 100.f);
+    TEST(std::abs(state.getScreenSpaceError(box, 1.f) - 10.f) < .0001f);
+    state.setLODProjection(triply::Vertex(0.f, 0.f, .5f), 100.f);
+    TEST(state.getScreenSpaceError(box, 1.f) ==
+         std::numeric_limits<float>::max());
+    TEST(state.getScreenSpaceError(box, 0.f) == 0.f);
+
+    // no level of detail: full resolution
+    const size_t total = root.getNumberOfVertices();
+    TEST(_testSelection(root, state) == total);
+
+    // far away: the root proxy
+    state.setLODThreshold(1.f);
+    state.setLODProjection(triply::Vertex(0.f, 0.f, 1000.f), 1000.f);
+    Nodes nodes;
+    root.cull(state, nodes);
+    TEST(nodes.size() == 1);
+    TEST(nodes[0] == root.getProxy());
+
+    // close up: refines with a decreasing threshold
+    state.setLODProjection(triply::Vertex(0.f, 0.f, 1.5f), 1000.f);
+    size_t last = 0;
+    bool mixed = false;
+    for (float threshold = 256.f; threshold >= .5f; threshold *= .5f)
+    {
+        state.setLODThreshold(threshold);
+        const size_t indices = _testSelection(root, state);
+        TESTINFO(indices >= last, indices << " < " << last);
+        last = indices;
+        mixed = mixed || (indices > root.getProxy()->getNumberOfVertices() &&
+                          indices < total);
+    }
+    TEST(mixed);
+
+    // partial range: the proxies must not cover other ranges
+    triply::Range range;
+    range[0] = 0.f;
+    range[1] = .5f;
+    state.setRange(range);
+    state.setLODThreshold(1.f);
+    state.setLODProjection(triply::Vertex(0.f, 0.f, 1000.f), 1000.f);
+    nodes.clear();
+    root.cull(state, nodes);
+    for (const VertexBufferBase* node : nodes)
+    {
+        TEST(node != root.getProxy());
+        TEST(node->getRange()[0] >= 0.f && node->getRange()[0] < .5f);
+    }
+    return EXIT_SUCCESS;
+}
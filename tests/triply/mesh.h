@@ -0,0 +1,75 @@
+/* Copyright (c) 2026, agent <agent@local>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#ifndef EQTEST_TRIPLY_MESH_H
+#define EQTEST_TRIPLY_MESH_H
+
+#include <triply/vertexBufferData.h>
+
+#include <cmath>
+
+namespace test
+{
+/**
+ * Create a tessellated, colored sphere cap offset from the origin.
+ *
+ * The mesh has size x size vertices, i.e., one full leaf for size < 256.
+ */
+inline void createMesh(triply::VertexBufferData& data, const size_t size)
+{
+    data.clear();
+    for (size_t y = 0; y < size; ++y)
+    {
+        for (size_t x = 0; x < size; ++x)
+        {
+            const float phi = float(x) / float(size) * 3.f;
+            const float theta = float(y) / float(size) * 1.5f + .1f;
+            const triply::Normal normal(std::sin(theta) * std::cos(phi),
+                                        std::sin(theta) * std::sin(phi),
+                                        std::cos(theta));
+            data.normals.push_back(normal);
+            data.vertices.push_back(normal * 2.5f +
+                                    triply::Vertex(10.f, -3.f, .5f));
+            data.colors.push_back(
+                triply::Color(uint8_t(x * 4), uint8_t(y * 4), 128));
+        }
+    }
+
+    for (size_t y = 0; y < size - 1; ++y)
+    {
+        for (size_t x = 0; x < size - 1; ++x)
+        {
+            const size_t i = y * size + x;
+            const size_t quad[] = {i,        i + 1, i + size,
+                                   i + size, i + 1, i + size + 1};
+            for (const size_t index : quad)
+                data.indices.push_back(triply::ShortIndex(index));
+        }
+    }
+}
+
+/** @return the size of the uncompressed vertex data in bytes. */
+inline size_t getSize(const triply::VertexBufferData& data)
+{
+    return data.vertices.size() * sizeof(triply::Vertex) +
+           data.colors.size() * sizeof(triply::Color) +
+           data.normals.size() * sizeof(triply::Normal) +
+           data.indices.size() * sizeof(triply::ShortIndex);
+}
+}
+
+#endif